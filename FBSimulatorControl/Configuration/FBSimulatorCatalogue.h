@@ -0,0 +1,149 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+/**
+ The Version of the Manifest format that can be read.
+ */
+extern NSUInteger const FBSimulatorCatalogueManifestVersion;
+
+/**
+ The Names of Product Families, as used in a Manifest.
+ */
+extern NSString *const FBSimulatorCatalogueFamilyiPhone;
+extern NSString *const FBSimulatorCatalogueFamilyiPad;
+extern NSString *const FBSimulatorCatalogueFamilyTV;
+extern NSString *const FBSimulatorCatalogueFamilyWatch;
+
+/**
+ A Device Model in the Catalogue.
+ */
+@interface FBSimulatorCatalogueDevice : NSObject <NSCopying>
+
+/**
+ The Name of the Device, as it is known to CoreSimulator. For example 'iPhone 6s'.
+ */
+@property (nonatomic, copy, readonly) NSString *name;
+
+/**
+ The Product Family of the Device. For example 'iPhone'.
+ */
+@property (nonatomic, copy, readonly) NSString *family;
+
+/**
+ The Product Family ID of the Device, as it is known to CoreSimulator.
+ */
+@property (nonatomic, assign, readonly) NSInteger productFamilyID;
+
+@end
+
+/**
+ An OS Runtime in the Catalogue.
+ */
+@interface FBSimulatorCatalogueRuntime : NSObject <NSCopying>
+
+/**
+ The Name of the Runtime, as it is known to CoreSimulator. For example 'iOS 9.2'.
+ */
+@property (nonatomic, copy, readonly) NSString *name;
+
+/**
+ The Version of the Runtime. For example '9.2'.
+ */
+@property (nonatomic, copy, readonly) NSString *version;
+
+/**
+ An NSSet<NSString *> of the Product Families that the Runtime supports.
+ */
+@property (nonatomic, copy, readonly) NSSet *families;
+
+/**
+ An NSSet<NSNumber *> of the Product Family IDs that the Runtime supports, as they are known to CoreSimulator.
+ */
+@property (nonatomic, copy, readonly) NSSet *productFamilyIDs;
+
+@end
+
+/**
+ A Catalogue of the Device Models and OS Runtimes that Simulators can be created with.
+
+ A Catalogue can be read from a versioned JSON or plist Manifest of the form:
+ {
+   "version": 1,
+   "devices": [{"name": "iPhone 6s", "family": "iPhone"}],
+   "runtimes": [{"name": "iOS 9.2", "version": "9.2", "families": ["iPhone", "iPad"]}]
+ }
+ Entries discovered from the installed CoreSimulator Device Types and Runtimes can then be merged in.
+ */
+@interface FBSimulatorCatalogue : NSObject <NSCopying>
+
+/**
+ Creates a Catalogue from a Manifest, validating it against the schema.
+
+ @param manifest the Manifest, as decoded from JSON or a plist.
+ @param error an error out for any error that occurred.
+ @return a Catalogue if the Manifest is valid, nil otherwise.
+ */
++ (instancetype)catalogueWithManifest:(NSDictionary *)manifest error:(NSError **)error;
+
+/**
+ Creates a Catalogue from a JSON or plist Manifest File.
+
+ @param path the path of the Manifest.
+ @param error an error out for any error that occurred.
+ @return a Catalogue if the Manifest could be read and is valid, nil otherwise.
+ */
++ (instancetype)catalogueWithManifestAtPath:(NSString *)path error:(NSError **)error;
+
+/**
+ Creates a Catalogue from CoreSimulator's Device Types and Runtimes.
+ Objects are accessed through Key-Value Coding, so do not need to be CoreSimulator classes.
+ Device Types and Runtimes of an unknown Product Family are ignored.
+
+ @param deviceTypes an NSArray<SimDeviceType *> of the Device Types.
+ @param runtimes an NSArray<SimRuntime *> of the Runtimes.
+ @return a Catalogue.
+ */
++ (instancetype)catalogueFromDeviceTypes:(NSArray *)deviceTypes runtimes:(NSArray *)runtimes;
+
+/**
+ Creates a Catalogue from the Device Types and Runtimes that are installed in CoreSimulator.
+ */
++ (instancetype)installedCatalogue;
+
+/**
+ Returns a Catalogue with the entries of the receiver, followed by any entries in the other catalogue with names that the receiver does not contain.
+
+ @param catalogue the catalogue to merge in.
+ @return a new Catalogue.
+ */
+- (instancetype)catalogueByMergingCatalogue:(FBSimulatorCatalogue *)catalogue;
+
+/**
+ An NSArray<FBSimulatorCatalogueDevice *> of the Devices.
+ */
+@property (nonatomic, copy, readonly) NSArray *devices;
+
+/**
+ An NSArray<FBSimulatorCatalogueRuntime *> of the Runtimes.
+ */
+@property (nonatomic, copy, readonly) NSArray *runtimes;
+
+/**
+ Returns the Device with the given name, nil if there is none.
+ */
+- (FBSimulatorCatalogueDevice *)deviceNamed:(NSString *)name;
+
+/**
+ Returns the Runtime with the given name, nil if there is none.
+ */
+- (FBSimulatorCatalogueRuntime *)runtimeNamed:(NSString *)name;
+
+@end
@@ -0,0 +1,414 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "FBSimulatorCatalogue.h"
+
+#import <CoreSimulator/SimDeviceType.h>
+#import <CoreSimulator/SimRuntime.h>
+
+#import "FBSimulatorControl+Class.h"
+#import "FBSimulatorError.h"
+
+NSUInteger const FBSimulatorCatalogueManifestVersion = 1;
+
+NSString *const FBSimulatorCatalogueFamilyiPhone = @"iPhone";
+NSString *const FBSimulatorCatalogueFamilyiPad = @"iPad";
+NSString *const FBSimulatorCatalogueFamilyTV = @"Apple TV";
+NSString *const FBSimulatorCatalogueFamilyWatch = @"Apple Watch";
+
+static NSDictionary *ProductFamilyIDs(void)
+{
+  static dispatch_once_t onceToken;
+  static NSDictionary *familyIDs;
+  dispatch_once(&onceToken, ^{
+    familyIDs = @{
+      FBSimulatorCatalogueFamilyiPhone : @1,
+      FBSimulatorCatalogueFamilyiPad : @2,
+      FBSimulatorCatalogueFamilyTV : @3,
+      FBSimulatorCatalogueFamilyWatch : @4,
+    };
+  });
+  return familyIDs;
+}
+
+static NSString *FamilyNameForProductFamilyID(NSInteger productFamilyID)
+{
+  return [ProductFamilyIDs() allKeysForObject:@(productFamilyID)].firstObject;
+}
+
+@interface FBSimulatorCatalogueDevice ()
+
+@property (nonatomic, copy, readwrite) NSString *name;
+@property (nonatomic, copy, readwrite) NSString *family;
+
+@end
+
+@implementation FBSimulatorCatalogueDevice
+
+- (NSInteger)productFamilyID
+{
+  return [ProductFamilyIDs()[self.family] integerValue];
+}
+
+#pragma mark NSCopying
+
+- (instancetype)copyWithZone:(NSZone *)zone
+{
+  return self;
+}
+
+#pragma mark NSObject
+
+- (BOOL)isEqual:(FBSimulatorCatalogueDevice *)object
+{
+  if (![object isMemberOfClass:self.class]) {
+    return NO;
+  }
+  return [object.name isEqualToString:self.name] &&
+         [object.family isEqualToString:self.family];
+}
+
+- (NSUInteger)hash
+{
+  return self.name.hash ^ self.family.hash;
+}
+
+- (NSString *)description
+{
+  return [NSString stringWithFormat:
+    @"Device '%@' | Family %@",
+    self.name,
+    self.family
+  ];
+}
+
+@end
+
+@interface FBSimulatorCatalogueRuntime ()
+
+@property (nonatomic, copy, readwrite) NSString *name;
+@property (nonatomic, copy, readwrite) NSString *version;
+@property (nonatomic, copy, readwrite) NSSet *families;
+
+@end
+
+@implementation FBSimulatorCatalogueRuntime
+
+- (NSSet *)productFamilyIDs
+{
+  NSMutableSet *productFamilyIDs = [NSMutableSet set];
+  for (NSString *family in self.families) {
+    [productFamilyIDs addObject:ProductFamilyIDs()[family]];
+  }
+  return [productFamilyIDs copy];
+}
+
+#pragma mark NSCopying
+
+- (instancetype)copyWithZone:(NSZone *)zone
+{
+  return self;
+}
+
+#pragma mark NSObject
+
+- (BOOL)isEqual:(FBSimulatorCatalogueRuntime *)object
+{
+  if (![object isMemberOfClass:self.class]) {
+    return NO;
+  }
+  return [object.name isEqualToString:self.name] &&
+         [object.version isEqualToString:self.version] &&
+         [object.families isEqualToSet:self.families];
+}
+
+- (NSUInteger)hash
+{
+  return self.name.hash ^ self.version.hash ^ self.families.hash;
+}
+
+- (NSString *)description
+{
+  return [NSString stringWithFormat:
+    @"Runtime '%@' | Version %@ | Families %@",
+    self.name,
+    self.version,
+    [self.families.allObjects componentsJoinedByString:@", "]
+  ];
+}
+
+@end
+
+@interface FBSimulatorCatalogue ()
+
+@property (nonatomic, copy, readwrite) NSArray *devices;
+@property (nonatomic, copy, readwrite) NSArray *runtimes;
+@property (nonatomic, copy, readwrite) NSDictionary *devicesByName;
+@property (nonatomic, copy, readwrite) NSDictionary *runtimesByName;
+
+@end
+
+@implementation FBSimulatorCatalogue
+
+#pragma mark Initializers
+
+- (instancetype)initWithDevices:(NSArray *)devices runtimes:(NSArray *)runtimes
+{
+  self = [super init];
+  if (!self) {
+    return nil;
+  }
+
+  _devices = [devices copy];
+  _runtimes = [runtimes copy];
+  _devicesByName = [NSDictionary dictionaryWithObjects:devices forKeys:[devices valueForKey:@"name"]];
+  _runtimesByName = [NSDictionary dictionaryWithObjects:runtimes forKeys:[runtimes valueForKey:@"name"]];
+
+  return self;
+}
+
++ (instancetype)catalogueWithManifest:(NSDictionary *)manifest error:(NSError **)error
+{
+  if (![manifest isKindOfClass:NSDictionary.class]) {
+    return [[FBSimulatorError describeFormat:@"Manifest must be a dictionary, not %@", manifest.class] fail:error];
+  }
+  NSNumber *version = manifest[@"version"];
+  if (![version isKindOfClass:NSNumber.class] || version.unsignedIntegerValue != FBSimulatorCatalogueManifestVersion) {
+    return [[FBSimulatorError describeFormat:@"Manifest version '%@' is not the supported version %lu", version, (unsigned long) FBSimulatorCatalogueManifestVersion] fail:error];
+  }
+
+  NSArray *deviceEntries = manifest[@"devices"] ?: @[];
+  if (![deviceEntries isKindOfClass:NSArray.class]) {
+    return [[FBSimulatorError describe:@"Manifest 'devices' must be an array"] fail:error];
+  }
+  NSMutableArray *devices = [NSMutableArray array];
+  NSMutableSet *deviceNames = [NSMutableSet set];
+  for (NSDictionary *entry in deviceEntries) {
+    NSError *innerError = nil;
+    FBSimulatorCatalogueDevice *device = [self deviceFromManifestEntry:entry error:&innerError];
+    if (!device) {
+      return [[[FBSimulatorError describeFormat:@"Invalid device at index %lu of Manifest", (unsigned long) devices.count] causedBy:innerError] fail:error];
+    }
+    if ([deviceNames containsObject:device.name]) {
+      return [[FBSimulatorError describeFormat:@"Manifest contains more than one device named '%@'", device.name] fail:error];
+    }
+    [deviceNames addObject:device.name];
+    [devices addObject:device];
+  }
+
+  NSArray *runtimeEntries = manifest[@"runtimes"] ?: @[];
+  if (![runtimeEntries isKindOfClass:NSArray.class]) {
+    return [[FBSimulatorError describe:@"Manifest 'runtimes' must be an array"] fail:error];
+  }
+  NSMutableArray *runtimes = [NSMutableArray array];
+  NSMutableSet *runtimeNames = [NSMutableSet set];
+  for (NSDictionary *entry in runtimeEntries) {
+    NSError *innerError = nil;
+    FBSimulatorCatalogueRuntime *runtime = [self runtimeFromManifestEntry:entry error:&innerError];
+    if (!runtime) {
+      return [[[FBSimulatorError describeFormat:@"Invalid runtime at index %lu of Manifest", (unsigned long) runtimes.count] causedBy:innerError] fail:error];
+    }
+    if ([runtimeNames containsObject:runtime.name]) {
+      return [[FBSimulatorError describeFormat:@"Manifest contains more than one runtime named '%@'", runtime.name] fail:error];
+    }
+    [runtimeNames addObject:runtime.name];
+    [runtimes addObject:runtime];
+  }
+
+  return [[self alloc] initWithDevices:devices runtimes:runtimes];
+}
+
++ (instancetype)catalogueWithManifestAtPath:(NSString *)path error:(NSError **)error
+{
+  NSError *innerError = nil;
+  NSData *data = [NSData dataWithContentsOfFile:path options:0 error:&innerError];
+  if (!data) {
+    return [[[FBSimulatorError describeFormat:@"Could not read Manifest at %@", path] causedBy:innerError] fail:error];
+  }
+  id manifest = [path.pathExtension isEqualToString:@"plist"]
+    ? [NSPropertyListSerialization propertyListWithData:data options:NSPropertyListImmutable format:nil error:&innerError]
+    : [NSJSONSerialization JSONObjectWithData:data options:0 error:&innerError];
+  if (!manifest) {
+    return [[[FBSimulatorError describeFormat:@"Could not decode Manifest at %@", path] causedBy:innerError] fail:error];
+  }
+  FBSimulatorCatalogue *catalogue = [self catalogueWithManifest:manifest error:&innerError];
+  if (!catalogue) {
+    return [[[FBSimulatorError describeFormat:@"Manifest at %@ is invalid", path] causedBy:innerError] fail:error];
+  }
+  return catalogue;
+}
+
++ (instancetype)catalogueFromDeviceTypes:(NSArray *)deviceTypes runtimes:(NSArray *)runtimes
+{
+  NSMutableArray *devices = [NSMutableArray array];
+  NSMutableSet *deviceNames = [NSMutableSet set];
+  for (id deviceType in deviceTypes) {
+    NSString *name = [deviceType valueForKey:@"name"];
+    NSString *family = FamilyNameForProductFamilyID([[deviceType valueForKey:@"productFamilyID"] integerValue]);
+    if (!name || !family || [deviceNames containsObject:name]) {
+      continue;
+    }
+
+    FBSimulatorCatalogueDevice *device = [FBSimulatorCatalogueDevice new];
+    device.name = name;
+    device.family = family;
+    [deviceNames addObject:name];
+    [devices addObject:device];
+  }
+
+  NSMutableArray *catalogueRuntimes = [NSMutableArray array];
+  NSMutableSet *runtimeNames = [NSMutableSet set];
+  for (id simRuntime in runtimes) {
+    NSString *name = [simRuntime valueForKey:@"name"];
+    NSString *version = [simRuntime valueForKey:@"versionString"];
+    NSMutableSet *families = [NSMutableSet set];
+    for (NSNumber *productFamilyID in [simRuntime valueForKey:@"supportedProductFamilyIDs"]) {
+      NSString *family = FamilyNameForProductFamilyID(productFamilyID.integerValue);
+      if (family) {
+        [families addObject:family];
+      }
+    }
+    if (!name || !version || families.count == 0 || [runtimeNames containsObject:name]) {
+      continue;
+    }
+
+    FBSimulatorCatalogueRuntime *runtime = [FBSimulatorCatalogueRuntime new];
+    runtime.name = name;
+    runtime.version = version;
+    runtime.families = families;
+    [runtimeNames addObject:name];
+    [catalogueRuntimes addObject:runtime];
+  }
+
+  return [[self alloc] initWithDevices:devices runtimes:catalogueRuntimes];
+}
+
++ (instancetype)installedCatalogue
+{
+  [FBSimulatorControl loadPrivateFrameworksOrAbort];
+  return [self
+    catalogueFromDeviceTypes:[NSClassFromString(@"SimDeviceType") supportedDeviceTypes]
+    runtimes:[NSClassFromString(@"SimRuntime") supportedRuntimes]];
+}
+
+#pragma mark Public
+
+- (instancetype)catalogueByMergingCatalogue:(FBSimulatorCatalogue *)catalogue
+{
+  NSMutableArray *devices = [self.devices mutableCopy];
+  for (FBSimulatorCatalogueDevice *device in catalogue.devices) {
+    if (!self.devicesByName[device.name]) {
+      [devices addObject:device];
+    }
+  }
+  NSMutableArray *runtimes = [self.runtimes mutableCopy];
+  for (FBSimulatorCatalogueRuntime *runtime in catalogue.runtimes) {
+    if (!self.runtimesByName[runtime.name]) {
+      [runtimes addObject:runtime];
+    }
+  }
+  return [[self.class alloc] initWithDevices:devices runtimes:runtimes];
+}
+
+- (FBSimulatorCatalogueDevice *)deviceNamed:(NSString *)name
+{
+  return name ? self.devicesByName[name] : nil;
+}
+
+- (FBSimulatorCatalogueRuntime *)runtimeNamed:(NSString *)name
+{
+  return name ? self.runtimesByName[name] : nil;
+}
+
+#pragma mark NSCopying
+
+- (instancetype)copyWithZone:(NSZone *)zone
+{
+  return self;
+}
+
+#pragma mark NSObject
+
+- (BOOL)isEqual:(FBSimulatorCatalogue *)object
+{
+  if (![object isMemberOfClass:self.class]) {
+    return NO;
+  }
+  return [object.devices isEqualToArray:self.devices] &&
+         [object.runtimes isEqualToArray:self.runtimes];
+}
+
+- (NSUInteger)hash
+{
+  return self.devices.hash ^ self.runtimes.hash;
+}
+
+- (NSString *)description
+{
+  return [NSString stringWithFormat:
+    @"Catalogue | Devices %@ | Runtimes %@",
+    [[self.devices valueForKey:@"name"] componentsJoinedByString:@", "],
+    [[self.runtimes valueForKey:@"name"] componentsJoinedByString:@", "]
+  ];
+}
+
+#pragma mark Private
+
++ (FBSimulatorCatalogueDevice *)deviceFromManifestEntry:(NSDictionary *)entry error:(NSError **)error
+{
+  if (![entry isKindOfClass:NSDictionary.class]) {
+    return [[FBSimulatorError describe:@"Device must be a dictionary"] fail:error];
+  }
+  NSString *name = entry[@"name"];
+  if (![name isKindOfClass:NSString.class] || name.length == 0) {
+    return [[FBSimulatorError describeFormat:@"Device 'name' must be a non-empty string, not '%@'", name] fail:error];
+  }
+  NSString *family = entry[@"family"];
+  if (![family isKindOfClass:NSString.class] || !ProductFamilyIDs()[family]) {
+    return [[FBSimulatorError describeFormat:@"Device '%@' has family '%@', which is not one of %@", name, family, ProductFamilyIDs().allKeys] fail:error];
+  }
+
+  FBSimulatorCatalogueDevice *device = [FBSimulatorCatalogueDevice new];
+  device.name = name;
+  device.family = family;
+  return device;
+}
+
++ (FBSimulatorCatalogueRuntime *)runtimeFromManifestEntry:(NSDictionary *)entry error:(NSError **)error
+{
+  if (![entry isKindOfClass:NSDictionary.class]) {
+    return [[FBSimulatorError describe:@"Runtime must be a dictionary"] fail:error];
+  }
+  NSString *name = entry[@"name"];
+  if (![name isKindOfClass:NSString.class] || name.length == 0) {
+    return [[FBSimulatorError describeFormat:@"Runtime 'name' must be a non-empty string, not '%@'", name] fail:error];
+  }
+  NSString *version = entry[@"version"];
+  NSCharacterSet *invalidVersionCharacters = [[NSCharacterSet characterSetWithCharactersInString:@"0123456789."] invertedSet];
+  if (![version isKindOfClass:NSString.class] || version.length == 0 || [version rangeOfCharacterFromSet:invalidVersionCharacters].location != NSNotFound) {
+    return [[FBSimulatorError describeFormat:@"Runtime '%@' has version '%@', which is not of the form 'X.Y'", name, version] fail:error];
+  }
+  NSArray *families = entry[@"families"];
+  if (![families isKindOfClass:NSArray.class] || families.count == 0) {
+    return [[FBSimulatorError describeFormat:@"Runtime '%@' must have a non-empty array of 'families'", name] fail:error];
+  }
+  for (NSString *family in families) {
+    if (![family isKindOfClass:NSString.class] || !ProductFamilyIDs()[family]) {
+      return [[FBSimulatorError describeFormat:@"Runtime '%@' has family '%@', which is not one of %@", name, family, ProductFamilyIDs().allKeys] fail:error];
+    }
+  }
+
+  FBSimulatorCatalogueRuntime *runtime = [FBSimulatorCatalogueRuntime new];
+  runtime.name = name;
+  runtime.version = version;
+  runtime.families = [NSSet setWithArray:families];
+  return runtime;
+}
+
+@end
@@ -46,15 +46,33 @@
 
 + (instancetype)inferSimulatorConfigurationFromDevice:(SimDevice *)simDevice error:(NSError **)error;
 {
-  id<FBSimulatorConfiguration_OS> configOS = FBSimulatorConfiguration.nameToOSVersion[simDevice.runtime.name];
+  // Configurations are immutable and depend only upon the Device Type & Runtime, so can be shared between all Simulators.
+  NSString *key = [NSString stringWithFormat:
+    @"%@|%@",
+    simDevice.deviceType.identifier ?: simDevice.deviceType.name,
+    simDevice.runtime.identifier ?: simDevice.runtime.name
+  ];
+  NSMutableDictionary *inferredConfigurations = self.inferredConfigurations;
+  @synchronized(inferredConfigurations) {
+    FBSimulatorConfiguration *configuration = inferredConfigurations[key];
+    if (configuration) {
+      return configuration;
+    }
+  }
+
+  id<FBSimulatorConfiguration_OS> configOS = [FBSimulatorConfiguration osWithName:simDevice.runtime.name];
   if (!configOS) {
     return [[FBSimulatorError describeFormat:@"Could not obtain OS Version for %@, perhaps it is unsupported by FBSimulatorControl", simDevice.runtime.name] fail:error];
   }
-  id<FBSimulatorConfiguration_Device> configDevice = FBSimulatorConfiguration.nameToDevice[simDevice.deviceType.name];
+  id<FBSimulatorConfiguration_Device> configDevice = [FBSimulatorConfiguration deviceWithName:simDevice.deviceType.name];
   if (!configDevice) {
     return [[FBSimulatorError describeFormat:@"Could not obtain Device for for %@, perhaps it is unsupported by FBSimulatorControl", simDevice.deviceType.name] fail:error];
   }
-  return [[FBSimulatorConfiguration.defaultConfiguration updateOSVersion:configOS] updateNamedDevice:configDevice];
+  FBSimulatorConfiguration *configuration = [[FBSimulatorConfiguration.defaultConfiguration updateOSVersion:configOS] updateNamedDevice:configDevice];
+  @synchronized(inferredConfigurations) {
+    inferredConfigurations[key] = configuration;
+  }
+  return configuration;
 }
 
 - (BOOL)checkRuntimeRequirementsReturningError:(NSError **)error
@@ -143,7 +161,7 @@
 {
   NSMutableArray *array = [NSMutableArray array];
   for (SimRuntime *runtime in [self supportedRuntimesForDevice:device]) {
-    id<FBSimulatorConfiguration_OS> os = FBSimulatorConfiguration.nameToOSVersion[runtime.name];
+    id<FBSimulatorConfiguration_OS> os = [FBSimulatorConfiguration osWithName:runtime.name];
     if (os) {
       [array addObject:os];
     }
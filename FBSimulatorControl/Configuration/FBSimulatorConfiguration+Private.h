@@ -179,6 +179,27 @@
 @interface FBSimulatorConfigurationScale_100 : FBSimulatorConfigurationVariant_Base <FBSimulatorConfigurationScale>
 @end
 
+@class FBSimulatorCatalogueDevice;
+@class FBSimulatorCatalogueRuntime;
+
+/**
+ A Device from the Catalogue, rather than built in.
+ */
+@interface FBSimulatorConfiguration_Device_Catalogue : FBSimulatorConfigurationVariant_Base <FBSimulatorConfiguration_Device>
+
+- (instancetype)initWithDevice:(FBSimulatorCatalogueDevice *)device;
+
+@end
+
+/**
+ An OS Version from the Catalogue, rather than built in.
+ */
+@interface FBSimulatorConfiguration_OS_Catalogue : FBSimulatorConfigurationVariant_Base <FBSimulatorConfiguration_OS>
+
+- (instancetype)initWithRuntime:(FBSimulatorCatalogueRuntime *)runtime;
+
+@end
+
 @interface FBSimulatorConfiguration ()
 
 @property (nonatomic, strong, readwrite) id<FBSimulatorConfiguration_Device> device;
@@ -193,5 +214,8 @@
 + (NSArray *)OSConfigurations;
 + (NSDictionary *)nameToDevice;
 + (NSDictionary *)nameToOSVersion;
++ (id<FBSimulatorConfiguration_Device>)deviceWithName:(NSString *)deviceName;
++ (id<FBSimulatorConfiguration_OS>)osWithName:(NSString *)osName;
++ (NSMutableDictionary *)inferredConfigurations;
 
 @end
@@ -9,6 +9,8 @@
 
 #import <Foundation/Foundation.h>
 
+@class FBSimulatorCatalogue;
+
 /**
  A Value object that represents the Configuration of a iPhone, iPad, Watch or TV Simulator.
 
@@ -125,7 +127,7 @@
 - (instancetype)appleTV1080p;
 
 /**
- A Device with the provided name.
+ A Device with the provided name, which may be built in or from the Catalogue.
  Will return nil, if no device with the given name could be found.
  */
 + (instancetype)withDeviceNamed:(NSString *)deviceName;
@@ -179,13 +181,13 @@
 - (instancetype)iOS_9_2;
 
 /**
- Device with the given OS version.
+ Device with the given OS version, which may be built in or from the Catalogue.
  Will return nil, if no OS with the given name could be found.
  */
 + (instancetype)withOSNamed:(NSString *)osName;
 
 /**
- Device with the given OS version.
+ Device with the given OS version, which may be built in or from the Catalogue.
  Will return nil, if no OS with the given name could be found.
  */
 - (instancetype)withOSNamed:(NSString *)osName;
@@ -248,4 +250,19 @@
  */
 - (instancetype)withLocaleNamed:(NSString *)localeIdentifier;
 
+#pragma mark Catalogue
+
+/**
+ The Catalogue that Device and OS names are resolved against, when they are not built in.
+ Defaults to nil, in which case only the built in Devices and OS Versions can be resolved.
+ */
++ (FBSimulatorCatalogue *)catalogue;
+
+/**
+ Sets the Catalogue that Device and OS names are resolved against.
+
+ @param catalogue the Catalogue to use, or nil to only use the built in Devices and OS Versions.
+ */
++ (void)setCatalogue:(FBSimulatorCatalogue *)catalogue;
+
 @end
@@ -12,6 +12,7 @@
 
 #import <objc/runtime.h>
 
+#import "FBSimulatorCatalogue.h"
 #import "FBSimulatorControl+Class.h"
 #import "FBSimulatorConfiguration+CoreSimulator.h"
 #import "FBSimulatorControlStaticConfiguration.h"
@@ -457,6 +458,179 @@
 
 @end
 
+#pragma mark Catalogue Variants
+
+static id<FBSimulatorConfiguration_Family> FamilyVariantForProductFamilyID(NSInteger productFamilyID)
+{
+  // The Product Family IDs are those of the built in Family Variants.
+  for (id<FBSimulatorConfiguration_Family> family in @[FBSimulatorConfiguration_Family_iPhone.new, FBSimulatorConfiguration_Family_iPad.new, FBSimulatorConfiguration_Family_TV.new, FBSimulatorConfiguration_Family_Watch.new]) {
+    if (family.productFamilyID == productFamilyID) {
+      return family;
+    }
+  }
+  return nil;
+}
+
+@interface FBSimulatorConfiguration_Device_Catalogue ()
+
+@property (nonatomic, copy, readonly) NSString *name;
+@property (nonatomic, assign, readonly) NSInteger productFamilyID;
+
+@end
+
+@implementation FBSimulatorConfiguration_Device_Catalogue
+
+- (instancetype)initWithDevice:(FBSimulatorCatalogueDevice *)device
+{
+  return [self initWithName:device.name productFamilyID:device.productFamilyID];
+}
+
+- (instancetype)initWithName:(NSString *)name productFamilyID:(NSInteger)productFamilyID
+{
+  NSParameterAssert(name);
+
+  self = [super init];
+  if (!self) {
+    return nil;
+  }
+
+  _name = [name copy];
+  _productFamilyID = productFamilyID;
+
+  return self;
+}
+
+- (NSString *)deviceName
+{
+  return self.name;
+}
+
+- (id<FBSimulatorConfiguration_Family>)family
+{
+  return FamilyVariantForProductFamilyID(self.productFamilyID);
+}
+
+#pragma mark NSCoding
+
+- (instancetype)initWithCoder:(NSCoder *)coder
+{
+  return [self
+    initWithName:[coder decodeObjectForKey:NSStringFromSelector(@selector(name))]
+    productFamilyID:[[coder decodeObjectForKey:NSStringFromSelector(@selector(productFamilyID))] integerValue]];
+}
+
+- (void)encodeWithCoder:(NSCoder *)coder
+{
+  [coder encodeObject:self.name forKey:NSStringFromSelector(@selector(name))];
+  [coder encodeObject:@(self.productFamilyID) forKey:NSStringFromSelector(@selector(productFamilyID))];
+}
+
+#pragma mark NSObject
+
+- (BOOL)isEqual:(FBSimulatorConfiguration_Device_Catalogue *)object
+{
+  if (![object isMemberOfClass:self.class]) {
+    return NO;
+  }
+  return [object.name isEqualToString:self.name] && object.productFamilyID == self.productFamilyID;
+}
+
+- (NSUInteger)hash
+{
+  return self.name.hash;
+}
+
+- (NSString *)description
+{
+  return [NSString stringWithFormat:@"Catalogue Device '%@'", self.name];
+}
+
+@end
+
+@interface FBSimulatorConfiguration_OS_Catalogue ()
+
+@property (nonatomic, copy, readonly) NSString *osName;
+@property (nonatomic, copy, readonly) NSSet *productFamilyIDs;
+
+@end
+
+@implementation FBSimulatorConfiguration_OS_Catalogue
+
+- (instancetype)initWithRuntime:(FBSimulatorCatalogueRuntime *)runtime
+{
+  return [self initWithName:runtime.name productFamilyIDs:runtime.productFamilyIDs];
+}
+
+- (instancetype)initWithName:(NSString *)name productFamilyIDs:(NSSet *)productFamilyIDs
+{
+  NSParameterAssert(name);
+  NSParameterAssert(productFamilyIDs);
+
+  self = [super init];
+  if (!self) {
+    return nil;
+  }
+
+  _osName = [name copy];
+  _productFamilyIDs = [productFamilyIDs copy];
+
+  return self;
+}
+
+- (NSString *)name
+{
+  return self.osName;
+}
+
+- (NSSet *)families
+{
+  NSMutableSet *families = [NSMutableSet set];
+  for (NSNumber *productFamilyID in self.productFamilyIDs) {
+    id<FBSimulatorConfiguration_Family> family = FamilyVariantForProductFamilyID(productFamilyID.integerValue);
+    if (family) {
+      [families addObject:family];
+    }
+  }
+  return [families copy];
+}
+
+#pragma mark NSCoding
+
+- (instancetype)initWithCoder:(NSCoder *)coder
+{
+  return [self
+    initWithName:[coder decodeObjectForKey:NSStringFromSelector(@selector(name))]
+    productFamilyIDs:[coder decodeObjectForKey:NSStringFromSelector(@selector(productFamilyIDs))]];
+}
+
+- (void)encodeWithCoder:(NSCoder *)coder
+{
+  [coder encodeObject:self.osName forKey:NSStringFromSelector(@selector(name))];
+  [coder encodeObject:self.productFamilyIDs forKey:NSStringFromSelector(@selector(productFamilyIDs))];
+}
+
+#pragma mark NSObject
+
+- (BOOL)isEqual:(FBSimulatorConfiguration_OS_Catalogue *)object
+{
+  if (![object isMemberOfClass:self.class]) {
+    return NO;
+  }
+  return [object.osName isEqualToString:self.osName] && [object.productFamilyIDs isEqualToSet:self.productFamilyIDs];
+}
+
+- (NSUInteger)hash
+{
+  return self.osName.hash;
+}
+
+- (NSString *)description
+{
+  return [NSString stringWithFormat:@"Catalogue OS '%@'", self.osName];
+}
+
+@end
+
 #pragma mark Scales
 
 @implementation FBSimulatorConfigurationScale_25
@@ -748,7 +922,7 @@
 
 - (instancetype)withDeviceNamed:(NSString *)deviceName
 {
-  return [self updateNamedDevice:self.class.nameToDevice[deviceName]];
+  return [self updateNamedDevice:[self.class deviceWithName:deviceName]];
 }
 
 #pragma mark OS Versions
@@ -825,7 +999,7 @@
 
 - (instancetype)withOSNamed:(NSString *)osName
 {
-  return [self updateOSVersion:self.class.nameToOSVersion[osName]];
+  return [self updateOSVersion:[self.class osWithName:osName]];
 }
 
 #pragma mark Scale
@@ -965,6 +1139,36 @@
   return OSConfigurations;
 }
 
+static FBSimulatorCatalogue *FBSimulatorConfigurationCatalogue = nil;
+static NSMutableDictionary *FBSimulatorConfigurationInferredConfigurations = nil;
+
++ (FBSimulatorCatalogue *)catalogue
+{
+  @synchronized(FBSimulatorConfiguration.class) {
+    return FBSimulatorConfigurationCatalogue;
+  }
+}
+
++ (void)setCatalogue:(FBSimulatorCatalogue *)catalogue
+{
+  @synchronized(FBSimulatorConfiguration.class) {
+    FBSimulatorConfigurationCatalogue = catalogue;
+    // Configurations inferred from the previous Catalogue may no longer be valid.
+    // A new dictionary is used, so that an inference that started before now is stored in the old one.
+    FBSimulatorConfigurationInferredConfigurations = nil;
+  }
+}
+
++ (NSMutableDictionary *)inferredConfigurations
+{
+  @synchronized(FBSimulatorConfiguration.class) {
+    if (!FBSimulatorConfigurationInferredConfigurations) {
+      FBSimulatorConfigurationInferredConfigurations = [NSMutableDictionary dictionary];
+    }
+    return FBSimulatorConfigurationInferredConfigurations;
+  }
+}
+
 + (NSDictionary *)nameToDevice
 {
   static dispatch_once_t onceToken;
@@ -995,4 +1199,24 @@
   return mapping;
 }
 
++ (id<FBSimulatorConfiguration_Device>)deviceWithName:(NSString *)deviceName
+{
+  id<FBSimulatorConfiguration_Device> device = deviceName ? self.nameToDevice[deviceName] : nil;
+  if (device) {
+    return device;
+  }
+  FBSimulatorCatalogueDevice *catalogueDevice = [FBSimulatorConfiguration.catalogue deviceNamed:deviceName];
+  return catalogueDevice ? [[FBSimulatorConfiguration_Device_Catalogue alloc] initWithDevice:catalogueDevice] : nil;
+}
+
++ (id<FBSimulatorConfiguration_OS>)osWithName:(NSString *)osName
+{
+  id<FBSimulatorConfiguration_OS> os = osName ? self.nameToOSVersion[osName] : nil;
+  if (os) {
+    return os;
+  }
+  FBSimulatorCatalogueRuntime *catalogueRuntime = [FBSimulatorConfiguration.catalogue runtimeNamed:osName];
+  return catalogueRuntime ? [[FBSimulatorConfiguration_OS_Catalogue alloc] initWithRuntime:catalogueRuntime] : nil;
+}
+
 @end
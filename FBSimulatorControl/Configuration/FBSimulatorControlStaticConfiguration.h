@@ -9,6 +9,7 @@
 
 #import <Foundation/Foundation.h>
 
+@class FBSimulatorToolchain;
 @protocol FBSimulatorLogger;
 
 /**
@@ -27,6 +28,11 @@ extern NSString *const FBSimulatorControlDebugLogging;
  */
 @interface FBSimulatorControlStaticConfiguration : NSObject
 
+/**
+ The Toolchain of the selected Xcode, read from the on-disk cache where possible.
+ */
++ (FBSimulatorToolchain *)toolchain;
+
 /**
  The path to of Xcode's /Xcode.app/Contents/Developer directory.
  */
@@ -12,25 +12,28 @@
 #import "FBSimulator.h"
 #import "FBSimulatorApplication.h"
 #import "FBSimulatorLogger.h"
-#import "FBTaskExecutor.h"
+#import "FBSimulatorToolchainCache.h"
 
 NSString *const FBSimulatorControlSimulatorLaunchEnvironmentSimulatorUDID = @"FBSIMULATORCONTROL_SIM_UDID";
 NSString *const FBSimulatorControlDebugLogging = @"FBSIMULATORCONTROL_DEBUG_LOGGING";
 
 @implementation FBSimulatorControlStaticConfiguration
 
-+ (NSString *)developerDirectory
++ (FBSimulatorToolchain *)toolchain
 {
   static dispatch_once_t onceToken;
-  static NSString *directory;
+  static FBSimulatorToolchain *toolchain;
   dispatch_once(&onceToken, ^{
-    directory = [[[FBTaskExecutor.sharedInstance
-      taskWithLaunchPath:@"/usr/bin/xcode-select" arguments:@[@"--print-path"]]
-      startSynchronouslyWithTimeout:10]
-      stdOut];
-    NSCAssert(directory, @"Xcode Path could not be determined from `xcode-select`");
+    NSError *error = nil;
+    toolchain = [FBSimulatorToolchainCache.sharedCache toolchainWithError:&error];
+    NSCAssert(toolchain, @"Toolchain could not be determined %@", error);
   });
-  return directory;
+  return toolchain;
+}
+
++ (NSString *)developerDirectory
+{
+  return self.toolchain.developerDirectory;
 }
 
 + (NSDecimalNumber *)sdkVersionNumber
@@ -53,37 +56,7 @@ NSString *const FBSimulatorControlDebugLogging = @"FBSIMULATORCONTROL_DEBUG_LOGG
 
 + (NSString *)sdkVersion
 {
-  static dispatch_once_t onceToken;
-  static NSString *sdkVersion;
-  dispatch_once(&onceToken, ^{
-    NSString *showSdks= [[[FBTaskExecutor.sharedInstance
-      taskWithLaunchPath:@"/usr/bin/xcodebuild" arguments:@[@"-showsdks"]]
-      startSynchronouslyWithTimeout:10]
-      stdOut];
-
-    NSString *pattern = @"iphonesimulator(.*)";
-    NSRegularExpression *regex = [NSRegularExpression
-      regularExpressionWithPattern:pattern
-      options:(NSRegularExpressionOptions) 0
-      error:nil];
-
-    NSArray *matches = [regex
-      matchesInString:showSdks
-      options:(NSMatchingOptions) 0
-      range:NSMakeRange(0, showSdks.length)];
-
-    // If xcode license is not accepted, no sdk is shown.
-    NSCAssert(matches.count >= 1, @"Could not find a match for the SDK version");
-
-    NSTextCheckingResult *match = [matches lastObject];
-    NSCAssert(
-      match.numberOfRanges == 2, @"We expect to have exactly 1 match. Text is %@",
-      [showSdks substringWithRange:match.range]
-    );
-
-    sdkVersion = [showSdks substringWithRange:[match rangeAtIndex:1]];
-  });
-  return sdkVersion;
+  return self.toolchain.sdkVersion;
 }
 
 + (BOOL)supportsCustomDeviceSets
@@ -0,0 +1,78 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+/**
+ A Declarative description of the Preferences of a Simulator.
+ The Profile describes the desired values of top-level keys in Property Lists, relative to the Simulator's Data Directory.
+ Keys in a Property List that are not described by the Profile are left untouched when the Profile is applied.
+ */
+@interface FBSimulatorPreferencesProfile : NSObject <NSCopying, NSCoding>
+
+/**
+ An Empty Profile.
+ */
++ (instancetype)profile;
+
+/**
+ A NSDictionary<NSString *, NSDictionary *> of relative Property List path to the desired top-level values.
+ */
+@property (nonatomic, copy, readonly) NSDictionary *plists;
+
+/**
+ Returns a new Profile with the values set for the Property List at the relative path.
+ Values for existing keys in the Profile are replaced.
+
+ @param values the top-level values to set.
+ @param relativePath the path of the Property List, relative to the Simulator's Data Directory.
+ @return a new Profile.
+ */
+- (instancetype)withValues:(NSDictionary *)values forPlistAtRelativePath:(NSString *)relativePath;
+
+/**
+ Returns a new Profile, with the values of the other Profile applied on top of the receiver.
+ */
+- (instancetype)withProfile:(FBSimulatorPreferencesProfile *)profile;
+
+/**
+ Returns a new Profile that sets the Locale and Language.
+ */
+- (instancetype)withLocale:(NSLocale *)locale;
+
+/**
+ Returns a new Profile that disables Caps Lock, Auto Capitalization and Auto Correction.
+ */
+- (instancetype)withKeyboardDefaults;
+
+/**
+ Returns a new Profile that authorizes Location Services for the Bundle ID.
+ */
+- (instancetype)withLocationAuthorizationForBundleID:(NSString *)bundleID;
+
+/**
+ Computes the values that differ from those on disk.
+ Files that are already in the desired state are absent from the returned dictionary.
+
+ @param rootPath the root that relative paths are resolved against.
+ @return a NSDictionary<NSString *, NSDictionary *> of relative path to the values that need to be written.
+ */
+- (NSDictionary *)diffAgainstRootPath:(NSString *)rootPath;
+
+/**
+ Applies the Profile, writing each changed Property List once and atomically.
+ Unchanged Property Lists are not written.
+
+ @param rootPath the root that relative paths are resolved against.
+ @param error an error out for any error that occurred.
+ @return an NSArray<NSString *> of the relative paths that were written, nil on failure.
+ */
+- (NSArray *)applyToRootPath:(NSString *)rootPath error:(NSError **)error;
+
+@end
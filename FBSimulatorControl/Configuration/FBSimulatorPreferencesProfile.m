@@ -0,0 +1,230 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "FBSimulatorPreferencesProfile.h"
+
+#import "FBSimulatorError.h"
+
+static NSString *const FBSimulatorPreferencesGlobalPreferencesPath = @"Library/Preferences/.GlobalPreferences.plist";
+static NSString *const FBSimulatorPreferencesPreferencesPath = @"Library/Preferences/com.apple.Preferences.plist";
+static NSString *const FBSimulatorPreferencesLocationClientsPath = @"Library/Caches/locationd/clients.plist";
+
+@implementation FBSimulatorPreferencesProfile
+
+#pragma mark Initializers
+
++ (instancetype)profile
+{
+  return [[self alloc] initWithPlists:@{}];
+}
+
+- (instancetype)initWithPlists:(NSDictionary *)plists
+{
+  NSParameterAssert(plists);
+
+  self = [super init];
+  if (!self) {
+    return nil;
+  }
+
+  _plists = [plists copy];
+
+  return self;
+}
+
+#pragma mark Profiles
+
+- (instancetype)withValues:(NSDictionary *)values forPlistAtRelativePath:(NSString *)relativePath
+{
+  NSParameterAssert(values);
+  NSParameterAssert(relativePath);
+
+  NSMutableDictionary *plists = [self.plists mutableCopy];
+  NSMutableDictionary *plist = [plists[relativePath] mutableCopy] ?: [NSMutableDictionary dictionary];
+  [plist addEntriesFromDictionary:values];
+  plists[relativePath] = [plist copy];
+  return [[FBSimulatorPreferencesProfile alloc] initWithPlists:plists];
+}
+
+- (instancetype)withProfile:(FBSimulatorPreferencesProfile *)profile
+{
+  NSParameterAssert(profile);
+
+  FBSimulatorPreferencesProfile *merged = self;
+  for (NSString *relativePath in profile.plists) {
+    merged = [merged withValues:profile.plists[relativePath] forPlistAtRelativePath:relativePath];
+  }
+  return merged;
+}
+
+- (instancetype)withLocale:(NSLocale *)locale
+{
+  NSParameterAssert(locale);
+
+  NSString *localeIdentifier = [locale localeIdentifier];
+  NSString *languageIdentifier = [NSLocale canonicalLanguageIdentifierFromString:localeIdentifier];
+  return [self withValues:@{
+    @"AppleLocale": localeIdentifier,
+    @"AppleLanguages": @[ languageIdentifier ],
+  } forPlistAtRelativePath:FBSimulatorPreferencesGlobalPreferencesPath];
+}
+
+- (instancetype)withKeyboardDefaults
+{
+  return [self withValues:@{
+    @"KeyboardCapsLock" : @NO,
+    @"KeyboardAutocapitalization" : @NO,
+    @"KeyboardAutocorrection" : @NO,
+  } forPlistAtRelativePath:FBSimulatorPreferencesPreferencesPath];
+}
+
+- (instancetype)withLocationAuthorizationForBundleID:(NSString *)bundleID
+{
+  NSParameterAssert(bundleID);
+
+  return [self withValues:@{
+    bundleID : @{
+      @"Whitelisted": @NO,
+      @"BundleId": bundleID,
+      @"SupportedAuthorizationMask" : @3,
+      @"Authorization" : @2,
+      @"Authorized": @YES,
+      @"Executable": @"",
+      @"Registered": @"",
+    },
+  } forPlistAtRelativePath:FBSimulatorPreferencesLocationClientsPath];
+}
+
+#pragma mark Applying
+
+- (NSDictionary *)diffAgainstRootPath:(NSString *)rootPath
+{
+  NSMutableDictionary *diff = [NSMutableDictionary dictionary];
+  for (NSString *relativePath in self.plists) {
+    NSDictionary *current = [FBSimulatorPreferencesProfile readPlistAtPath:[rootPath stringByAppendingPathComponent:relativePath] format:NULL];
+    NSDictionary *changes = [FBSimulatorPreferencesProfile changesFrom:current to:self.plists[relativePath]];
+    if (changes.count) {
+      diff[relativePath] = changes;
+    }
+  }
+  return [diff copy];
+}
+
+- (NSArray *)applyToRootPath:(NSString *)rootPath error:(NSError **)error
+{
+  NSMutableArray *written = [NSMutableArray array];
+  for (NSString *relativePath in [self.plists.allKeys sortedArrayUsingSelector:@selector(compare:)]) {
+    NSString *path = [rootPath stringByAppendingPathComponent:relativePath];
+    NSPropertyListFormat format = NSPropertyListBinaryFormat_v1_0;
+    NSDictionary *current = [FBSimulatorPreferencesProfile readPlistAtPath:path format:&format];
+    NSDictionary *changes = [FBSimulatorPreferencesProfile changesFrom:current to:self.plists[relativePath]];
+    if (!changes.count) {
+      continue;
+    }
+
+    NSMutableDictionary *updated = [current mutableCopy] ?: [NSMutableDictionary dictionary];
+    [updated addEntriesFromDictionary:changes];
+    if (![FBSimulatorPreferencesProfile writePlist:updated toPath:path format:format error:error]) {
+      return nil;
+    }
+    [written addObject:relativePath];
+  }
+  return [written copy];
+}
+
+#pragma mark Private
+
++ (NSDictionary *)readPlistAtPath:(NSString *)path format:(NSPropertyListFormat *)format
+{
+  NSData *data = [NSData dataWithContentsOfFile:path];
+  if (!data) {
+    return nil;
+  }
+  NSDictionary *plist = [NSPropertyListSerialization propertyListWithData:data options:NSPropertyListImmutable format:format error:nil];
+  if (![plist isKindOfClass:NSDictionary.class]) {
+    return nil;
+  }
+  return plist;
+}
+
++ (NSDictionary *)changesFrom:(NSDictionary *)current to:(NSDictionary *)desired
+{
+  NSMutableDictionary *changes = [NSMutableDictionary dictionary];
+  for (NSString *key in desired) {
+    if ([current[key] isEqual:desired[key]]) {
+      continue;
+    }
+    changes[key] = desired[key];
+  }
+  return [changes copy];
+}
+
++ (BOOL)writePlist:(NSDictionary *)plist toPath:(NSString *)path format:(NSPropertyListFormat)format error:(NSError **)error
+{
+  NSError *innerError = nil;
+  NSData *data = [NSPropertyListSerialization dataWithPropertyList:plist format:format options:0 error:&innerError];
+  if (!data) {
+    return [[[FBSimulatorError describeFormat:@"Failed to serialize Property List for %@", path] causedBy:innerError] failBool:error];
+  }
+  if (![NSFileManager.defaultManager createDirectoryAtPath:path.stringByDeletingLastPathComponent withIntermediateDirectories:YES attributes:nil error:&innerError]) {
+    return [[[FBSimulatorError describeFormat:@"Failed to create directory for %@", path] causedBy:innerError] failBool:error];
+  }
+  if (![data writeToFile:path options:NSDataWritingAtomic error:&innerError]) {
+    return [[[FBSimulatorError describeFormat:@"Failed to write Property List to %@", path] causedBy:innerError] failBool:error];
+  }
+  return YES;
+}
+
+#pragma mark NSCopying
+
+- (instancetype)copyWithZone:(NSZone *)zone
+{
+  return self;
+}
+
+#pragma mark NSCoding
+
+- (instancetype)initWithCoder:(NSCoder *)coder
+{
+  self = [super init];
+  if (!self) {
+    return nil;
+  }
+
+  _plists = [coder decodeObjectForKey:NSStringFromSelector(@selector(plists))];
+
+  return self;
+}
+
+- (void)encodeWithCoder:(NSCoder *)coder
+{
+  [coder encodeObject:self.plists forKey:NSStringFromSelector(@selector(plists))];
+}
+
+#pragma mark NSObject
+
+- (BOOL)isEqual:(FBSimulatorPreferencesProfile *)object
+{
+  if (![object isMemberOfClass:self.class]) {
+    return NO;
+  }
+  return [object.plists isEqualToDictionary:self.plists];
+}
+
+- (NSUInteger)hash
+{
+  return self.plists.hash;
+}
+
+- (NSString *)description
+{
+  return [NSString stringWithFormat:@"Preferences Profile | Plists %@", [self.plists.allKeys sortedArrayUsingSelector:@selector(compare:)]];
+}
+
+@end
@@ -0,0 +1,92 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+/**
+ The Version of the on-disk format. Caches written with a different version are discarded.
+ */
+extern NSUInteger const FBSimulatorToolchainCacheVersion;
+
+/**
+ The Developer Directory and SDK Version of the selected Xcode.
+ */
+@interface FBSimulatorToolchain : NSObject <NSCopying>
+
+/**
+ Creates a Toolchain with the provided values.
+
+ @param developerDirectory the path of the Developer Directory.
+ @param sdkVersion the iPhone Simulator SDK Version.
+ @return a new Toolchain.
+ */
++ (instancetype)toolchainWithDeveloperDirectory:(NSString *)developerDirectory sdkVersion:(NSString *)sdkVersion;
+
+/**
+ The path to of Xcode's /Xcode.app/Contents/Developer directory.
+ */
+@property (nonatomic, copy, readonly) NSString *developerDirectory;
+
+/**
+ The iPhone Simulator SDK Version of the selected Xcode. For example '9.2'.
+ */
+@property (nonatomic, copy, readonly) NSString *sdkVersion;
+
+@end
+
+/**
+ Discovers the Toolchain from `xcode-select` and `xcodebuild`, persisting the result so that later processes do not need to.
+
+ The persisted Toolchain is keyed by the Xcode selection (either $DEVELOPER_DIR or the xcode-select link),
+ along with the identity and modification time of the link and the directory it selects.
+ When the selection changes, or the selected Xcode is replaced, the key will not match and the Toolchain is discovered again.
+ If the selection cannot be determined, the Toolchain is discovered every time.
+ */
+@interface FBSimulatorToolchainCache : NSObject
+
+/**
+ The Cache in the current user's Caches directory, discovering with the system tools.
+ */
++ (instancetype)sharedCache;
+
+/**
+ A Cache backed by the file at the provided path, discovering with the provided tools.
+
+ @param path the path of the cache file. The directory will be created if it does not exist.
+ @param selectionPath the path of the symlink that `xcode-select` maintains.
+ @param xcodeSelectPath the path of the `xcode-select` executable.
+ @param xcodebuildPath the path of the `xcodebuild` executable.
+ @param environment the environment to read $DEVELOPER_DIR from.
+ @return a new Cache.
+ */
++ (instancetype)cacheWithPath:(NSString *)path selectionPath:(NSString *)selectionPath xcodeSelectPath:(NSString *)xcodeSelectPath xcodebuildPath:(NSString *)xcodebuildPath environment:(NSDictionary *)environment;
+
+/**
+ The path of the cache file.
+ */
+@property (nonatomic, copy, readonly) NSString *path;
+
+/**
+ Returns the persisted Toolchain if the selection is unchanged, otherwise discovers and persists it.
+ Failing to persist the Toolchain is not an error.
+
+ @param error an error out for any error that occurred.
+ @return the Toolchain if it could be determined, nil otherwise.
+ */
+- (FBSimulatorToolchain *)toolchainWithError:(NSError **)error;
+
+/**
+ Extracts the iPhone Simulator SDK Version from the output of `xcodebuild -showsdks`.
+
+ @param output the output of `xcodebuild -showsdks`.
+ @return the last iPhone Simulator SDK Version in the output, nil if there is none.
+ */
++ (NSString *)sdkVersionFromShowSDKsOutput:(NSString *)output;
+
+@end
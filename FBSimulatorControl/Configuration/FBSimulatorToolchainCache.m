@@ -0,0 +1,283 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "FBSimulatorToolchainCache.h"
+
+#include <sys/stat.h>
+
+#import "FBSimulatorError.h"
+#import "FBTaskExecutor.h"
+
+NSUInteger const FBSimulatorToolchainCacheVersion = 1;
+
+static NSString *const KeyVersion = @"version";
+static NSString *const KeySelection = @"selection";
+static NSString *const KeyDeveloperDirectory = @"developer_directory";
+static NSString *const KeySDKVersion = @"sdk_version";
+
+static NSTimeInterval const DiscoveryTimeout = 10;
+
+static NSString *FileIdentity(NSString *path, BOOL followSymlinks)
+{
+  struct stat fileStat;
+  int result = followSymlinks
+    ? stat(path.fileSystemRepresentation, &fileStat)
+    : lstat(path.fileSystemRepresentation, &fileStat);
+  if (result != 0) {
+    return nil;
+  }
+  return [NSString stringWithFormat:
+    @"%llu:%llu:%ld.%09ld",
+    (unsigned long long) fileStat.st_dev,
+    (unsigned long long) fileStat.st_ino,
+    (long) fileStat.st_mtimespec.tv_sec,
+    (long) fileStat.st_mtimespec.tv_nsec
+  ];
+}
+
+@implementation FBSimulatorToolchain
+
++ (instancetype)toolchainWithDeveloperDirectory:(NSString *)developerDirectory sdkVersion:(NSString *)sdkVersion
+{
+  return [[self alloc] initWithDeveloperDirectory:developerDirectory sdkVersion:sdkVersion];
+}
+
+- (instancetype)initWithDeveloperDirectory:(NSString *)developerDirectory sdkVersion:(NSString *)sdkVersion
+{
+  NSParameterAssert(developerDirectory);
+  NSParameterAssert(sdkVersion);
+
+  self = [super init];
+  if (!self) {
+    return nil;
+  }
+
+  _developerDirectory = [developerDirectory copy];
+  _sdkVersion = [sdkVersion copy];
+
+  return self;
+}
+
+#pragma mark NSCopying
+
+- (instancetype)copyWithZone:(NSZone *)zone
+{
+  return self;
+}
+
+#pragma mark NSObject
+
+- (BOOL)isEqual:(FBSimulatorToolchain *)object
+{
+  if (![object isKindOfClass:self.class]) {
+    return NO;
+  }
+  return [self.developerDirectory isEqualToString:object.developerDirectory] &&
+         [self.sdkVersion isEqualToString:object.sdkVersion];
+}
+
+- (NSUInteger)hash
+{
+  return self.developerDirectory.hash ^ self.sdkVersion.hash;
+}
+
+- (NSString *)description
+{
+  return [NSString stringWithFormat:
+    @"Developer Directory %@ | SDK Version %@",
+    self.developerDirectory,
+    self.sdkVersion
+  ];
+}
+
+@end
+
+@interface FBSimulatorToolchainCache ()
+
+@property (nonatomic, copy, readonly) NSString *selectionPath;
+@property (nonatomic, copy, readonly) NSString *xcodeSelectPath;
+@property (nonatomic, copy, readonly) NSString *xcodebuildPath;
+@property (nonatomic, copy, readonly) NSDictionary *environment;
+
+@end
+
+@implementation FBSimulatorToolchainCache
+
+#pragma mark Initializers
+
++ (instancetype)sharedCache
+{
+  static dispatch_once_t onceToken;
+  static FBSimulatorToolchainCache *cache;
+  dispatch_once(&onceToken, ^{
+    NSString *path = [[NSHomeDirectory()
+      stringByAppendingPathComponent:@"Library/Caches/com.facebook.FBSimulatorControl"]
+      stringByAppendingPathComponent:@"toolchain.plist"];
+    cache = [self
+      cacheWithPath:path
+      selectionPath:@"/var/db/xcode_select_link"
+      xcodeSelectPath:@"/usr/bin/xcode-select"
+      xcodebuildPath:@"/usr/bin/xcodebuild"
+      environment:NSProcessInfo.processInfo.environment];
+  });
+  return cache;
+}
+
++ (instancetype)cacheWithPath:(NSString *)path selectionPath:(NSString *)selectionPath xcodeSelectPath:(NSString *)xcodeSelectPath xcodebuildPath:(NSString *)xcodebuildPath environment:(NSDictionary *)environment
+{
+  return [[self alloc] initWithPath:path selectionPath:selectionPath xcodeSelectPath:xcodeSelectPath xcodebuildPath:xcodebuildPath environment:environment];
+}
+
+- (instancetype)initWithPath:(NSString *)path selectionPath:(NSString *)selectionPath xcodeSelectPath:(NSString *)xcodeSelectPath xcodebuildPath:(NSString *)xcodebuildPath environment:(NSDictionary *)environment
+{
+  NSParameterAssert(path);
+  NSParameterAssert(selectionPath);
+  NSParameterAssert(xcodeSelectPath);
+  NSParameterAssert(xcodebuildPath);
+
+  self = [super init];
+  if (!self) {
+    return nil;
+  }
+
+  _path = [path copy];
+  _selectionPath = [selectionPath copy];
+  _xcodeSelectPath = [xcodeSelectPath copy];
+  _xcodebuildPath = [xcodebuildPath copy];
+  _environment = [environment copy] ?: @{};
+
+  return self;
+}
+
+#pragma mark Public
+
+- (FBSimulatorToolchain *)toolchainWithError:(NSError **)error
+{
+  @synchronized(self) {
+    NSString *selection = self.currentSelection;
+    FBSimulatorToolchain *toolchain = [self persistedToolchainForSelection:selection];
+    if (toolchain) {
+      return toolchain;
+    }
+
+    toolchain = [self discoverToolchainWithError:error];
+    if (!toolchain) {
+      return nil;
+    }
+    if (selection) {
+      [self persistToolchain:toolchain forSelection:selection];
+    }
+    return toolchain;
+  }
+}
+
++ (NSString *)sdkVersionFromShowSDKsOutput:(NSString *)output
+{
+  if (!output) {
+    return nil;
+  }
+  NSRegularExpression *regex = [NSRegularExpression
+    regularExpressionWithPattern:@"iphonesimulator(.*)"
+    options:(NSRegularExpressionOptions) 0
+    error:nil];
+  NSTextCheckingResult *match = [[regex
+    matchesInString:output
+    options:(NSMatchingOptions) 0
+    range:NSMakeRange(0, output.length)]
+    lastObject];
+  if (match.numberOfRanges != 2) {
+    return nil;
+  }
+  NSString *version = [[output substringWithRange:[match rangeAtIndex:1]] stringByTrimmingCharactersInSet:NSCharacterSet.whitespaceCharacterSet];
+  return version.length > 0 ? version : nil;
+}
+
+#pragma mark Private
+
+/**
+ A description of the current Xcode selection that changes whenever the selection does, nil if it cannot be determined.
+ */
+- (NSString *)currentSelection
+{
+  NSString *developerDirectory = self.environment[@"DEVELOPER_DIR"];
+  if (developerDirectory.length > 0) {
+    NSString *identity = FileIdentity(developerDirectory, YES);
+    return identity ? [NSString stringWithFormat:@"env:%@|%@", developerDirectory, identity] : nil;
+  }
+
+  NSString *destination = [NSFileManager.defaultManager destinationOfSymbolicLinkAtPath:self.selectionPath error:nil];
+  NSString *linkIdentity = FileIdentity(self.selectionPath, NO);
+  NSString *destinationIdentity = FileIdentity(self.selectionPath, YES);
+  if (!destination || !linkIdentity || !destinationIdentity) {
+    return nil;
+  }
+  return [NSString stringWithFormat:@"link:%@|%@|%@", destination, linkIdentity, destinationIdentity];
+}
+
+- (FBSimulatorToolchain *)persistedToolchainForSelection:(NSString *)selection
+{
+  if (!selection) {
+    return nil;
+  }
+  // A missing, corrupt, differently versioned or mismatching cache file is ignored, to be replaced after discovery.
+  NSData *data = [NSData dataWithContentsOfFile:self.path];
+  if (!data) {
+    return nil;
+  }
+  NSDictionary *contents = [NSPropertyListSerialization propertyListWithData:data options:NSPropertyListImmutable format:nil error:nil];
+  if (![contents isKindOfClass:NSDictionary.class]) {
+    return nil;
+  }
+  if ([contents[KeyVersion] unsignedIntegerValue] != FBSimulatorToolchainCacheVersion || ![contents[KeySelection] isEqual:selection]) {
+    return nil;
+  }
+  NSString *developerDirectory = contents[KeyDeveloperDirectory];
+  NSString *sdkVersion = contents[KeySDKVersion];
+  if (![developerDirectory isKindOfClass:NSString.class] || ![sdkVersion isKindOfClass:NSString.class]) {
+    return nil;
+  }
+  return [FBSimulatorToolchain toolchainWithDeveloperDirectory:developerDirectory sdkVersion:sdkVersion];
+}
+
+- (void)persistToolchain:(FBSimulatorToolchain *)toolchain forSelection:(NSString *)selection
+{
+  NSDictionary *contents = @{
+    KeyVersion : @(FBSimulatorToolchainCacheVersion),
+    KeySelection : selection,
+    KeyDeveloperDirectory : toolchain.developerDirectory,
+    KeySDKVersion : toolchain.sdkVersion,
+  };
+  NSData *data = [NSPropertyListSerialization dataWithPropertyList:contents format:NSPropertyListBinaryFormat_v1_0 options:0 error:nil];
+  [NSFileManager.defaultManager createDirectoryAtPath:self.path.stringByDeletingLastPathComponent withIntermediateDirectories:YES attributes:nil error:nil];
+  [data writeToFile:self.path options:NSDataWritingAtomic error:nil];
+}
+
+- (FBSimulatorToolchain *)discoverToolchainWithError:(NSError **)error
+{
+  id<FBTask> task = [[FBTaskExecutor.sharedInstance
+    taskWithLaunchPath:self.xcodeSelectPath arguments:@[@"--print-path"]]
+    startSynchronouslyWithTimeout:DiscoveryTimeout];
+  NSString *developerDirectory = task.stdOut;
+  if (!task.wasSuccessful || developerDirectory.length == 0) {
+    return [[[FBSimulatorError describeFormat:@"Xcode Path could not be determined from %@", self.xcodeSelectPath] causedBy:task.error] fail:error];
+  }
+
+  task = [[FBTaskExecutor.sharedInstance
+    taskWithLaunchPath:self.xcodebuildPath arguments:@[@"-showsdks"]]
+    startSynchronouslyWithTimeout:DiscoveryTimeout];
+  NSString *sdkVersion = task.wasSuccessful ? [FBSimulatorToolchainCache sdkVersionFromShowSDKsOutput:task.stdOut] : nil;
+  if (!sdkVersion) {
+    // If the Xcode license is not accepted, no SDK is shown.
+    return [[[FBSimulatorError describeFormat:@"Could not find the iPhone Simulator SDK Version from %@ -showsdks", self.xcodebuildPath] causedBy:task.error] fail:error];
+  }
+
+  return [FBSimulatorToolchain toolchainWithDeveloperDirectory:developerDirectory sdkVersion:sdkVersion];
+}
+
+@end
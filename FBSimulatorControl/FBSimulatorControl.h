@@ -8,15 +8,23 @@
  */
 
 #import <FBSimulatorControl/FBAddVideoPolyfill.h>
+#import <FBSimulatorControl/FBApplicationMetadataCache.h>
 #import <FBSimulatorControl/FBBinaryParser.h>
+#import <FBSimulatorControl/FBBundleAnalyzer.h>
 #import <FBSimulatorControl/FBCollectionDescriptions.h>
 #import <FBSimulatorControl/FBCompositeSimulatorEventSink.h>
 #import <FBSimulatorControl/FBConcurrentCollectionOperations.h>
 #import <FBSimulatorControl/FBCoreSimulatorNotifier.h>
 #import <FBSimulatorControl/FBCrashLogInfo.h>
+#import <FBSimulatorControl/FBDebuggerSession.h>
+#import <FBSimulatorControl/FBDebuggerSessionPool.h>
 #import <FBSimulatorControl/FBDispatchSourceNotifier.h>
+#import <FBSimulatorControl/FBDisplayCaptureFrameSource.h>
+#import <FBSimulatorControl/FBFrameSignature.h>
 #import <FBSimulatorControl/FBInteraction+Private.h>
 #import <FBSimulatorControl/FBInteraction.h>
+#import <FBSimulatorControl/FBLaunchProbe.h>
+#import <FBSimulatorControl/FBMediaManifest.h>
 #import <FBSimulatorControl/FBProcessInfo+Helpers.h>
 #import <FBSimulatorControl/FBProcessInfo.h>
 #import <FBSimulatorControl/FBProcessLaunchConfiguration+Helpers.h>
@@ -25,11 +33,18 @@
 #import <FBSimulatorControl/FBProcessQuery+Helpers.h>
 #import <FBSimulatorControl/FBProcessQuery+Simulators.h>
 #import <FBSimulatorControl/FBProcessQuery.h>
+#import <FBSimulatorControl/FBRollingVideoRecorder.h>
+#import <FBSimulatorControl/FBScreenCaptureFrameSource.h>
+#import <FBSimulatorControl/FBScreenshotEncoder.h>
+#import <FBSimulatorControl/FBScreenshotSource.h>
+#import <FBSimulatorControl/FBSegmentedVideoRecorder.h>
+#import <FBSimulatorControl/FBSharedScreenCapture.h>
 #import <FBSimulatorControl/FBSimDeviceWrapper.h>
 #import <FBSimulatorControl/FBSimulator+Helpers.h>
 #import <FBSimulatorControl/FBSimulator+Private.h>
 #import <FBSimulatorControl/FBSimulator.h>
 #import <FBSimulatorControl/FBSimulatorApplication.h>
+#import <FBSimulatorControl/FBSimulatorCatalogue.h>
 #import <FBSimulatorControl/FBSimulatorConfiguration+CoreSimulator.h>
 #import <FBSimulatorControl/FBSimulatorConfiguration+Private.h>
 #import <FBSimulatorControl/FBSimulatorConfiguration.h>
@@ -56,17 +71,21 @@
 #import <FBSimulatorControl/FBSimulatorLogger.h>
 #import <FBSimulatorControl/FBSimulatorLoggingEventSink.h>
 #import <FBSimulatorControl/FBSimulatorLogs.h>
+#import <FBSimulatorControl/FBSimulatorMatrix.h>
 #import <FBSimulatorControl/FBSimulatorNotificationEventSink.h>
 #import <FBSimulatorControl/FBSimulatorPool+Private.h>
 #import <FBSimulatorControl/FBSimulatorPool.h>
 #import <FBSimulatorControl/FBSimulatorPredicates.h>
+#import <FBSimulatorControl/FBSimulatorPreferencesProfile.h>
 #import <FBSimulatorControl/FBSimulatorResourceManager.h>
 #import <FBSimulatorControl/FBSimulatorSession+Convenience.h>
 #import <FBSimulatorControl/FBSimulatorSession+Private.h>
 #import <FBSimulatorControl/FBSimulatorSession.h>
 #import <FBSimulatorControl/FBSimulatorTerminationStrategy.h>
+#import <FBSimulatorControl/FBSimulatorToolchainCache.h>
 #import <FBSimulatorControl/FBSimulatorVideoRecorder.h>
 #import <FBSimulatorControl/FBSimulatorWindowHelpers.h>
+#import <FBSimulatorControl/FBSimulatorWindowPacker.h>
 #import <FBSimulatorControl/FBSimulatorWindowTiler.h>
 #import <FBSimulatorControl/FBSimulatorWindowTilingStrategy.h>
 #import <FBSimulatorControl/FBTask+Private.h>
@@ -75,6 +94,15 @@
 #import <FBSimulatorControl/FBTaskExecutor+Private.h>
 #import <FBSimulatorControl/FBTaskExecutor.h>
 #import <FBSimulatorControl/FBTerminationHandle.h>
+#import <FBSimulatorControl/FBTracer.h>
+#import <FBSimulatorControl/FBVideoFrameDeduplicator.h>
+#import <FBSimulatorControl/FBVideoFrameSource.h>
+#import <FBSimulatorControl/FBVideoSegment.h>
+#import <FBSimulatorControl/FBVideoSegmentIndex.h>
+#import <FBSimulatorControl/FBVideoSegmentMuxer.h>
+#import <FBSimulatorControl/FBVideoSegmentWriter.h>
+#import <FBSimulatorControl/FBVideoSegmenter.h>
+#import <FBSimulatorControl/FBVideoTrimmer.h>
 #import <FBSimulatorControl/FBWritableLog+Private.h>
 #import <FBSimulatorControl/FBWritableLog.h>
 #import <FBSimulatorControl/NSRunLoop+SimulatorControlAdditions.h>
@@ -50,7 +50,7 @@
 
   FBSimulator *simulator = self.simulator;
 
-  return [self interact:^ BOOL (NSError **error, id _) {
+  return [self trace:"launchApplication" interact:^ BOOL (NSError **error, id _) {
     NSError *innerError = nil;
     NSDictionary *installedApps = [simulator.device installedAppsWithError:&innerError];
     if (!installedApps) {
@@ -25,7 +25,8 @@
  - (instancetype)sampleApplication:(FBSimulatorApplication *)application withDuration:(NSInteger)durationInSeconds frequency:(NSInteger)frequencyInMilliseconds;
 
 /**
- Executes a command with lldb(1). This is done asynchronously.
+ Executes a command with lldb(1).
+ The Debugger remains attached to the Application between commands, so repeated commands do not pay the cost of attaching.
  The result is attached to the Session State. If an error occurs during the run of the lldb command, no result will be returned.
 
  @param application the Application to sample. Must be running, otherwise the interaction will fail.
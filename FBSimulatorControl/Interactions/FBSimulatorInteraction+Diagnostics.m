@@ -9,6 +9,8 @@
 
 #import "FBSimulatorInteraction+Diagnostics.h"
 
+#import "FBDebuggerSessionPool.h"
+#import "FBProcessInfo.h"
 #import "FBSimulatorApplication.h"
 #import "FBSimulatorError.h"
 #import "FBSimulatorEventSink.h"
@@ -33,14 +35,19 @@ typedef id<FBTask>(^FBDiagnosticTaskFactory)(FBTaskExecutor *executor, pid_t pro
 
 - (instancetype)onApplication:(FBSimulatorApplication *)application executeLLDBCommand:(NSString *)command
 {
+  NSParameterAssert(application);
   NSParameterAssert(command);
 
-  return [self syncDiagnosticOnApplication:application name:@"lldb_command" taskFactory:^id<FBTask>(FBTaskExecutor *executor, pid_t processIdentifier) {
-    return [[[[executor
-      withLaunchPath:@"/usr/bin/lldb"]
-      withArguments:@[@"-p", @(processIdentifier).stringValue, @"-o", command, @"-o", @"script import os; os._exit(1)"]]
-      withAcceptableTerminationStatusCodes:[NSSet setWithArray:@[@0, @1]]]
-      build];
+  FBSimulator *simulator = self.simulator;
+
+  return [self binary:application.binary interact:^ BOOL (FBProcessInfo *process, NSError **error) {
+    NSError *innerError = nil;
+    NSString *output = [FBDebuggerSessionPool.sharedPool executeCommand:command onProcessIdentifier:process.processIdentifier timeout:FBSimulatorDefaultTimeout error:&innerError];
+    if (!output) {
+      return [[[FBSimulatorError describeFormat:@"Failed to execute LLDB command '%@'", command] causedBy:innerError] failBool:error];
+    }
+    [simulator.eventSink diagnosticInformationAvailable:@"lldb_command" process:process value:output];
+    return YES;
   }];
 }
 
@@ -72,24 +79,4 @@ typedef id<FBTask>(^FBDiagnosticTaskFactory)(FBTaskExecutor *executor, pid_t pro
   }];
 }
 
-- (instancetype)syncDiagnosticOnApplication:(FBSimulatorApplication *)application name:(NSString *)name taskFactory:(FBDiagnosticTaskFactory)taskFactory
-{
-  NSParameterAssert(application);
-  NSParameterAssert(name);
-
-  FBSimulator *simulator = self.simulator;
-
-  return [self binary:application.binary interact:^ BOOL (FBProcessInfo *process, NSError **error) {
-    id<FBTask> task = taskFactory(FBTaskExecutor.sharedInstance, process.processIdentifier);
-    NSCAssert(task, @"Task should not be nil");
-
-    [task startSynchronouslyWithTimeout:FBSimulatorDefaultTimeout];
-    if (task.error) {
-      return [FBSimulatorError failBoolWithError:task.error errorOut:error];
-    }
-    [simulator.eventSink diagnosticInformationAvailable:name process:process value:task.stdOut];
-    return YES;
-  }];
-}
-
 @end
@@ -16,6 +16,11 @@
 
 @property (nonatomic, strong) FBSimulator *simulator;
 
+/**
+ Chains an interaction, recording the time taken to perform it as a Trace Span for the Simulator.
+ */
+- (instancetype)trace:(const char *)name interact:(BOOL (^)(NSError **error, id interaction))block;
+
 /**
  Chains an interaction on an process, for the given application.
  */
@@ -9,8 +9,18 @@
 
 #import <FBSimulatorControl/FBSimulatorInteraction.h>
 
+@class FBSimulatorPreferencesProfile;
+
 @interface FBSimulatorInteraction (Setup)
 
+/**
+ Applies the Preferences Profile to the Simulator.
+ Only the Property Lists that differ from the Profile are written, each with a single atomic write.
+
+ @param profile the Profile to apply, must not be nil.
+ */
+- (instancetype)applyPreferencesProfile:(FBSimulatorPreferencesProfile *)profile;
+
 /**
  Sets the locale for the simulator.
 
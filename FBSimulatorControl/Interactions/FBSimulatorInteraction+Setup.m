@@ -16,86 +16,42 @@
 #import "FBSimulatorApplication.h"
 #import "FBSimulatorError.h"
 #import "FBSimulatorInteraction+Private.h"
+#import "FBSimulatorPreferencesProfile.h"
 
 @implementation FBSimulatorInteraction (Setup)
 
-- (instancetype)setLocale:(NSLocale *)locale
+- (instancetype)applyPreferencesProfile:(FBSimulatorPreferencesProfile *)profile
 {
-  NSParameterAssert(locale);
+  NSParameterAssert(profile);
 
   FBSimulator *simulator = self.simulator;
 
   return [self interact:^ BOOL (NSError **error, id _) {
-    NSString *localeIdentifier = [locale localeIdentifier];
-    NSString *languageIdentifier = [NSLocale canonicalLanguageIdentifierFromString:localeIdentifier];
-    NSDictionary *preferencesDict = @{
-      @"AppleLocale": localeIdentifier,
-      @"AppleLanguages": @[ languageIdentifier ],
-    };
-
-    NSString *simulatorRoot = simulator.device.dataPath;
-    NSString *path = [simulatorRoot stringByAppendingPathComponent:@"Library/Preferences/.GlobalPreferences.plist"];
-    if (![preferencesDict writeToFile:path atomically:YES]) {
-      return [FBSimulatorError failBoolWithError:nil description:@"Failed to write .GlobalPreferences.plist" errorOut:error];
+    NSError *innerError = nil;
+    if (![profile applyToRootPath:simulator.device.dataPath error:&innerError]) {
+      return [[[[FBSimulatorError describeFormat:@"Failed to apply %@", profile] causedBy:innerError] inSimulator:simulator] failBool:error];
     }
-
     return YES;
   }];
 }
 
-- (instancetype)authorizeLocationSettingsForApplication:(FBSimulatorApplication *)application
+- (instancetype)setLocale:(NSLocale *)locale
 {
-  NSParameterAssert(application);
-
-  FBSimulator *simulator = self.simulator;
-
-  return [self interact:^ BOOL (NSError **error, id _) {
-    NSString *simulatorRoot = simulator.device.dataPath;
-    NSString *bundleID = application.bundleID;
+  NSParameterAssert(locale);
 
-    NSString *locationClientsDirectory = [simulatorRoot stringByAppendingPathComponent:@"Library/Caches/locationd"];
-    NSError *innerError = nil;
-    if (![NSFileManager.defaultManager createDirectoryAtPath:locationClientsDirectory withIntermediateDirectories:YES attributes:nil error:&innerError]) {
-      return [FBSimulatorError failBoolWithError:innerError description:@"Failed to create locationd" errorOut:error];
-    }
+  return [self applyPreferencesProfile:[FBSimulatorPreferencesProfile.profile withLocale:locale]];
+}
 
-    NSString *locationClientsPath = [locationClientsDirectory stringByAppendingPathComponent:@"clients.plist"];
-    NSMutableDictionary *locationClients = [NSMutableDictionary dictionaryWithContentsOfFile:locationClientsPath] ?: [NSMutableDictionary dictionary];
-    locationClients[bundleID] = @{
-      @"Whitelisted": @NO,
-      @"BundleId": bundleID,
-      @"SupportedAuthorizationMask" : @3,
-      @"Authorization" : @2,
-      @"Authorized": @YES,
-      @"Executable": @"",
-      @"Registered": @"",
-    };
+- (instancetype)authorizeLocationSettingsForApplication:(FBSimulatorApplication *)application
+{
+  NSParameterAssert(application);
 
-    if (![locationClients writeToFile:locationClientsPath atomically:YES]) {
-      return [FBSimulatorError failBoolWithError:innerError description:@"Failed to write clients.plist" errorOut:error];
-    }
-    return YES;
-  }];
+  return [self applyPreferencesProfile:[FBSimulatorPreferencesProfile.profile withLocationAuthorizationForBundleID:application.bundleID]];
 }
 
-
 - (instancetype)setupKeyboard
 {
-  FBSimulator *simulator = self.simulator;
-
-  return [self interact:^ BOOL (NSError **error, id _) {
-    NSString *simulatorRoot = simulator.device.dataPath;
-    NSString *preferencesPath = [simulatorRoot stringByAppendingPathComponent:@"Library/Preferences/com.apple.Preferences.plist"];
-    NSError *innerError = nil;
-    NSMutableDictionary *preferences = [NSMutableDictionary dictionaryWithContentsOfFile:preferencesPath] ?: [NSMutableDictionary dictionary];
-    preferences[@"KeyboardCapsLock"] = @NO;
-    preferences[@"KeyboardAutocapitalization"] = @NO;
-    preferences[@"KeyboardAutocorrection"] = @NO;
-    if (![preferences writeToFile:preferencesPath atomically:YES]) {
-      return [FBSimulatorError failBoolWithError:innerError description:@"Failed to write com.apple.Preferences.plist" errorOut:error];
-    }
-    return YES;
-  }];
+  return [self applyPreferencesProfile:FBSimulatorPreferencesProfile.profile.withKeyboardDefaults];
 }
 
 @end
@@ -9,6 +9,8 @@
 
 #import <FBSimulatorControl/FBSimulatorInteraction.h>
 
+@class FBMediaManifest;
+
 @interface FBSimulatorInteraction (Upload)
 
 /**
@@ -25,4 +27,23 @@
  */
 - (instancetype)uploadVideos:(NSArray *)videoPaths;
 
+/**
+ Seeds the Camera Roll of the Simulator with the Media in the Manifest.
+ Photos are uploaded concurrently and Videos are uploaded in a single batch.
+ The Content Hashes of the files of seeded Media are recorded in the Simulator's data directory,
+ so Media with the same contents as previously seeded Media is skipped. Seeding an already-seeded Simulator is a no-op.
+ The record is not checked against the Camera Roll, so Media removed from within the Simulator will not be re-seeded.
+
+ @param manifest the Manifest of Media to seed.
+ */
+- (instancetype)seedMedia:(FBMediaManifest *)manifest;
+
+/**
+ Seeds the Camera Roll of the Simulator with all of the Media in a directory.
+
+ @see seedMedia:
+ @param directory the directory containing Photos and Videos to seed.
+ */
+- (instancetype)seedMediaFromDirectory:(NSString *)directory;
+
 @end
@@ -11,7 +11,9 @@
 
 #import <CoreSimulator/SimDevice.h>
 
+#import "FBConcurrentCollectionOperations.h"
 #import "FBInteraction+Private.h"
+#import "FBMediaManifest.h"
 #import "FBProcessLaunchConfiguration+Helpers.h"
 #import "FBSimDeviceWrapper.h"
 #import "FBSimulator+Helpers.h"
@@ -24,6 +26,9 @@
 #import "FBSimulatorSession.h"
 #import "NSRunLoop+SimulatorControlAdditions.h"
 
+static NSUInteger const FBSimulatorMediaSeedMaxConcurrentUploads = 4;
+static NSString *const FBSimulatorMediaSeedRecordPath = @"Media/FBSimulatorControl_SeededMedia.plist";
+
 @implementation FBSimulatorInteraction (Upload)
 
 - (instancetype)uploadPhotos:(NSArray *)photoPaths
@@ -71,4 +76,78 @@
   }];
 }
 
+- (instancetype)seedMedia:(FBMediaManifest *)manifest
+{
+  NSParameterAssert(manifest);
+
+  FBSimulator *simulator = self.simulator;
+
+  return [self interact:^ BOOL (NSError **error, id _) {
+    if (simulator.state != FBSimulatorStateBooted) {
+      return [[FBSimulatorError describeFormat:@"Simulator must be booted to seed media, is %@", simulator.device.stateString] failBool:error];
+    }
+
+    NSString *recordPath = [simulator.dataDirectory stringByAppendingPathComponent:FBSimulatorMediaSeedRecordPath];
+    FBMediaManifest *pending = [manifest manifestByRemovingContentHashes:[FBMediaManifest recordedContentHashesAtPath:recordPath]];
+    if (!pending.items.count) {
+      return YES;
+    }
+
+    // Upload the Photos concurrently, recording the successful uploads even if some fail.
+    NSArray *photoErrors = [FBConcurrentCollectionOperations
+      map:pending.photos
+      maxConcurrency:FBSimulatorMediaSeedMaxConcurrentUploads
+      withBlock:^ id (FBMediaItem *item) {
+        NSError *innerError = nil;
+        if (![simulator.device addPhoto:[NSURL fileURLWithPath:item.path] error:&innerError]) {
+          return [[[FBSimulatorError describeFormat:@"Failed to upload photo at path %@", item.path] causedBy:innerError] build];
+        }
+        return nil;
+      }];
+
+    NSMutableArray *uploaded = [NSMutableArray array];
+    NSError *firstError = nil;
+    for (NSUInteger index = 0; index < pending.photos.count; index++) {
+      id result = photoErrors[index];
+      if ([result isKindOfClass:NSError.class]) {
+        firstError = firstError ?: result;
+        continue;
+      }
+      [uploaded addObject:pending.photos[index]];
+    }
+
+    // Videos go through a single batch, so that the upload mechanism is only invoked once.
+    NSArray *videos = pending.videos;
+    if (videos.count) {
+      NSError *innerError = nil;
+      if ([simulator.simDeviceWrapper addVideos:[videos valueForKey:@"path"] error:&innerError]) {
+        [uploaded addObjectsFromArray:videos];
+      } else {
+        firstError = firstError ?: [[[FBSimulatorError describeFormat:@"Failed to upload videos at paths %@", [videos valueForKey:@"path"]] causedBy:innerError] build];
+      }
+    }
+
+    NSError *innerError = nil;
+    if (![FBMediaManifest recordItems:uploaded atPath:recordPath error:&innerError]) {
+      return [[[FBSimulatorError describe:@"Failed to record seeded media"] causedBy:innerError] failBool:error];
+    }
+    if (firstError) {
+      return [[[FBSimulatorError describeFormat:@"Failed to seed %lu of %lu media items", pending.items.count - uploaded.count, pending.items.count] causedBy:firstError] failBool:error];
+    }
+    return YES;
+  }];
+}
+
+- (instancetype)seedMediaFromDirectory:(NSString *)directory
+{
+  NSParameterAssert(directory);
+
+  NSError *error = nil;
+  FBMediaManifest *manifest = [FBMediaManifest manifestWithDirectory:directory error:&error];
+  if (!manifest) {
+    return [self failWith:error];
+  }
+  return [self seedMedia:manifest];
+}
+
 @end
@@ -7,8 +7,12 @@
  * of patent rights can be found in the PATENTS file in the same directory.
  */
 
+#import <FBSimulatorControl/FBScreenshotEncoder.h>
 #import <FBSimulatorControl/FBSimulatorInteraction.h>
 
+@class FBRollingVideoRecorder;
+@class FBSegmentedVideoRecorder;
+@protocol FBScreenshotSource;
 @protocol FBSimulatorWindowTilingStrategy;
 
 @interface FBSimulatorInteraction (Video)
@@ -28,4 +32,37 @@
  */
 - (instancetype)recordVideo;
 
+/**
+ Starts the Rolling Recorder, which keeps the most recent Video of the Simulator until the Session is terminated.
+ The Recorder can commit the retained Video to a file at any point, such as when a failure occurs.
+ */
+- (instancetype)recordRollingVideo:(FBRollingVideoRecorder *)recorder;
+
+/**
+ Starts the Segmented Recorder, until the Session is terminated.
+ The path of the Recorder's Index is available as the 'video_index' diagnostic of the Simulator.
+ */
+- (instancetype)recordSegmentedVideo:(FBSegmentedVideoRecorder *)recorder;
+
+/**
+ Grabs a single image of the Simulator's window, without setting up Video capture.
+ The image is encoded off the calling queue and attached as the 'screenshot' diagnostic of the Simulator, as an FBWritableLog.
+ The interaction fails if the image cannot be grabbed or encoded.
+
+ @param format the format to encode the image to.
+ @returns the reciever, for chaining.
+ */
+- (instancetype)screenshot:(FBScreenshotFormat)format;
+
+/**
+ Grabs a single image from the Screenshot Source.
+ The image is encoded off the calling queue and attached as the 'screenshot' diagnostic of the Simulator, as an FBWritableLog.
+ The interaction fails if the image cannot be grabbed or encoded.
+
+ @param source the Source to grab the image from.
+ @param encoder the Encoder to encode the image with.
+ @returns the reciever, for chaining.
+ */
+- (instancetype)screenshotFromSource:(id<FBScreenshotSource>)source encoder:(FBScreenshotEncoder *)encoder;
+
 @end
@@ -10,6 +10,9 @@
 #import "FBSimulatorInteraction+Video.h"
 
 #import "FBInteraction+Private.h"
+#import "FBRollingVideoRecorder.h"
+#import "FBScreenshotSource.h"
+#import "FBSegmentedVideoRecorder.h"
 #import "FBSimulator+Helpers.h"
 #import "FBSimulatorError.h"
 #import "FBSimulatorEventSink.h"
@@ -61,4 +64,74 @@
   }];
 }
 
+- (instancetype)recordRollingVideo:(FBRollingVideoRecorder *)recorder
+{
+  NSParameterAssert(recorder);
+
+  FBSimulator *simulator = self.simulator;
+
+  return [self interact:^ BOOL (NSError **error, id _) {
+    NSError *innerError = nil;
+    if (![recorder startWithError:&innerError]) {
+      return [[[[FBSimulatorError describe:@"Failed to start rolling video recording"] causedBy:innerError] inSimulator:simulator] failBool:error];
+    }
+
+    [simulator.eventSink terminationHandleAvailable:recorder];
+
+    return YES;
+  }];
+}
+
+- (instancetype)recordSegmentedVideo:(FBSegmentedVideoRecorder *)recorder
+{
+  NSParameterAssert(recorder);
+
+  FBSimulator *simulator = self.simulator;
+
+  return [self interact:^ BOOL (NSError **error, id _) {
+    NSError *innerError = nil;
+    if (![recorder startWithError:&innerError]) {
+      return [[[[FBSimulatorError describe:@"Failed to start segmented video recording"] causedBy:innerError] inSimulator:simulator] failBool:error];
+    }
+
+    [simulator.eventSink diagnosticInformationAvailable:@"video_index" process:nil value:recorder.indexPath];
+    [simulator.eventSink terminationHandleAvailable:recorder];
+
+    return YES;
+  }];
+}
+
+- (instancetype)screenshot:(FBScreenshotFormat)format
+{
+  FBScreenshotEncoder *encoder = format == FBScreenshotFormatJPEG ? FBScreenshotEncoder.jpegEncoder : FBScreenshotEncoder.pngEncoder;
+  return [self screenshotFromSource:[FBWindowScreenshotSource forSimulator:self.simulator] encoder:encoder];
+}
+
+- (instancetype)screenshotFromSource:(id<FBScreenshotSource>)source encoder:(FBScreenshotEncoder *)encoder
+{
+  NSParameterAssert(source);
+  NSParameterAssert(encoder);
+
+  FBSimulator *simulator = self.simulator;
+
+  return [self interact:^ BOOL (NSError **error, id _) {
+    NSError *innerError = nil;
+    CGImageRef image = [source createImageWithError:&innerError];
+    if (!image) {
+      return [[[[FBSimulatorError describe:@"Failed to grab a screenshot"] causedBy:innerError] inSimulator:simulator] failBool:error];
+    }
+
+    // The interaction has to wait for the encoded screenshot anyway, so the encode happens on this queue.
+    FBWritableLog *log = [encoder encodeImage:image name:@"screenshot" error:&innerError];
+    CGImageRelease(image);
+
+    if (!log) {
+      return [[[[FBSimulatorError describe:@"Failed to encode a screenshot"] causedBy:innerError] inSimulator:simulator] failBool:error];
+    }
+    [simulator.eventSink diagnosticInformationAvailable:@"screenshot" process:nil value:log];
+
+    return YES;
+  }];
+}
+
 @end
@@ -30,6 +30,7 @@
 #import "FBSimulatorSession+Private.h"
 #import "FBSimulatorTerminationStrategy.h"
 #import "FBTaskExecutor.h"
+#import "FBTracer.h"
 
 @implementation FBSimulatorInteraction
 
@@ -44,7 +45,7 @@
 {
   FBSimulator *simulator = self.simulator;
 
-  return [self interact:^ BOOL (NSError **error, id _) {
+  return [self trace:"bootSimulator" interact:^ BOOL (NSError **error, id _) {
     if (!simulator.simulatorApplication) {
       return [[FBSimulatorError describe:@"Could not boot Simulator as no Simulator Application was provided"] failBool:error];
     }
@@ -103,7 +104,7 @@
 {
   FBSimulator *simulator = self.simulator;
 
-  return [self interact:^ BOOL (NSError **error, id _) {
+  return [self trace:"shutdownSimulator" interact:^ BOOL (NSError **error, id _) {
     FBSimulatorLaunchInfo *launchInfo = simulator.launchInfo;
     if (!launchInfo) {
       return [[[FBSimulatorError describe:@"Could not shutdown simulator as there is no available launch info"] inSimulator:simulator] failBool:error];
@@ -141,6 +142,21 @@
 
 #pragma mark Private
 
+- (instancetype)trace:(const char *)name interact:(BOOL (^)(NSError **error, id interaction))block
+{
+  NSParameterAssert(name);
+  NSParameterAssert(block);
+
+  NSString *udid = self.simulator.udid;
+
+  return [self interact:^ BOOL (NSError **error, id interaction) {
+    FBTraceSpan span = FBTraceBegin("interaction", name);
+    BOOL success = block(error, interaction);
+    FBTraceEndWithUDID(span, udid);
+    return success;
+  }];
+}
+
 - (instancetype)binary:(FBSimulatorBinary *)binary interact:(BOOL (^)(FBProcessInfo *process, NSError **error))block
 {
   NSParameterAssert(binary);
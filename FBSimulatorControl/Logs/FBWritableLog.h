@@ -12,8 +12,9 @@
 /**
  Defines the content & metadata of a log.
  Lazily converts between data formats.
+ Can be serialized, so that it can be attached to a Simulator's History as a Diagnostic.
  */
-@interface FBWritableLog : NSObject<NSCopying>
+@interface FBWritableLog : NSObject<NSCopying, NSCoding>
 
 /**
  The name of the Log for uniquely identifying the log.
@@ -27,6 +27,38 @@
   return log;
 }
 
+#pragma mark NSCoding
+
+- (instancetype)initWithCoder:(NSCoder *)coder
+{
+  self = [super init];
+  if (!self) {
+    return nil;
+  }
+
+  _shortName = [coder decodeObjectForKey:NSStringFromSelector(@selector(shortName))];
+  _fileType = [coder decodeObjectForKey:NSStringFromSelector(@selector(fileType))];
+  _destination = [coder decodeObjectForKey:NSStringFromSelector(@selector(destination))];
+  _humanReadableName = [coder decodeObjectForKey:NSStringFromSelector(@selector(humanReadableName))];
+  _logData = [coder decodeObjectForKey:NSStringFromSelector(@selector(logData))];
+  _logString = [coder decodeObjectForKey:NSStringFromSelector(@selector(logString))];
+  _logPath = [coder decodeObjectForKey:NSStringFromSelector(@selector(logPath))];
+
+  return self;
+}
+
+- (void)encodeWithCoder:(NSCoder *)coder
+{
+  // The concrete subclass is encoded by the archiver, so the representation of the content is preserved.
+  [coder encodeObject:self.shortName forKey:NSStringFromSelector(@selector(shortName))];
+  [coder encodeObject:self.fileType forKey:NSStringFromSelector(@selector(fileType))];
+  [coder encodeObject:self.destination forKey:NSStringFromSelector(@selector(destination))];
+  [coder encodeObject:self.humanReadableName forKey:NSStringFromSelector(@selector(humanReadableName))];
+  [coder encodeObject:self.logData forKey:NSStringFromSelector(@selector(logData))];
+  [coder encodeObject:self.logString forKey:NSStringFromSelector(@selector(logString))];
+  [coder encodeObject:self.logPath forKey:NSStringFromSelector(@selector(logPath))];
+}
+
 - (NSData *)data
 {
   NSAssert(NO, @"-[%@ %@] is abstract and should be subclassed", NSStringFromClass(self.class), NSStringFromSelector(_cmd));
@@ -16,6 +16,7 @@
 #import "FBSimulatorError.h"
 #import "FBSimulatorInteraction.h"
 #import "FBSimulatorPool.h"
+#import "FBTracer.h"
 #import "NSRunLoop+SimulatorControlAdditions.h"
 
 @implementation FBSimulator (Helpers)
@@ -69,9 +70,12 @@
 
 - (BOOL)waitOnState:(FBSimulatorState)state timeout:(NSTimeInterval)timeout
 {
-  return [NSRunLoop.currentRunLoop spinRunLoopWithTimeout:timeout untilTrue:^ BOOL {
+  FBTraceSpan span = FBTraceBegin("wait", "waitOnState");
+  BOOL success = [NSRunLoop.currentRunLoop spinRunLoopWithTimeout:timeout untilTrue:^ BOOL {
     return self.state == state;
   }];
+  FBTraceEndWithUDID(span, self.udid);
+  return success;
 }
 
 - (BOOL)waitOnState:(FBSimulatorState)state withError:(NSError **)error
@@ -0,0 +1,177 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import <FBSimulatorControl/FBSimulatorPool.h>
+
+@class FBSimulator;
+@class FBSimulatorConfiguration;
+
+/**
+ The default maximum number of Simulators that are provisioned at once.
+ */
+extern NSUInteger const FBSimulatorMatrixDefaultMaxConcurrency;
+
+/**
+ A single combination of Device and OS in a Matrix.
+ */
+@interface FBSimulatorMatrixCell : NSObject <NSCopying>
+
+/**
+ Creates and returns a new Cell.
+
+ @param deviceName the name of the Device, as understood by `-[FBSimulatorConfiguration withDeviceNamed:]`.
+ @param osName the name of the OS, as understood by `-[FBSimulatorConfiguration withOSNamed:]`.
+ @return a new Cell.
+ */
++ (instancetype)cellWithDeviceName:(NSString *)deviceName osName:(NSString *)osName;
+
+/**
+ The name of the Device.
+ */
+@property (nonatomic, copy, readonly) NSString *deviceName;
+
+/**
+ The name of the OS.
+ */
+@property (nonatomic, copy, readonly) NSString *osName;
+
+@end
+
+/**
+ A Matrix of every Device on one axis with every OS on the other, less any exclusions.
+ */
+@interface FBSimulatorMatrix : NSObject <NSCopying>
+
+/**
+ Creates and returns a new Matrix.
+
+ @param deviceNames an NSArray<NSString *> of Device names.
+ @param osNames an NSArray<NSString *> of OS names.
+ @return a new Matrix.
+ */
++ (instancetype)matrixWithDeviceNames:(NSArray *)deviceNames osNames:(NSArray *)osNames;
+
+/**
+ Returns a copy of the reciever, excluding matching cells.
+
+ @param deviceName the name of the Device to exclude. nil matches any Device.
+ @param osName the name of the OS to exclude. nil matches any OS.
+ @return a new Matrix.
+ */
+- (instancetype)excludingDeviceName:(NSString *)deviceName osName:(NSString *)osName;
+
+/**
+ Returns a copy of the reciever, where cells are derived from the provided Configuration.
+ Use this to apply Locale, Scale and so on to every cell.
+
+ @param configuration the Configuration to derive cells from.
+ @return a new Matrix.
+ */
+- (instancetype)withBaseConfiguration:(FBSimulatorConfiguration *)configuration;
+
+/**
+ An NSArray<NSString *> of the Device names.
+ */
+@property (nonatomic, copy, readonly) NSArray *deviceNames;
+
+/**
+ An NSArray<NSString *> of the OS names.
+ */
+@property (nonatomic, copy, readonly) NSArray *osNames;
+
+/**
+ The Configuration that cells are derived from.
+ */
+@property (nonatomic, copy, readonly) FBSimulatorConfiguration *baseConfiguration;
+
+/**
+ An NSArray<FBSimulatorMatrixCell *> of the cells that are not excluded, ordered by Device then OS.
+ */
+@property (nonatomic, copy, readonly) NSArray *cells;
+
+/**
+ Returns the Configuration for a Cell, validating that the Device and OS are known and compatible with each other.
+ This does not check that the Device and OS are available in CoreSimulator.
+
+ @param cell the cell to get the Configuration for.
+ @param error an error out for any error that occurred.
+ @return a Configuration if the cell is valid, nil otherwise.
+ */
+- (FBSimulatorConfiguration *)configurationForCell:(FBSimulatorMatrixCell *)cell error:(NSError **)error;
+
+@end
+
+/**
+ The Result of provisioning a Matrix, keyed by cell.
+ */
+@interface FBSimulatorMatrixResult : NSObject
+
+/**
+ An NSArray<FBSimulatorMatrixCell *> of all the cells that were provisioned, in the order of the Matrix.
+ */
+@property (nonatomic, copy, readonly) NSArray *cells;
+
+/**
+ An NSDictionary<FBSimulatorMatrixCell *, FBSimulator *> of the successfully provisioned Simulators.
+ */
+@property (nonatomic, copy, readonly) NSDictionary *simulators;
+
+/**
+ An NSDictionary<FBSimulatorMatrixCell *, NSError *> of the cells that failed.
+ */
+@property (nonatomic, copy, readonly) NSDictionary *errors;
+
+/**
+ YES if every cell was provisioned, NO otherwise.
+ */
+@property (nonatomic, assign, readonly) BOOL isComplete;
+
+/**
+ Returns the Simulator for the Device and OS, nil if there is none.
+ */
+- (FBSimulator *)simulatorForDeviceName:(NSString *)deviceName osName:(NSString *)osName;
+
+/**
+ Returns the Error for the Device and OS, nil if there is none.
+ */
+- (NSError *)errorForDeviceName:(NSString *)deviceName osName:(NSString *)osName;
+
+@end
+
+/**
+ Provisioning of many Simulators at once.
+ */
+@interface FBSimulatorPool (Matrix)
+
+/**
+ Allocates, boots and prepares a Simulator for each cell of the Matrix.
+ Every cell is validated first, so invalid cells fail without allocating anything.
+ Valid cells are then provisioned concurrently, up to `FBSimulatorMatrixDefaultMaxConcurrency` at a time.
+
+ @param matrix the Matrix to provision.
+ @param options the options for the allocation of each Simulator.
+ @return a Result containing a Simulator or an Error for every cell.
+ */
+- (FBSimulatorMatrixResult *)provisionMatrix:(FBSimulatorMatrix *)matrix options:(FBSimulatorAllocationOptions)options;
+
+/**
+ Allocates, boots and prepares a Simulator for each cell of the Matrix.
+ Every cell is validated first, so invalid cells fail without allocating anything.
+ A Simulator that fails to boot is freed, so that it can be reused.
+
+ @param matrix the Matrix to provision.
+ @param options the options for the allocation of each Simulator.
+ @param maxConcurrency the maximum number of Simulators to provision at once.
+ @return a Result containing a Simulator or an Error for every cell.
+ */
+- (FBSimulatorMatrixResult *)provisionMatrix:(FBSimulatorMatrix *)matrix options:(FBSimulatorAllocationOptions)options maxConcurrency:(NSUInteger)maxConcurrency;
+
+@end
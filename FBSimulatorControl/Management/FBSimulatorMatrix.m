@@ -0,0 +1,334 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "FBSimulatorMatrix.h"
+
+#import "FBConcurrentCollectionOperations.h"
+#import "FBInteraction.h"
+#import "FBSimulator+Helpers.h"
+#import "FBSimulator.h"
+#import "FBSimulatorConfiguration+CoreSimulator.h"
+#import "FBSimulatorConfiguration.h"
+#import "FBSimulatorError.h"
+#import "FBSimulatorInteraction.h"
+#import "FBSimulatorLogger.h"
+#import "FBSimulatorPool+Private.h"
+
+NSUInteger const FBSimulatorMatrixDefaultMaxConcurrency = 4;
+
+@implementation FBSimulatorMatrixCell
+
++ (instancetype)cellWithDeviceName:(NSString *)deviceName osName:(NSString *)osName
+{
+  return [[self alloc] initWithDeviceName:deviceName osName:osName];
+}
+
+- (instancetype)initWithDeviceName:(NSString *)deviceName osName:(NSString *)osName
+{
+  NSParameterAssert(deviceName);
+  NSParameterAssert(osName);
+
+  self = [super init];
+  if (!self) {
+    return nil;
+  }
+
+  _deviceName = [deviceName copy];
+  _osName = [osName copy];
+
+  return self;
+}
+
+#pragma mark NSCopying
+
+- (instancetype)copyWithZone:(NSZone *)zone
+{
+  return self;
+}
+
+#pragma mark NSObject
+
+- (BOOL)isEqual:(FBSimulatorMatrixCell *)object
+{
+  if (![object isKindOfClass:self.class]) {
+    return NO;
+  }
+  return [self.deviceName isEqualToString:object.deviceName] &&
+         [self.osName isEqualToString:object.osName];
+}
+
+- (NSUInteger)hash
+{
+  return self.deviceName.hash ^ (self.osName.hash << 1);
+}
+
+- (NSString *)description
+{
+  return [NSString stringWithFormat:@"%@ | %@", self.deviceName, self.osName];
+}
+
+@end
+
+@interface FBSimulatorMatrix ()
+
+@property (nonatomic, copy, readwrite) NSArray *deviceNames;
+@property (nonatomic, copy, readwrite) NSArray *osNames;
+@property (nonatomic, copy, readwrite) FBSimulatorConfiguration *baseConfiguration;
+@property (nonatomic, copy, readwrite) NSArray *exclusions;
+
+@end
+
+@implementation FBSimulatorMatrix
+
++ (instancetype)matrixWithDeviceNames:(NSArray *)deviceNames osNames:(NSArray *)osNames
+{
+  NSParameterAssert(deviceNames);
+  NSParameterAssert(osNames);
+
+  FBSimulatorMatrix *matrix = [self new];
+  // Duplicates are removed, so that every cell is unique.
+  matrix.deviceNames = [NSOrderedSet orderedSetWithArray:deviceNames].array;
+  matrix.osNames = [NSOrderedSet orderedSetWithArray:osNames].array;
+  matrix.baseConfiguration = FBSimulatorConfiguration.defaultConfiguration;
+  matrix.exclusions = @[];
+  return matrix;
+}
+
+- (instancetype)excludingDeviceName:(NSString *)deviceName osName:(NSString *)osName
+{
+  // An exclusion is stored as a pair, with NSNull standing in for 'any'.
+  FBSimulatorMatrix *matrix = [self matrixCopy];
+  matrix.exclusions = [self.exclusions arrayByAddingObject:@[deviceName ?: NSNull.null, osName ?: NSNull.null]];
+  return matrix;
+}
+
+- (instancetype)withBaseConfiguration:(FBSimulatorConfiguration *)configuration
+{
+  NSParameterAssert(configuration);
+
+  FBSimulatorMatrix *matrix = [self matrixCopy];
+  matrix.baseConfiguration = configuration;
+  return matrix;
+}
+
+- (NSArray *)cells
+{
+  NSMutableArray *cells = [NSMutableArray array];
+  for (NSString *deviceName in self.deviceNames) {
+    for (NSString *osName in self.osNames) {
+      if ([self isExcludedDeviceName:deviceName osName:osName]) {
+        continue;
+      }
+      [cells addObject:[FBSimulatorMatrixCell cellWithDeviceName:deviceName osName:osName]];
+    }
+  }
+  return [cells copy];
+}
+
+- (FBSimulatorConfiguration *)configurationForCell:(FBSimulatorMatrixCell *)cell error:(NSError **)error
+{
+  FBSimulatorConfiguration *configuration = [self.baseConfiguration withOSNamed:cell.osName];
+  if (!configuration) {
+    return [[FBSimulatorError describeFormat:@"'%@' is not a known OS", cell.osName] fail:error];
+  }
+  configuration = [configuration withDeviceNamed:cell.deviceName];
+  if (!configuration) {
+    return [[FBSimulatorError describeFormat:@"'%@' is not a known Device", cell.deviceName] fail:error];
+  }
+  // Applying a Device that the OS does not support will substitute the newest OS that the Device does support.
+  if (![configuration.osVersionString isEqualToString:cell.osName]) {
+    return [[FBSimulatorError describeFormat:@"'%@' does not support '%@'", cell.osName, cell.deviceName] fail:error];
+  }
+  return configuration;
+}
+
+#pragma mark NSCopying
+
+- (instancetype)copyWithZone:(NSZone *)zone
+{
+  return self;
+}
+
+#pragma mark NSObject
+
+- (BOOL)isEqual:(FBSimulatorMatrix *)object
+{
+  if (![object isKindOfClass:self.class]) {
+    return NO;
+  }
+  return [self.deviceNames isEqualToArray:object.deviceNames] &&
+         [self.osNames isEqualToArray:object.osNames] &&
+         [self.baseConfiguration isEqual:object.baseConfiguration] &&
+         [self.exclusions isEqualToArray:object.exclusions];
+}
+
+- (NSUInteger)hash
+{
+  return self.deviceNames.hash ^ self.osNames.hash ^ self.exclusions.hash;
+}
+
+- (NSString *)description
+{
+  return [NSString stringWithFormat:
+    @"Matrix | Devices %@ | OS %@ | Exclusions %lu | Cells %lu",
+    [self.deviceNames componentsJoinedByString:@", "],
+    [self.osNames componentsJoinedByString:@", "],
+    (unsigned long) self.exclusions.count,
+    (unsigned long) self.cells.count
+  ];
+}
+
+#pragma mark Private
+
+- (instancetype)matrixCopy
+{
+  FBSimulatorMatrix *matrix = [self.class new];
+  matrix.deviceNames = self.deviceNames;
+  matrix.osNames = self.osNames;
+  matrix.baseConfiguration = self.baseConfiguration;
+  matrix.exclusions = self.exclusions;
+  return matrix;
+}
+
+- (BOOL)isExcludedDeviceName:(NSString *)deviceName osName:(NSString *)osName
+{
+  for (NSArray *exclusion in self.exclusions) {
+    BOOL deviceMatches = [exclusion[0] isEqual:NSNull.null] || [exclusion[0] isEqualToString:deviceName];
+    BOOL osMatches = [exclusion[1] isEqual:NSNull.null] || [exclusion[1] isEqualToString:osName];
+    if (deviceMatches && osMatches) {
+      return YES;
+    }
+  }
+  return NO;
+}
+
+@end
+
+@interface FBSimulatorMatrixResult ()
+
+@property (nonatomic, copy, readwrite) NSArray *cells;
+@property (nonatomic, copy, readwrite) NSDictionary *simulators;
+@property (nonatomic, copy, readwrite) NSDictionary *errors;
+
+@end
+
+@implementation FBSimulatorMatrixResult
+
+- (BOOL)isComplete
+{
+  return self.errors.count == 0;
+}
+
+- (FBSimulator *)simulatorForDeviceName:(NSString *)deviceName osName:(NSString *)osName
+{
+  return self.simulators[[FBSimulatorMatrixCell cellWithDeviceName:deviceName osName:osName]];
+}
+
+- (NSError *)errorForDeviceName:(NSString *)deviceName osName:(NSString *)osName
+{
+  return self.errors[[FBSimulatorMatrixCell cellWithDeviceName:deviceName osName:osName]];
+}
+
+- (NSString *)description
+{
+  NSMutableArray *rows = [NSMutableArray array];
+  for (FBSimulatorMatrixCell *cell in self.cells) {
+    FBSimulator *simulator = self.simulators[cell];
+    [rows addObject:[NSString stringWithFormat:
+      @"%@ => %@",
+      cell,
+      simulator ? simulator.udid : [self.errors[cell] localizedDescription]
+    ]];
+  }
+  return [NSString stringWithFormat:
+    @"Matrix Result | Provisioned %lu of %lu\n%@",
+    (unsigned long) self.simulators.count,
+    (unsigned long) self.cells.count,
+    [rows componentsJoinedByString:@"\n"]
+  ];
+}
+
+@end
+
+@implementation FBSimulatorPool (Matrix)
+
+- (FBSimulatorMatrixResult *)provisionMatrix:(FBSimulatorMatrix *)matrix options:(FBSimulatorAllocationOptions)options
+{
+  return [self provisionMatrix:matrix options:options maxConcurrency:FBSimulatorMatrixDefaultMaxConcurrency];
+}
+
+- (FBSimulatorMatrixResult *)provisionMatrix:(FBSimulatorMatrix *)matrix options:(FBSimulatorAllocationOptions)options maxConcurrency:(NSUInteger)maxConcurrency
+{
+  NSParameterAssert(matrix);
+  NSParameterAssert(maxConcurrency > 0);
+
+  NSArray *cells = matrix.cells;
+  NSMutableDictionary *errors = [NSMutableDictionary dictionary];
+
+  // Validate every cell up-front, so that nothing is allocated for cells that can never succeed.
+  NSMutableArray *validCells = [NSMutableArray array];
+  NSMutableArray *configurations = [NSMutableArray array];
+  for (FBSimulatorMatrixCell *cell in cells) {
+    NSError *error = nil;
+    FBSimulatorConfiguration *configuration = [matrix configurationForCell:cell error:&error];
+    if (!configuration || ![configuration checkRuntimeRequirementsReturningError:&error]) {
+      errors[cell] = [[[FBSimulatorError describeFormat:@"Cell %@ is not valid", cell] causedBy:error] build];
+      continue;
+    }
+    [validCells addObject:cell];
+    [configurations addObject:configuration];
+  }
+  [self.logger logMessage:@"Provisioning %lu of %lu cells of %@", (unsigned long) validCells.count, (unsigned long) cells.count, matrix];
+
+  NSArray *indices = [FBConcurrentCollectionOperations generate:validCells.count withBlock:^ id (NSUInteger index) {
+    return @(index);
+  }];
+  NSArray *outcomes = [FBConcurrentCollectionOperations map:indices maxConcurrency:maxConcurrency withBlock:^ id (NSNumber *index) {
+    FBSimulatorMatrixCell *cell = validCells[index.unsignedIntegerValue];
+    FBSimulatorConfiguration *configuration = configurations[index.unsignedIntegerValue];
+    NSError *error = nil;
+    FBSimulator *simulator = [self provisionSimulatorWithConfiguration:configuration options:options error:&error];
+    return simulator ?: [[[FBSimulatorError describeFormat:@"Failed to provision cell %@", cell] causedBy:error] build];
+  }];
+
+  NSMutableDictionary *simulators = [NSMutableDictionary dictionary];
+  for (NSUInteger index = 0; index < validCells.count; index++) {
+    id outcome = outcomes[index];
+    if ([outcome isKindOfClass:NSError.class]) {
+      errors[validCells[index]] = outcome;
+    } else {
+      simulators[validCells[index]] = outcome;
+    }
+  }
+
+  FBSimulatorMatrixResult *result = [FBSimulatorMatrixResult new];
+  result.cells = cells;
+  result.simulators = simulators;
+  result.errors = errors;
+  [self.logger logMessage:@"%@", result];
+  return result;
+}
+
+#pragma mark Private
+
+- (FBSimulator *)provisionSimulatorWithConfiguration:(FBSimulatorConfiguration *)configuration options:(FBSimulatorAllocationOptions)options error:(NSError **)error
+{
+  NSError *innerError = nil;
+  FBSimulator *simulator = [self allocateSimulatorWithConfiguration:configuration options:options error:&innerError];
+  if (!simulator) {
+    return [FBSimulatorError failWithError:innerError errorOut:error];
+  }
+  if (![simulator.interact.bootSimulator performInteractionWithError:&innerError]) {
+    [self freeSimulator:simulator error:nil];
+    return [[[[FBSimulatorError describe:@"Failed to boot Simulator"] inSimulator:simulator] causedBy:innerError] fail:error];
+  }
+  return simulator;
+}
+
+@end
@@ -27,9 +27,11 @@
 #import "FBSimulatorInteraction.h"
 #import "FBSimulatorLogger.h"
 #import "FBSimulatorPredicates.h"
+#import "FBSimulatorPreferencesProfile.h"
 #import "FBSimulatorTerminationStrategy.h"
 #import "FBTaskExecutor+Convenience.h"
 #import "FBTaskExecutor.h"
+#import "FBTracer.h"
 #import "NSRunLoop+SimulatorControlAdditions.h"
 
 static NSTimeInterval const FBSimulatorPoolDefaultWait = 30.0;
@@ -135,24 +137,26 @@ static NSTimeInterval const FBSimulatorPoolDefaultWait = 30.0;
 
 - (NSArray *)allSimulators
 {
-  // Inflate new simulators that have come along since last time.
-  NSArray *simDevices = self.deviceSet.availableDevices;
-  for (SimDevice *device in simDevices) {
-    NSString *udid = device.UDID.UUIDString;
-    if (self.inflatedSimulators[udid]) {
-      continue;
+  @synchronized(self) {
+    // Inflate new simulators that have come along since last time.
+    NSArray *simDevices = self.deviceSet.availableDevices;
+    for (SimDevice *device in simDevices) {
+      NSString *udid = device.UDID.UUIDString;
+      if (self.inflatedSimulators[udid]) {
+        continue;
+      }
+      FBSimulator *simulator = [FBSimulator fromSimDevice:device configuration:nil pool:self query:self.processQuery logger:self.logger];
+      self.inflatedSimulators[udid] = simulator;
     }
-    FBSimulator *simulator = [FBSimulator fromSimDevice:device configuration:nil pool:self query:self.processQuery logger:self.logger];
-    self.inflatedSimulators[udid] = simulator;
-  }
 
-  // Cull Simulators that should have gone away.
-  NSArray *currentSimulatorUDIDs = [simDevices valueForKeyPath:@"UDID.UUIDString"];
-  NSMutableSet *cullSet = [NSMutableSet setWithArray:self.inflatedSimulators.allKeys];
-  [cullSet minusSet:[NSSet setWithArray:currentSimulatorUDIDs]];
-  [self.inflatedSimulators removeObjectsForKeys:cullSet.allObjects];
+    // Cull Simulators that should have gone away.
+    NSArray *currentSimulatorUDIDs = [simDevices valueForKeyPath:@"UDID.UUIDString"];
+    NSMutableSet *cullSet = [NSMutableSet setWithArray:self.inflatedSimulators.allKeys];
+    [cullSet minusSet:[NSSet setWithArray:currentSimulatorUDIDs]];
+    [self.inflatedSimulators removeObjectsForKeys:cullSet.allObjects];
 
-  return [self.inflatedSimulators objectsForKeys:currentSimulatorUDIDs notFoundMarker:NSNull.null];
+    return [self.inflatedSimulators objectsForKeys:currentSimulatorUDIDs notFoundMarker:NSNull.null];
+  }
 }
 
 - (FBSimulatorTerminationStrategy *)terminationStrategy
@@ -165,34 +169,49 @@ static NSTimeInterval const FBSimulatorPoolDefaultWait = 30.0;
 
 - (FBSimulator *)allocateSimulatorWithConfiguration:(FBSimulatorConfiguration *)configuration options:(FBSimulatorAllocationOptions)options error:(NSError **)error;
 {
+  FBTraceSpan span = FBTraceBegin("pool", "allocateSimulator");
   NSError *innerError = nil;
+
+  // An obtained Simulator is already marked as allocated, so that concurrent allocations cannot obtain the same Simulator.
+  FBTraceSpan obtainSpan = FBTraceBegin("pool", "obtainSimulator");
   FBSimulator *simulator = [self obtainSimulatorWithConfiguration:configuration options:options error:&innerError];
+  FBTraceEndWithUDID(obtainSpan, simulator.udid);
   if (!simulator) {
+    FBTraceEnd(span);
     return [FBSimulatorError failWithError:innerError errorOut:error];
   }
 
-  if (![self prepareSimulatorForUsage:simulator configuration:configuration options:options error:&innerError]) {
+  FBTraceSpan prepareSpan = FBTraceBegin("pool", "prepareSimulator");
+  BOOL prepared = [self prepareSimulatorForUsage:simulator configuration:configuration options:options error:&innerError];
+  FBTraceEndWithUDID(prepareSpan, simulator.udid);
+  if (!prepared) {
+    [self popAllocation:simulator];
+    FBTraceEndWithUDID(span, simulator.udid);
     return [FBSimulatorError failWithError:innerError errorOut:error];
   }
 
-  [self pushAllocation:simulator options:options];
+  FBTraceEndWithUDID(span, simulator.udid);
   return simulator;
 }
 
 - (BOOL)freeSimulator:(FBSimulator *)simulator error:(NSError **)error
 {
+  FBTraceSpan span = FBTraceBegin("pool", "freeSimulator");
   FBSimulatorAllocationOptions options = [self popAllocation:simulator];
 
   // Killing is a pre-requesite for deleting/erasing
   NSError *innerError = nil;
   if (![self.terminationStrategy killSimulators:@[simulator] withError:&innerError]) {
+    FBTraceEndWithUDID(span, simulator.udid);
     return [FBSimulatorError failBoolWithError:innerError description:@"Failed to Free Device in Killing Device" errorOut:error];
   }
 
   // When Deleting on Free, there's no point in erasing first, so return early.
   BOOL deleteOnFree = (options & FBSimulatorAllocationOptionsDeleteOnFree) == FBSimulatorAllocationOptionsDeleteOnFree;
   if (deleteOnFree) {
-    if (![self deleteSimulator:simulator withError:&innerError]) {
+    BOOL deleted = [self deleteSimulator:simulator withError:&innerError];
+    FBTraceEndWithUDID(span, simulator.udid);
+    if (!deleted) {
       return [FBSimulatorError failBoolWithError:innerError description:@"Failed to Free Device in Deleting Device" errorOut:error];
     }
     return YES;
@@ -200,12 +219,15 @@ static NSTimeInterval const FBSimulatorPoolDefaultWait = 30.0;
 
   BOOL eraseOnFree = (self.configuration.options & FBSimulatorAllocationOptionsEraseOnFree) == FBSimulatorAllocationOptionsEraseOnFree;
   if (eraseOnFree) {
-    if (![simulator eraseWithError:&innerError]) {
+    BOOL erased = [simulator eraseWithError:&innerError];
+    FBTraceEndWithUDID(span, simulator.udid);
+    if (!erased) {
       return [FBSimulatorError failBoolWithError:innerError description:@"Failed to Free Device in Erasing Device" errorOut:error];
     }
     return YES;
   }
 
+  FBTraceEndWithUDID(span, simulator.udid);
   return YES;
 }
 
@@ -296,9 +318,12 @@ static NSTimeInterval const FBSimulatorPoolDefaultWait = 30.0;
 
   BOOL reuse = (options & FBSimulatorAllocationOptionsReuse) == FBSimulatorAllocationOptionsReuse;
   if (reuse) {
-    FBSimulator *simulator = [self findUnallocatedSimulatorWithConfiguration:configuration];
-    if (simulator) {
-      return simulator;
+    @synchronized(self) {
+      FBSimulator *simulator = [self findUnallocatedSimulatorWithConfiguration:configuration];
+      if (simulator) {
+        [self pushAllocation:simulator options:options];
+        return simulator;
+      }
     }
   }
 
@@ -306,7 +331,7 @@ static NSTimeInterval const FBSimulatorPoolDefaultWait = 30.0;
   if (!create) {
     return [[FBSimulatorError describeFormat:@"Could not obtain a simulator as the options don't allow creation"] fail:error];
   }
-  return [self createSimulatorWithConfiguration:configuration error:error];
+  return [self createSimulatorWithConfiguration:configuration options:options error:error];
 }
 
 - (FBSimulator *)findUnallocatedSimulatorWithConfiguration:(FBSimulatorConfiguration *)configuration
@@ -318,7 +343,7 @@ static NSTimeInterval const FBSimulatorPoolDefaultWait = 30.0;
   return [[self.allSimulators filteredArrayUsingPredicate:predicate] firstObject];
 }
 
-- (FBSimulator *)createSimulatorWithConfiguration:(FBSimulatorConfiguration *)configuration error:(NSError **)error
+- (FBSimulator *)createSimulatorWithConfiguration:(FBSimulatorConfiguration *)configuration options:(FBSimulatorAllocationOptions)options error:(NSError **)error
 {
   NSString *targetName = configuration.deviceName;
 
@@ -333,22 +358,35 @@ static NSTimeInterval const FBSimulatorPoolDefaultWait = 30.0;
     return [[[FBSimulatorError describeFormat:@"Could not obtain a SimRuntime for Configuration %@", configuration] causedBy:innerError] fail:error];
   }
 
-  // First, create the device.
+  // First, create the device. This is outside of the lock, so that Simulators can be created concurrently.
   SimDevice *device = [self.deviceSet createDeviceWithType:deviceType runtime:runtime name:targetName error:&innerError];
   if (!device) {
     return [[[FBSimulatorError describeFormat:@"Failed to create a simulator with the name %@, runtime %@, type %@", targetName, runtime, deviceType] causedBy:innerError] fail:error];
   }
 
   // The SimDevice should now be in the DeviceSet and thus in the collection of Simulators.
-  FBSimulator *simulator = [FBSimulatorPool keySimulatorsByUDID:self.allSimulators][device.UDID.UUIDString];
+  // A concurrent allocation that reuses Simulators may have already taken it, in which case another is created.
+  FBSimulator *simulator = nil;
+  @synchronized(self) {
+    simulator = [FBSimulatorPool keySimulatorsByUDID:self.allSimulators][device.UDID.UUIDString];
+    if (!simulator) {
+      return [[FBSimulatorError describeFormat:@"Expected simulator with UDID %@ to be inflated", device.UDID.UUIDString] fail:error];
+    }
+    if ([self.allocatedUDIDs containsObject:simulator.udid]) {
+      simulator = nil;
+    } else {
+      simulator.configuration = configuration;
+      [self pushAllocation:simulator options:options];
+    }
+  }
   if (!simulator) {
-    return [[FBSimulatorError describeFormat:@"Expected simulator with UDID %@ to be inflated", device.UDID.UUIDString] fail:error];
+    return [self createSimulatorWithConfiguration:configuration options:options error:error];
   }
-  simulator.configuration = configuration;
 
   // This step ensures that the Simulator is in a known-shutdown state after creation.
   // This prevents racing with any 'booting' interaction that occurs immediately after allocation.
   if (![self.terminationStrategy safeShutdownSimulator:simulator withError:&innerError]) {
+    [self popAllocation:simulator];
     return [[[[FBSimulatorError describeFormat:@"Could not get newly-created simulator into a shutdown state"] inSimulator:simulator] causedBy:innerError] fail:error];
   }
 
@@ -374,11 +412,12 @@ static NSTimeInterval const FBSimulatorPoolDefaultWait = 30.0;
 
   // Do the other configuration that is dependent on a shutdown Simulator.
   if (shutdown || erase) {
-    if (configuration.locale && ![[simulator.interact setLocale:configuration.locale] performInteractionWithError:&innerError]) {
-      return [[[[FBSimulatorError describe:@"Failed to set the locale on a Simulator when allocating it"] causedBy:innerError] inSimulator:simulator] failBool:error];
+    FBSimulatorPreferencesProfile *profile = FBSimulatorPreferencesProfile.profile.withKeyboardDefaults;
+    if (configuration.locale) {
+      profile = [profile withLocale:configuration.locale];
     }
-    if (![[simulator.interact setupKeyboard] performInteractionWithError:&innerError]) {
-      return [[[[FBSimulatorError describe:@"Failed to setup the keyboard of a Simulator when allocating it"] causedBy:innerError] inSimulator:simulator] failBool:error];
+    if (![[simulator.interact applyPreferencesProfile:profile] performInteractionWithError:&innerError]) {
+      return [[[[FBSimulatorError describe:@"Failed to setup the preferences of a Simulator when allocating it"] causedBy:innerError] inSimulator:simulator] failBool:error];
     }
   }
 
@@ -387,24 +426,28 @@ static NSTimeInterval const FBSimulatorPoolDefaultWait = 30.0;
 
 - (void)pushAllocation:(FBSimulator *)simulator options:(FBSimulatorAllocationOptions)options
 {
-  NSParameterAssert(simulator);
-  NSParameterAssert(![self.allocatedUDIDs containsObject:simulator.udid]);
-  NSParameterAssert(!self.allocationOptions[simulator.udid]);
+  @synchronized(self) {
+    NSParameterAssert(simulator);
+    NSParameterAssert(![self.allocatedUDIDs containsObject:simulator.udid]);
+    NSParameterAssert(!self.allocationOptions[simulator.udid]);
 
-  [self.allocatedUDIDs addObject:simulator.udid];
-  self.allocationOptions[simulator.udid] = @(options);
+    [self.allocatedUDIDs addObject:simulator.udid];
+    self.allocationOptions[simulator.udid] = @(options);
+  }
 }
 
 - (FBSimulatorAllocationOptions)popAllocation:(FBSimulator *)simulator
 {
-  NSParameterAssert(simulator);
-  NSParameterAssert([self.allocatedUDIDs containsObject:simulator.udid]);
-  NSParameterAssert(self.allocationOptions[simulator.udid]);
-
-  [self.allocatedUDIDs removeObject:simulator.udid];
-  FBSimulatorAllocationOptions options = [self.allocationOptions[simulator.udid] unsignedIntegerValue];
-  [self.allocationOptions removeObjectForKey:simulator.udid];
-  return options;
+  @synchronized(self) {
+    NSParameterAssert(simulator);
+    NSParameterAssert([self.allocatedUDIDs containsObject:simulator.udid]);
+    NSParameterAssert(self.allocationOptions[simulator.udid]);
+
+    [self.allocatedUDIDs removeObject:simulator.udid];
+    FBSimulatorAllocationOptions options = [self.allocationOptions[simulator.udid] unsignedIntegerValue];
+    [self.allocationOptions removeObjectForKey:simulator.udid];
+    return options;
+  }
 }
 
 #pragma mark - Helpers
@@ -424,12 +467,16 @@ static NSTimeInterval const FBSimulatorPoolDefaultWait = 30.0;
 
 - (NSArray *)allocatedSimulators
 {
-  return [self.allSimulators filteredArrayUsingPredicate:[FBSimulatorPredicates allocatedByPool:self]];
+  @synchronized(self) {
+    return [self.allSimulators filteredArrayUsingPredicate:[FBSimulatorPredicates allocatedByPool:self]];
+  }
 }
 
 - (NSArray *)unallocatedSimulators
 {
-  return [self.allSimulators filteredArrayUsingPredicate:[FBSimulatorPredicates unallocatedByPool:self]];
+  @synchronized(self) {
+    return [self.allSimulators filteredArrayUsingPredicate:[FBSimulatorPredicates unallocatedByPool:self]];
+  }
 }
 
 - (NSArray *)launchedSimulators
@@ -31,6 +31,7 @@
 #import "FBSimulatorPredicates.h"
 #import "FBTaskExecutor+Convenience.h"
 #import "FBTaskExecutor.h"
+#import "FBTracer.h"
 #import "NSRunLoop+SimulatorControlAdditions.h"
 
 @interface FBSimulatorTerminationStrategy ()
@@ -143,10 +144,16 @@
       continue;
     }
     NSError *innerError = nil;
-    if (![self killSimulatorProcess:simulatorProcess error:&innerError]) {
+    FBTraceSpan span = FBTraceBegin("termination", "killSimulatorProcess");
+    BOOL killed = [self killSimulatorProcess:simulatorProcess error:&innerError];
+    FBTraceEndWithUDID(span, simulator.udid);
+    if (!killed) {
       return [[[[FBSimulatorError describeFormat:@"Could not kill simulator process %@", simulatorProcess] inSimulator:simulator] causedBy:innerError] fail:error];
     }
-    if (![self safeShutdownSimulator:simulator withError:&innerError]) {
+    span = FBTraceBegin("termination", "safeShutdownSimulator");
+    BOOL shutdown = [self safeShutdownSimulator:simulator withError:&innerError];
+    FBTraceEndWithUDID(span, simulator.udid);
+    if (!shutdown) {
       return [[[[FBSimulatorError describe:@"Could not shut down simulator after termination"] inSimulator:simulator] causedBy:innerError] fail:error];
     }
   }
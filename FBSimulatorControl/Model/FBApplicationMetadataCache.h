@@ -0,0 +1,102 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+@class FBSimulatorApplication;
+@class FBSimulatorBinary;
+
+/**
+ The Version of the on-disk format. Caches written with a different version are discarded.
+ */
+extern NSUInteger const FBApplicationMetadataCacheVersion;
+
+/**
+ A persistent cache of Application and Binary metadata, shared between processes.
+
+ Entries are validated against the identity (device, inode, size and modification time) of the files they were derived from,
+ so an entry is only returned if the Info.plist and executable are unchanged.
+ The cache file is guarded by an advisory lock, so it is safe to read and write from many processes at once.
+ The number of entries is bounded, with the least recently used entries evicted first.
+ */
+@interface FBApplicationMetadataCache : NSObject
+
+/**
+ The Cache in the current user's Caches directory.
+ */
++ (instancetype)sharedCache;
+
+/**
+ A Cache backed by the file at the provided path.
+
+ @param path the path of the cache file. The directory will be created if it does not exist.
+ @param capacity the maximum number of entries to persist.
+ @return a new Cache.
+ */
++ (instancetype)cacheWithPath:(NSString *)path capacity:(NSUInteger)capacity;
+
+/**
+ The path of the cache file.
+ */
+@property (nonatomic, copy, readonly) NSString *path;
+
+/**
+ The maximum number of entries to persist.
+ */
+@property (nonatomic, assign, readonly) NSUInteger capacity;
+
+/**
+ Returns the cached Application for the path, if the files it was derived from are unchanged.
+
+ @param path the path of the Application.
+ @return the Application if there is a valid entry, nil otherwise.
+ */
+- (FBSimulatorApplication *)applicationForPath:(NSString *)path;
+
+/**
+ Persists the Application.
+
+ @param application the Application to cache.
+ @param infoPlistPath the path of the Info.plist that the Application was derived from.
+ @param error an error out for any error that occurred.
+ @return YES if successful, NO otherwise.
+ */
+- (BOOL)cacheApplication:(FBSimulatorApplication *)application infoPlistPath:(NSString *)infoPlistPath error:(NSError **)error;
+
+/**
+ Returns the cached Binary for the path, if the file is unchanged.
+
+ @param path the path of the Binary.
+ @return the Binary if there is a valid entry, nil otherwise.
+ */
+- (FBSimulatorBinary *)binaryForPath:(NSString *)path;
+
+/**
+ Persists the Binary.
+
+ @param binary the Binary to cache.
+ @param error an error out for any error that occurred.
+ @return YES if successful, NO otherwise.
+ */
+- (BOOL)cacheBinary:(FBSimulatorBinary *)binary error:(NSError **)error;
+
+/**
+ The number of persisted entries, including those that may no longer be valid.
+ */
+- (NSUInteger)count;
+
+/**
+ Removes all entries.
+
+ @param error an error out for any error that occurred.
+ @return YES if successful, NO otherwise.
+ */
+- (BOOL)removeAllEntriesWithError:(NSError **)error;
+
+@end
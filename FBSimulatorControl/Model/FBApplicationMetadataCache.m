@@ -0,0 +1,327 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "FBApplicationMetadataCache.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#import "FBSimulatorApplication.h"
+#import "FBSimulatorError.h"
+
+NSUInteger const FBApplicationMetadataCacheVersion = 1;
+
+static NSString *const KeyVersion = @"version";
+static NSString *const KeyEntries = @"entries";
+static NSString *const KeyKind = @"kind";
+static NSString *const KeyName = @"name";
+static NSString *const KeyBundleID = @"bundle_id";
+static NSString *const KeyBinaryName = @"binary_name";
+static NSString *const KeyBinaryPath = @"binary_path";
+static NSString *const KeyArchitectures = @"architectures";
+static NSString *const KeyFileIdentities = @"file_identities";
+static NSString *const KeyLastAccess = @"last_access";
+
+static NSString *const KindApplication = @"application";
+static NSString *const KindBinary = @"binary";
+
+static NSString *FileIdentity(NSString *path)
+{
+  struct stat fileStat;
+  if (stat(path.fileSystemRepresentation, &fileStat) != 0) {
+    return nil;
+  }
+  return [NSString stringWithFormat:
+    @"%llu:%llu:%lld:%ld.%09ld",
+    (unsigned long long) fileStat.st_dev,
+    (unsigned long long) fileStat.st_ino,
+    (long long) fileStat.st_size,
+    (long) fileStat.st_mtimespec.tv_sec,
+    (long) fileStat.st_mtimespec.tv_nsec
+  ];
+}
+
+static NSDictionary *FileIdentitiesForPaths(NSArray *paths)
+{
+  NSMutableDictionary *identities = [NSMutableDictionary dictionary];
+  for (NSString *path in paths) {
+    NSString *identity = FileIdentity(path);
+    if (!identity) {
+      return nil;
+    }
+    identities[path] = identity;
+  }
+  return [identities copy];
+}
+
+@interface FBApplicationMetadataCache ()
+
+@property (nonatomic, copy, readonly) NSString *lockPath;
+@property (nonatomic, copy, readwrite) NSString *loadedFileIdentity;
+@property (nonatomic, copy, readwrite) NSDictionary *entries;
+@property (nonatomic, strong, readonly) NSMutableDictionary *accessDates;
+
+@end
+
+@implementation FBApplicationMetadataCache
+
+#pragma mark Initializers
+
++ (instancetype)sharedCache
+{
+  static dispatch_once_t onceToken;
+  static FBApplicationMetadataCache *cache;
+  dispatch_once(&onceToken, ^{
+    NSString *path = [[NSHomeDirectory()
+      stringByAppendingPathComponent:@"Library/Caches/com.facebook.FBSimulatorControl"]
+      stringByAppendingPathComponent:@"application_metadata.plist"];
+    cache = [self cacheWithPath:path capacity:256];
+  });
+  return cache;
+}
+
++ (instancetype)cacheWithPath:(NSString *)path capacity:(NSUInteger)capacity
+{
+  return [[self alloc] initWithPath:path capacity:capacity];
+}
+
+- (instancetype)initWithPath:(NSString *)path capacity:(NSUInteger)capacity
+{
+  NSParameterAssert(path);
+  NSParameterAssert(capacity > 0);
+
+  self = [super init];
+  if (!self) {
+    return nil;
+  }
+
+  _path = [path copy];
+  _lockPath = [path stringByAppendingPathExtension:@"lock"];
+  _capacity = capacity;
+  _entries = @{};
+  _accessDates = [NSMutableDictionary dictionary];
+
+  return self;
+}
+
+#pragma mark Public
+
+- (FBSimulatorApplication *)applicationForPath:(NSString *)path
+{
+  NSDictionary *entry = [self validEntryForPath:path kind:KindApplication];
+  if (!entry) {
+    return nil;
+  }
+  FBSimulatorBinary *binary = [FBSimulatorBinary
+    withName:entry[KeyBinaryName]
+    path:entry[KeyBinaryPath]
+    architectures:[NSSet setWithArray:entry[KeyArchitectures]]];
+  return [FBSimulatorApplication withName:entry[KeyName] path:path bundleID:entry[KeyBundleID] binary:binary];
+}
+
+- (BOOL)cacheApplication:(FBSimulatorApplication *)application infoPlistPath:(NSString *)infoPlistPath error:(NSError **)error
+{
+  NSDictionary *identities = FileIdentitiesForPaths(@[infoPlistPath, application.binary.path]);
+  if (!identities) {
+    return [[FBSimulatorError describeFormat:@"Could not obtain the identity of the files of %@", application] failBool:error];
+  }
+  NSDictionary *entry = @{
+    KeyKind : KindApplication,
+    KeyName : application.name,
+    KeyBundleID : application.bundleID,
+    KeyBinaryName : application.binary.name,
+    KeyBinaryPath : application.binary.path,
+    KeyArchitectures : application.binary.architectures.allObjects,
+    KeyFileIdentities : identities,
+  };
+  return [self writeEntry:entry forPath:application.path error:error];
+}
+
+- (FBSimulatorBinary *)binaryForPath:(NSString *)path
+{
+  NSDictionary *entry = [self validEntryForPath:path kind:KindBinary];
+  if (!entry) {
+    return nil;
+  }
+  return [FBSimulatorBinary withName:entry[KeyName] path:path architectures:[NSSet setWithArray:entry[KeyArchitectures]]];
+}
+
+- (BOOL)cacheBinary:(FBSimulatorBinary *)binary error:(NSError **)error
+{
+  NSDictionary *identities = FileIdentitiesForPaths(@[binary.path]);
+  if (!identities) {
+    return [[FBSimulatorError describeFormat:@"Could not obtain the identity of the file of %@", binary] failBool:error];
+  }
+  NSDictionary *entry = @{
+    KeyKind : KindBinary,
+    KeyName : binary.name,
+    KeyArchitectures : binary.architectures.allObjects,
+    KeyFileIdentities : identities,
+  };
+  return [self writeEntry:entry forPath:binary.path error:error];
+}
+
+- (NSUInteger)count
+{
+  @synchronized(self) {
+    [self withLock:LOCK_SH error:nil perform:^ BOOL (NSError **_) {
+      [self reloadIfChanged];
+      return YES;
+    }];
+    return self.entries.count;
+  }
+}
+
+- (BOOL)removeAllEntriesWithError:(NSError **)error
+{
+  @synchronized(self) {
+    return [self withLock:LOCK_EX error:error perform:^ BOOL (NSError **innerError) {
+      [self.accessDates removeAllObjects];
+      return [self persistEntries:@{} error:innerError];
+    }];
+  }
+}
+
+#pragma mark Private
+
+- (NSDictionary *)validEntryForPath:(NSString *)path kind:(NSString *)kind
+{
+  if (!path) {
+    return nil;
+  }
+  @synchronized(self) {
+    __block NSDictionary *entry = nil;
+    [self withLock:LOCK_SH error:nil perform:^ BOOL (NSError **_) {
+      [self reloadIfChanged];
+      entry = self.entries[path];
+      return YES;
+    }];
+    if (![entry isKindOfClass:NSDictionary.class] || ![entry[KeyKind] isEqual:kind] || ![entry[KeyArchitectures] isKindOfClass:NSArray.class]) {
+      return nil;
+    }
+    NSDictionary *identities = entry[KeyFileIdentities];
+    if (![identities isKindOfClass:NSDictionary.class] || identities.count == 0) {
+      return nil;
+    }
+    if (![FileIdentitiesForPaths(identities.allKeys) isEqualToDictionary:identities]) {
+      return nil;
+    }
+    // Access times are recorded in memory, then persisted along with the next write.
+    self.accessDates[path] = NSDate.date;
+    return entry;
+  }
+}
+
+- (BOOL)writeEntry:(NSDictionary *)entry forPath:(NSString *)path error:(NSError **)error
+{
+  @synchronized(self) {
+    self.accessDates[path] = NSDate.date;
+    return [self withLock:LOCK_EX error:error perform:^ BOOL (NSError **innerError) {
+      // Other processes may have written since the last read, so the latest entries on disk are updated.
+      [self reloadIfChanged];
+      NSMutableDictionary *entries = [self.entries mutableCopy];
+      entries[path] = entry;
+      return [self persistEntries:entries error:innerError];
+    }];
+  }
+}
+
+- (BOOL)persistEntries:(NSDictionary *)entries error:(NSError **)error
+{
+  NSMutableDictionary *updated = [NSMutableDictionary dictionary];
+  for (NSString *path in entries) {
+    NSMutableDictionary *entry = [entries[path] mutableCopy];
+    NSDate *accessDate = self.accessDates[path];
+    if (accessDate && accessDate.timeIntervalSince1970 > [entry[KeyLastAccess] doubleValue]) {
+      entry[KeyLastAccess] = @(accessDate.timeIntervalSince1970);
+    }
+    updated[path] = entry;
+  }
+
+  if (updated.count > self.capacity) {
+    NSArray *leastRecentlyUsed = [updated keysSortedByValueUsingComparator:^ NSComparisonResult (NSDictionary *left, NSDictionary *right) {
+      return [left[KeyLastAccess] ?: @0 compare:right[KeyLastAccess] ?: @0];
+    }];
+    NSArray *evicted = [leastRecentlyUsed subarrayWithRange:NSMakeRange(0, updated.count - self.capacity)];
+    [updated removeObjectsForKeys:evicted];
+    [self.accessDates removeObjectsForKeys:evicted];
+  }
+
+  NSDictionary *contents = @{
+    KeyVersion : @(FBApplicationMetadataCacheVersion),
+    KeyEntries : updated,
+  };
+  NSError *innerError = nil;
+  NSData *data = [NSPropertyListSerialization dataWithPropertyList:contents format:NSPropertyListBinaryFormat_v1_0 options:0 error:&innerError];
+  if (!data) {
+    return [[[FBSimulatorError describe:@"Could not serialize Application Metadata"] causedBy:innerError] failBool:error];
+  }
+  if (![data writeToFile:self.path options:NSDataWritingAtomic error:&innerError]) {
+    return [[[FBSimulatorError describeFormat:@"Could not write Application Metadata to %@", self.path] causedBy:innerError] failBool:error];
+  }
+
+  self.entries = updated;
+  self.loadedFileIdentity = FileIdentity(self.path);
+  return YES;
+}
+
+- (void)reloadIfChanged
+{
+  NSString *fileIdentity = FileIdentity(self.path);
+  if ([fileIdentity isEqualToString:self.loadedFileIdentity]) {
+    return;
+  }
+  self.loadedFileIdentity = fileIdentity;
+  self.entries = @{};
+
+  // A missing, corrupt or differently versioned cache file is treated as empty, to be replaced on the next write.
+  NSData *data = [NSData dataWithContentsOfFile:self.path];
+  if (!data) {
+    return;
+  }
+  NSDictionary *contents = [NSPropertyListSerialization propertyListWithData:data options:NSPropertyListImmutable format:nil error:nil];
+  if (![contents isKindOfClass:NSDictionary.class]) {
+    return;
+  }
+  if ([contents[KeyVersion] unsignedIntegerValue] != FBApplicationMetadataCacheVersion) {
+    return;
+  }
+  NSDictionary *entries = contents[KeyEntries];
+  if (![entries isKindOfClass:NSDictionary.class]) {
+    return;
+  }
+  self.entries = entries;
+}
+
+- (BOOL)withLock:(int)operation error:(NSError **)error perform:(BOOL (^)(NSError **))block
+{
+  NSString *directory = self.path.stringByDeletingLastPathComponent;
+  NSError *innerError = nil;
+  if (![NSFileManager.defaultManager createDirectoryAtPath:directory withIntermediateDirectories:YES attributes:nil error:&innerError]) {
+    return [[[FBSimulatorError describeFormat:@"Could not create directory for Application Metadata at %@", directory] causedBy:innerError] failBool:error];
+  }
+  int fileDescriptor = open(self.lockPath.fileSystemRepresentation, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+  if (fileDescriptor < 0) {
+    return [[FBSimulatorError describeFormat:@"Could not open lock file %@: %s", self.lockPath, strerror(errno)] failBool:error];
+  }
+  if (flock(fileDescriptor, operation) != 0) {
+    close(fileDescriptor);
+    return [[FBSimulatorError describeFormat:@"Could not lock %@: %s", self.lockPath, strerror(errno)] failBool:error];
+  }
+  BOOL success = block(error);
+  flock(fileDescriptor, LOCK_UN);
+  close(fileDescriptor);
+  return success;
+}
+
+@end
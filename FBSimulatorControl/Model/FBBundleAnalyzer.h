@@ -0,0 +1,94 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+@class FBMachOBinary;
+
+/**
+ A single Mach-O within a Bundle, along with any reasons it is incompatible with the target.
+ */
+@interface FBBundleComponent : NSObject <NSCopying>
+
+/**
+ The path of the Mach-O, relative to the root of the analyzed Bundle.
+ */
+@property (nonatomic, copy, readonly) NSString *relativePath;
+
+/**
+ The parsed Mach-O, nil if it could not be parsed.
+ */
+@property (nonatomic, copy, readonly) FBMachOBinary *binary;
+
+/**
+ An NSArray<NSString *> of descriptions of why the Mach-O is incompatible. Empty if it is compatible.
+ */
+@property (nonatomic, copy, readonly) NSArray *problems;
+
+/**
+ YES if there are no problems.
+ */
+@property (nonatomic, assign, readonly) BOOL isCompatible;
+
+@end
+
+/**
+ The result of analyzing all of the Mach-Os within a Bundle.
+ */
+@interface FBBundleAnalysis : NSObject <NSCopying>
+
+/**
+ The path of the analyzed Bundle.
+ */
+@property (nonatomic, copy, readonly) NSString *bundlePath;
+
+/**
+ The Architecture and OS Version that the Bundle was analyzed against.
+ */
+@property (nonatomic, copy, readonly) NSString *architecture;
+@property (nonatomic, copy, readonly) NSString *osVersion;
+
+/**
+ An NSArray<FBBundleComponent *> of every Mach-O in the Bundle, ordered by relative path.
+ */
+@property (nonatomic, copy, readonly) NSArray *components;
+
+/**
+ An NSArray<FBBundleComponent *> of the components that are not compatible.
+ */
+@property (nonatomic, copy, readonly) NSArray *incompatibleComponents;
+
+/**
+ YES if every component is compatible.
+ */
+@property (nonatomic, assign, readonly) BOOL isCompatible;
+
+@end
+
+/**
+ Analyzes an Application Bundle, along with its embedded Frameworks, Extensions and nested Bundles.
+ */
+@interface FBBundleAnalyzer : NSObject
+
+/**
+ Finds and parses every Mach-O in the Bundle, in parallel, checking each against the target.
+
+ A Mach-O is compatible when it has a slice for the architecture that is built for the Simulator, does not require a newer OS and is not encrypted.
+ Mach-Os inside 'Watch' are checked against the i386 Watch Simulator, without an OS Version check.
+ The main executable is found from the Info.plist, then 'Frameworks', 'PlugIns' and 'Watch' are searched for nested Bundles and dylibs.
+
+ @param bundlePath the path of the Bundle to analyze.
+ @param architecture the architecture of the target Simulator, such as 'x86_64'.
+ @param osVersion the OS Version of the target Simulator, such as '9.2'.
+ @param error an error out for any error that occurred.
+ @return an Analysis if the Bundle could be read, nil otherwise. A Bundle with incompatible components is not an error.
+ */
++ (FBBundleAnalysis *)analyzeBundleAtPath:(NSString *)bundlePath architecture:(NSString *)architecture osVersion:(NSString *)osVersion error:(NSError **)error;
+
+@end
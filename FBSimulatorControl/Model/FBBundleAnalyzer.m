@@ -0,0 +1,268 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "FBBundleAnalyzer.h"
+
+#import "FBBinaryParser.h"
+#import "FBConcurrentCollectionOperations.h"
+#import "FBSimulatorError.h"
+
+@interface FBBundleComponent ()
+
+@property (nonatomic, copy, readwrite) NSString *relativePath;
+@property (nonatomic, copy, readwrite) FBMachOBinary *binary;
+@property (nonatomic, copy, readwrite) NSArray *problems;
+
+@end
+
+@implementation FBBundleComponent
+
+- (BOOL)isCompatible
+{
+  return self.problems.count == 0;
+}
+
+#pragma mark NSCopying
+
+- (instancetype)copyWithZone:(NSZone *)zone
+{
+  return self;
+}
+
+#pragma mark NSObject
+
+- (NSString *)description
+{
+  if (self.isCompatible) {
+    return [NSString stringWithFormat:@"%@ | Compatible", self.relativePath];
+  }
+  return [NSString stringWithFormat:@"%@ | %@", self.relativePath, [self.problems componentsJoinedByString:@", "]];
+}
+
+@end
+
+@interface FBBundleAnalysis ()
+
+@property (nonatomic, copy, readwrite) NSString *bundlePath;
+@property (nonatomic, copy, readwrite) NSString *architecture;
+@property (nonatomic, copy, readwrite) NSString *osVersion;
+@property (nonatomic, copy, readwrite) NSArray *components;
+
+@end
+
+@implementation FBBundleAnalysis
+
+- (NSArray *)incompatibleComponents
+{
+  return [self.components filteredArrayUsingPredicate:[NSPredicate predicateWithBlock:^ BOOL (FBBundleComponent *component, NSDictionary *_) {
+    return !component.isCompatible;
+  }]];
+}
+
+- (BOOL)isCompatible
+{
+  return self.incompatibleComponents.count == 0;
+}
+
+#pragma mark NSCopying
+
+- (instancetype)copyWithZone:(NSZone *)zone
+{
+  return self;
+}
+
+#pragma mark NSObject
+
+- (NSString *)description
+{
+  return [NSString stringWithFormat:
+    @"Bundle %@ | Target %@ %@ | %lu Components | Incompatible %@",
+    self.bundlePath.lastPathComponent,
+    self.architecture,
+    self.osVersion,
+    (unsigned long) self.components.count,
+    self.incompatibleComponents
+  ];
+}
+
+@end
+
+@implementation FBBundleAnalyzer
+
+#pragma mark Public
+
++ (FBBundleAnalysis *)analyzeBundleAtPath:(NSString *)bundlePath architecture:(NSString *)architecture osVersion:(NSString *)osVersion error:(NSError **)error
+{
+  NSParameterAssert(architecture);
+  NSParameterAssert(osVersion);
+
+  NSString *executablePath = [self executablePathForBundleAtPath:bundlePath];
+  if (!executablePath) {
+    return [[FBSimulatorError describeFormat:@"Could not find the executable of the bundle at %@", bundlePath] fail:error];
+  }
+  NSMutableArray *machOPaths = [NSMutableArray arrayWithObject:executablePath];
+  [self collectEmbeddedMachOPathsInBundleAtPath:bundlePath into:machOPaths];
+
+  NSUInteger maxConcurrency = MAX(NSProcessInfo.processInfo.activeProcessorCount, (NSUInteger) 1);
+  NSArray *components = [FBConcurrentCollectionOperations map:machOPaths maxConcurrency:maxConcurrency withBlock:^ FBBundleComponent * (NSString *path) {
+    return [self componentForMachOAtPath:path bundlePath:bundlePath architecture:architecture osVersion:osVersion];
+  }];
+
+  FBBundleAnalysis *analysis = [FBBundleAnalysis new];
+  analysis.bundlePath = bundlePath;
+  analysis.architecture = architecture;
+  analysis.osVersion = osVersion;
+  analysis.components = [components sortedArrayUsingComparator:^ NSComparisonResult (FBBundleComponent *left, FBBundleComponent *right) {
+    return [left.relativePath compare:right.relativePath];
+  }];
+  return analysis;
+}
+
+#pragma mark Private
+
++ (NSSet *)nestedBundleExtensions
+{
+  static dispatch_once_t onceToken;
+  static NSSet *extensions;
+  dispatch_once(&onceToken, ^{
+    extensions = [NSSet setWithArray:@[@"app", @"appex", @"bundle", @"framework", @"xctest"]];
+  });
+  return extensions;
+}
+
++ (NSSet *)simulatorPlatformsForArchitecture:(NSString *)architecture
+{
+  // Before LC_BUILD_VERSION, Simulator slices had the same version load command as device slices.
+  // An Intel slice can only be a Simulator slice, but an ARM slice with an 'ios' platform is built for devices.
+  if ([architecture isEqualToString:@"i386"] || [architecture isEqualToString:@"x86_64"]) {
+    return [NSSet setWithArray:@[@"ios-simulator", @"ios"]];
+  }
+  return [NSSet setWithObject:@"ios-simulator"];
+}
+
++ (NSSet *)watchSimulatorPlatforms
+{
+  // Watch Applications run on a paired Watch Simulator, whose OS Version is not the target's.
+  return [NSSet setWithArray:@[@"watchos-simulator", @"watchos"]];
+}
+
++ (NSString *)watchSimulatorArchitecture
+{
+  // Watch Simulators are 32-bit, whatever the architecture of the iPhone Simulator that they are paired with.
+  return @"i386";
+}
+
++ (NSArray *)embeddedDirectoryNames
+{
+  return @[@"Frameworks", @"PlugIns", @"Watch", @"Contents/Frameworks", @"Contents/PlugIns"];
+}
+
++ (void)collectEmbeddedMachOPathsInBundleAtPath:(NSString *)bundlePath into:(NSMutableArray *)paths
+{
+  NSFileManager *fileManager = NSFileManager.defaultManager;
+  for (NSString *directoryName in self.embeddedDirectoryNames) {
+    NSString *directory = [bundlePath stringByAppendingPathComponent:directoryName];
+    NSArray *contents = [[fileManager contentsOfDirectoryAtPath:directory error:nil] sortedArrayUsingSelector:@selector(compare:)];
+    for (NSString *name in contents) {
+      NSString *path = [directory stringByAppendingPathComponent:name];
+      BOOL isDirectory = NO;
+      if (![fileManager fileExistsAtPath:path isDirectory:&isDirectory]) {
+        continue;
+      }
+      if (isDirectory && [self.nestedBundleExtensions containsObject:name.pathExtension]) {
+        // Bundles without an executable, such as resource bundles, have nothing to analyze but may still contain nested bundles.
+        NSString *executablePath = [self executablePathForBundleAtPath:path];
+        if (executablePath) {
+          [paths addObject:executablePath];
+        }
+        [self collectEmbeddedMachOPathsInBundleAtPath:path into:paths];
+      } else if (!isDirectory && [name.pathExtension isEqualToString:@"dylib"]) {
+        [paths addObject:path];
+      }
+    }
+  }
+}
+
++ (NSString *)executablePathForBundleAtPath:(NSString *)bundlePath
+{
+  NSFileManager *fileManager = NSFileManager.defaultManager;
+  NSString *executableName = nil;
+  for (NSString *infoPlistPath in @[[bundlePath stringByAppendingPathComponent:@"Info.plist"], [bundlePath stringByAppendingPathComponent:@"Contents/Info.plist"]]) {
+    NSDictionary *infoPlist = [NSDictionary dictionaryWithContentsOfFile:infoPlistPath];
+    if ([infoPlist[@"CFBundleExecutable"] isKindOfClass:NSString.class]) {
+      executableName = infoPlist[@"CFBundleExecutable"];
+      break;
+    }
+  }
+  // Frameworks do not always have an Info.plist at the root, in which case the executable has the name of the Framework.
+  if (!executableName && [bundlePath.pathExtension isEqualToString:@"framework"]) {
+    executableName = bundlePath.lastPathComponent.stringByDeletingPathExtension;
+  }
+  if (!executableName) {
+    return nil;
+  }
+  for (NSString *path in @[[bundlePath stringByAppendingPathComponent:executableName], [[bundlePath stringByAppendingPathComponent:@"Contents/MacOS"] stringByAppendingPathComponent:executableName]]) {
+    if ([fileManager fileExistsAtPath:path]) {
+      return path;
+    }
+  }
+  return nil;
+}
+
++ (FBBundleComponent *)componentForMachOAtPath:(NSString *)path bundlePath:(NSString *)bundlePath architecture:(NSString *)architecture osVersion:(NSString *)osVersion
+{
+  FBBundleComponent *component = [FBBundleComponent new];
+  component.relativePath = [path hasPrefix:bundlePath]
+    ? [[path substringFromIndex:bundlePath.length] stringByTrimmingCharactersInSet:[NSCharacterSet characterSetWithCharactersInString:@"/"]]
+    : path;
+
+  NSError *error = nil;
+  FBMachOBinary *binary = [FBBinaryParser binaryAtPath:path error:&error];
+  if (!binary) {
+    component.problems = @[[NSString stringWithFormat:@"Could not be parsed: %@", error.localizedDescription]];
+    return component;
+  }
+  component.binary = binary;
+
+  // Each platform is checked against the architecture of the Simulator that it runs on.
+  BOOL isWatchComponent = [component.relativePath.pathComponents containsObject:@"Watch"];
+  if (isWatchComponent) {
+    architecture = self.watchSimulatorArchitecture;
+  }
+
+  FBMachOSlice *slice = nil;
+  for (FBMachOSlice *candidate in binary.slices) {
+    if ([candidate.architecture isEqualToString:architecture]) {
+      slice = candidate;
+      break;
+    }
+  }
+  if (!slice) {
+    NSArray *available = [binary.architectures.allObjects sortedArrayUsingSelector:@selector(compare:)];
+    component.problems = @[[NSString stringWithFormat:@"Missing %@ slice, has %@", architecture, [available componentsJoinedByString:@", "]]];
+    return component;
+  }
+
+  // The OS Version is only comparable once the slice is known to be built for the target's platform.
+  NSMutableArray *problems = [NSMutableArray array];
+  NSSet *platforms = isWatchComponent ? self.watchSimulatorPlatforms : [self simulatorPlatformsForArchitecture:architecture];
+  if (slice.platform && ![platforms containsObject:slice.platform]) {
+    NSString *expected = [[platforms.allObjects sortedArrayUsingSelector:@selector(compare:)] componentsJoinedByString:@" or "];
+    [problems addObject:[NSString stringWithFormat:@"Built for %@, target is %@", slice.platform, expected]];
+  } else if (!isWatchComponent && slice.minimumOSVersion && [slice.minimumOSVersion compare:osVersion options:NSNumericSearch] == NSOrderedDescending) {
+    [problems addObject:[NSString stringWithFormat:@"Requires OS %@, target is %@", slice.minimumOSVersion, osVersion]];
+  }
+  if (slice.isEncrypted) {
+    [problems addObject:[NSString stringWithFormat:@"The %@ slice is encrypted", architecture]];
+  }
+  component.problems = problems;
+  return component;
+}
+
+@end
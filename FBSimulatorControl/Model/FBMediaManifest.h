@@ -0,0 +1,150 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+/**
+ The Kind of a Media Item, which determines how it is uploaded to the Simulator.
+ */
+typedef NS_ENUM(NSUInteger, FBMediaKind) {
+  FBMediaKindPhoto = 0,
+  FBMediaKindVideo = 1,
+};
+
+/**
+ Concrete value wrapper around a Media File that can be uploaded to the Camera Roll of a Simulator.
+ */
+@interface FBMediaItem : NSObject <NSCopying>
+
+/**
+ Creates a Media Item for the File at the given path, hashing the contents of the File.
+
+ @param path the path of the Media File. Must not be nil.
+ @param error an error out for any error that occurred.
+ @return a new FBMediaItem if the file could be read and is of a known Media type, nil otherwise.
+ */
++ (instancetype)itemWithPath:(NSString *)path error:(NSError **)error;
+
+/**
+ The path to the Media File.
+ */
+@property (nonatomic, copy, readonly) NSString *path;
+
+/**
+ A SHA-1 hex digest of the contents of the Media File.
+ */
+@property (nonatomic, copy, readonly) NSString *contentHash;
+
+/**
+ The Kind of the Media File.
+ */
+@property (nonatomic, assign, readonly) FBMediaKind kind;
+
+/**
+ The File Extensions that are recognised as Photos.
+ */
++ (NSSet *)photoExtensions;
+
+/**
+ The File Extensions that are recognised as Videos.
+ */
++ (NSSet *)videoExtensions;
+
+@end
+
+/**
+ An immutable collection of Media Items, keyed by their contents.
+ Items with identical contents are collapsed, so that the same media will not be uploaded twice.
+ */
+@interface FBMediaManifest : NSObject <NSCopying>
+
+/**
+ Creates a Manifest from an NSArray<NSString *> of Media File Paths. Files are hashed concurrently.
+
+ @param paths the paths of the Media Files.
+ @param error an error out for any error that occurred.
+ @return a new FBMediaManifest if all of the paths are readable Media Files, nil otherwise.
+ */
++ (instancetype)manifestWithPaths:(NSArray *)paths error:(NSError **)error;
+
+/**
+ Creates a Manifest from all of the Media Files in a directory, recursively.
+ Files that are not of a known Media type are ignored.
+
+ @param directory the directory to enumerate.
+ @param error an error out for any error that occurred.
+ @return a new FBMediaManifest if the directory could be enumerated, nil otherwise.
+ */
++ (instancetype)manifestWithDirectory:(NSString *)directory error:(NSError **)error;
+
+/**
+ Creates a Manifest from a JSON Manifest File, containing an Array of Media File Paths.
+ Relative paths are resolved against the directory containing the Manifest File.
+
+ @param manifestPath the path of the JSON Manifest File.
+ @param error an error out for any error that occurred.
+ @return a new FBMediaManifest if the Manifest File and all of the paths within it are readable, nil otherwise.
+ */
++ (instancetype)manifestWithManifestFile:(NSString *)manifestPath error:(NSError **)error;
+
+/**
+ An NSArray<FBMediaItem *> of all Items in the Manifest, in the order that they were provided.
+ */
+@property (nonatomic, copy, readonly) NSArray *items;
+
+/**
+ An NSArray<FBMediaItem *> of the Photos in the Manifest.
+ */
+@property (nonatomic, copy, readonly) NSArray *photos;
+
+/**
+ An NSArray<FBMediaItem *> of the Videos in the Manifest.
+ */
+@property (nonatomic, copy, readonly) NSArray *videos;
+
+/**
+ An NSSet<NSString *> of the Content Hashes of all Items in the Manifest.
+ */
+@property (nonatomic, copy, readonly) NSSet *contentHashes;
+
+/**
+ Returns a Manifest containing only those Items whose Content Hash is not in `contentHashes`.
+
+ @param contentHashes an NSSet<NSString *> of the Content Hashes to remove.
+ @return a new FBMediaManifest.
+ */
+- (instancetype)manifestByRemovingContentHashes:(NSSet *)contentHashes;
+
+@end
+
+/**
+ Persistence of the Content Hashes of Media that has been seeded, so that re-seeding can be skipped.
+ The record is of what was uploaded, it is not checked against the Media in the Simulator.
+ */
+@interface FBMediaManifest (Record)
+
+/**
+ Reads the Content Hashes that have been recorded at the given path.
+
+ @param path the path of the record.
+ @return an NSSet<NSString *> of the recorded Content Hashes. Empty if no record exists.
+ */
++ (NSSet *)recordedContentHashesAtPath:(NSString *)path;
+
+/**
+ Adds the Content Hashes of the provided Items to the record at the given path.
+
+ @param items an NSArray<FBMediaItem *> of the items to record.
+ @param path the path of the record.
+ @param error an error out for any error that occurred.
+ @return YES if the record was written, NO otherwise.
+ */
++ (BOOL)recordItems:(NSArray *)items atPath:(NSString *)path error:(NSError **)error;
+
+@end
@@ -0,0 +1,298 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "FBMediaManifest.h"
+
+#import <CommonCrypto/CommonDigest.h>
+
+#import "FBConcurrentCollectionOperations.h"
+#import "FBSimulatorError.h"
+
+static NSUInteger const FBMediaManifestHashChunkSize = 1024 * 1024;
+
+static NSString *ContentHashOfData(NSData *data)
+{
+  CC_SHA1_CTX context;
+  CC_SHA1_Init(&context);
+  const uint8_t *bytes = data.bytes;
+  for (NSUInteger offset = 0; offset < data.length; offset += FBMediaManifestHashChunkSize) {
+    NSUInteger length = MIN(FBMediaManifestHashChunkSize, data.length - offset);
+    CC_SHA1_Update(&context, bytes + offset, (CC_LONG) length);
+  }
+  unsigned char digest[CC_SHA1_DIGEST_LENGTH];
+  CC_SHA1_Final(digest, &context);
+
+  NSMutableString *string = [NSMutableString stringWithCapacity:CC_SHA1_DIGEST_LENGTH * 2];
+  for (NSUInteger index = 0; index < CC_SHA1_DIGEST_LENGTH; index++) {
+    [string appendFormat:@"%02x", digest[index]];
+  }
+  return [string copy];
+}
+
+@implementation FBMediaItem
+
+#pragma mark Initializers
+
++ (instancetype)itemWithPath:(NSString *)path error:(NSError **)error
+{
+  if (!path) {
+    return [[FBSimulatorError describe:@"Path is nil for Media Item"] fail:error];
+  }
+
+  NSString *extension = path.pathExtension.lowercaseString;
+  FBMediaKind kind = FBMediaKindPhoto;
+  if ([self.videoExtensions containsObject:extension]) {
+    kind = FBMediaKindVideo;
+  } else if (![self.photoExtensions containsObject:extension]) {
+    return [[FBSimulatorError describeFormat:@"File at path %@ is not a known Photo or Video type", path] fail:error];
+  }
+
+  NSError *innerError = nil;
+  NSData *data = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedIfSafe error:&innerError];
+  if (!data) {
+    return [[[FBSimulatorError describeFormat:@"Could not read Media File at path %@", path] causedBy:innerError] fail:error];
+  }
+
+  return [[self alloc] initWithPath:path contentHash:ContentHashOfData(data) kind:kind];
+}
+
+- (instancetype)initWithPath:(NSString *)path contentHash:(NSString *)contentHash kind:(FBMediaKind)kind
+{
+  NSParameterAssert(path);
+  NSParameterAssert(contentHash);
+
+  self = [super init];
+  if (!self) {
+    return nil;
+  }
+
+  _path = path;
+  _contentHash = contentHash;
+  _kind = kind;
+
+  return self;
+}
+
++ (NSSet *)photoExtensions
+{
+  static dispatch_once_t onceToken;
+  static NSSet *extensions;
+  dispatch_once(&onceToken, ^{
+    extensions = [NSSet setWithArray:@[@"png", @"jpg", @"jpeg", @"gif", @"heic", @"tiff"]];
+  });
+  return extensions;
+}
+
++ (NSSet *)videoExtensions
+{
+  static dispatch_once_t onceToken;
+  static NSSet *extensions;
+  dispatch_once(&onceToken, ^{
+    extensions = [NSSet setWithArray:@[@"mp4", @"mov", @"m4v"]];
+  });
+  return extensions;
+}
+
+#pragma mark NSCopying
+
+- (instancetype)copyWithZone:(NSZone *)zone
+{
+  return self;
+}
+
+#pragma mark NSObject
+
+- (BOOL)isEqual:(FBMediaItem *)object
+{
+  if (![object isMemberOfClass:self.class]) {
+    return NO;
+  }
+  return [object.path isEqual:self.path] &&
+         [object.contentHash isEqual:self.contentHash] &&
+         object.kind == self.kind;
+}
+
+- (NSUInteger)hash
+{
+  return self.path.hash | self.contentHash.hash | self.kind;
+}
+
+- (NSString *)description
+{
+  return [NSString stringWithFormat:
+    @"%@ | Path: %@ | Hash: %@",
+    self.kind == FBMediaKindVideo ? @"Video" : @"Photo",
+    self.path,
+    self.contentHash
+  ];
+}
+
+@end
+
+@implementation FBMediaManifest
+
+#pragma mark Initializers
+
++ (instancetype)manifestWithPaths:(NSArray *)paths error:(NSError **)error
+{
+  NSArray *results = [FBConcurrentCollectionOperations map:paths withBlock:^ id (NSString *path) {
+    NSError *innerError = nil;
+    return [FBMediaItem itemWithPath:path error:&innerError] ?: innerError;
+  }];
+
+  for (id result in results) {
+    if ([result isKindOfClass:NSError.class]) {
+      return [[[FBSimulatorError describe:@"Could not create a Media Manifest"] causedBy:result] fail:error];
+    }
+  }
+  return [[self alloc] initWithItems:results];
+}
+
++ (instancetype)manifestWithDirectory:(NSString *)directory error:(NSError **)error
+{
+  NSError *innerError = nil;
+  NSArray *subpaths = [NSFileManager.defaultManager subpathsOfDirectoryAtPath:directory error:&innerError];
+  if (!subpaths) {
+    return [[[FBSimulatorError describeFormat:@"Could not enumerate Media directory at path %@", directory] causedBy:innerError] fail:error];
+  }
+
+  NSMutableSet *extensions = [NSMutableSet setWithSet:FBMediaItem.photoExtensions];
+  [extensions unionSet:FBMediaItem.videoExtensions];
+  NSMutableArray *paths = [NSMutableArray array];
+  for (NSString *subpath in [subpaths sortedArrayUsingSelector:@selector(compare:)]) {
+    if (![extensions containsObject:subpath.pathExtension.lowercaseString]) {
+      continue;
+    }
+    [paths addObject:[directory stringByAppendingPathComponent:subpath]];
+  }
+  return [self manifestWithPaths:paths error:error];
+}
+
++ (instancetype)manifestWithManifestFile:(NSString *)manifestPath error:(NSError **)error
+{
+  NSError *innerError = nil;
+  NSData *data = [NSData dataWithContentsOfFile:manifestPath options:0 error:&innerError];
+  if (!data) {
+    return [[[FBSimulatorError describeFormat:@"Could not read Media Manifest at path %@", manifestPath] causedBy:innerError] fail:error];
+  }
+  NSArray *entries = [NSJSONSerialization JSONObjectWithData:data options:0 error:&innerError];
+  if (![entries isKindOfClass:NSArray.class]) {
+    return [[[FBSimulatorError describeFormat:@"Media Manifest at path %@ is not a JSON Array", manifestPath] causedBy:innerError] fail:error];
+  }
+
+  NSString *baseDirectory = manifestPath.stringByDeletingLastPathComponent;
+  NSMutableArray *paths = [NSMutableArray array];
+  for (NSString *entry in entries) {
+    if (![entry isKindOfClass:NSString.class]) {
+      return [[FBSimulatorError describeFormat:@"Media Manifest entry %@ is not a String", entry] fail:error];
+    }
+    [paths addObject:entry.isAbsolutePath ? entry : [baseDirectory stringByAppendingPathComponent:entry]];
+  }
+  return [self manifestWithPaths:paths error:error];
+}
+
+- (instancetype)initWithItems:(NSArray *)items
+{
+  self = [super init];
+  if (!self) {
+    return nil;
+  }
+
+  NSMutableSet *contentHashes = [NSMutableSet set];
+  NSMutableArray *uniqueItems = [NSMutableArray array];
+  for (FBMediaItem *item in items) {
+    if ([contentHashes containsObject:item.contentHash]) {
+      continue;
+    }
+    [contentHashes addObject:item.contentHash];
+    [uniqueItems addObject:item];
+  }
+
+  _items = [uniqueItems copy];
+  _contentHashes = [contentHashes copy];
+
+  return self;
+}
+
+#pragma mark Public
+
+- (NSArray *)photos
+{
+  return [self.items filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"kind == %lu", FBMediaKindPhoto]];
+}
+
+- (NSArray *)videos
+{
+  return [self.items filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"kind == %lu", FBMediaKindVideo]];
+}
+
+- (instancetype)manifestByRemovingContentHashes:(NSSet *)contentHashes
+{
+  NSPredicate *predicate = [NSPredicate predicateWithFormat:@"NOT (contentHash IN %@)", contentHashes];
+  return [[FBMediaManifest alloc] initWithItems:[self.items filteredArrayUsingPredicate:predicate]];
+}
+
+#pragma mark NSCopying
+
+- (instancetype)copyWithZone:(NSZone *)zone
+{
+  return self;
+}
+
+#pragma mark NSObject
+
+- (BOOL)isEqual:(FBMediaManifest *)object
+{
+  if (![object isMemberOfClass:self.class]) {
+    return NO;
+  }
+  return [object.items isEqualToArray:self.items];
+}
+
+- (NSUInteger)hash
+{
+  return self.items.hash;
+}
+
+- (NSString *)description
+{
+  return [NSString stringWithFormat:@"Media Manifest | %lu Photos | %lu Videos", self.photos.count, self.videos.count];
+}
+
+@end
+
+@implementation FBMediaManifest (Record)
+
++ (NSSet *)recordedContentHashesAtPath:(NSString *)path
+{
+  NSArray *hashes = [NSArray arrayWithContentsOfFile:path];
+  return hashes ? [NSSet setWithArray:hashes] : [NSSet set];
+}
+
++ (BOOL)recordItems:(NSArray *)items atPath:(NSString *)path error:(NSError **)error
+{
+  if (!items.count) {
+    return YES;
+  }
+
+  NSMutableSet *hashes = [[self recordedContentHashesAtPath:path] mutableCopy];
+  [hashes addObjectsFromArray:[items valueForKey:@"contentHash"]];
+  NSArray *sortedHashes = [hashes.allObjects sortedArrayUsingSelector:@selector(compare:)];
+
+  NSError *innerError = nil;
+  if (![NSFileManager.defaultManager createDirectoryAtPath:path.stringByDeletingLastPathComponent withIntermediateDirectories:YES attributes:nil error:&innerError]) {
+    return [[[FBSimulatorError describeFormat:@"Could not create directory for Media record at path %@", path] causedBy:innerError] failBool:error];
+  }
+  if (![sortedHashes writeToFile:path atomically:YES]) {
+    return [[FBSimulatorError describeFormat:@"Could not write Media record to path %@", path] failBool:error];
+  }
+  return YES;
+}
+
+@end
@@ -9,12 +9,19 @@
 
 #import "FBSimulatorApplication.h"
 
+#import "FBApplicationMetadataCache.h"
 #import "FBBinaryParser.h"
 #import "FBConcurrentCollectionOperations.h"
 #import "FBSimulatorControlStaticConfiguration.h"
 #import "FBSimulatorError.h"
 #import "FBTaskExecutor.h"
 
+@interface FBSimulatorBinary (Private)
+
++ (instancetype)createBinaryWithPath:(NSString *)binaryPath error:(NSError **)error;
+
+@end
+
 @implementation FBSimulatorBinary
 
 - (instancetype)initWithName:(NSString *)name path:(NSString *)path architectures:(NSSet *)architectures
@@ -199,13 +206,21 @@
   if (application) {
     return application;
   }
+  application = [FBApplicationMetadataCache.sharedCache applicationForPath:path];
+  if (application) {
+    applicationCache[path] = application;
+    return application;
+  }
 
   NSError *innerError = nil;
-  application = [FBSimulatorApplication createApplicationWithPath:path error:&innerError];
+  NSString *infoPlistPath = nil;
+  application = [FBSimulatorApplication createApplicationWithPath:path infoPlistPath:&infoPlistPath error:&innerError];
   if (!application) {
     return [FBSimulatorError failWithError:innerError errorOut:error];
   }
   applicationCache[path] = application;
+  // Failing to persist the metadata only means that it will be derived again next time.
+  [FBApplicationMetadataCache.sharedCache cacheApplication:application infoPlistPath:infoPlistPath error:nil];
   return application;
 }
 
@@ -240,7 +255,7 @@
     stringByAppendingPathExtension:@"app"];
 }
 
-+ (instancetype)createApplicationWithPath:(NSString *)path error:(NSError **)error;
++ (instancetype)createApplicationWithPath:(NSString *)path infoPlistPath:(NSString **)infoPlistPathOut error:(NSError **)error;
 {
   if (!path) {
     return [[FBSimulatorError describe:@"Path is nil for Application"] fail:error];
@@ -249,16 +264,24 @@
   if (!appName) {
     return [[FBSimulatorError describeFormat:@"Could not obtain app name for path %@", path] fail:error];
   }
-  NSString *bundleID = [self bundleIDForAppAtPath:path];
+  NSString *infoPlistPath = [self infoPlistPathForAppAtPath:path];
+  NSDictionary *infoPlist = infoPlistPath ? [NSDictionary dictionaryWithContentsOfFile:infoPlistPath] : nil;
+  if (!infoPlist) {
+    return [[FBSimulatorError describeFormat:@"Could not read Info.plist for app at path %@", path] fail:error];
+  }
+  NSString *bundleID = infoPlist[@"CFBundleIdentifier"];
   if (!bundleID) {
     return [[FBSimulatorError describeFormat:@"Could not obtain Bundle ID for app at path %@", path] fail:error];
   }
   NSError *innerError = nil;
-  FBSimulatorBinary *binary = [self binaryForApplicationPath:path error:&innerError];
+  FBSimulatorBinary *binary = [self binaryForApplicationPath:path binaryName:infoPlist[@"CFBundleExecutable"] error:&innerError];
   if (!binary) {
     return [[[FBSimulatorError describeFormat:@"Could not obtain binary for app at path %@", path] causedBy:innerError] fail:error];
   }
 
+  if (infoPlistPathOut) {
+    *infoPlistPathOut = infoPlistPath;
+  }
   return [[FBSimulatorApplication alloc] initWithName:appName path:path bundleID:bundleID binary:binary];
 }
 
@@ -272,15 +295,15 @@
   return cache;
 }
 
-+ (FBSimulatorBinary *)binaryForApplicationPath:(NSString *)applicationPath error:(NSError **)error
++ (FBSimulatorBinary *)binaryForApplicationPath:(NSString *)applicationPath binaryName:(NSString *)binaryName error:(NSError **)error
 {
-  NSString *binaryPath = [self binaryPathForAppAtPath:applicationPath];
+  NSString *binaryPath = [self binaryPathForAppAtPath:applicationPath binaryName:binaryName];
   if (!binaryPath) {
     return [[FBSimulatorError describeFormat:@"Could not obtain binary path for application at path %@", applicationPath] fail:error];
   }
 
   NSError *innerError = nil;
-  FBSimulatorBinary *binary = [FBSimulatorBinary binaryWithPath:binaryPath error:&innerError];
+  FBSimulatorBinary *binary = [FBSimulatorBinary createBinaryWithPath:binaryPath error:&innerError];
   if (!binary) {
     return [[[FBSimulatorError describeFormat:@"Could not obtain binary info for binary at path %@", binaryPath] causedBy:innerError] fail:error];
   }
@@ -292,15 +315,8 @@
   return [[appPath lastPathComponent] stringByDeletingPathExtension];
 }
 
-+ (NSString *)binaryNameForAppAtPath:(NSString *)appPath
-{
-  NSDictionary *infoPlist = [NSDictionary dictionaryWithContentsOfFile:[self infoPlistPathForAppAtPath:appPath]];
-  return infoPlist[@"CFBundleExecutable"];
-}
-
-+ (NSString *)binaryPathForAppAtPath:(NSString *)appPath
++ (NSString *)binaryPathForAppAtPath:(NSString *)appPath binaryName:(NSString *)binaryName
 {
-  NSString *binaryName = [self binaryNameForAppAtPath:appPath];
   if (!binaryName) {
     return nil;
   }
@@ -317,12 +333,6 @@
   return nil;
 }
 
-+ (NSString *)bundleIDForAppAtPath:(NSString *)appPath
-{
-  NSDictionary *infoPlist = [NSDictionary dictionaryWithContentsOfFile:[self infoPlistPathForAppAtPath:appPath]];
-  return infoPlist[@"CFBundleIdentifier"];
-}
-
 + (NSString *)infoPlistPathForAppAtPath:(NSString *)appPath
 {
   NSArray *paths = @[
@@ -343,6 +353,20 @@
 @implementation FBSimulatorBinary (Helpers)
 
 + (instancetype)binaryWithPath:(NSString *)binaryPath error:(NSError **)error;
+{
+  FBSimulatorBinary *binary = [FBApplicationMetadataCache.sharedCache binaryForPath:binaryPath];
+  if (binary) {
+    return binary;
+  }
+  binary = [self createBinaryWithPath:binaryPath error:error];
+  if (!binary) {
+    return nil;
+  }
+  [FBApplicationMetadataCache.sharedCache cacheBinary:binary error:nil];
+  return binary;
+}
+
++ (instancetype)createBinaryWithPath:(NSString *)binaryPath error:(NSError **)error
 {
   NSError *innerError = nil;
   NSSet *archs = [FBBinaryParser architecturesForBinaryAtPath:binaryPath error:&innerError];
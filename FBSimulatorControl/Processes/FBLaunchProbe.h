@@ -0,0 +1,103 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+/**
+ The Environment Variable that Shimulator reads the Probe path from.
+ */
+extern NSString *const FBLaunchProbeEnvironmentKey;
+
+/**
+ The Events that are reported by the Launch Probe in Shimulator.
+ */
+extern NSString *const FBLaunchProbeEventProcessStart;
+extern NSString *const FBLaunchProbeEventConstructor;
+extern NSString *const FBLaunchProbeEventMainRunLoop;
+extern NSString *const FBLaunchProbeEventDidFinishLaunching;
+extern NSString *const FBLaunchProbeEventMainRunLoopIdle;
+
+/**
+ The Timings of a Launch, as reported from inside the launched process.
+ */
+@interface FBLaunchTimings : NSObject <NSCopying, NSCoding>
+
+/**
+ Parses the output of a Launch Probe.
+ Each line is of the form '<pid> <event> <seconds since epoch>'. Malformed or unterminated lines are ignored, as are repeated events.
+
+ @param output the contents of the Probe file.
+ @return an NSDictionary<NSNumber *, FBLaunchTimings *> of Process Identifier to the Timings for that process.
+ */
++ (NSDictionary *)timingsFromProbeOutput:(NSString *)output;
+
+/**
+ The Process Identifier of the launched process.
+ */
+@property (nonatomic, assign, readonly) pid_t processIdentifier;
+
+/**
+ An NSDictionary<NSString *, NSDate *> of Event Name to the time it occurred.
+ */
+@property (nonatomic, copy, readonly) NSDictionary *events;
+
+/**
+ The time from the start of the process to the event, or a negative value if either is unknown.
+ */
+- (NSTimeInterval)intervalFromProcessStartToEvent:(NSString *)event;
+
+/**
+ YES if the main run loop has become idle, which is the last event reported by the Probe.
+ */
+@property (nonatomic, assign, readonly) BOOL isComplete;
+
+@end
+
+/**
+ Collects Launch Timings reported by Shimulator, via a file passed in the environment of the launched process.
+ The Shimulator that is injected must be built from Shims/Shimulator with the Launch Probe,
+ the prebuilt Shims/Binaries/libShimulator.dylib does not report Launch Timings.
+ */
+@interface FBLaunchProbe : NSObject
+
+/**
+ A Probe that writes to a new temporary file.
+ */
++ (instancetype)probe;
+
+/**
+ A Probe that writes to the file at the provided path.
+ */
++ (instancetype)probeWithPath:(NSString *)path;
+
+/**
+ The path of the file that is reported to.
+ */
+@property (nonatomic, copy, readonly) NSString *path;
+
+/**
+ The Environment to add to the launched process, in addition to injecting Shimulator.
+ */
+@property (nonatomic, copy, readonly) NSDictionary *environment;
+
+/**
+ Returns the Timings reported so far by the process, nil if there are none.
+ */
+- (FBLaunchTimings *)timingsForProcessIdentifier:(pid_t)processIdentifier;
+
+/**
+ Waits for the process to report all of its Timings.
+
+ @param processIdentifier the process to wait for.
+ @param timeout the maximum time to wait.
+ @return the Timings, which may be incomplete if the timeout is reached. nil if no timings were reported.
+ */
+- (FBLaunchTimings *)waitForTimingsForProcessIdentifier:(pid_t)processIdentifier timeout:(NSTimeInterval)timeout;
+
+@end
@@ -0,0 +1,214 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "FBLaunchProbe.h"
+
+#import "NSRunLoop+SimulatorControlAdditions.h"
+
+NSString *const FBLaunchProbeEnvironmentKey = @"SHIMULATOR_LAUNCH_PROBE";
+
+NSString *const FBLaunchProbeEventProcessStart = @"process_start";
+NSString *const FBLaunchProbeEventConstructor = @"constructor";
+NSString *const FBLaunchProbeEventMainRunLoop = @"main_run_loop";
+NSString *const FBLaunchProbeEventDidFinishLaunching = @"did_finish_launching";
+NSString *const FBLaunchProbeEventMainRunLoopIdle = @"main_run_loop_idle";
+
+@implementation FBLaunchTimings
+
+#pragma mark Initializers
+
++ (NSDictionary *)timingsFromProbeOutput:(NSString *)output
+{
+  // The last component is either empty, or a line that is still being written.
+  NSArray *lines = [output componentsSeparatedByString:@"\n"];
+  lines = [lines subarrayWithRange:NSMakeRange(0, lines.count - 1)];
+
+  NSMutableDictionary *eventsByProcess = [NSMutableDictionary dictionary];
+  for (NSString *line in lines) {
+    NSArray *components = [line componentsSeparatedByString:@" "];
+    if (components.count != 3) {
+      continue;
+    }
+    NSScanner *scanner = [NSScanner scannerWithString:components[0]];
+    int processIdentifier = 0;
+    if (![scanner scanInt:&processIdentifier] || !scanner.isAtEnd || processIdentifier <= 0) {
+      continue;
+    }
+    NSString *event = components[1];
+    if (event.length == 0) {
+      continue;
+    }
+    scanner = [NSScanner scannerWithString:components[2]];
+    double seconds = 0;
+    if (![scanner scanDouble:&seconds] || !scanner.isAtEnd) {
+      continue;
+    }
+
+    NSMutableDictionary *events = eventsByProcess[@(processIdentifier)];
+    if (!events) {
+      events = [NSMutableDictionary dictionary];
+      eventsByProcess[@(processIdentifier)] = events;
+    }
+    if (!events[event]) {
+      events[event] = [NSDate dateWithTimeIntervalSince1970:seconds];
+    }
+  }
+
+  NSMutableDictionary *timings = [NSMutableDictionary dictionary];
+  for (NSNumber *processIdentifier in eventsByProcess) {
+    timings[processIdentifier] = [[FBLaunchTimings alloc] initWithProcessIdentifier:processIdentifier.intValue events:eventsByProcess[processIdentifier]];
+  }
+  return [timings copy];
+}
+
+- (instancetype)initWithProcessIdentifier:(pid_t)processIdentifier events:(NSDictionary *)events
+{
+  NSParameterAssert(events);
+
+  self = [super init];
+  if (!self) {
+    return nil;
+  }
+
+  _processIdentifier = processIdentifier;
+  _events = [events copy];
+
+  return self;
+}
+
+#pragma mark Public
+
+- (NSTimeInterval)intervalFromProcessStartToEvent:(NSString *)event
+{
+  NSDate *start = self.events[FBLaunchProbeEventProcessStart];
+  NSDate *end = self.events[event];
+  if (!start || !end) {
+    return -1;
+  }
+  return [end timeIntervalSinceDate:start];
+}
+
+- (BOOL)isComplete
+{
+  return self.events[FBLaunchProbeEventMainRunLoopIdle] != nil;
+}
+
+#pragma mark NSCopying
+
+- (instancetype)copyWithZone:(NSZone *)zone
+{
+  return self;
+}
+
+#pragma mark NSCoding
+
+- (instancetype)initWithCoder:(NSCoder *)coder
+{
+  self = [super init];
+  if (!self) {
+    return nil;
+  }
+
+  _processIdentifier = [[coder decodeObjectForKey:NSStringFromSelector(@selector(processIdentifier))] intValue];
+  _events = [coder decodeObjectForKey:NSStringFromSelector(@selector(events))];
+
+  return self;
+}
+
+- (void)encodeWithCoder:(NSCoder *)coder
+{
+  [coder encodeObject:@(self.processIdentifier) forKey:NSStringFromSelector(@selector(processIdentifier))];
+  [coder encodeObject:self.events forKey:NSStringFromSelector(@selector(events))];
+}
+
+#pragma mark NSObject
+
+- (BOOL)isEqual:(FBLaunchTimings *)object
+{
+  if (![object isMemberOfClass:self.class]) {
+    return NO;
+  }
+  return object.processIdentifier == self.processIdentifier &&
+         [object.events isEqualToDictionary:self.events];
+}
+
+- (NSUInteger)hash
+{
+  return (NSUInteger) self.processIdentifier ^ self.events.hash;
+}
+
+- (NSString *)description
+{
+  NSMutableArray *intervals = [NSMutableArray array];
+  for (NSString *event in @[FBLaunchProbeEventConstructor, FBLaunchProbeEventMainRunLoop, FBLaunchProbeEventDidFinishLaunching, FBLaunchProbeEventMainRunLoopIdle]) {
+    NSTimeInterval interval = [self intervalFromProcessStartToEvent:event];
+    if (interval < 0) {
+      continue;
+    }
+    [intervals addObject:[NSString stringWithFormat:@"%@ %.3fs", event, interval]];
+  }
+  return [NSString stringWithFormat:@"Launch Timings | PID %d | %@", self.processIdentifier, [intervals componentsJoinedByString:@" | "]];
+}
+
+@end
+
+@implementation FBLaunchProbe
+
+#pragma mark Initializers
+
++ (instancetype)probe
+{
+  NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:[NSString stringWithFormat:@"FBLaunchProbe_%@.txt", NSUUID.UUID.UUIDString]];
+  return [self probeWithPath:path];
+}
+
++ (instancetype)probeWithPath:(NSString *)path
+{
+  return [[self alloc] initWithPath:path];
+}
+
+- (instancetype)initWithPath:(NSString *)path
+{
+  NSParameterAssert(path);
+
+  self = [super init];
+  if (!self) {
+    return nil;
+  }
+
+  _path = [path copy];
+
+  return self;
+}
+
+#pragma mark Public
+
+- (NSDictionary *)environment
+{
+  return @{FBLaunchProbeEnvironmentKey : self.path};
+}
+
+- (FBLaunchTimings *)timingsForProcessIdentifier:(pid_t)processIdentifier
+{
+  NSString *output = [NSString stringWithContentsOfFile:self.path encoding:NSUTF8StringEncoding error:nil];
+  if (!output) {
+    return nil;
+  }
+  return [FBLaunchTimings timingsFromProbeOutput:output][@(processIdentifier)];
+}
+
+- (FBLaunchTimings *)waitForTimingsForProcessIdentifier:(pid_t)processIdentifier timeout:(NSTimeInterval)timeout
+{
+  [NSRunLoop.currentRunLoop spinRunLoopWithTimeout:timeout untilTrue:^ BOOL {
+    return [self timingsForProcessIdentifier:processIdentifier].isComplete;
+  }];
+  return [self timingsForProcessIdentifier:processIdentifier];
+}
+
+@end
@@ -15,6 +15,7 @@
 #include <sys/sysctl.h>
 
 #import "FBProcessInfo.h"
+#import "FBTracer.h"
 
 #define PID_MAX 99999
 
@@ -201,6 +202,7 @@ static BOOL ProcessNameForProcessIdentifier(pid_t processIdentifier, char *buffe
 
 - (NSArray *)subprocessesOf:(pid_t)parent
 {
+  FBTraceSpan span = FBTraceBegin("process_query", "subprocessesOf");
   NSMutableArray *subprocesses = [NSMutableArray array];
 
   IterateSubprocessesOf(self.pidBuffer, self.pidBufferSize, parent, ^ BOOL (pid_t pid) {
@@ -211,11 +213,13 @@ static BOOL ProcessNameForProcessIdentifier(pid_t processIdentifier, char *buffe
     return YES;
   });
 
+  FBTraceEnd(span);
   return [subprocesses copy];
 }
 
 - (NSArray *)processesWithLaunchPathSubstring:(NSString *)substring
 {
+  FBTraceSpan span = FBTraceBegin("process_query", "processesWithLaunchPathSubstring");
   NSMutableArray *subprocesses = [NSMutableArray array];
 
   IterateAllProcesses(self.pidBuffer, self.pidBufferSize, ^ BOOL (pid_t pid) {
@@ -230,11 +234,13 @@ static BOOL ProcessNameForProcessIdentifier(pid_t processIdentifier, char *buffe
     return YES;
   });
 
+  FBTraceEnd(span);
   return [subprocesses copy];
 }
 
 - (NSArray *)processesWithProcessName:(NSString *)processName;
 {
+  FBTraceSpan span = FBTraceBegin("process_query", "processesWithProcessName");
   NSMutableArray *subprocesses = [NSMutableArray array];
   size_t bufferSize = self.argumentBufferSize;
   char *buffer = self.argumentBuffer;
@@ -255,6 +261,7 @@ static BOOL ProcessNameForProcessIdentifier(pid_t processIdentifier, char *buffe
     return YES;
   });
 
+  FBTraceEnd(span);
   return [subprocesses copy];
 }
 
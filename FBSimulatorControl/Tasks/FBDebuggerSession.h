@@ -0,0 +1,104 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+/**
+ The Completion of a Debugger Command. Exactly one of output and error is non-nil.
+ */
+typedef void (^FBDebuggerCommandCompletion)(NSString *output, NSError *error);
+
+/**
+ Creates the command that causes the Debugger to print the marker on a line of its own.
+ */
+typedef NSString *(^FBDebuggerMarkerCommand)(NSString *marker);
+
+/**
+ A long-lived Debugger process, attached to a single target process.
+
+ Commands are written to the Debugger's stdin as soon as they are submitted, so multiple commands can be in-flight at once.
+ Each command is followed by a marker command, the response to a command is all of the output up to the marker line.
+ If a command does not complete within its timeout, the Debugger is interrupted and the session is terminated, failing all pending commands.
+ */
+@interface FBDebuggerSession : NSObject
+
+/**
+ A Session that attaches lldb(1) to the provided process.
+
+ @param processIdentifier the process to attach to.
+ @return a new Debugger Session, that has not been started.
+ */
++ (instancetype)lldbSessionAttachingToProcessIdentifier:(pid_t)processIdentifier;
+
+/**
+ Creates a Session for an arbitrary Debugger-like process, that reads commands from stdin and writes responses to stdout.
+
+ @param processIdentifier the target process of the Debugger.
+ @param launchPath the launch path of the Debugger.
+ @param arguments the arguments to launch the Debugger with.
+ @param markerCommand a block that returns the command for printing a marker line.
+ @param ignoredLinePrefix lines with this prefix, such as echoed prompts, are not included in responses. May be nil.
+ @param detachCommands the commands to write when the session is terminated, so that the Debugger detaches cleanly.
+ @return a new Debugger Session, that has not been started.
+ */
++ (instancetype)sessionWithProcessIdentifier:(pid_t)processIdentifier launchPath:(NSString *)launchPath arguments:(NSArray *)arguments markerCommand:(FBDebuggerMarkerCommand)markerCommand ignoredLinePrefix:(NSString *)ignoredLinePrefix detachCommands:(NSArray *)detachCommands;
+
+/**
+ Launches the Debugger process.
+
+ @param error an error out for any error that occurred.
+ @return YES if successful, NO otherwise.
+ */
+- (BOOL)startWithError:(NSError **)error;
+
+/**
+ Executes a Command Asynchronously. The completion is called on an arbitrary queue.
+
+ @param command the command to execute.
+ @param timeout the maximum time to wait for a response, once all previous commands have completed.
+ @param completion the completion to call with the response.
+ */
+- (void)executeCommand:(NSString *)command timeout:(NSTimeInterval)timeout completion:(FBDebuggerCommandCompletion)completion;
+
+/**
+ Executes a Command Synchronously.
+
+ @param command the command to execute.
+ @param timeout the maximum time to wait for a response, once all previous commands have completed.
+ @param error an error out for any error that occurred.
+ @return the output of the command if successful, nil otherwise.
+ */
+- (NSString *)executeCommand:(NSString *)command timeout:(NSTimeInterval)timeout error:(NSError **)error;
+
+/**
+ Detaches the Debugger from the target and terminates it. Pending commands are failed.
+ */
+- (void)terminate;
+
+/**
+ The target process of the Debugger.
+ */
+@property (nonatomic, assign, readonly) pid_t processIdentifier;
+
+/**
+ The time at which a command was last submitted or completed.
+ */
+@property (atomic, copy, readonly) NSDate *lastActivityDate;
+
+/**
+ The number of commands that have been submitted, but not completed.
+ */
+@property (atomic, assign, readonly) NSUInteger pendingCommandCount;
+
+/**
+ YES if the session has been terminated or the Debugger process has exited.
+ */
+@property (atomic, assign, readonly) BOOL hasTerminated;
+
+@end
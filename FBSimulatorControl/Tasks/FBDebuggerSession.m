@@ -0,0 +1,400 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "FBDebuggerSession.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#import "FBSimulatorError.h"
+
+static NSTimeInterval const FBDebuggerSessionDetachGracePeriod = 2.0;
+
+@interface FBDebuggerSession_Command : NSObject
+
+@property (nonatomic, copy) NSString *marker;
+@property (nonatomic, assign) NSTimeInterval timeout;
+@property (nonatomic, copy) FBDebuggerCommandCompletion completion;
+@property (nonatomic, strong) NSMutableArray *lines;
+@property (nonatomic, assign) BOOL armed;
+
+@end
+
+@implementation FBDebuggerSession_Command
+
+@end
+
+@interface FBDebuggerSession ()
+
+@property (nonatomic, assign, readwrite) pid_t processIdentifier;
+@property (nonatomic, copy) NSString *launchPath;
+@property (nonatomic, copy) NSArray *arguments;
+@property (nonatomic, copy) FBDebuggerMarkerCommand markerCommand;
+@property (nonatomic, copy) NSString *ignoredLinePrefix;
+@property (nonatomic, copy) NSArray *detachCommands;
+@property (nonatomic, copy) NSString *markerPrefix;
+
+@property (nonatomic, strong) NSTask *task;
+@property (nonatomic, assign) int inputFileDescriptor;
+@property (nonatomic, strong) dispatch_queue_t writeQueue;
+@property (nonatomic, strong) NSMutableData *buffer;
+@property (nonatomic, strong) NSMutableArray *pendingCommands;
+@property (nonatomic, assign) NSUInteger commandCount;
+
+@property (atomic, copy, readwrite) NSDate *lastActivityDate;
+@property (atomic, assign, readwrite) NSUInteger pendingCommandCount;
+@property (atomic, assign, readwrite) BOOL hasTerminated;
+
+@end
+
+@implementation FBDebuggerSession
+
+#pragma mark Initializers
+
++ (instancetype)lldbSessionAttachingToProcessIdentifier:(pid_t)processIdentifier
+{
+  return [self
+    sessionWithProcessIdentifier:processIdentifier
+    launchPath:@"/usr/bin/lldb"
+    arguments:@[@"--no-use-colors", @"-p", @(processIdentifier).stringValue]
+    markerCommand:^ NSString * (NSString *marker) {
+      return [NSString stringWithFormat:@"script print('%@')", marker];
+    }
+    ignoredLinePrefix:@"(lldb) "
+    detachCommands:@[@"process detach", @"quit"]];
+}
+
++ (instancetype)sessionWithProcessIdentifier:(pid_t)processIdentifier launchPath:(NSString *)launchPath arguments:(NSArray *)arguments markerCommand:(FBDebuggerMarkerCommand)markerCommand ignoredLinePrefix:(NSString *)ignoredLinePrefix detachCommands:(NSArray *)detachCommands
+{
+  return [[self alloc] initWithProcessIdentifier:processIdentifier launchPath:launchPath arguments:arguments markerCommand:markerCommand ignoredLinePrefix:ignoredLinePrefix detachCommands:detachCommands];
+}
+
+- (instancetype)initWithProcessIdentifier:(pid_t)processIdentifier launchPath:(NSString *)launchPath arguments:(NSArray *)arguments markerCommand:(FBDebuggerMarkerCommand)markerCommand ignoredLinePrefix:(NSString *)ignoredLinePrefix detachCommands:(NSArray *)detachCommands
+{
+  NSParameterAssert(launchPath);
+  NSParameterAssert(arguments);
+  NSParameterAssert(markerCommand);
+  NSParameterAssert(detachCommands);
+
+  self = [super init];
+  if (!self) {
+    return nil;
+  }
+
+  _processIdentifier = processIdentifier;
+  _launchPath = launchPath;
+  _arguments = arguments;
+  _markerCommand = markerCommand;
+  _ignoredLinePrefix = ignoredLinePrefix;
+  _detachCommands = detachCommands;
+  _markerPrefix = [NSString stringWithFormat:@"__FBDEBUGGER_%@_", [NSUUID.UUID.UUIDString stringByReplacingOccurrencesOfString:@"-" withString:@""]];
+
+  _inputFileDescriptor = -1;
+  _writeQueue = dispatch_queue_create("com.facebook.fbsimulatorcontrol.debugger.write", DISPATCH_QUEUE_SERIAL);
+  _buffer = [NSMutableData data];
+  _pendingCommands = [NSMutableArray array];
+  _lastActivityDate = NSDate.date;
+
+  return self;
+}
+
+#pragma mark Public
+
+- (BOOL)startWithError:(NSError **)error
+{
+  NSPipe *inputPipe = NSPipe.pipe;
+  NSPipe *outputPipe = NSPipe.pipe;
+
+  NSTask *task = [NSTask new];
+  task.launchPath = self.launchPath;
+  task.arguments = self.arguments;
+  task.standardInput = inputPipe;
+  task.standardOutput = outputPipe;
+  task.standardError = outputPipe;
+
+  __weak FBDebuggerSession *weakSelf = self;
+  task.terminationHandler = ^(NSTask *_) {
+    [weakSelf debuggerDidExit];
+  };
+  outputPipe.fileHandleForReading.readabilityHandler = ^(NSFileHandle *handle) {
+    NSData *data = handle.availableData;
+    if (data.length == 0) {
+      handle.readabilityHandler = nil;
+      return;
+    }
+    [weakSelf consumeData:data];
+  };
+
+  @try {
+    [task launch];
+  }
+  @catch (NSException *exception) {
+    outputPipe.fileHandleForReading.readabilityHandler = nil;
+    return [[FBSimulatorError describeFormat:@"Failed to launch Debugger %@: %@", self.launchPath, exception.reason] failBool:error];
+  }
+
+  int inputFileDescriptor = dup(inputPipe.fileHandleForWriting.fileDescriptor);
+#ifdef F_SETNOSIGPIPE
+  fcntl(inputFileDescriptor, F_SETNOSIGPIPE, 1);
+#endif
+  [inputPipe.fileHandleForWriting closeFile];
+
+  @synchronized(self) {
+    self.task = task;
+    self.inputFileDescriptor = inputFileDescriptor;
+  }
+  return YES;
+}
+
+- (void)executeCommand:(NSString *)command timeout:(NSTimeInterval)timeout completion:(FBDebuggerCommandCompletion)completion
+{
+  NSParameterAssert(command);
+  NSParameterAssert(completion);
+
+  // The write happens on the writer queue, rather than under the lock.
+  // The Debugger may stop reading its input until its output is drained, which needs the lock.
+  NSError *error = nil;
+  @synchronized(self) {
+    if (self.hasTerminated || self.inputFileDescriptor < 0) {
+      error = [[FBSimulatorError describeFormat:@"Cannot execute '%@' as the Debugger Session is not running", command] build];
+    } else {
+      FBDebuggerSession_Command *pending = [FBDebuggerSession_Command new];
+      pending.marker = [NSString stringWithFormat:@"%@%lu__", self.markerPrefix, (unsigned long) ++self.commandCount];
+      pending.timeout = timeout;
+      pending.completion = completion;
+      pending.lines = [NSMutableArray array];
+
+      [self.pendingCommands addObject:pending];
+      self.pendingCommandCount = self.pendingCommands.count;
+      self.lastActivityDate = NSDate.date;
+      [self armHeadCommand];
+
+      // Enqueued under the lock, so that writes happen in the same order as the pending commands.
+      NSString *payload = [NSString stringWithFormat:@"%@\n%@\n", command, self.markerCommand(pending.marker)];
+      int fileDescriptor = self.inputFileDescriptor;
+      dispatch_async(self.writeQueue, ^{
+        if ([FBDebuggerSession writeString:payload toFileDescriptor:fileDescriptor]) {
+          return;
+        }
+        NSError *writeError = [[FBSimulatorError describeFormat:@"Failed to write '%@' to the Debugger: %s", command, strerror(errno)] build];
+        [self failPendingCommand:pending error:writeError];
+      });
+    }
+  }
+  if (error) {
+    completion(nil, error);
+  }
+}
+
+- (NSString *)executeCommand:(NSString *)command timeout:(NSTimeInterval)timeout error:(NSError **)error
+{
+  dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+  __block NSString *output = nil;
+  __block NSError *innerError = nil;
+  [self executeCommand:command timeout:timeout completion:^(NSString *commandOutput, NSError *commandError) {
+    output = commandOutput;
+    innerError = commandError;
+    dispatch_semaphore_signal(semaphore);
+  }];
+  dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+
+  if (!output) {
+    return [FBSimulatorError failWithError:innerError errorOut:error];
+  }
+  return output;
+}
+
+- (void)terminate
+{
+  [self terminateInterrupting:NO description:@"The Debugger Session was terminated"];
+}
+
+#pragma mark Private
+
++ (BOOL)writeString:(NSString *)string toFileDescriptor:(int)fileDescriptor
+{
+  NSData *data = [string dataUsingEncoding:NSUTF8StringEncoding];
+  const char *bytes = data.bytes;
+  size_t remaining = data.length;
+  while (remaining > 0) {
+    ssize_t written = write(fileDescriptor, bytes, remaining);
+    if (written < 0) {
+      if (errno == EINTR || errno == EAGAIN) {
+        continue;
+      }
+      return NO;
+    }
+    bytes += written;
+    remaining -= (size_t) written;
+  }
+  return YES;
+}
+
+- (void)failPendingCommand:(FBDebuggerSession_Command *)command error:(NSError *)error
+{
+  @synchronized(self) {
+    NSUInteger index = [self.pendingCommands indexOfObjectIdenticalTo:command];
+    if (index == NSNotFound) {
+      // Already completed or failed by termination.
+      return;
+    }
+    [self.pendingCommands removeObjectAtIndex:index];
+    self.pendingCommandCount = self.pendingCommands.count;
+    [self armHeadCommand];
+  }
+  command.completion(nil, error);
+}
+
+- (void)armHeadCommand
+{
+  FBDebuggerSession_Command *head = self.pendingCommands.firstObject;
+  if (!head || head.armed) {
+    return;
+  }
+  head.armed = YES;
+
+  __weak FBDebuggerSession *weakSelf = self;
+  dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t) (head.timeout * NSEC_PER_SEC)), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+    FBDebuggerSession *session = weakSelf;
+    BOOL timedOut = NO;
+    @synchronized(session) {
+      timedOut = session.pendingCommands.firstObject == head;
+    }
+    if (timedOut) {
+      [session terminateInterrupting:YES description:[NSString stringWithFormat:@"Timed out after %f seconds waiting for a Debugger response", head.timeout]];
+    }
+  });
+}
+
+- (void)consumeData:(NSData *)data
+{
+  NSMutableArray *completed = [NSMutableArray array];
+  @synchronized(self) {
+    [self.buffer appendData:data];
+    while (YES) {
+      NSRange newline = [self.buffer rangeOfData:[NSData dataWithBytes:"\n" length:1] options:0 range:NSMakeRange(0, self.buffer.length)];
+      if (newline.location == NSNotFound) {
+        break;
+      }
+      NSData *lineData = [self.buffer subdataWithRange:NSMakeRange(0, newline.location)];
+      [self.buffer replaceBytesInRange:NSMakeRange(0, newline.location + 1) withBytes:NULL length:0];
+      NSString *line = [[NSString alloc] initWithData:lineData encoding:NSUTF8StringEncoding] ?: @"";
+
+      FBDebuggerSession_Command *head = self.pendingCommands.firstObject;
+      if (!head) {
+        continue;
+      }
+      if ([line hasSuffix:head.marker]) {
+        // Output that isn't newline-terminated will share a line with the marker.
+        NSString *remainder = [line substringToIndex:line.length - head.marker.length];
+        if (remainder.length) {
+          [head.lines addObject:remainder];
+        }
+        [completed addObject:head];
+        [self.pendingCommands removeObjectAtIndex:0];
+        self.pendingCommandCount = self.pendingCommands.count;
+        self.lastActivityDate = NSDate.date;
+        [self armHeadCommand];
+        continue;
+      }
+      if ([line hasPrefix:self.markerPrefix]) {
+        continue;
+      }
+      if (self.ignoredLinePrefix && [line hasPrefix:self.ignoredLinePrefix]) {
+        continue;
+      }
+      [head.lines addObject:line];
+    }
+  }
+
+  for (FBDebuggerSession_Command *command in completed) {
+    command.completion([command.lines componentsJoinedByString:@"\n"], nil);
+  }
+}
+
+- (void)debuggerDidExit
+{
+  NSArray *failed = nil;
+  @synchronized(self) {
+    self.hasTerminated = YES;
+    failed = [self.pendingCommands copy];
+    [self.pendingCommands removeAllObjects];
+    self.pendingCommandCount = 0;
+
+    // Termination will return early from here on, so the input has to be closed now.
+    if (self.inputFileDescriptor >= 0) {
+      int fileDescriptor = self.inputFileDescriptor;
+      dispatch_async(self.writeQueue, ^{
+        close(fileDescriptor);
+      });
+      self.inputFileDescriptor = -1;
+    }
+  }
+  NSError *error = [[FBSimulatorError describeFormat:@"The Debugger for process %d exited", self.processIdentifier] build];
+  for (FBDebuggerSession_Command *command in failed) {
+    command.completion(nil, error);
+  }
+}
+
+- (void)terminateInterrupting:(BOOL)interrupt description:(NSString *)description
+{
+  NSArray *failed = nil;
+  NSTask *task = nil;
+  @synchronized(self) {
+    if (self.hasTerminated) {
+      return;
+    }
+    self.hasTerminated = YES;
+    failed = [self.pendingCommands copy];
+    [self.pendingCommands removeAllObjects];
+    self.pendingCommandCount = 0;
+
+    task = self.task;
+    if (interrupt && task.isRunning) {
+      [task interrupt];
+    }
+    if (self.inputFileDescriptor >= 0) {
+      // Closing on the writer queue means that the descriptor outlives any writes that are still enqueued.
+      int fileDescriptor = self.inputFileDescriptor;
+      NSString *detach = [[self.detachCommands componentsJoinedByString:@"\n"] stringByAppendingString:@"\n"];
+      dispatch_async(self.writeQueue, ^{
+        [FBDebuggerSession writeString:detach toFileDescriptor:fileDescriptor];
+        close(fileDescriptor);
+      });
+      self.inputFileDescriptor = -1;
+    }
+  }
+
+  // Give the Debugger a chance to detach, before forcibly terminating it.
+  dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t) (FBDebuggerSessionDetachGracePeriod * NSEC_PER_SEC)), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+    if (task.isRunning) {
+      [task terminate];
+    }
+  });
+
+  NSError *error = [[FBSimulatorError describe:description] build];
+  for (FBDebuggerSession_Command *command in failed) {
+    command.completion(nil, error);
+  }
+}
+
+#pragma mark NSObject
+
+- (NSString *)description
+{
+  return [NSString stringWithFormat:
+    @"Debugger Session | Target %d | Pending %lu | Terminated %d",
+    self.processIdentifier,
+    (unsigned long) self.pendingCommandCount,
+    self.hasTerminated
+  ];
+}
+
+@end
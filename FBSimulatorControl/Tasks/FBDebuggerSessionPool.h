@@ -0,0 +1,78 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+@class FBDebuggerSession;
+
+/**
+ Creates an un-started Debugger Session for the target process.
+ */
+typedef FBDebuggerSession *(^FBDebuggerSessionFactory)(pid_t processIdentifier);
+
+/**
+ Keeps Debugger Sessions attached between commands, so that the cost of attaching is only paid once per target process.
+
+ Sessions are detached when they have been idle for longer than the idle timeout, or when their target process has exited.
+ When the maximum number of sessions is reached, the least recently used session is detached to make room for a new one.
+ */
+@interface FBDebuggerSessionPool : NSObject
+
+/**
+ The Pool used by the Diagnostic Interactions, attaching with lldb(1).
+ */
++ (instancetype)sharedPool;
+
+/**
+ Creates a Pool.
+
+ @param maximumSessions the maximum number of live sessions.
+ @param idleTimeout the time after which an idle session is detached.
+ @param sessionFactory the factory for new sessions.
+ @return a new Pool.
+ */
++ (instancetype)poolWithMaximumSessions:(NSUInteger)maximumSessions idleTimeout:(NSTimeInterval)idleTimeout sessionFactory:(FBDebuggerSessionFactory)sessionFactory;
+
+/**
+ Returns a running Session for the target process, attaching a new one if required.
+
+ @param processIdentifier the target process.
+ @param error an error out for any error that occurred.
+ @return a Session if successful, nil otherwise.
+ */
+- (FBDebuggerSession *)sessionForProcessIdentifier:(pid_t)processIdentifier error:(NSError **)error;
+
+/**
+ Executes a Command Synchronously against the target process.
+
+ @param command the command to execute.
+ @param processIdentifier the target process.
+ @param timeout the maximum time to wait for a response.
+ @param error an error out for any error that occurred.
+ @return the output of the command if successful, nil otherwise.
+ */
+- (NSString *)executeCommand:(NSString *)command onProcessIdentifier:(pid_t)processIdentifier timeout:(NSTimeInterval)timeout error:(NSError **)error;
+
+/**
+ Detaches Sessions that are idle, have exited, or whose target has exited.
+ This is performed periodically, but can be called to reap sessions immediately.
+ */
+- (void)reapSessions;
+
+/**
+ Detaches all Sessions.
+ */
+- (void)terminateAllSessions;
+
+/**
+ The number of live Sessions.
+ */
+@property (nonatomic, assign, readonly) NSUInteger sessionCount;
+
+@end
@@ -0,0 +1,171 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "FBDebuggerSessionPool.h"
+
+#include <errno.h>
+#include <signal.h>
+
+#import "FBDebuggerSession.h"
+#import "FBSimulatorError.h"
+
+static NSUInteger const FBDebuggerSessionPoolDefaultMaximumSessions = 4;
+static NSTimeInterval const FBDebuggerSessionPoolDefaultIdleTimeout = 120.0;
+
+@interface FBDebuggerSessionPool ()
+
+@property (nonatomic, assign) NSUInteger maximumSessions;
+@property (nonatomic, assign) NSTimeInterval idleTimeout;
+@property (nonatomic, copy) FBDebuggerSessionFactory sessionFactory;
+@property (nonatomic, strong) NSMutableDictionary *sessions;
+@property (nonatomic, strong) dispatch_source_t reapTimer;
+
+@end
+
+@implementation FBDebuggerSessionPool
+
+#pragma mark Initializers
+
++ (instancetype)sharedPool
+{
+  static dispatch_once_t onceToken;
+  static FBDebuggerSessionPool *pool;
+  dispatch_once(&onceToken, ^{
+    pool = [self
+      poolWithMaximumSessions:FBDebuggerSessionPoolDefaultMaximumSessions
+      idleTimeout:FBDebuggerSessionPoolDefaultIdleTimeout
+      sessionFactory:^ FBDebuggerSession * (pid_t processIdentifier) {
+        return [FBDebuggerSession lldbSessionAttachingToProcessIdentifier:processIdentifier];
+      }];
+  });
+  return pool;
+}
+
++ (instancetype)poolWithMaximumSessions:(NSUInteger)maximumSessions idleTimeout:(NSTimeInterval)idleTimeout sessionFactory:(FBDebuggerSessionFactory)sessionFactory
+{
+  return [[self alloc] initWithMaximumSessions:maximumSessions idleTimeout:idleTimeout sessionFactory:sessionFactory];
+}
+
+- (instancetype)initWithMaximumSessions:(NSUInteger)maximumSessions idleTimeout:(NSTimeInterval)idleTimeout sessionFactory:(FBDebuggerSessionFactory)sessionFactory
+{
+  NSParameterAssert(maximumSessions > 0);
+  NSParameterAssert(idleTimeout > 0);
+  NSParameterAssert(sessionFactory);
+
+  self = [super init];
+  if (!self) {
+    return nil;
+  }
+
+  _maximumSessions = maximumSessions;
+  _idleTimeout = idleTimeout;
+  _sessionFactory = sessionFactory;
+  _sessions = [NSMutableDictionary dictionary];
+
+  __weak FBDebuggerSessionPool *weakSelf = self;
+  uint64_t interval = (uint64_t) (idleTimeout / 2 * NSEC_PER_SEC);
+  _reapTimer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_BACKGROUND, 0));
+  dispatch_source_set_timer(_reapTimer, dispatch_time(DISPATCH_TIME_NOW, (int64_t) interval), interval, interval / 10);
+  dispatch_source_set_event_handler(_reapTimer, ^{
+    [weakSelf reapSessions];
+  });
+  dispatch_resume(_reapTimer);
+
+  return self;
+}
+
+- (void)dealloc
+{
+  dispatch_source_cancel(_reapTimer);
+  for (FBDebuggerSession *session in _sessions.allValues) {
+    [session terminate];
+  }
+}
+
+#pragma mark Public
+
+- (FBDebuggerSession *)sessionForProcessIdentifier:(pid_t)processIdentifier error:(NSError **)error
+{
+  [self reapSessions];
+
+  @synchronized(self) {
+    FBDebuggerSession *session = self.sessions[@(processIdentifier)];
+    if (session) {
+      return session;
+    }
+
+    while (self.sessions.count >= self.maximumSessions) {
+      NSNumber *leastRecentlyUsed = [[self.sessions keysSortedByValueUsingComparator:^ NSComparisonResult (FBDebuggerSession *left, FBDebuggerSession *right) {
+        return [left.lastActivityDate compare:right.lastActivityDate];
+      }] firstObject];
+      [self.sessions[leastRecentlyUsed] terminate];
+      [self.sessions removeObjectForKey:leastRecentlyUsed];
+    }
+
+    session = self.sessionFactory(processIdentifier);
+    NSError *innerError = nil;
+    if (![session startWithError:&innerError]) {
+      return [[[FBSimulatorError describeFormat:@"Failed to attach a Debugger to process %d", processIdentifier] causedBy:innerError] fail:error];
+    }
+    self.sessions[@(processIdentifier)] = session;
+    return session;
+  }
+}
+
+- (NSString *)executeCommand:(NSString *)command onProcessIdentifier:(pid_t)processIdentifier timeout:(NSTimeInterval)timeout error:(NSError **)error
+{
+  NSError *innerError = nil;
+  FBDebuggerSession *session = [self sessionForProcessIdentifier:processIdentifier error:&innerError];
+  if (!session) {
+    return [FBSimulatorError failWithError:innerError errorOut:error];
+  }
+  NSString *output = [session executeCommand:command timeout:timeout error:&innerError];
+  if (!output) {
+    return [[[FBSimulatorError describeFormat:@"Failed to execute '%@' on process %d", command, processIdentifier] causedBy:innerError] fail:error];
+  }
+  return output;
+}
+
+- (void)reapSessions
+{
+  NSDate *idleDate = [NSDate dateWithTimeIntervalSinceNow:-self.idleTimeout];
+  NSMutableArray *reaped = [NSMutableArray array];
+  @synchronized(self) {
+    for (NSNumber *processIdentifier in self.sessions.allKeys) {
+      FBDebuggerSession *session = self.sessions[processIdentifier];
+      BOOL isIdle = session.pendingCommandCount == 0 && [session.lastActivityDate compare:idleDate] == NSOrderedAscending;
+      BOOL targetExited = kill(processIdentifier.intValue, 0) != 0 && errno == ESRCH;
+      if (!session.hasTerminated && !isIdle && !targetExited) {
+        continue;
+      }
+      [reaped addObject:session];
+      [self.sessions removeObjectForKey:processIdentifier];
+    }
+  }
+  [reaped makeObjectsPerformSelector:@selector(terminate)];
+}
+
+- (void)terminateAllSessions
+{
+  NSArray *sessions = nil;
+  @synchronized(self) {
+    sessions = self.sessions.allValues;
+    [self.sessions removeAllObjects];
+  }
+  [sessions makeObjectsPerformSelector:@selector(terminate)];
+}
+
+- (NSUInteger)sessionCount
+{
+  @synchronized(self) {
+    return self.sessions.count;
+  }
+}
+
+@end
@@ -11,6 +11,7 @@
 #import "FBTask+Private.h"
 
 #import "FBTaskExecutor.h"
+#import "FBTracer.h"
 #import "NSRunLoop+SimulatorControlAdditions.h"
 
 /**
@@ -74,10 +75,12 @@ NSTimeInterval const FBTaskDefaultTimeout = 30;
 
 - (instancetype)startSynchronouslyWithTimeout:(NSTimeInterval)timeout
 {
+  FBTraceSpan span = FBTraceBegin("task", "startSynchronously");
   [self launchWithTerminationHandler:nil];
   BOOL completed = [NSRunLoop.currentRunLoop spinRunLoopWithTimeout:timeout untilTrue:^BOOL{
     return !self.task.isRunning;
   }];
+  FBTraceEnd(span);
 
   if (!completed) {
     NSString *message = [NSString stringWithFormat:
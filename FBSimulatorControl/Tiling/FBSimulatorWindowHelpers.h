@@ -44,6 +44,13 @@
  */
 + (CGDirectDisplayID)displayIDForSimulator:(FBSimulator *)simulator cropRect:(CGRect *)cropRect screenSize:(CGSize *)screenSize;
 
+/**
+ Returns the bounds of the active Displays, in global co-ordinates with the origin at the top left of the main Display.
+
+ @return an NSArray<NSValue<CGRect>> of the bounds of the Displays, with the main Display first.
+ */
++ (NSArray *)boundsOfActiveDisplays;
+
 /**
  Returns a String representing the known information about Simulator Windows as well as the Diplays.
  This can be helpful when you wish to know about the working environment of a CI machine.
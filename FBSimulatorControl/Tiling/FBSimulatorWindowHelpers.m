@@ -110,6 +110,29 @@ static void EnsureCGIsInitialized(void)
   return displayID;
 }
 
++ (NSArray *)boundsOfActiveDisplays
+{
+  EnsureCGIsInitialized();
+
+  uint32_t maximumDisplays = 32;
+  uint32_t actualDisplays = 0;
+  CGDirectDisplayID displays[32];
+  if (CGGetActiveDisplayList(maximumDisplays, displays, &actualDisplays) != kCGErrorSuccess) {
+    return @[];
+  }
+
+  NSMutableArray *bounds = [NSMutableArray array];
+  for (uint32_t index = 0; index < actualDisplays; index++) {
+    NSValue *value = [NSValue valueWithRect:CGDisplayBounds(displays[index])];
+    if (CGDisplayIsMain(displays[index])) {
+      [bounds insertObject:value atIndex:0];
+    } else {
+      [bounds addObject:value];
+    }
+  }
+  return [bounds copy];
+}
+
 + (NSString *)debugDescription
 {
   return [NSString stringWithFormat:@"%@\nWindows: %@", [self onlineDisplaysDescription], [self allWindows]];
@@ -0,0 +1,62 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <CoreGraphics/CoreGraphics.h>
+#import <Foundation/Foundation.h>
+
+/**
+ Packs Windows of mixed sizes into the free space of one or more Displays, using the 'Maximal Rectangles' algorithm.
+ The free space is kept as the set of largest empty rectangles, so a Window is placed wherever it fits in both dimensions.
+
+ Windows are placed on the first Display they fit on, at the top-most then left-most position.
+ The layout depends only on the Displays, occupied areas and sizes of the Windows, so is deterministic.
+ All rectangles are in the same co-ordinate space as the Display bounds, with the origin at the top left.
+ */
+@interface FBSimulatorWindowPacker : NSObject
+
+/**
+ Creates and returns a new Packer.
+
+ @param displayBounds an NSArray<NSValue<CGRect>> of the bounds of the Displays to pack into, in order of preference.
+ @param margin the minimum gap between Windows. No gap is left at the edge of a Display.
+ @return a new Packer.
+ */
++ (instancetype)packerWithDisplayBounds:(NSArray *)displayBounds margin:(CGFloat)margin;
+
+/**
+ An NSArray<NSValue<CGRect>> of the bounds of the Displays.
+ */
+@property (nonatomic, copy, readonly) NSArray *displayBounds;
+
+/**
+ The minimum gap between Windows.
+ */
+@property (nonatomic, assign, readonly) CGFloat margin;
+
+/**
+ An NSArray<NSValue<CGRect>> of the maximal free rectangles, including the margin to the right and bottom of each one.
+ */
+@property (nonatomic, copy, readonly) NSArray *freeRects;
+
+/**
+ Marks an area as occupied, such as by an existing Window.
+
+ @param rect the area to mark as occupied.
+ */
+- (void)occupyRect:(CGRect)rect;
+
+/**
+ Places a Window, marking the area it occupies.
+
+ @param windowSize the size of the Window to place.
+ @return the position of the Window, or CGRectNull if there is no room for it.
+ */
+- (CGRect)placeWindowOfSize:(CGSize)windowSize;
+
+@end
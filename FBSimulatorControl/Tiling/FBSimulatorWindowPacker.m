@@ -0,0 +1,194 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "FBSimulatorWindowPacker.h"
+
+static inline BOOL FBRectsOverlap(CGRect first, CGRect second)
+{
+  // Rectangles that only share an edge do not overlap.
+  return CGRectGetMinX(first) < CGRectGetMaxX(second) && CGRectGetMaxX(first) > CGRectGetMinX(second)
+      && CGRectGetMinY(first) < CGRectGetMaxY(second) && CGRectGetMaxY(first) > CGRectGetMinY(second);
+}
+
+@interface FBSimulatorWindowPacker ()
+
+@property (nonatomic, strong, readonly) NSArray *freeRectsByDisplay;
+
+@end
+
+@implementation FBSimulatorWindowPacker
+
+#pragma mark Initializers
+
++ (instancetype)packerWithDisplayBounds:(NSArray *)displayBounds margin:(CGFloat)margin
+{
+  return [[self alloc] initWithDisplayBounds:displayBounds margin:margin];
+}
+
+- (instancetype)initWithDisplayBounds:(NSArray *)displayBounds margin:(CGFloat)margin
+{
+  NSParameterAssert(displayBounds.count > 0);
+  NSParameterAssert(margin >= 0);
+
+  self = [super init];
+  if (!self) {
+    return nil;
+  }
+
+  _displayBounds = [displayBounds copy];
+  _margin = margin;
+
+  // Every rectangle is extended by the margin to the right and bottom, including the Displays.
+  // This leaves a gap of the margin between Windows, but not between a Window and the edge of a Display.
+  NSMutableArray *freeRectsByDisplay = [NSMutableArray array];
+  for (NSValue *value in displayBounds) {
+    [freeRectsByDisplay addObject:[NSMutableArray arrayWithObject:[NSValue valueWithRect:[self paddedRect:value.rectValue]]]];
+  }
+  _freeRectsByDisplay = [freeRectsByDisplay copy];
+
+  return self;
+}
+
+#pragma mark Public
+
+- (NSArray *)freeRects
+{
+  NSMutableArray *freeRects = [NSMutableArray array];
+  for (NSArray *displayFreeRects in self.freeRectsByDisplay) {
+    [freeRects addObjectsFromArray:displayFreeRects];
+  }
+  return [freeRects copy];
+}
+
+- (void)occupyRect:(CGRect)rect
+{
+  if (CGRectIsNull(rect) || CGRectIsEmpty(rect)) {
+    return;
+  }
+  CGRect paddedRect = [self paddedRect:rect];
+  for (NSMutableArray *displayFreeRects in self.freeRectsByDisplay) {
+    [self.class splitFreeRects:displayFreeRects aroundRect:paddedRect];
+  }
+}
+
+- (CGRect)placeWindowOfSize:(CGSize)windowSize
+{
+  if (windowSize.width <= 0 || windowSize.height <= 0) {
+    return CGRectNull;
+  }
+  CGSize paddedSize = CGSizeMake(windowSize.width + self.margin, windowSize.height + self.margin);
+
+  for (NSMutableArray *displayFreeRects in self.freeRectsByDisplay) {
+    // The top-most, then left-most free rectangle that the Window fits in.
+    CGRect best = CGRectNull;
+    for (NSValue *value in displayFreeRects) {
+      CGRect freeRect = value.rectValue;
+      if (CGRectGetWidth(freeRect) < paddedSize.width || CGRectGetHeight(freeRect) < paddedSize.height) {
+        continue;
+      }
+      if (CGRectIsNull(best) ||
+          CGRectGetMinY(freeRect) < CGRectGetMinY(best) ||
+          (CGRectGetMinY(freeRect) == CGRectGetMinY(best) && CGRectGetMinX(freeRect) < CGRectGetMinX(best))) {
+        best = freeRect;
+      }
+    }
+    if (CGRectIsNull(best)) {
+      continue;
+    }
+
+    // The extended edge of one Display may overlap the next, so only the Display that is placed into is split.
+    [self.class splitFreeRects:displayFreeRects aroundRect:(CGRect) {best.origin, paddedSize}];
+    return (CGRect) {best.origin, windowSize};
+  }
+  return CGRectNull;
+}
+
+#pragma mark NSObject
+
+- (NSString *)description
+{
+  return [NSString stringWithFormat:
+    @"Window Packer | %lu Displays | Margin %.0f | %lu Free Rects",
+    (unsigned long) self.displayBounds.count,
+    self.margin,
+    (unsigned long) self.freeRects.count
+  ];
+}
+
+#pragma mark Private
+
+- (CGRect)paddedRect:(CGRect)rect
+{
+  return CGRectMake(CGRectGetMinX(rect), CGRectGetMinY(rect), CGRectGetWidth(rect) + self.margin, CGRectGetHeight(rect) + self.margin);
+}
+
++ (void)splitFreeRects:(NSMutableArray *)freeRects aroundRect:(CGRect)usedRect
+{
+  // Each free rectangle that overlaps is replaced by the up-to-four largest rectangles around the used rectangle.
+  NSMutableArray *splitRects = [NSMutableArray array];
+  for (NSValue *value in freeRects) {
+    CGRect freeRect = value.rectValue;
+    if (!FBRectsOverlap(freeRect, usedRect)) {
+      [splitRects addObject:value];
+      continue;
+    }
+    if (CGRectGetMinX(usedRect) > CGRectGetMinX(freeRect)) {
+      [splitRects addObject:[NSValue valueWithRect:CGRectMake(
+        CGRectGetMinX(freeRect),
+        CGRectGetMinY(freeRect),
+        CGRectGetMinX(usedRect) - CGRectGetMinX(freeRect),
+        CGRectGetHeight(freeRect)
+      )]];
+    }
+    if (CGRectGetMaxX(usedRect) < CGRectGetMaxX(freeRect)) {
+      [splitRects addObject:[NSValue valueWithRect:CGRectMake(
+        CGRectGetMaxX(usedRect),
+        CGRectGetMinY(freeRect),
+        CGRectGetMaxX(freeRect) - CGRectGetMaxX(usedRect),
+        CGRectGetHeight(freeRect)
+      )]];
+    }
+    if (CGRectGetMinY(usedRect) > CGRectGetMinY(freeRect)) {
+      [splitRects addObject:[NSValue valueWithRect:CGRectMake(
+        CGRectGetMinX(freeRect),
+        CGRectGetMinY(freeRect),
+        CGRectGetWidth(freeRect),
+        CGRectGetMinY(usedRect) - CGRectGetMinY(freeRect)
+      )]];
+    }
+    if (CGRectGetMaxY(usedRect) < CGRectGetMaxY(freeRect)) {
+      [splitRects addObject:[NSValue valueWithRect:CGRectMake(
+        CGRectGetMinX(freeRect),
+        CGRectGetMaxY(usedRect),
+        CGRectGetWidth(freeRect),
+        CGRectGetMaxY(freeRect) - CGRectGetMaxY(usedRect)
+      )]];
+    }
+  }
+
+  // Rectangles contained within another are redundant. Of identical rectangles, the first is kept.
+  NSMutableIndexSet *redundant = [NSMutableIndexSet indexSet];
+  for (NSUInteger index = 0; index < splitRects.count; index++) {
+    CGRect rect = [splitRects[index] rectValue];
+    for (NSUInteger otherIndex = 0; otherIndex < splitRects.count; otherIndex++) {
+      if (index == otherIndex || [redundant containsIndex:otherIndex]) {
+        continue;
+      }
+      CGRect otherRect = [splitRects[otherIndex] rectValue];
+      if (CGRectContainsRect(otherRect, rect) && (!CGRectEqualToRect(otherRect, rect) || otherIndex < index)) {
+        [redundant addIndex:index];
+        break;
+      }
+    }
+  }
+  [splitRects removeObjectsAtIndexes:redundant];
+  [freeRects setArray:splitRects];
+}
+
+@end
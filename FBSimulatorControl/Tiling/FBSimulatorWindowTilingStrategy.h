@@ -49,4 +49,24 @@
  */
 + (id<FBSimulatorWindowTilingStrategy>)isolatedRegionStrategyWithOffset:(NSInteger)offset total:(NSInteger)total;
 
+/**
+ A Strategy that packs windows in two dimensions around the windows of Simulators other than the 'target', across all active Displays.
+ Unlike the horizontal strategy, windows of mixed sizes are placed in rows, using the vertical space of each Display.
+
+ @param targetSimulator the existing Simulator to place. Simulators other than the 'targetSimulator' will be considered occluded areas.
+ @param margin the minimum gap between windows.
+ @return a Window Tiling Strategy
+ */
++ (id<FBSimulatorWindowTilingStrategy>)packingStrategy:(FBSimulator *)targetSimulator margin:(CGFloat)margin;
+
+/**
+ A Strategy that packs windows in two dimensions around fixed occupied areas.
+
+ @param displayBounds an NSArray<NSValue<CGRect>> of the bounds of the Displays to pack into, in order of preference. If nil, the screen size that is provided on placement is used.
+ @param occupiedBounds an NSArray<NSValue<CGRect>> of the bounds of areas that are occupied.
+ @param margin the minimum gap between windows.
+ @return a Window Tiling Strategy
+ */
++ (id<FBSimulatorWindowTilingStrategy>)packingStrategyWithDisplayBounds:(NSArray *)displayBounds occupiedBounds:(NSArray *)occupiedBounds margin:(CGFloat)margin;
+
 @end
@@ -12,6 +12,7 @@
 #import "FBSimulator.h"
 #import "FBSimulatorError.h"
 #import "FBSimulatorWindowHelpers.h"
+#import "FBSimulatorWindowPacker.h"
 
 static inline NSRange FBHorizontalOcclusionRange(CGRect rect)
 {
@@ -78,6 +79,43 @@ static inline NSRange FBHorizontalOcclusionRange(CGRect rect)
 
 @end
 
+@interface FBWindowTilingStrategy_Packing : NSObject <FBSimulatorWindowTilingStrategy>
+
+@property (nonatomic, strong, readwrite) FBSimulator *targetSimulator;
+@property (nonatomic, copy, readwrite) NSArray *displayBounds;
+@property (nonatomic, copy, readwrite) NSArray *occupiedBounds;
+@property (nonatomic, assign, readwrite) CGFloat margin;
+
+@end
+
+@implementation FBWindowTilingStrategy_Packing
+
+- (CGRect)targetPositionOfWindowWithSize:(CGSize)windowSize inScreenSize:(CGSize)screenSize withError:(NSError **)error
+{
+  NSArray *displayBounds = self.displayBounds;
+  NSArray *occupiedBounds = self.occupiedBounds ?: @[];
+  if (self.targetSimulator) {
+    displayBounds = [FBSimulatorWindowHelpers boundsOfActiveDisplays];
+    occupiedBounds = [FBSimulatorWindowHelpers obtainBoundsOfOtherSimulators:self.targetSimulator];
+  }
+  if (displayBounds.count == 0) {
+    displayBounds = @[[NSValue valueWithRect:(CGRect) {CGPointZero, screenSize}]];
+  }
+
+  // The packing is recalculated from the occupied areas each time, so that windows that have since closed are reclaimed.
+  FBSimulatorWindowPacker *packer = [FBSimulatorWindowPacker packerWithDisplayBounds:displayBounds margin:self.margin];
+  for (NSValue *value in occupiedBounds) {
+    [packer occupyRect:value.rectValue];
+  }
+  CGRect rect = [packer placeWindowOfSize:windowSize];
+  if (CGRectIsNull(rect)) {
+    return [[FBSimulatorError describeFormat:@"No room to place a window of size %@ around %lu occupied areas", NSStringFromSize(windowSize), (unsigned long) occupiedBounds.count] failRect:error];
+  }
+  return rect;
+}
+
+@end
+
 @implementation FBSimulatorWindowTilingStrategy
 
 + (id<FBSimulatorWindowTilingStrategy>)horizontalOcclusionStrategy:(FBSimulator *)targetSimulator;
@@ -95,4 +133,23 @@ static inline NSRange FBHorizontalOcclusionRange(CGRect rect)
   return strategy;
 }
 
++ (id<FBSimulatorWindowTilingStrategy>)packingStrategy:(FBSimulator *)targetSimulator margin:(CGFloat)margin
+{
+  NSParameterAssert(targetSimulator);
+
+  FBWindowTilingStrategy_Packing *strategy = [FBWindowTilingStrategy_Packing new];
+  strategy.targetSimulator = targetSimulator;
+  strategy.margin = margin;
+  return strategy;
+}
+
++ (id<FBSimulatorWindowTilingStrategy>)packingStrategyWithDisplayBounds:(NSArray *)displayBounds occupiedBounds:(NSArray *)occupiedBounds margin:(CGFloat)margin
+{
+  FBWindowTilingStrategy_Packing *strategy = [FBWindowTilingStrategy_Packing new];
+  strategy.displayBounds = displayBounds;
+  strategy.occupiedBounds = occupiedBounds;
+  strategy.margin = margin;
+  return strategy;
+}
+
 @end
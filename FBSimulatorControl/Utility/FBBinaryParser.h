@@ -10,10 +10,123 @@
 #import <Foundation/Foundation.h>
 
 /**
- Parsers the Mach-O Header of a binary.
+ A single architecture slice of a Mach-O Binary.
+ */
+@interface FBMachOSlice : NSObject <NSCopying>
+
+/**
+ The Architecture Name of the slice, such as 'x86_64' or 'arm64'. nil if the CPU Type is not known.
+ */
+@property (nonatomic, copy, readonly) NSString *architecture;
+
+/**
+ The CPU Type and Subtype from the Mach Header.
+ */
+@property (nonatomic, assign, readonly) int32_t cpuType;
+@property (nonatomic, assign, readonly) int32_t cpuSubtype;
+
+/**
+ The File Type from the Mach Header, such as MH_EXECUTE or MH_DYLIB.
+ */
+@property (nonatomic, assign, readonly) uint32_t fileType;
+
+/**
+ YES if the slice has a 64-Bit Mach Header.
+ */
+@property (nonatomic, assign, readonly) BOOL is64Bit;
+
+/**
+ The offset and size of the slice within the file.
+ */
+@property (nonatomic, assign, readonly) uint64_t offset;
+@property (nonatomic, assign, readonly) uint64_t size;
+
+/**
+ The UUID from LC_UUID, nil if there is none.
+ */
+@property (nonatomic, copy, readonly) NSUUID *uuid;
+
+/**
+ The Platform from the Version Load Commands, such as 'ios' or 'macos'. nil if there is none.
+ */
+@property (nonatomic, copy, readonly) NSString *platform;
+
+/**
+ The Minimum OS and SDK Versions from the Version Load Commands, such as '9.0'. nil if there are none.
+ */
+@property (nonatomic, copy, readonly) NSString *minimumOSVersion;
+@property (nonatomic, copy, readonly) NSString *sdkVersion;
+
+/**
+ An NSArray<NSString *> of the install names of linked dylibs, in load command order.
+ */
+@property (nonatomic, copy, readonly) NSArray *linkedDylibs;
+
+/**
+ An NSArray<NSString *> of the runpath search paths, in load command order.
+ */
+@property (nonatomic, copy, readonly) NSArray *rpaths;
+
+/**
+ YES if the slice has an LC_CODE_SIGNATURE load command.
+ */
+@property (nonatomic, assign, readonly) BOOL hasCodeSignature;
+
+/**
+ YES if the slice has encryption info, YES in isEncrypted if the encryption is active.
+ */
+@property (nonatomic, assign, readonly) BOOL hasEncryptionInfo;
+@property (nonatomic, assign, readonly) BOOL isEncrypted;
+
+@end
+
+/**
+ A parsed Mach-O Binary, which may be thin or fat.
+ */
+@interface FBMachOBinary : NSObject <NSCopying>
+
+/**
+ YES if the Binary has a Fat Header.
+ */
+@property (nonatomic, assign, readonly) BOOL isFat;
+
+/**
+ An NSArray<FBMachOSlice *> of the slices in the Binary.
+ */
+@property (nonatomic, copy, readonly) NSArray *slices;
+
+/**
+ An NSSet<NSString *> of the known architectures of all slices.
+ */
+@property (nonatomic, copy, readonly) NSSet *architectures;
+
+@end
+
+/**
+ Parses Mach-O Binaries.
+ The file is memory-mapped, and all reads are bounds checked, so malformed binaries result in an error.
+ The parser has no dependency upon the host's Mach-O headers.
  */
 @interface FBBinaryParser : NSObject
 
+/**
+ Parses the Mach-O Binary at the given path.
+
+ @param binaryPath the Path of the Binary to parse.
+ @param error an error out for any error that occurred.
+ @return a Binary if successful, nil otherwise.
+ */
++ (FBMachOBinary *)binaryAtPath:(NSString *)binaryPath error:(NSError **)error;
+
+/**
+ Parses the Mach-O Binary from in-memory Data.
+
+ @param data the data of the Binary.
+ @param error an error out for any error that occurred.
+ @return a Binary if successful, nil otherwise.
+ */
++ (FBMachOBinary *)binaryFromData:(NSData *)data error:(NSError **)error;
+
 /**
  Parses the Mach-O Header of a binary, returning a set of archs.
 
@@ -9,181 +9,493 @@
 
 #import "FBBinaryParser.h"
 
-#include <mach/machine.h>
-#include <stdio.h>
-
-#include <mach-o/fat.h>
-#include <mach-o/loader.h>
-#include <mach-o/swap.h>
+#include <string.h>
 
 #import "FBSimulatorError.h"
 
-static inline NSString *ArchitectureForCPUType(cpu_type_t cpuType)
+// The Mach-O constants are defined here, rather than taken from <mach-o/loader.h>, so that parsing works on any host.
+static uint32_t const FBMachOMagic32 = 0xfeedface;
+static uint32_t const FBMachOCigam32 = 0xcefaedfe;
+static uint32_t const FBMachOMagic64 = 0xfeedfacf;
+static uint32_t const FBMachOCigam64 = 0xcffaedfe;
+static uint32_t const FBMachOFatMagic = 0xcafebabe;
+static uint32_t const FBMachOFatCigam = 0xbebafeca;
+static uint32_t const FBMachOFatMagic64 = 0xcafebabf;
+static uint32_t const FBMachOFatCigam64 = 0xbfbafeca;
+
+static uint64_t const FBMachOHeaderSize32 = 28;
+static uint64_t const FBMachOHeaderSize64 = 32;
+static uint64_t const FBMachOFatHeaderSize = 8;
+static uint64_t const FBMachOFatArchSize32 = 20;
+static uint64_t const FBMachOFatArchSize64 = 32;
+static uint64_t const FBMachOLoadCommandSize = 8;
+
+static uint32_t const FBMachORequiresDYLD = 0x80000000;
+static uint32_t const FBMachOLoadCommandLoadDylib = 0xc;
+static uint32_t const FBMachOLoadCommandUUID = 0x1b;
+static uint32_t const FBMachOLoadCommandCodeSignature = 0x1d;
+static uint32_t const FBMachOLoadCommandLoadWeakDylib = 0x18 | FBMachORequiresDYLD;
+static uint32_t const FBMachOLoadCommandRPath = 0x1c | FBMachORequiresDYLD;
+static uint32_t const FBMachOLoadCommandReexportDylib = 0x1f | FBMachORequiresDYLD;
+static uint32_t const FBMachOLoadCommandLazyLoadDylib = 0x20;
+static uint32_t const FBMachOLoadCommandEncryptionInfo = 0x21;
+static uint32_t const FBMachOLoadCommandLoadUpwardDylib = 0x23 | FBMachORequiresDYLD;
+static uint32_t const FBMachOLoadCommandVersionMinMacOSX = 0x24;
+static uint32_t const FBMachOLoadCommandVersionMinIPhoneOS = 0x25;
+static uint32_t const FBMachOLoadCommandEncryptionInfo64 = 0x2c;
+static uint32_t const FBMachOLoadCommandVersionMinTVOS = 0x2f;
+static uint32_t const FBMachOLoadCommandVersionMinWatchOS = 0x30;
+static uint32_t const FBMachOLoadCommandBuildVersion = 0x32;
+
+static int32_t const FBMachOCPUArch64 = 0x01000000;
+static int32_t const FBMachOCPUTypeX86 = 7;
+static int32_t const FBMachOCPUTypeARM = 12;
+
+/**
+ A bounds-checked view onto a region of a mapped file.
+ */
+typedef struct {
+  const uint8_t *bytes;
+  uint64_t length;
+  BOOL swap;
+} FBMachOReader;
+
+static inline BOOL ReadUInt32(FBMachOReader reader, uint64_t offset, uint32_t *value)
 {
-  NSDictionary *lookup = @{
-    @(CPU_TYPE_I386) : @"i386",
-    @(CPU_TYPE_X86_64) : @"x86_64",
-    @(CPU_TYPE_ARM) : @"arm" ,
-    @(CPU_TYPE_ARM64) : @"arm64"
-  };
-  return lookup[@(cpuType)];
+  if (offset > reader.length || reader.length - offset < sizeof(uint32_t)) {
+    return NO;
+  }
+  uint32_t raw = 0;
+  memcpy(&raw, reader.bytes + offset, sizeof(uint32_t));
+  *value = reader.swap ? __builtin_bswap32(raw) : raw;
+  return YES;
 }
 
-static inline NSString *MagicNameForMagic(uint32_t magic)
+static inline BOOL ReadUInt64(FBMachOReader reader, uint64_t offset, uint64_t *value)
 {
-  NSDictionary *lookup = @{
-    @(MH_MAGIC) : @"MH_MAGIC",
-    @(MH_CIGAM) : @"MH_CIGAM",
-    @(MH_MAGIC_64) : @"MH_MAGIC_64",
-    @(MH_CIGAM_64) : @"MH_CIGAM_64",
-    @(FAT_MAGIC) : @"FAT_MAGIC",
-    @(FAT_CIGAM) : @"FAT_CIGAM"
-  };
-  return lookup[@(magic)];
+  if (offset > reader.length || reader.length - offset < sizeof(uint64_t)) {
+    return NO;
+  }
+  uint64_t raw = 0;
+  memcpy(&raw, reader.bytes + offset, sizeof(uint64_t));
+  *value = reader.swap ? __builtin_bswap64(raw) : raw;
+  return YES;
 }
 
-static inline BOOL IsMagic32(uint32_t magic)
+static inline BOOL IsThinMagic(uint32_t magic)
 {
-  return magic == MH_MAGIC || magic == MH_CIGAM;
+  return magic == FBMachOMagic32 || magic == FBMachOCigam32 || magic == FBMachOMagic64 || magic == FBMachOCigam64;
 }
 
-static inline BOOL IsMagic64(uint32_t magic)
+static inline BOOL IsFatMagic(uint32_t magic)
 {
-  return magic == MH_MAGIC_64 || magic == MH_CIGAM_64;
+  return magic == FBMachOFatMagic || magic == FBMachOFatCigam || magic == FBMachOFatMagic64 || magic == FBMachOFatCigam64;
 }
 
-static inline BOOL IsFatMagic(uint32_t magic)
+static inline NSString *ArchitectureForCPUType(int32_t cpuType)
 {
-  return magic == FAT_MAGIC || magic == FAT_CIGAM;
+  switch (cpuType) {
+    case FBMachOCPUTypeX86:
+      return @"i386";
+    case FBMachOCPUTypeX86 | FBMachOCPUArch64:
+      return @"x86_64";
+    case FBMachOCPUTypeARM:
+      return @"arm";
+    case FBMachOCPUTypeARM | FBMachOCPUArch64:
+      return @"arm64";
+    default:
+      return nil;
+  }
 }
 
-static inline BOOL IsSwap(uint32_t magic)
+static inline NSString *PlatformForBuildVersion(uint32_t platform)
 {
-  return magic == MH_CIGAM || magic == MH_CIGAM_64 || magic == FAT_CIGAM;
+  switch (platform) {
+    case 1:
+      return @"macos";
+    case 2:
+      return @"ios";
+    case 3:
+      return @"tvos";
+    case 4:
+      return @"watchos";
+    case 5:
+      return @"bridgeos";
+    case 6:
+      return @"maccatalyst";
+    case 7:
+      return @"ios-simulator";
+    case 8:
+      return @"tvos-simulator";
+    case 9:
+      return @"watchos-simulator";
+    default:
+      return [NSString stringWithFormat:@"platform-%u", platform];
+  }
 }
 
-static inline BOOL IsMagic(uint32_t magic)
+static inline NSString *PlatformForVersionMinCommand(uint32_t command)
 {
-  return IsMagic32(magic) || IsMagic64(magic) || IsFatMagic(magic);
+  if (command == FBMachOLoadCommandVersionMinMacOSX) {
+    return @"macos";
+  }
+  if (command == FBMachOLoadCommandVersionMinIPhoneOS) {
+    return @"ios";
+  }
+  if (command == FBMachOLoadCommandVersionMinTVOS) {
+    return @"tvos";
+  }
+  return @"watchos";
 }
 
-static inline uint32_t GetMagic(FILE *file)
+static inline NSString *VersionString(uint32_t version)
 {
-  // Get then read from the current position.
-  long position = ftell(file);
-  uint32_t magic;
-  fread(&magic, sizeof(uint32_t), 1, file);
+  uint32_t major = version >> 16;
+  uint32_t minor = (version >> 8) & 0xff;
+  uint32_t patch = version & 0xff;
+  if (patch == 0) {
+    return [NSString stringWithFormat:@"%u.%u", major, minor];
+  }
+  return [NSString stringWithFormat:@"%u.%u.%u", major, minor, patch];
+}
+
+@interface FBMachOSlice ()
+
+@property (nonatomic, copy, readwrite) NSString *architecture;
+@property (nonatomic, assign, readwrite) int32_t cpuType;
+@property (nonatomic, assign, readwrite) int32_t cpuSubtype;
+@property (nonatomic, assign, readwrite) uint32_t fileType;
+@property (nonatomic, assign, readwrite) BOOL is64Bit;
+@property (nonatomic, assign, readwrite) uint64_t offset;
+@property (nonatomic, assign, readwrite) uint64_t size;
+@property (nonatomic, copy, readwrite) NSUUID *uuid;
+@property (nonatomic, copy, readwrite) NSString *platform;
+@property (nonatomic, copy, readwrite) NSString *minimumOSVersion;
+@property (nonatomic, copy, readwrite) NSString *sdkVersion;
+@property (nonatomic, copy, readwrite) NSArray *linkedDylibs;
+@property (nonatomic, copy, readwrite) NSArray *rpaths;
+@property (nonatomic, assign, readwrite) BOOL hasCodeSignature;
+@property (nonatomic, assign, readwrite) BOOL hasEncryptionInfo;
+@property (nonatomic, assign, readwrite) BOOL isEncrypted;
+
+@end
 
-  // Move back to the previous position now we know the magic.
-  fseek(file, position, SEEK_SET);
-  return magic;
+@implementation FBMachOSlice
+
+#pragma mark NSCopying
+
+- (instancetype)copyWithZone:(NSZone *)zone
+{
+  return self;
 }
 
-static inline NSString *ReadArch32(FILE *file, uint32_t magic)
+#pragma mark NSObject
+
+- (NSString *)description
 {
-  struct mach_header header;
-  fread(&header, sizeof(struct mach_header), 1, file);
-  if (IsSwap(magic)) {
-    swap_mach_header(&header, 0);
-  }
-  return ArchitectureForCPUType(header.cputype);
+  return [NSString stringWithFormat:
+    @"Slice %@ | UUID %@ | %@ %@ (SDK %@) | %lu Dylibs | %lu RPaths | Signed %d | Encrypted %d",
+    self.architecture ?: @(self.cpuType),
+    self.uuid.UUIDString,
+    self.platform,
+    self.minimumOSVersion,
+    self.sdkVersion,
+    (unsigned long) self.linkedDylibs.count,
+    (unsigned long) self.rpaths.count,
+    self.hasCodeSignature,
+    self.isEncrypted
+  ];
 }
 
-static inline NSString *ReadArch64(FILE *file, uint32_t magic)
+@end
+
+@interface FBMachOBinary ()
+
+@property (nonatomic, assign, readwrite) BOOL isFat;
+@property (nonatomic, copy, readwrite) NSArray *slices;
+
+@end
+
+@implementation FBMachOBinary
+
+- (NSSet *)architectures
 {
-  struct mach_header_64 header;
-  fread(&header, sizeof(struct mach_header_64), 1, file);
-  if (IsSwap(magic)) {
-    swap_mach_header_64(&header, 0);
+  NSMutableSet *architectures = [NSMutableSet set];
+  for (FBMachOSlice *slice in self.slices) {
+    if (slice.architecture) {
+      [architectures addObject:slice.architecture];
+    }
   }
-  return ArchitectureForCPUType(header.cputype);
+  return [architectures copy];
+}
+
+#pragma mark NSCopying
+
+- (instancetype)copyWithZone:(NSZone *)zone
+{
+  return self;
 }
 
-static inline NSString *ReadArch(FILE *file, uint32_t magic)
+#pragma mark NSObject
+
+- (NSString *)description
+{
+  return [NSString stringWithFormat:@"Mach-O Binary | Fat %d | Slices %@", self.isFat, self.slices];
+}
+
+@end
+
+@implementation FBBinaryParser
+
+#pragma mark Public
+
++ (FBMachOBinary *)binaryAtPath:(NSString *)binaryPath error:(NSError **)error
 {
-  if (IsMagic32(magic)) {
-    return ReadArch32(file, magic);
+  NSError *innerError = nil;
+  NSData *data = [NSData dataWithContentsOfFile:binaryPath options:NSDataReadingMappedAlways error:&innerError];
+  if (!data) {
+    return [[[FBSimulatorError describeFormat:@"Could not map binary at path %@", binaryPath] causedBy:innerError] fail:error];
   }
-  if (IsMagic64(magic)) {
-    return ReadArch64(file, magic);
+  FBMachOBinary *binary = [self binaryFromData:data error:&innerError];
+  if (!binary) {
+    return [[[FBSimulatorError describeFormat:@"Could not parse binary at path %@", binaryPath] causedBy:innerError] fail:error];
   }
-  abort();
+  return binary;
 }
 
-static inline NSArray *ReadArchsFat(FILE *file, uint32_t fatMagic)
++ (FBMachOBinary *)binaryFromData:(NSData *)data error:(NSError **)error
 {
-  // Get the Fat Header.
-  struct fat_header header;
-  fread(&header, sizeof(struct fat_header), 1, file);
-  if (IsSwap(fatMagic)) {
-    swap_fat_header(&header, 0);
+  FBMachOReader reader = {data.bytes, data.length, NO};
+  uint32_t magic = 0;
+  if (!ReadUInt32(reader, 0, &magic)) {
+    return [[FBSimulatorError describeFormat:@"Binary of %lu bytes is too short to contain a magic", (unsigned long) data.length] fail:error];
   }
 
-  NSMutableArray *array = [NSMutableArray array];
-  long fatArchPosition = sizeof(struct fat_header);
-  for (uint32_t index = 0; index < header.nfat_arch; index++) {
-    // Seek-to then get the Fat Arch info
-    fseek(file, fatArchPosition, SEEK_SET);
-    struct fat_arch fatArch;
-    fread(&fatArch, sizeof(struct fat_arch), 1, file);
-    if (IsSwap(fatMagic)) {
-      swap_fat_arch(&fatArch, 1, 0);
-    }
-
-    // Seek to the start position of the arch
-    fseek(file, fatArch.offset, SEEK_SET);
-    uint32_t magic = GetMagic(file);
-    if (!IsMagic(magic)){
+  FBMachOBinary *binary = [FBMachOBinary new];
+  if (IsThinMagic(magic)) {
+    FBMachOSlice *slice = [self sliceFromReader:reader offset:0 error:error];
+    if (!slice) {
       return nil;
     }
-
-    // Get the Arch
-    NSString *arch = ReadArch(file, magic);
-    if (!arch) {
+    binary.slices = @[slice];
+    return binary;
+  }
+  if (IsFatMagic(magic)) {
+    NSArray *slices = [self slicesFromFatReader:reader magic:magic error:error];
+    if (!slices) {
       return nil;
     }
-    [array addObject:arch];
-    fatArchPosition += sizeof(struct fat_arch);
+    binary.isFat = YES;
+    binary.slices = slices;
+    return binary;
   }
+  return [[FBSimulatorError describeFormat:@"Could not interpret magic '0x%08x'", magic] fail:error];
+}
 
-  return [array copy];
++ (NSSet *)architecturesForBinaryAtPath:(NSString *)binaryPath error:(NSError **)error
+{
+  return [[self binaryAtPath:binaryPath error:error] architectures];
 }
 
-static inline NSArray *ReadArchs(FILE *file, uint32_t magic)
+#pragma mark Private
+
++ (NSArray *)slicesFromFatReader:(FBMachOReader)reader magic:(uint32_t)magic error:(NSError **)error
 {
-  if (IsFatMagic(magic)) {
-    return ReadArchsFat(file, magic);
+  // Fat Headers are always big-endian.
+  reader.swap = magic == FBMachOFatCigam || magic == FBMachOFatCigam64;
+  BOOL is64 = magic == FBMachOFatMagic64 || magic == FBMachOFatCigam64;
+  uint64_t archSize = is64 ? FBMachOFatArchSize64 : FBMachOFatArchSize32;
+
+  uint32_t archCount = 0;
+  if (!ReadUInt32(reader, 4, &archCount)) {
+    return [[FBSimulatorError describe:@"Fat Header is truncated"] fail:error];
   }
-  if (IsMagic32(magic) || IsMagic64(magic)) {
-    NSString *arch = IsMagic32(magic) ? ReadArch32(file, magic) : ReadArch64(file, magic);
-    return arch ? @[arch] : @[];
+  if (archCount == 0 || (reader.length - FBMachOFatHeaderSize) / archSize < archCount) {
+    return [[FBSimulatorError describeFormat:@"Fat Header declares %u archs, which do not fit in %llu bytes", archCount, reader.length] fail:error];
   }
-  abort();
-}
 
-@implementation FBBinaryParser
+  NSMutableArray *slices = [NSMutableArray array];
+  for (uint32_t index = 0; index < archCount; index++) {
+    uint64_t archOffset = FBMachOFatHeaderSize + index * archSize;
+    uint64_t sliceOffset = 0;
+    uint64_t sliceSize = 0;
+    if (is64) {
+      ReadUInt64(reader, archOffset + 8, &sliceOffset);
+      ReadUInt64(reader, archOffset + 16, &sliceSize);
+    } else {
+      uint32_t offset32 = 0;
+      uint32_t size32 = 0;
+      ReadUInt32(reader, archOffset + 8, &offset32);
+      ReadUInt32(reader, archOffset + 12, &size32);
+      sliceOffset = offset32;
+      sliceSize = size32;
+    }
+    if (sliceOffset > reader.length || reader.length - sliceOffset < sliceSize) {
+      return [[FBSimulatorError describeFormat:@"Fat Arch %u at offset %llu of size %llu extends beyond the end of the file", index, sliceOffset, sliceSize] fail:error];
+    }
 
-+ (NSSet *)architecturesForBinaryAtPath:(NSString *)binaryPath error:(NSError **)error
+    FBMachOReader sliceReader = {reader.bytes + sliceOffset, sliceSize, NO};
+    NSError *innerError = nil;
+    FBMachOSlice *slice = [self sliceFromReader:sliceReader offset:sliceOffset error:&innerError];
+    if (!slice) {
+      return [[[FBSimulatorError describeFormat:@"Could not parse Fat Arch %u", index] causedBy:innerError] fail:error];
+    }
+    [slices addObject:slice];
+  }
+  return [slices copy];
+}
+
++ (FBMachOSlice *)sliceFromReader:(FBMachOReader)reader offset:(uint64_t)offset error:(NSError **)error
 {
-  FILE *file = fopen(binaryPath.UTF8String, "rb");
+  uint32_t magic = 0;
+  if (!ReadUInt32(reader, 0, &magic) || !IsThinMagic(magic)) {
+    return [[FBSimulatorError describeFormat:@"Slice at offset %llu does not have a Mach-O magic", offset] fail:error];
+  }
+  reader.swap = magic == FBMachOCigam32 || magic == FBMachOCigam64;
+  BOOL is64 = magic == FBMachOMagic64 || magic == FBMachOCigam64;
+  uint64_t headerSize = is64 ? FBMachOHeaderSize64 : FBMachOHeaderSize32;
+  if (reader.length < headerSize) {
+    return [[FBSimulatorError describeFormat:@"Mach Header at offset %llu is truncated", offset] fail:error];
+  }
+
+  uint32_t cpuType = 0, cpuSubtype = 0, fileType = 0, commandCount = 0, commandsSize = 0;
+  ReadUInt32(reader, 4, &cpuType);
+  ReadUInt32(reader, 8, &cpuSubtype);
+  ReadUInt32(reader, 12, &fileType);
+  ReadUInt32(reader, 16, &commandCount);
+  ReadUInt32(reader, 20, &commandsSize);
+  if (reader.length - headerSize < commandsSize) {
+    return [[FBSimulatorError describeFormat:@"Load Commands of size %u do not fit in slice of %llu bytes", commandsSize, reader.length] fail:error];
+  }
 
-  // Seek to and read the magic.
-  rewind(file);
-  uint32_t magic = GetMagic(file);
+  FBMachOSlice *slice = [FBMachOSlice new];
+  slice.cpuType = (int32_t) cpuType;
+  slice.cpuSubtype = (int32_t) cpuSubtype;
+  slice.architecture = ArchitectureForCPUType((int32_t) cpuType);
+  slice.fileType = fileType;
+  slice.is64Bit = is64;
+  slice.offset = offset;
+  slice.size = reader.length;
+
+  NSMutableArray *linkedDylibs = [NSMutableArray array];
+  NSMutableArray *rpaths = [NSMutableArray array];
+  uint64_t commandsEnd = headerSize + commandsSize;
+  uint64_t commandOffset = headerSize;
+  for (uint32_t index = 0; index < commandCount; index++) {
+    uint32_t command = 0, commandSize = 0;
+    if (commandsEnd - commandOffset < FBMachOLoadCommandSize) {
+      return [[FBSimulatorError describeFormat:@"Load Command %u of %u is beyond the end of the Load Commands", index, commandCount] fail:error];
+    }
+    ReadUInt32(reader, commandOffset, &command);
+    ReadUInt32(reader, commandOffset + 4, &commandSize);
+    if (commandSize < FBMachOLoadCommandSize || commandsEnd - commandOffset < commandSize) {
+      return [[FBSimulatorError describeFormat:@"Load Command %u has invalid size %u", index, commandSize] fail:error];
+    }
+    FBMachOReader commandReader = {reader.bytes + commandOffset, commandSize, reader.swap};
 
-  if (!IsMagic(magic)) {
-    fclose(file);
-    return [[FBSimulatorError describeFormat:@"Could not interpret magic '%d' in file %@", magic, binaryPath] fail:error];
+    NSError *innerError = nil;
+    if (![self parseCommand:command reader:commandReader slice:slice linkedDylibs:linkedDylibs rpaths:rpaths error:&innerError]) {
+      return [[[FBSimulatorError describeFormat:@"Could not parse Load Command %u (0x%x)", index, command] causedBy:innerError] fail:error];
+    }
+    commandOffset += commandSize;
   }
 
-  NSArray *archs = ReadArchs(file, magic);
-  if (!archs) {
-    fclose(file);
-    return [[FBSimulatorError describeFormat:@"Could not read architechtures of magic %@ in file %@", MagicNameForMagic(magic), binaryPath] fail:error];
+  slice.linkedDylibs = linkedDylibs;
+  slice.rpaths = rpaths;
+  return slice;
+}
+
++ (BOOL)parseCommand:(uint32_t)command reader:(FBMachOReader)reader slice:(FBMachOSlice *)slice linkedDylibs:(NSMutableArray *)linkedDylibs rpaths:(NSMutableArray *)rpaths error:(NSError **)error
+{
+  switch (command) {
+    case FBMachOLoadCommandLoadDylib:
+    case FBMachOLoadCommandLoadWeakDylib:
+    case FBMachOLoadCommandReexportDylib:
+    case FBMachOLoadCommandLazyLoadDylib:
+    case FBMachOLoadCommandLoadUpwardDylib: {
+      NSString *name = [self stringInCommand:reader minimumOffset:24 error:error];
+      if (!name) {
+        return NO;
+      }
+      [linkedDylibs addObject:name];
+      return YES;
+    }
+    case FBMachOLoadCommandRPath: {
+      NSString *path = [self stringInCommand:reader minimumOffset:12 error:error];
+      if (!path) {
+        return NO;
+      }
+      [rpaths addObject:path];
+      return YES;
+    }
+    case FBMachOLoadCommandUUID: {
+      if (reader.length < 24) {
+        return [[FBSimulatorError describe:@"LC_UUID is truncated"] failBool:error];
+      }
+      slice.uuid = [[NSUUID alloc] initWithUUIDBytes:reader.bytes + 8];
+      return YES;
+    }
+    case FBMachOLoadCommandVersionMinMacOSX:
+    case FBMachOLoadCommandVersionMinIPhoneOS:
+    case FBMachOLoadCommandVersionMinTVOS:
+    case FBMachOLoadCommandVersionMinWatchOS: {
+      uint32_t version = 0, sdk = 0;
+      if (!ReadUInt32(reader, 8, &version) || !ReadUInt32(reader, 12, &sdk)) {
+        return [[FBSimulatorError describe:@"Version Min Load Command is truncated"] failBool:error];
+      }
+      slice.platform = PlatformForVersionMinCommand(command);
+      slice.minimumOSVersion = VersionString(version);
+      slice.sdkVersion = VersionString(sdk);
+      return YES;
+    }
+    case FBMachOLoadCommandBuildVersion: {
+      uint32_t platform = 0, version = 0, sdk = 0;
+      if (!ReadUInt32(reader, 8, &platform) || !ReadUInt32(reader, 12, &version) || !ReadUInt32(reader, 16, &sdk)) {
+        return [[FBSimulatorError describe:@"LC_BUILD_VERSION is truncated"] failBool:error];
+      }
+      slice.platform = PlatformForBuildVersion(platform);
+      slice.minimumOSVersion = VersionString(version);
+      slice.sdkVersion = VersionString(sdk);
+      return YES;
+    }
+    case FBMachOLoadCommandCodeSignature: {
+      slice.hasCodeSignature = YES;
+      return YES;
+    }
+    case FBMachOLoadCommandEncryptionInfo:
+    case FBMachOLoadCommandEncryptionInfo64: {
+      uint32_t cryptID = 0;
+      if (!ReadUInt32(reader, 16, &cryptID)) {
+        return [[FBSimulatorError describe:@"Encryption Info Load Command is truncated"] failBool:error];
+      }
+      slice.hasEncryptionInfo = YES;
+      slice.isEncrypted = cryptID != 0;
+      return YES;
+    }
+    default:
+      return YES;
   }
+}
 
-  fclose(file);
-  return [NSSet setWithArray:archs];
++ (NSString *)stringInCommand:(FBMachOReader)reader minimumOffset:(uint32_t)minimumOffset error:(NSError **)error
+{
+  uint32_t stringOffset = 0;
+  if (!ReadUInt32(reader, 8, &stringOffset)) {
+    return [[FBSimulatorError describe:@"Load Command is too short to contain a string offset"] fail:error];
+  }
+  if (stringOffset < minimumOffset || stringOffset >= reader.length) {
+    return [[FBSimulatorError describeFormat:@"String offset %u is outside of the Load Command of size %llu", stringOffset, reader.length] fail:error];
+  }
+  const char *start = (const char *) reader.bytes + stringOffset;
+  size_t length = strnlen(start, (size_t) (reader.length - stringOffset));
+  if (length == reader.length - stringOffset) {
+    return [[FBSimulatorError describe:@"String in Load Command is not terminated"] fail:error];
+  }
+  NSString *string = [[NSString alloc] initWithBytes:start length:length encoding:NSUTF8StringEncoding];
+  if (!string) {
+    return [[FBSimulatorError describe:@"String in Load Command is not valid UTF-8"] fail:error];
+  }
+  return string;
 }
 
 @end
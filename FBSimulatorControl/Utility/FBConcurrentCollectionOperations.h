@@ -30,6 +30,16 @@
  */
 + (NSArray *)map:(NSArray *)array withBlock:( id(^)(id object) )block;
 
+/**
+ Map an array of objects concurrently, with at most `maxConcurrency` invocations of the block in-flight at once.
+ Objects where nil is returned will contain `NSNull.null`
+
+ @param array the array to map.
+ @param maxConcurrency the maximum number of concurrent invocations of the block. Must be greater than zero.
+ @param block the block to map objects with.
+ */
++ (NSArray *)map:(NSArray *)array maxConcurrency:(NSUInteger)maxConcurrency withBlock:( id(^)(id object) )block;
+
 /**
  Map and then filter an array of objects concurrently.
 
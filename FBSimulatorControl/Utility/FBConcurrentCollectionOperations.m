@@ -60,6 +60,35 @@
     }];
 }
 
++ (NSArray *)map:(NSArray *)array maxConcurrency:(NSUInteger)maxConcurrency withBlock:( id(^)(id object) )block
+{
+  NSParameterAssert(maxConcurrency > 0);
+
+  NSMutableArray *output = [NSMutableArray array];
+  for (NSUInteger index = 0; index < array.count; index++) {
+    [output addObject:NSNull.null];
+  }
+
+  dispatch_queue_t queue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_HIGH, 0);
+  dispatch_semaphore_t semaphore = dispatch_semaphore_create((long) maxConcurrency);
+  dispatch_group_t group = dispatch_group_create();
+  for (NSUInteger index = 0; index < array.count; index++) {
+    dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+    dispatch_group_async(group, queue, ^{
+      id object = block(array[index]);
+      if (object) {
+        @synchronized(output) {
+          output[index] = object;
+        }
+      }
+      dispatch_semaphore_signal(semaphore);
+    });
+  }
+  dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+
+  return [output copy];
+}
+
 + (NSArray *)mapFilter:(NSArray *)array map:(id (^)(id))block predicate:(NSPredicate *)predicate
 {
   NSMutableArray *output = [NSMutableArray array];
@@ -0,0 +1,129 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+#include <mach/mach_time.h>
+
+/**
+ An Environment Variable that enables tracing from process start.
+ */
+extern NSString *const FBSimulatorControlTracing;
+
+/**
+ Backing storage for `FBTracerIsEnabled`. Use `+[FBTracer setEnabled:]` to mutate.
+ */
+extern volatile BOOL FBTracerEnabledFlag;
+
+/**
+ A Span that has been started with `FBTraceBegin`.
+ A Span with a zero `start` is inert, so ending it is a no-op.
+ */
+typedef struct {
+  const char *name;
+  const char *category;
+  uint64_t start;
+} FBTraceSpan;
+
+/**
+ Whether tracing is enabled. This is the only cost paid on the hot path when tracing is disabled.
+ */
+static inline BOOL FBTracerIsEnabled(void)
+{
+  return __atomic_load_n(&FBTracerEnabledFlag, __ATOMIC_RELAXED);
+}
+
+/**
+ Begins a Span.
+
+ @param category the category of the span, must be a string with static storage.
+ @param name the name of the span, must be a string with static storage.
+ @return a span, to be passed to `FBTraceEnd`.
+ */
+static inline FBTraceSpan FBTraceBegin(const char *category, const char *name)
+{
+  if (!FBTracerIsEnabled()) {
+    return (FBTraceSpan) {NULL, NULL, 0};
+  }
+  return (FBTraceSpan) {name, category, mach_absolute_time()};
+}
+
+/**
+ Ends a Span, recording it into the calling thread's buffer.
+
+ @param span the span returned from `FBTraceBegin`.
+ @param udid the UDID of the Simulator the span applies to. May be nil.
+ */
+void FBTraceEndWithUDID(FBTraceSpan span, NSString *udid);
+
+/**
+ Ends a Span that does not apply to a specific Simulator.
+ */
+static inline void FBTraceEnd(FBTraceSpan span)
+{
+  if (span.start == 0) {
+    return;
+  }
+  FBTraceEndWithUDID(span, nil);
+}
+
+/**
+ Records timing spans into per-thread buffers and exports them in the Chrome Trace Event Format.
+ This format can be loaded by chrome://tracing and Perfetto.
+
+ Each thread writes to its own fixed-size buffer without locking. Exporting can be done from any thread
+ whilst spans are being recorded. When a thread exits, its buffer is freed and the spans it recorded are kept.
+ Spans recorded when a thread's buffer is full are dropped and counted.
+ */
+@interface FBTracer : NSObject
+
+/**
+ Enables or Disables tracing globally.
+ */
++ (void)setEnabled:(BOOL)enabled;
+
+/**
+ Whether tracing is enabled.
+ */
++ (BOOL)isEnabled;
+
+/**
+ The number of spans that were dropped because a thread's buffer was full.
+ */
++ (NSUInteger)droppedSpanCount;
+
+/**
+ Discards all recorded spans.
+ Must not be called whilst other threads are recording spans.
+ */
++ (void)reset;
+
+/**
+ Returns an NSArray<NSDictionary *> of all the recorded spans as Chrome Trace Events.
+ */
++ (NSArray *)traceEvents;
+
+/**
+ Serializes all recorded spans as a Chrome Trace Event JSON Object.
+
+ @param error an error out for any error that occurred.
+ @return JSON Data if successful, nil otherwise.
+ */
++ (NSData *)chromeTraceJSONWithError:(NSError **)error;
+
+/**
+ Writes all recorded spans as a Chrome Trace Event JSON file.
+
+ @param path the path to write to.
+ @param error an error out for any error that occurred.
+ @return YES if successful, NO otherwise.
+ */
++ (BOOL)writeChromeTraceToPath:(NSString *)path error:(NSError **)error;
+
+@end
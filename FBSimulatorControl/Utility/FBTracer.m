@@ -0,0 +1,284 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "FBTracer.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#import "FBSimulatorError.h"
+
+NSString *const FBSimulatorControlTracing = @"FBSIMULATORCONTROL_TRACE_PATH";
+
+volatile BOOL FBTracerEnabledFlag = NO;
+
+static uint32_t const FBTraceBufferCapacity = 16384;
+
+typedef struct {
+  const char *name;
+  const char *category;
+  uint64_t start;
+  uint64_t end;
+  char udid[40];
+} FBTraceRecord;
+
+typedef struct FBTraceBuffer {
+  struct FBTraceBuffer *next;
+  uint64_t threadID;
+  char threadName[64];
+  BOOL retired;
+  uint32_t capacity;
+  uint32_t count;
+  FBTraceRecord records[];
+} FBTraceBuffer;
+
+static FBTraceBuffer *FBTraceBufferHead = NULL;
+static pthread_mutex_t FBTraceBufferListMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_key_t FBTraceBufferKey;
+static uint64_t FBTraceDroppedCount = 0;
+static __thread FBTraceBuffer *FBTraceCurrentBuffer = NULL;
+
+static FBTraceBuffer *FBTraceBufferAllocate(uint32_t capacity)
+{
+  return calloc(1, sizeof(FBTraceBuffer) + (sizeof(FBTraceRecord) * capacity));
+}
+
+static void FBTraceReplaceBuffer(FBTraceBuffer *buffer, FBTraceBuffer *replacement)
+{
+  // Must be called with the list mutex held.
+  for (FBTraceBuffer **link = &FBTraceBufferHead; *link; link = &(*link)->next) {
+    if (*link != buffer) {
+      continue;
+    }
+    if (replacement) {
+      replacement->next = buffer->next;
+      *link = replacement;
+    } else {
+      *link = buffer->next;
+    }
+    return;
+  }
+}
+
+static void FBTraceRetireBuffer(void *value)
+{
+  // Runs on the exiting thread. The recorded spans are moved into a buffer that is only as large as they are,
+  // so that the full-size buffer is not held on to for the lifetime of the process.
+  FBTraceBuffer *buffer = value;
+  FBTraceCurrentBuffer = NULL;
+
+  uint32_t count = __atomic_load_n(&buffer->count, __ATOMIC_ACQUIRE);
+  FBTraceBuffer *retired = count > 0 ? FBTraceBufferAllocate(count) : NULL;
+  if (retired) {
+    retired->threadID = buffer->threadID;
+    memcpy(retired->threadName, buffer->threadName, sizeof(retired->threadName));
+    retired->retired = YES;
+    retired->capacity = count;
+    retired->count = count;
+    memcpy(retired->records, buffer->records, sizeof(FBTraceRecord) * count);
+  } else if (count > 0) {
+    __atomic_add_fetch(&FBTraceDroppedCount, count, __ATOMIC_RELAXED);
+  }
+
+  pthread_mutex_lock(&FBTraceBufferListMutex);
+  FBTraceReplaceBuffer(buffer, retired);
+  pthread_mutex_unlock(&FBTraceBufferListMutex);
+  free(buffer);
+}
+
+static FBTraceBuffer *FBTraceRegisterCurrentThread(void)
+{
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    pthread_key_create(&FBTraceBufferKey, FBTraceRetireBuffer);
+  });
+
+  FBTraceBuffer *buffer = FBTraceBufferAllocate(FBTraceBufferCapacity);
+  if (!buffer) {
+    return NULL;
+  }
+  buffer->capacity = FBTraceBufferCapacity;
+  pthread_threadid_np(NULL, &buffer->threadID);
+  pthread_getname_np(pthread_self(), buffer->threadName, sizeof(buffer->threadName));
+
+  // Recording does not touch the list, it is only locked when threads come and go or when exporting.
+  pthread_mutex_lock(&FBTraceBufferListMutex);
+  buffer->next = FBTraceBufferHead;
+  FBTraceBufferHead = buffer;
+  pthread_mutex_unlock(&FBTraceBufferListMutex);
+
+  // The destructor frees the buffer when the thread exits.
+  pthread_setspecific(FBTraceBufferKey, buffer);
+  FBTraceCurrentBuffer = buffer;
+  return buffer;
+}
+
+void FBTraceEndWithUDID(FBTraceSpan span, NSString *udid)
+{
+  if (span.start == 0) {
+    return;
+  }
+  uint64_t end = mach_absolute_time();
+
+  FBTraceBuffer *buffer = FBTraceCurrentBuffer ?: FBTraceRegisterCurrentThread();
+  if (!buffer) {
+    __atomic_add_fetch(&FBTraceDroppedCount, 1, __ATOMIC_RELAXED);
+    return;
+  }
+
+  // Only this thread writes to the buffer, the count is published after the record is written.
+  uint32_t index = __atomic_load_n(&buffer->count, __ATOMIC_RELAXED);
+  if (index >= buffer->capacity) {
+    __atomic_add_fetch(&FBTraceDroppedCount, 1, __ATOMIC_RELAXED);
+    return;
+  }
+  FBTraceRecord *record = &buffer->records[index];
+  record->name = span.name;
+  record->category = span.category;
+  record->start = span.start;
+  record->end = end;
+  if (!udid || ![udid getCString:record->udid maxLength:sizeof(record->udid) encoding:NSASCIIStringEncoding]) {
+    record->udid[0] = '\0';
+  }
+  __atomic_store_n(&buffer->count, index + 1, __ATOMIC_RELEASE);
+}
+
+static double FBTraceMicroseconds(uint64_t machTime)
+{
+  static mach_timebase_info_data_t timebase;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    mach_timebase_info(&timebase);
+  });
+  return ((double) machTime * timebase.numer / timebase.denom) / 1000.0;
+}
+
+@implementation FBTracer
+
++ (void)load
+{
+  NSString *tracePath = NSProcessInfo.processInfo.environment[FBSimulatorControlTracing];
+  if (tracePath.length == 0) {
+    return;
+  }
+  [self setEnabled:YES];
+  atexit_b(^{
+    [FBTracer writeChromeTraceToPath:tracePath error:nil];
+  });
+}
+
+#pragma mark Public
+
++ (void)setEnabled:(BOOL)enabled
+{
+  __atomic_store_n(&FBTracerEnabledFlag, enabled, __ATOMIC_RELAXED);
+}
+
++ (BOOL)isEnabled
+{
+  return FBTracerIsEnabled();
+}
+
++ (NSUInteger)droppedSpanCount
+{
+  return (NSUInteger) __atomic_load_n(&FBTraceDroppedCount, __ATOMIC_RELAXED);
+}
+
++ (void)reset
+{
+  pthread_mutex_lock(&FBTraceBufferListMutex);
+  FBTraceBuffer *buffer = FBTraceBufferHead;
+  while (buffer) {
+    FBTraceBuffer *next = buffer->next;
+    if (buffer->retired) {
+      FBTraceReplaceBuffer(buffer, NULL);
+      free(buffer);
+    } else {
+      __atomic_store_n(&buffer->count, 0, __ATOMIC_RELEASE);
+    }
+    buffer = next;
+  }
+  pthread_mutex_unlock(&FBTraceBufferListMutex);
+  __atomic_store_n(&FBTraceDroppedCount, 0, __ATOMIC_RELAXED);
+}
+
++ (NSArray *)traceEvents
+{
+  NSNumber *processIdentifier = @(getpid());
+  NSMutableArray *events = [NSMutableArray array];
+
+  pthread_mutex_lock(&FBTraceBufferListMutex);
+  for (FBTraceBuffer *buffer = FBTraceBufferHead; buffer; buffer = buffer->next) {
+    uint32_t count = __atomic_load_n(&buffer->count, __ATOMIC_ACQUIRE);
+    if (count == 0) {
+      continue;
+    }
+    NSNumber *threadIdentifier = @(buffer->threadID);
+    NSString *threadName = buffer->threadName[0] ? @(buffer->threadName) : [NSString stringWithFormat:@"Thread %llu", buffer->threadID];
+    [events addObject:@{
+      @"name" : @"thread_name",
+      @"ph" : @"M",
+      @"pid" : processIdentifier,
+      @"tid" : threadIdentifier,
+      @"args" : @{@"name" : threadName},
+    }];
+
+    for (uint32_t index = 0; index < count; index++) {
+      FBTraceRecord *record = &buffer->records[index];
+      NSMutableDictionary *arguments = [NSMutableDictionary dictionary];
+      if (record->udid[0]) {
+        arguments[@"udid"] = @(record->udid);
+      }
+      [events addObject:@{
+        @"name" : @(record->name),
+        @"cat" : @(record->category),
+        @"ph" : @"X",
+        @"ts" : @(FBTraceMicroseconds(record->start)),
+        @"dur" : @(FBTraceMicroseconds(record->end - record->start)),
+        @"pid" : processIdentifier,
+        @"tid" : threadIdentifier,
+        @"args" : [arguments copy],
+      }];
+    }
+  }
+  pthread_mutex_unlock(&FBTraceBufferListMutex);
+  return [events copy];
+}
+
++ (NSData *)chromeTraceJSONWithError:(NSError **)error
+{
+  NSDictionary *trace = @{
+    @"traceEvents" : self.traceEvents,
+    @"displayTimeUnit" : @"ms",
+    @"otherData" : @{@"dropped_spans" : @(self.droppedSpanCount)},
+  };
+  NSError *innerError = nil;
+  NSData *data = [NSJSONSerialization dataWithJSONObject:trace options:0 error:&innerError];
+  if (!data) {
+    return [[[FBSimulatorError describe:@"Could not serialize Chrome Trace"] causedBy:innerError] fail:error];
+  }
+  return data;
+}
+
++ (BOOL)writeChromeTraceToPath:(NSString *)path error:(NSError **)error
+{
+  NSError *innerError = nil;
+  NSData *data = [self chromeTraceJSONWithError:&innerError];
+  if (!data) {
+    return [FBSimulatorError failBoolWithError:innerError errorOut:error];
+  }
+  if (![data writeToFile:path options:NSDataWritingAtomic error:&innerError]) {
+    return [[[FBSimulatorError describeFormat:@"Could not write Chrome Trace to %@", path] causedBy:innerError] failBool:error];
+  }
+  return YES;
+}
+
+@end
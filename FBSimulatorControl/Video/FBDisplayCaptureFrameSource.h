@@ -0,0 +1,31 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <CoreGraphics/CoreGraphics.h>
+#import <Foundation/Foundation.h>
+
+#import <FBSimulatorControl/FBSimulatorLogger.h>
+#import <FBSimulatorControl/FBVideoFrameSource.h>
+
+/**
+ A Frame Source that captures the whole of a Display.
+ */
+@interface FBDisplayCaptureFrameSource : NSObject <FBVideoFrameSource>
+
+/**
+ Creates a new Frame Source for the provided Display.
+
+ @param displayID the Display to capture.
+ @param framesPerSecond the maximum rate at which to capture Frames.
+ @param logger a logger to record interactions. May be nil.
+ @return a new Frame Source.
+ */
++ (instancetype)sourceWithDisplayID:(CGDirectDisplayID)displayID framesPerSecond:(NSUInteger)framesPerSecond logger:(id<FBSimulatorLogger>)logger;
+
+@end
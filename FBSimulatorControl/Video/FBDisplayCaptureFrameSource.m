@@ -0,0 +1,120 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "FBDisplayCaptureFrameSource.h"
+
+#import <AVFoundation/AVFoundation.h>
+
+#import "FBSimulatorError.h"
+
+@interface FBDisplayCaptureFrameSource () <AVCaptureVideoDataOutputSampleBufferDelegate>
+
+@property (nonatomic, assign, readonly) CGDirectDisplayID displayID;
+@property (nonatomic, assign, readonly) NSUInteger framesPerSecond;
+@property (nonatomic, strong, readonly) id<FBSimulatorLogger> logger;
+@property (nonatomic, strong, readonly) dispatch_queue_t queue;
+
+@property (nonatomic, strong, readwrite) AVCaptureSession *session;
+@property (nonatomic, strong, readwrite) id<FBVideoFrameConsumer> consumer;
+
+@end
+
+@implementation FBDisplayCaptureFrameSource
+
++ (instancetype)sourceWithDisplayID:(CGDirectDisplayID)displayID framesPerSecond:(NSUInteger)framesPerSecond logger:(id<FBSimulatorLogger>)logger
+{
+  return [[self alloc] initWithDisplayID:displayID framesPerSecond:framesPerSecond logger:logger];
+}
+
+- (instancetype)initWithDisplayID:(CGDirectDisplayID)displayID framesPerSecond:(NSUInteger)framesPerSecond logger:(id<FBSimulatorLogger>)logger
+{
+  NSParameterAssert(framesPerSecond > 0);
+
+  self = [super init];
+  if (!self) {
+    return nil;
+  }
+
+  _displayID = displayID;
+  _framesPerSecond = framesPerSecond;
+  _logger = logger;
+  _queue = dispatch_queue_create("com.facebook.FBSimulatorControl.displaycapture", DISPATCH_QUEUE_SERIAL);
+
+  return self;
+}
+
+#pragma mark FBVideoFrameSource
+
+- (BOOL)startWithConsumer:(id<FBVideoFrameConsumer>)consumer error:(NSError **)error
+{
+  NSParameterAssert(consumer);
+
+  if (self.session) {
+    return [[FBSimulatorError describe:@"Cannot Start Capturing twice"] failBool:error];
+  }
+
+  AVCaptureScreenInput *input = [[AVCaptureScreenInput alloc] initWithDisplayID:self.displayID];
+  if (!input) {
+    return [[FBSimulatorError describeFormat:@"Could not Create Screen input for display id %u", self.displayID] failBool:error];
+  }
+  input.minFrameDuration = CMTimeMake(1, (int32_t) self.framesPerSecond);
+
+  // Frames that arrive whilst the consumer is busy are dropped, rather than queued without bound.
+  AVCaptureVideoDataOutput *output = [[AVCaptureVideoDataOutput alloc] init];
+  output.alwaysDiscardsLateVideoFrames = YES;
+  output.videoSettings = @{(NSString *) kCVPixelBufferPixelFormatTypeKey : @(kCVPixelFormatType_32BGRA)};
+  [output setSampleBufferDelegate:self queue:self.queue];
+
+  AVCaptureSession *session = [[AVCaptureSession alloc] init];
+  if (![session canAddInput:input]) {
+    return [[FBSimulatorError describe:@"Could not add AV Input to the Capture Sesion"] failBool:error];
+  }
+  [session addInput:input];
+  if (![session canAddOutput:output]) {
+    return [[FBSimulatorError describe:@"Could not add AV Output to the Capture Sesion"] failBool:error];
+  }
+  [session addOutput:output];
+
+  dispatch_sync(self.queue, ^{
+    self.consumer = consumer;
+  });
+  self.session = session;
+  [session startRunning];
+  [self.logger logMessage:@"Capturing Display %u at %lu fps", self.displayID, (unsigned long) self.framesPerSecond];
+
+  return YES;
+}
+
+- (void)stop
+{
+  [self.session stopRunning];
+  self.session = nil;
+  // Frames are delivered on the queue, so once the consumer is removed on the queue, no more will be delivered.
+  dispatch_sync(self.queue, ^{
+    self.consumer = nil;
+  });
+}
+
+- (void)dealloc
+{
+  [_session stopRunning];
+}
+
+#pragma mark AVCaptureVideoDataOutputSampleBufferDelegate
+
+- (void)captureOutput:(AVCaptureOutput *)captureOutput didOutputSampleBuffer:(CMSampleBufferRef)sampleBuffer fromConnection:(AVCaptureConnection *)connection
+{
+  CVPixelBufferRef pixelBuffer = CMSampleBufferGetImageBuffer(sampleBuffer);
+  if (!pixelBuffer) {
+    return;
+  }
+  [self.consumer frameSource:self didProduceFrame:pixelBuffer presentationTime:CMSampleBufferGetPresentationTimeStamp(sampleBuffer)];
+}
+
+@end
@@ -0,0 +1,80 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <CoreVideo/CoreVideo.h>
+#import <Foundation/Foundation.h>
+
+/**
+ The default number of tiles along each axis of a Signature.
+ */
+extern NSUInteger const FBFrameSignatureDefaultGridSize;
+
+/**
+ The default sampling of rows for a Signature. Every Nth row is sampled.
+ */
+extern NSUInteger const FBFrameSignatureDefaultRowStride;
+
+/**
+ A cheap fingerprint of a Frame, for detecting whether it has changed.
+ The Frame is divided into a grid of tiles and the mean byte value of each tile is computed, which is equivalent to a heavily downsampled copy of the Frame.
+ Summing contiguous bytes of a row is a plain reduction, so is vectorized by the compiler.
+ */
+@interface FBFrameSignature : NSObject
+
+/**
+ Computes the Signature of a 32-bit Frame with the default grid and sampling.
+
+ @param pixelBuffer the Frame. Must have a 32-bit pixel format, such as BGRA.
+ @return the Signature, or nil if the Frame is not 32-bit.
+ */
++ (instancetype)signatureOfPixelBuffer:(CVPixelBufferRef)pixelBuffer;
+
+/**
+ Computes the Signature of a buffer of 32-bit pixels.
+
+ @param bytes the start of the first row.
+ @param width the width in pixels.
+ @param height the height in pixels.
+ @param bytesPerRow the distance in bytes between the start of each row.
+ @param gridSize the number of tiles along each axis. Clamped to the dimensions of the Frame.
+ @param rowStride the sampling of rows. Every Nth row is sampled.
+ @return the Signature.
+ */
++ (instancetype)signatureOfBytes:(const uint8_t *)bytes width:(NSUInteger)width height:(NSUInteger)height bytesPerRow:(NSUInteger)bytesPerRow gridSize:(NSUInteger)gridSize rowStride:(NSUInteger)rowStride;
+
+/**
+ The width of the Frame in pixels.
+ */
+@property (nonatomic, assign, readonly) NSUInteger width;
+
+/**
+ The height of the Frame in pixels.
+ */
+@property (nonatomic, assign, readonly) NSUInteger height;
+
+/**
+ The number of tiles along the horizontal axis.
+ */
+@property (nonatomic, assign, readonly) NSUInteger gridWidth;
+
+/**
+ The number of tiles along the vertical axis.
+ */
+@property (nonatomic, assign, readonly) NSUInteger gridHeight;
+
+/**
+ The difference between two Signatures: the largest change in the mean byte value of any tile, from 0 to 255.
+ Signatures of Frames with different geometry are maximally different.
+
+ @param signature the Signature to compare to.
+ @return the difference.
+ */
+- (double)differenceFromSignature:(FBFrameSignature *)signature;
+
+@end
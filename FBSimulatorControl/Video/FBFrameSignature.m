@@ -0,0 +1,147 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "FBFrameSignature.h"
+
+NSUInteger const FBFrameSignatureDefaultGridSize = 16;
+NSUInteger const FBFrameSignatureDefaultRowStride = 2;
+
+static NSUInteger const BytesPerPixel = 4;
+
+static inline uint32_t SumBytes(const uint8_t *bytes, NSUInteger length)
+{
+  uint32_t sum = 0;
+  for (NSUInteger index = 0; index < length; index++) {
+    sum += bytes[index];
+  }
+  return sum;
+}
+
+@interface FBFrameSignature ()
+
+@property (nonatomic, copy, readonly) NSData *tileMeans;
+
+@end
+
+@implementation FBFrameSignature
+
+#pragma mark Initializers
+
++ (instancetype)signatureOfPixelBuffer:(CVPixelBufferRef)pixelBuffer
+{
+  OSType format = CVPixelBufferGetPixelFormatType(pixelBuffer);
+  if (format != kCVPixelFormatType_32BGRA && format != kCVPixelFormatType_32ARGB && format != kCVPixelFormatType_32RGBA) {
+    return nil;
+  }
+
+  CVPixelBufferLockBaseAddress(pixelBuffer, kCVPixelBufferLock_ReadOnly);
+  FBFrameSignature *signature = [self
+    signatureOfBytes:CVPixelBufferGetBaseAddress(pixelBuffer)
+    width:CVPixelBufferGetWidth(pixelBuffer)
+    height:CVPixelBufferGetHeight(pixelBuffer)
+    bytesPerRow:CVPixelBufferGetBytesPerRow(pixelBuffer)
+    gridSize:FBFrameSignatureDefaultGridSize
+    rowStride:FBFrameSignatureDefaultRowStride];
+  CVPixelBufferUnlockBaseAddress(pixelBuffer, kCVPixelBufferLock_ReadOnly);
+
+  return signature;
+}
+
++ (instancetype)signatureOfBytes:(const uint8_t *)bytes width:(NSUInteger)width height:(NSUInteger)height bytesPerRow:(NSUInteger)bytesPerRow gridSize:(NSUInteger)gridSize rowStride:(NSUInteger)rowStride
+{
+  NSParameterAssert(bytes);
+  NSParameterAssert(width > 0 && height > 0);
+  NSParameterAssert(bytesPerRow >= width * BytesPerPixel);
+  NSParameterAssert(gridSize > 0);
+  NSParameterAssert(rowStride > 0);
+
+  NSUInteger gridWidth = MIN(gridSize, width);
+  NSUInteger gridHeight = MIN(gridSize, height);
+  NSUInteger tileCount = gridWidth * gridHeight;
+  uint32_t *sums = calloc(tileCount, sizeof(uint32_t));
+  uint32_t *counts = calloc(tileCount, sizeof(uint32_t));
+
+  // Tile boundaries are in bytes from the start of a row, so that each tile of a row is one contiguous run.
+  NSUInteger *columnStarts = calloc(gridWidth + 1, sizeof(NSUInteger));
+  for (NSUInteger column = 0; column <= gridWidth; column++) {
+    columnStarts[column] = (column * width / gridWidth) * BytesPerPixel;
+  }
+
+  for (NSUInteger row = 0; row < height; row += rowStride) {
+    const uint8_t *rowBytes = bytes + (row * bytesPerRow);
+    NSUInteger tileRow = row * gridHeight / height;
+    uint32_t *rowSums = sums + (tileRow * gridWidth);
+    uint32_t *rowCounts = counts + (tileRow * gridWidth);
+    for (NSUInteger column = 0; column < gridWidth; column++) {
+      NSUInteger length = columnStarts[column + 1] - columnStarts[column];
+      rowSums[column] += SumBytes(rowBytes + columnStarts[column], length);
+      rowCounts[column] += (uint32_t) length;
+    }
+  }
+
+  NSMutableData *tileMeans = [NSMutableData dataWithLength:tileCount * sizeof(float)];
+  float *means = tileMeans.mutableBytes;
+  for (NSUInteger tile = 0; tile < tileCount; tile++) {
+    means[tile] = counts[tile] ? (float) sums[tile] / (float) counts[tile] : 0;
+  }
+  free(columnStarts);
+  free(counts);
+  free(sums);
+
+  return [[self alloc] initWithWidth:width height:height gridWidth:gridWidth gridHeight:gridHeight tileMeans:tileMeans];
+}
+
+- (instancetype)initWithWidth:(NSUInteger)width height:(NSUInteger)height gridWidth:(NSUInteger)gridWidth gridHeight:(NSUInteger)gridHeight tileMeans:(NSData *)tileMeans
+{
+  self = [super init];
+  if (!self) {
+    return nil;
+  }
+
+  _width = width;
+  _height = height;
+  _gridWidth = gridWidth;
+  _gridHeight = gridHeight;
+  _tileMeans = [tileMeans copy];
+
+  return self;
+}
+
+#pragma mark Public
+
+- (double)differenceFromSignature:(FBFrameSignature *)signature
+{
+  if (!signature || signature.width != self.width || signature.height != self.height || signature.tileMeans.length != self.tileMeans.length) {
+    return 255;
+  }
+
+  const float *left = self.tileMeans.bytes;
+  const float *right = signature.tileMeans.bytes;
+  NSUInteger tileCount = self.tileMeans.length / sizeof(float);
+  float difference = 0;
+  for (NSUInteger tile = 0; tile < tileCount; tile++) {
+    difference = MAX(difference, fabsf(left[tile] - right[tile]));
+  }
+  return difference;
+}
+
+#pragma mark NSObject
+
+- (NSString *)description
+{
+  return [NSString stringWithFormat:
+    @"Frame Signature %lux%lu | Grid %lux%lu",
+    (unsigned long) self.width,
+    (unsigned long) self.height,
+    (unsigned long) self.gridWidth,
+    (unsigned long) self.gridHeight
+  ];
+}
+
+@end
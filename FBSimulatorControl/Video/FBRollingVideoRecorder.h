@@ -0,0 +1,78 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import <FBSimulatorControl/FBSimulatorLogger.h>
+#import <FBSimulatorControl/FBTerminationHandle.h>
+#import <FBSimulatorControl/FBVideoFrameSource.h>
+
+@class FBSimulator;
+@class FBVideoSegmentRing;
+
+/**
+ Records Video into a rolling buffer of short Segments on disk, keeping only the most recent part of the recording.
+ The last N seconds can then be committed to a standalone movie on demand, such as when a failure occurs.
+
+ Unlike FBSimulatorVideoRecorder, the disk usage is bounded by the retention window rather than the length of the session.
+ */
+@interface FBRollingVideoRecorder : NSObject <FBTerminationHandle>
+
+/**
+ Creates a new Recorder that captures the provided Simulator's window.
+ Frames that are unchanged from the previous Frame are dropped, so that an idle screen costs little to encode and store.
+
+ @param simulator the Simulator to Record.
+ @param retention the number of seconds of the most recent Video to keep.
+ @param logger a logger to record interactions. May be nil.
+ @return a new Recorder.
+ */
++ (instancetype)forSimulator:(FBSimulator *)simulator retention:(NSTimeInterval)retention logger:(id<FBSimulatorLogger>)logger;
+
+/**
+ Creates a new Recorder.
+
+ @param frameSource the Source of the Frames to Record.
+ @param retention the number of seconds of the most recent Video to keep.
+ @param segmentDuration the duration of each Segment. Shorter Segments waste less space beyond the retention window, at the cost of more files.
+ @param directory the directory to write Segments into. Will be created if it does not exist.
+ @param logger a logger to record interactions. May be nil.
+ @return a new Recorder.
+ */
++ (instancetype)recorderWithFrameSource:(id<FBVideoFrameSource>)frameSource retention:(NSTimeInterval)retention segmentDuration:(NSTimeInterval)segmentDuration directory:(NSString *)directory logger:(id<FBSimulatorLogger>)logger;
+
+/**
+ The Ring of completed Segments.
+ */
+@property (nonatomic, strong, readonly) FBVideoSegmentRing *ring;
+
+/**
+ Starts Recording.
+
+ @param error an error out for any error that occurred.
+ @return YES if successful, NO otherwise.
+ */
+- (BOOL)startWithError:(NSError **)error;
+
+/**
+ Writes the most recent Video to a standalone movie file, without interrupting the Recording.
+
+ @param duration the number of seconds to write, counting back from the most recent Frame.
+ @param filePath the path to write the movie to. Any existing file is overwritten.
+ @param error an error out for any error that occurred.
+ @return YES if successful, NO otherwise.
+ */
+- (BOOL)commitLast:(NSTimeInterval)duration toFilePath:(NSString *)filePath error:(NSError **)error;
+
+/**
+ Stops Recording, deleting all Segments.
+ */
+- (void)stop;
+
+@end
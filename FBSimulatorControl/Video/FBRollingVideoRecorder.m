@@ -0,0 +1,122 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "FBRollingVideoRecorder.h"
+
+#import "FBScreenCaptureFrameSource.h"
+#import "FBSimulatorError.h"
+#import "FBVideoFrameDeduplicator.h"
+#import "FBVideoSegment.h"
+#import "FBVideoSegmentMuxer.h"
+#import "FBVideoSegmenter.h"
+
+static NSTimeInterval const FBRollingVideoRecorderDefaultSegmentDuration = 2;
+static NSUInteger const FBRollingVideoRecorderDefaultFramesPerSecond = 30;
+
+@interface FBRollingVideoRecorder () <FBVideoSegmenterDelegate>
+
+@property (nonatomic, copy, readonly) NSString *directory;
+@property (nonatomic, strong, readonly) id<FBSimulatorLogger> logger;
+@property (nonatomic, strong, readonly) FBVideoSegmenter *segmenter;
+
+@end
+
+@implementation FBRollingVideoRecorder
+
+#pragma mark Initializers
+
++ (instancetype)forSimulator:(FBSimulator *)simulator retention:(NSTimeInterval)retention logger:(id<FBSimulatorLogger>)logger
+{
+  id<FBVideoFrameSource> captureSource = [FBScreenCaptureFrameSource forSimulator:simulator framesPerSecond:FBRollingVideoRecorderDefaultFramesPerSecond logger:logger];
+  id<FBVideoFrameSource> frameSource = [FBVideoFrameDeduplicator deduplicatorWithFrameSource:captureSource];
+  NSString *directory = [NSTemporaryDirectory() stringByAppendingPathComponent:[NSString stringWithFormat:@"FBSimulatorControl_RollingVideo_%@", NSUUID.UUID.UUIDString]];
+  return [self recorderWithFrameSource:frameSource retention:retention segmentDuration:FBRollingVideoRecorderDefaultSegmentDuration directory:directory logger:logger];
+}
+
++ (instancetype)recorderWithFrameSource:(id<FBVideoFrameSource>)frameSource retention:(NSTimeInterval)retention segmentDuration:(NSTimeInterval)segmentDuration directory:(NSString *)directory logger:(id<FBSimulatorLogger>)logger
+{
+  return [[self alloc] initWithFrameSource:frameSource retention:retention segmentDuration:segmentDuration directory:directory logger:logger];
+}
+
+- (instancetype)initWithFrameSource:(id<FBVideoFrameSource>)frameSource retention:(NSTimeInterval)retention segmentDuration:(NSTimeInterval)segmentDuration directory:(NSString *)directory logger:(id<FBSimulatorLogger>)logger
+{
+  NSParameterAssert(directory);
+
+  self = [super init];
+  if (!self) {
+    return nil;
+  }
+
+  _ring = [FBVideoSegmentRing ringWithRetention:retention];
+  _directory = [directory copy];
+  _logger = logger;
+  _segmenter = [FBVideoSegmenter segmenterWithFrameSource:frameSource segmentDuration:segmentDuration directory:directory delegate:self logger:logger];
+
+  return self;
+}
+
+#pragma mark Public
+
+- (BOOL)startWithError:(NSError **)error
+{
+  return [self.segmenter startWithError:error];
+}
+
+- (BOOL)commitLast:(NSTimeInterval)duration toFilePath:(NSString *)filePath error:(NSError **)error
+{
+  NSParameterAssert(duration > 0);
+  NSParameterAssert(filePath);
+
+  // The open Segment is cut short, so that the commit includes everything up to the most recent Frame.
+  __block NSError *innerError = nil;
+  if (![self.segmenter cutWithError:&innerError]) {
+    return [[[FBSimulatorError describe:@"Cannot commit a Recording without any Frames"] causedBy:innerError] failBool:error];
+  }
+
+  // Muxing happens on the same queue that appends to the Ring, so Segments cannot be evicted from underneath it.
+  __block BOOL success = NO;
+  dispatch_sync(self.segmenter.queue, ^{
+    NSArray *segments = [self.ring segmentsCoveringLast:duration];
+    NSTimeInterval startTime = [segments.lastObject endTime] - duration;
+    success = [FBVideoSegmentMuxer muxSegments:segments fromTime:startTime toFilePath:filePath error:&innerError];
+  });
+  if (!success) {
+    return [[[FBSimulatorError describeFormat:@"Could not commit the last %.1fs to %@", duration, filePath] causedBy:innerError] failBool:error];
+  }
+  [self.logger logMessage:@"Committed the last %.1fs of Video to %@", duration, filePath];
+  return YES;
+}
+
+- (void)stop
+{
+  if (![self.segmenter stopWithError:nil]) {
+    return;
+  }
+  dispatch_sync(self.segmenter.queue, ^{
+    [self.ring removeAllSegments];
+  });
+  [NSFileManager.defaultManager removeItemAtPath:self.directory error:nil];
+}
+
+#pragma mark FBTerminationHandle
+
+- (void)terminate
+{
+  [self stop];
+}
+
+#pragma mark FBVideoSegmenterDelegate
+
+- (void)segmenter:(FBVideoSegmenter *)segmenter didFinishSegment:(FBVideoSegment *)segment
+{
+  NSArray *evicted = [self.ring appendSegment:segment];
+  [self.logger logMessage:@"Finished %@, evicting %lu Segments", segment, (unsigned long) evicted.count];
+}
+
+@end
@@ -0,0 +1,33 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import <FBSimulatorControl/FBSimulatorLogger.h>
+#import <FBSimulatorControl/FBVideoFrameSource.h>
+
+@class FBSimulator;
+
+/**
+ A Frame Source that captures the area of the screen occupied by a Simulator's window.
+ The Display is captured once for all Simulators on it, so many Sources on the same Display cost little more than one.
+ */
+@interface FBScreenCaptureFrameSource : NSObject <FBVideoFrameSource>
+
+/**
+ Creates a new Frame Source for the provided Simulator.
+
+ @param simulator the Simulator to capture.
+ @param framesPerSecond the maximum rate at which to capture Frames.
+ @param logger a logger to record interactions. May be nil.
+ @return a new Frame Source.
+ */
++ (instancetype)forSimulator:(FBSimulator *)simulator framesPerSecond:(NSUInteger)framesPerSecond logger:(id<FBSimulatorLogger>)logger;
+
+@end
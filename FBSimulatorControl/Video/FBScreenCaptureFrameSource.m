@@ -0,0 +1,133 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "FBScreenCaptureFrameSource.h"
+
+#import "FBSharedScreenCapture.h"
+#import "FBSimulator.h"
+#import "FBSimulatorError.h"
+#import "FBSimulatorWindowHelpers.h"
+
+@interface FBScreenCaptureFrameSource () <FBVideoFrameConsumer>
+
+@property (nonatomic, strong, readonly) FBSimulator *simulator;
+@property (nonatomic, assign, readonly) NSUInteger framesPerSecond;
+@property (nonatomic, strong, readonly) id<FBSimulatorLogger> logger;
+
+@property (nonatomic, strong, readwrite) FBSharedScreenCaptureClient *client;
+@property (nonatomic, strong, readwrite) id<FBVideoFrameConsumer> consumer;
+
+@end
+
+@implementation FBScreenCaptureFrameSource
+
++ (instancetype)forSimulator:(FBSimulator *)simulator framesPerSecond:(NSUInteger)framesPerSecond logger:(id<FBSimulatorLogger>)logger
+{
+  return [[self alloc] initWithSimulator:simulator framesPerSecond:framesPerSecond logger:logger];
+}
+
+- (instancetype)initWithSimulator:(FBSimulator *)simulator framesPerSecond:(NSUInteger)framesPerSecond logger:(id<FBSimulatorLogger>)logger
+{
+  NSParameterAssert(simulator);
+  NSParameterAssert(framesPerSecond > 0);
+
+  self = [super init];
+  if (!self) {
+    return nil;
+  }
+
+  _simulator = simulator;
+  _framesPerSecond = framesPerSecond;
+  _logger = logger;
+
+  return self;
+}
+
+#pragma mark FBVideoFrameSource
+
+- (BOOL)startWithConsumer:(id<FBVideoFrameConsumer>)consumer error:(NSError **)error
+{
+  NSParameterAssert(consumer);
+
+  if (self.client) {
+    return [[[FBSimulatorError describe:@"Cannot Start Capturing twice"] inSimulator:self.simulator] failBool:error];
+  }
+
+  CGDirectDisplayID displayID = [FBSimulatorWindowHelpers displayIDForSimulator:self.simulator cropRect:NULL screenSize:NULL];
+  if (!displayID) {
+    return [[[FBSimulatorError describe:@"Cannot obtain display ID for capture"] inSimulator:self.simulator] failBool:error];
+  }
+
+  // The Display is captured once for all Simulators on it, each Simulator receives the region of its window.
+  // The window is looked up again periodically, so that a window that moves continues to be captured.
+  FBSimulator *simulator = self.simulator;
+  FBSharedScreenCapture *capture = [FBSharedScreenCapture sharedCaptureForDisplay:displayID framesPerSecond:self.framesPerSecond logger:self.logger];
+  FBSharedScreenCaptureClient *client = [capture
+    clientWithRegionProvider:^ CGRect (CGSize frameSize) {
+      return [FBScreenCaptureFrameSource regionOfSimulator:simulator onDisplay:displayID frameSize:frameSize];
+    }
+    queueDepth:FBSharedScreenCaptureDefaultQueueDepth
+    regionRefreshInterval:FBSharedScreenCaptureDefaultRegionRefreshInterval];
+
+  self.consumer = consumer;
+  NSError *innerError = nil;
+  if (![client startWithConsumer:self error:&innerError]) {
+    self.consumer = nil;
+    return [[[[FBSimulatorError describe:@"Could not start capturing the Display"] causedBy:innerError] inSimulator:self.simulator] failBool:error];
+  }
+  self.client = client;
+  [self.logger logMessage:@"Capturing %@ at %lu fps", self.simulator, (unsigned long) self.framesPerSecond];
+
+  return YES;
+}
+
+- (void)stop
+{
+  [self.client stop];
+  self.client = nil;
+  self.consumer = nil;
+}
+
+- (void)dealloc
+{
+  [_client stop];
+}
+
+#pragma mark FBVideoFrameConsumer
+
+- (void)frameSource:(id<FBVideoFrameSource>)frameSource didProduceFrame:(CVPixelBufferRef)pixelBuffer presentationTime:(CMTime)presentationTime
+{
+  [self.consumer frameSource:self didProduceFrame:pixelBuffer presentationTime:presentationTime];
+}
+
+#pragma mark Private
+
++ (CGRect)regionOfSimulator:(FBSimulator *)simulator onDisplay:(CGDirectDisplayID)displayID frameSize:(CGSize)frameSize
+{
+  NSDictionary *window = [[FBSimulatorWindowHelpers windowsForSimulators:@[simulator]] firstObject];
+  CGRect windowBounds = CGRectZero;
+  if (!window || !CGRectMakeWithDictionaryRepresentation((CFDictionaryRef) window[(NSString *)kCGWindowBounds], &windowBounds)) {
+    return CGRectNull;
+  }
+
+  // Window and Display bounds are both in points with a top left origin, whereas the Frame is in pixels.
+  CGRect displayBounds = CGDisplayBounds(displayID);
+  if (CGRectIsEmpty(displayBounds)) {
+    return CGRectNull;
+  }
+  CGFloat scale = frameSize.width / CGRectGetWidth(displayBounds);
+  return CGRectMake(
+    (CGRectGetMinX(windowBounds) - CGRectGetMinX(displayBounds)) * scale,
+    (CGRectGetMinY(windowBounds) - CGRectGetMinY(displayBounds)) * scale,
+    CGRectGetWidth(windowBounds) * scale,
+    CGRectGetHeight(windowBounds) * scale
+  );
+}
+
+@end
@@ -0,0 +1,109 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <CoreGraphics/CoreGraphics.h>
+#import <CoreVideo/CoreVideo.h>
+#import <Foundation/Foundation.h>
+
+@class FBWritableLog;
+
+/**
+ The Image Formats that Screenshots can be encoded to.
+ */
+typedef NS_ENUM(NSUInteger, FBScreenshotFormat) {
+  FBScreenshotFormatPNG = 0,
+  FBScreenshotFormatJPEG = 1,
+};
+
+/**
+ Encodes Screenshots to Image Data.
+ */
+@interface FBScreenshotEncoder : NSObject
+
+/**
+ Creates and returns a new Encoder.
+
+ @param format the format to encode to.
+ @param compressionQuality the quality of lossy formats, from 0 to 1. Ignored for lossless formats.
+ @return a new Encoder.
+ */
++ (instancetype)encoderWithFormat:(FBScreenshotFormat)format compressionQuality:(CGFloat)compressionQuality;
+
+/**
+ An Encoder for lossless PNG.
+ */
++ (instancetype)pngEncoder;
+
+/**
+ An Encoder for JPEG at a quality suitable for diagnostics.
+ */
++ (instancetype)jpegEncoder;
+
+/**
+ The format to encode to.
+ */
+@property (nonatomic, assign, readonly) FBScreenshotFormat format;
+
+/**
+ The quality of lossy formats, from 0 to 1.
+ */
+@property (nonatomic, assign, readonly) CGFloat compressionQuality;
+
+/**
+ The file extension for the format.
+ */
+@property (nonatomic, copy, readonly) NSString *fileExtension;
+
+/**
+ Synchronously encodes an image.
+
+ @param image the image to encode.
+ @param error an error out for any error that occurred.
+ @return the encoded Data if successful, nil otherwise.
+ */
+- (NSData *)encodeImage:(CGImageRef)image error:(NSError **)error;
+
+/**
+ Synchronously encodes a Frame.
+
+ @param pixelBuffer the Frame to encode. Must be 32-bit BGRA.
+ @param error an error out for any error that occurred.
+ @return the encoded Data if successful, nil otherwise.
+ */
+- (NSData *)encodePixelBuffer:(CVPixelBufferRef)pixelBuffer error:(NSError **)error;
+
+/**
+ Synchronously encodes an image into a Writable Log.
+
+ @param image the image to encode.
+ @param name the short name of the Writable Log.
+ @param error an error out for any error that occurred.
+ @return the Writable Log if successful, nil otherwise.
+ */
+- (FBWritableLog *)encodeImage:(CGImageRef)image name:(NSString *)name error:(NSError **)error;
+
+/**
+ Encodes an image on a background queue, into a Writable Log.
+ The image is retained until the encoding has finished.
+
+ @param image the image to encode.
+ @param name the short name of the Writable Log.
+ @param completion called on a background queue with the Writable Log if successful, or the error otherwise.
+ */
+- (void)encodeImage:(CGImageRef)image name:(NSString *)name completion:(void (^)(FBWritableLog *log, NSError *error))completion;
+
+/**
+ Creates an image from a 32-bit BGRA Frame, copying the pixels. The caller is responsible for releasing it.
+
+ @param pixelBuffer the Frame to create an image from.
+ @return the image if successful, NULL otherwise.
+ */
++ (CGImageRef)createImageFromPixelBuffer:(CVPixelBufferRef)pixelBuffer CF_RETURNS_RETAINED;
+
+@end
@@ -0,0 +1,155 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "FBScreenshotEncoder.h"
+
+#import <ImageIO/ImageIO.h>
+
+#import "FBSimulatorError.h"
+#import "FBWritableLog.h"
+
+@implementation FBScreenshotEncoder
+
+#pragma mark Initializers
+
++ (instancetype)encoderWithFormat:(FBScreenshotFormat)format compressionQuality:(CGFloat)compressionQuality
+{
+  return [[self alloc] initWithFormat:format compressionQuality:compressionQuality];
+}
+
++ (instancetype)pngEncoder
+{
+  return [self encoderWithFormat:FBScreenshotFormatPNG compressionQuality:1];
+}
+
++ (instancetype)jpegEncoder
+{
+  return [self encoderWithFormat:FBScreenshotFormatJPEG compressionQuality:0.8];
+}
+
+- (instancetype)initWithFormat:(FBScreenshotFormat)format compressionQuality:(CGFloat)compressionQuality
+{
+  NSParameterAssert(compressionQuality >= 0 && compressionQuality <= 1);
+
+  self = [super init];
+  if (!self) {
+    return nil;
+  }
+
+  _format = format;
+  _compressionQuality = compressionQuality;
+
+  return self;
+}
+
+#pragma mark Public
+
+- (NSString *)fileExtension
+{
+  return self.format == FBScreenshotFormatJPEG ? @"jpg" : @"png";
+}
+
+- (NSData *)encodeImage:(CGImageRef)image error:(NSError **)error
+{
+  NSParameterAssert(image);
+
+  NSMutableData *data = [NSMutableData data];
+  CGImageDestinationRef destination = CGImageDestinationCreateWithData((__bridge CFMutableDataRef) data, (__bridge CFStringRef) self.uniformTypeIdentifier, 1, NULL);
+  if (!destination) {
+    return [[FBSimulatorError describeFormat:@"Could not create an Image Destination for %@", self.uniformTypeIdentifier] fail:error];
+  }
+
+  NSDictionary *properties = @{(NSString *) kCGImageDestinationLossyCompressionQuality : @(self.compressionQuality)};
+  CGImageDestinationAddImage(destination, image, (__bridge CFDictionaryRef) properties);
+  BOOL success = CGImageDestinationFinalize(destination);
+  CFRelease(destination);
+
+  if (!success) {
+    return [[FBSimulatorError describeFormat:@"Could not encode a %zux%zu image as %@", CGImageGetWidth(image), CGImageGetHeight(image), self.uniformTypeIdentifier] fail:error];
+  }
+  return [data copy];
+}
+
+- (NSData *)encodePixelBuffer:(CVPixelBufferRef)pixelBuffer error:(NSError **)error
+{
+  CGImageRef image = [FBScreenshotEncoder createImageFromPixelBuffer:pixelBuffer];
+  if (!image) {
+    return [[FBSimulatorError describeFormat:@"Could not create an image from Pixel Buffer %@", pixelBuffer] fail:error];
+  }
+  NSData *data = [self encodeImage:image error:error];
+  CGImageRelease(image);
+  return data;
+}
+
+- (FBWritableLog *)encodeImage:(CGImageRef)image name:(NSString *)name error:(NSError **)error
+{
+  NSParameterAssert(name);
+
+  NSData *data = [self encodeImage:image error:error];
+  if (!data) {
+    return nil;
+  }
+  return [[[[[FBWritableLogBuilder builder]
+    updateShortName:name]
+    updateFileType:self.fileExtension]
+    updateHumanReadableName:[NSString stringWithFormat:@"Screenshot (%@)", self.fileExtension.uppercaseString]]
+    updateData:data]
+    build];
+}
+
+- (void)encodeImage:(CGImageRef)image name:(NSString *)name completion:(void (^)(FBWritableLog *log, NSError *error))completion
+{
+  NSParameterAssert(image);
+  NSParameterAssert(name);
+  NSParameterAssert(completion);
+
+  // Encoding, PNG especially, is far slower than grabbing the image, so is kept off the caller's queue.
+  CGImageRetain(image);
+  dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+    NSError *error = nil;
+    FBWritableLog *log = [self encodeImage:image name:name error:&error];
+    CGImageRelease(image);
+    completion(log, error);
+  });
+}
+
++ (CGImageRef)createImageFromPixelBuffer:(CVPixelBufferRef)pixelBuffer
+{
+  if (!pixelBuffer || CVPixelBufferGetPixelFormatType(pixelBuffer) != kCVPixelFormatType_32BGRA) {
+    return NULL;
+  }
+
+  CVPixelBufferLockBaseAddress(pixelBuffer, kCVPixelBufferLock_ReadOnly);
+  CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+  CGContextRef context = CGBitmapContextCreate(
+    CVPixelBufferGetBaseAddress(pixelBuffer),
+    CVPixelBufferGetWidth(pixelBuffer),
+    CVPixelBufferGetHeight(pixelBuffer),
+    8,
+    CVPixelBufferGetBytesPerRow(pixelBuffer),
+    colorSpace,
+    kCGBitmapByteOrder32Little | kCGImageAlphaPremultipliedFirst
+  );
+  // Creating the image from the context copies the pixels, so the image outlives the Pixel Buffer.
+  CGImageRef image = context ? CGBitmapContextCreateImage(context) : NULL;
+  CGContextRelease(context);
+  CGColorSpaceRelease(colorSpace);
+  CVPixelBufferUnlockBaseAddress(pixelBuffer, kCVPixelBufferLock_ReadOnly);
+
+  return image;
+}
+
+#pragma mark Private
+
+- (NSString *)uniformTypeIdentifier
+{
+  return self.format == FBScreenshotFormatJPEG ? @"public.jpeg" : @"public.png";
+}
+
+@end
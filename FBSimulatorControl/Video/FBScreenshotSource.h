@@ -0,0 +1,62 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <CoreGraphics/CoreGraphics.h>
+#import <Foundation/Foundation.h>
+
+@class FBSimulator;
+@protocol FBVideoFrameSource;
+
+/**
+ Produces single images of a Simulator's screen on demand.
+ */
+@protocol FBScreenshotSource <NSObject>
+
+/**
+ Grabs an image. The caller is responsible for releasing it.
+
+ @param error an error out for any error that occurred.
+ @return the image if successful, NULL otherwise.
+ */
+- (CGImageRef)createImageWithError:(NSError **)error CF_RETURNS_RETAINED;
+
+@end
+
+/**
+ A Screenshot Source that grabs the contents of the Simulator's window from the Window Server.
+ Unlike capturing a region of the screen, this does not depend on the position of the window or whether it is occluded.
+ */
+@interface FBWindowScreenshotSource : NSObject <FBScreenshotSource>
+
+/**
+ Creates a Screenshot Source for the provided Simulator.
+
+ @param simulator the Simulator to grab images of.
+ @return a new Screenshot Source.
+ */
++ (instancetype)forSimulator:(FBSimulator *)simulator;
+
+@end
+
+/**
+ A Screenshot Source that takes the next Frame of a Frame Source.
+ The Frame Source is started for each image and stopped once a Frame has arrived.
+ */
+@interface FBFrameScreenshotSource : NSObject <FBScreenshotSource>
+
+/**
+ Creates a Screenshot Source that takes Frames from the provided Frame Source.
+
+ @param frameSource the Frame Source to take Frames from.
+ @param timeout the maximum time to wait for a Frame.
+ @return a new Screenshot Source.
+ */
++ (instancetype)sourceWithFrameSource:(id<FBVideoFrameSource>)frameSource timeout:(NSTimeInterval)timeout;
+
+@end
@@ -0,0 +1,153 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "FBScreenshotSource.h"
+
+#import "FBScreenshotEncoder.h"
+#import "FBSimulator.h"
+#import "FBSimulatorError.h"
+#import "FBSimulatorWindowHelpers.h"
+#import "FBVideoFrameSource.h"
+
+@interface FBWindowScreenshotSource ()
+
+@property (nonatomic, strong, readonly) FBSimulator *simulator;
+
+@end
+
+@implementation FBWindowScreenshotSource
+
++ (instancetype)forSimulator:(FBSimulator *)simulator
+{
+  return [[self alloc] initWithSimulator:simulator];
+}
+
+- (instancetype)initWithSimulator:(FBSimulator *)simulator
+{
+  NSParameterAssert(simulator);
+
+  self = [super init];
+  if (!self) {
+    return nil;
+  }
+
+  _simulator = simulator;
+
+  return self;
+}
+
+#pragma mark FBScreenshotSource
+
+- (CGImageRef)createImageWithError:(NSError **)error
+{
+  FBSimulator *simulator = self.simulator;
+  NSDictionary *window = [[FBSimulatorWindowHelpers windowsForSimulators:@[simulator]] firstObject];
+  NSNumber *windowNumber = window[(NSString *) kCGWindowNumber];
+  if (!windowNumber) {
+    [[[FBSimulatorError describe:@"Could not find the Window of the Simulator"] inSimulator:simulator] fail:error];
+    return NULL;
+  }
+
+  CGImageRef image = CGWindowListCreateImage(
+    CGRectNull,
+    kCGWindowListOptionIncludingWindow,
+    (CGWindowID) windowNumber.unsignedIntValue,
+    kCGWindowImageBoundsIgnoreFraming | kCGWindowImageNominalResolution
+  );
+  if (!image) {
+    [[[FBSimulatorError describeFormat:@"Could not create an image of Window %@", windowNumber] inSimulator:simulator] fail:error];
+    return NULL;
+  }
+  return image;
+}
+
+@end
+
+@interface FBFrameScreenshotSource () <FBVideoFrameConsumer>
+
+@property (nonatomic, strong, readonly) id<FBVideoFrameSource> frameSource;
+@property (nonatomic, assign, readonly) NSTimeInterval timeout;
+@property (nonatomic, strong, readwrite) dispatch_semaphore_t frameSemaphore;
+@property (nonatomic, assign, readwrite) CGImageRef image;
+
+@end
+
+@implementation FBFrameScreenshotSource
+
++ (instancetype)sourceWithFrameSource:(id<FBVideoFrameSource>)frameSource timeout:(NSTimeInterval)timeout
+{
+  return [[self alloc] initWithFrameSource:frameSource timeout:timeout];
+}
+
+- (instancetype)initWithFrameSource:(id<FBVideoFrameSource>)frameSource timeout:(NSTimeInterval)timeout
+{
+  NSParameterAssert(frameSource);
+
+  self = [super init];
+  if (!self) {
+    return nil;
+  }
+
+  _frameSource = frameSource;
+  _timeout = timeout;
+
+  return self;
+}
+
+- (void)dealloc
+{
+  CGImageRelease(_image);
+}
+
+#pragma mark FBScreenshotSource
+
+- (CGImageRef)createImageWithError:(NSError **)error
+{
+  @synchronized(self) {
+    self.frameSemaphore = dispatch_semaphore_create(0);
+    CGImageRelease(self.image);
+    self.image = NULL;
+  }
+
+  NSError *innerError = nil;
+  if (![self.frameSource startWithConsumer:self error:&innerError]) {
+    [[[FBSimulatorError describe:@"Could not start the Frame Source"] causedBy:innerError] fail:error];
+    return NULL;
+  }
+  long timedOut = dispatch_semaphore_wait(self.frameSemaphore, dispatch_time(DISPATCH_TIME_NOW, (int64_t) (self.timeout * NSEC_PER_SEC)));
+  [self.frameSource stop];
+
+  @synchronized(self) {
+    CGImageRef image = self.image;
+    self.image = NULL;
+    if (timedOut || !image) {
+      CGImageRelease(image);
+      [[FBSimulatorError describeFormat:@"No Frame arrived within %.1f seconds", self.timeout] fail:error];
+      return NULL;
+    }
+    return image;
+  }
+}
+
+#pragma mark FBVideoFrameConsumer
+
+- (void)frameSource:(id<FBVideoFrameSource>)frameSource didProduceFrame:(CVPixelBufferRef)pixelBuffer presentationTime:(CMTime)presentationTime
+{
+  @synchronized(self) {
+    if (self.image) {
+      return;
+    }
+    self.image = [FBScreenshotEncoder createImageFromPixelBuffer:pixelBuffer];
+    if (self.image) {
+      dispatch_semaphore_signal(self.frameSemaphore);
+    }
+  }
+}
+
+@end
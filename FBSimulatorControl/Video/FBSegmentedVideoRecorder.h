@@ -0,0 +1,82 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import <FBSimulatorControl/FBSimulatorLogger.h>
+#import <FBSimulatorControl/FBTerminationHandle.h>
+#import <FBSimulatorControl/FBVideoFrameSource.h>
+
+@class FBSimulator;
+@class FBVideoSegmentIndex;
+
+/**
+ Records Video into a sequence of Segment files, starting a new Segment periodically and at each Marker.
+ A JSON sidecar Index maps Markers to Segment files and the offsets within them, so that one recording can be shared between many Tests and cut afterwards.
+ */
+@interface FBSegmentedVideoRecorder : NSObject <FBTerminationHandle>
+
+/**
+ Creates a new Recorder that captures the provided Simulator's window.
+ Frames that are unchanged from the previous Frame are dropped, so that an idle screen costs little to encode and store.
+
+ @param simulator the Simulator to Record.
+ @param segmentDuration the maximum duration of each Segment.
+ @param directory the directory to write Segments and the Index into. Will be created if it does not exist.
+ @param logger a logger to record interactions. May be nil.
+ @return a new Recorder.
+ */
++ (instancetype)forSimulator:(FBSimulator *)simulator segmentDuration:(NSTimeInterval)segmentDuration directory:(NSString *)directory logger:(id<FBSimulatorLogger>)logger;
+
+/**
+ Creates a new Recorder.
+
+ @param frameSource the Source of the Frames to Record.
+ @param segmentDuration the maximum duration of each Segment.
+ @param directory the directory to write Segments and the Index into. Will be created if it does not exist.
+ @param logger a logger to record interactions. May be nil.
+ @return a new Recorder.
+ */
++ (instancetype)recorderWithFrameSource:(id<FBVideoFrameSource>)frameSource segmentDuration:(NSTimeInterval)segmentDuration directory:(NSString *)directory logger:(id<FBSimulatorLogger>)logger;
+
+/**
+ The path of the JSON sidecar Index. Is rewritten each time a Segment is finished.
+ */
+@property (nonatomic, copy, readonly) NSString *indexPath;
+
+/**
+ The Index of the Segments that have been finished so far.
+ */
+@property (nonatomic, copy, readonly) FBVideoSegmentIndex *index;
+
+/**
+ Starts Recording.
+
+ @param error an error out for any error that occurred.
+ @return YES if successful, NO otherwise.
+ */
+- (BOOL)startWithError:(NSError **)error;
+
+/**
+ Places a Marker in the Recording, such as when a Test starts.
+ The Segment in progress is finished, so that the Marker is at the start of a new Segment.
+
+ @param name the name of the Marker.
+ */
+- (void)markWithName:(NSString *)name;
+
+/**
+ Stops Recording, finishing the last Segment and writing the Index.
+
+ @param error an error out for any error that occurred.
+ @return the final Index if successful, nil otherwise.
+ */
+- (FBVideoSegmentIndex *)stopWithError:(NSError **)error;
+
+@end
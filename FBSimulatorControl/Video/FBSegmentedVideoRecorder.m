@@ -0,0 +1,136 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "FBSegmentedVideoRecorder.h"
+
+#import "FBScreenCaptureFrameSource.h"
+#import "FBSimulatorError.h"
+#import "FBVideoFrameDeduplicator.h"
+#import "FBVideoSegment.h"
+#import "FBVideoSegmentIndex.h"
+#import "FBVideoSegmenter.h"
+
+static NSUInteger const FBSegmentedVideoRecorderDefaultFramesPerSecond = 30;
+
+@interface FBSegmentedVideoRecorder () <FBVideoSegmenterDelegate>
+
+@property (nonatomic, strong, readonly) id<FBSimulatorLogger> logger;
+@property (nonatomic, strong, readonly) FBVideoSegmenter *segmenter;
+
+// Only accessed on the Segmenter's queue.
+@property (nonatomic, copy, readwrite) FBVideoSegmentIndex *currentIndex;
+
+@end
+
+@implementation FBSegmentedVideoRecorder
+
+#pragma mark Initializers
+
++ (instancetype)forSimulator:(FBSimulator *)simulator segmentDuration:(NSTimeInterval)segmentDuration directory:(NSString *)directory logger:(id<FBSimulatorLogger>)logger
+{
+  id<FBVideoFrameSource> captureSource = [FBScreenCaptureFrameSource forSimulator:simulator framesPerSecond:FBSegmentedVideoRecorderDefaultFramesPerSecond logger:logger];
+  id<FBVideoFrameSource> frameSource = [FBVideoFrameDeduplicator deduplicatorWithFrameSource:captureSource];
+  return [self recorderWithFrameSource:frameSource segmentDuration:segmentDuration directory:directory logger:logger];
+}
+
++ (instancetype)recorderWithFrameSource:(id<FBVideoFrameSource>)frameSource segmentDuration:(NSTimeInterval)segmentDuration directory:(NSString *)directory logger:(id<FBSimulatorLogger>)logger
+{
+  return [[self alloc] initWithFrameSource:frameSource segmentDuration:segmentDuration directory:directory logger:logger];
+}
+
+- (instancetype)initWithFrameSource:(id<FBVideoFrameSource>)frameSource segmentDuration:(NSTimeInterval)segmentDuration directory:(NSString *)directory logger:(id<FBSimulatorLogger>)logger
+{
+  NSParameterAssert(directory);
+
+  self = [super init];
+  if (!self) {
+    return nil;
+  }
+
+  _indexPath = [directory stringByAppendingPathComponent:@"index.json"];
+  _logger = logger;
+  _segmenter = [FBVideoSegmenter segmenterWithFrameSource:frameSource segmentDuration:segmentDuration directory:directory delegate:self logger:logger];
+
+  return self;
+}
+
+#pragma mark Public
+
+- (FBVideoSegmentIndex *)index
+{
+  __block FBVideoSegmentIndex *index = nil;
+  dispatch_sync(self.segmenter.queue, ^{
+    index = self.currentIndex;
+  });
+  return index;
+}
+
+- (BOOL)startWithError:(NSError **)error
+{
+  return [self.segmenter startWithError:error];
+}
+
+- (void)markWithName:(NSString *)name
+{
+  NSParameterAssert(name);
+
+  // The Marker is placed at the next Frame, which is the first Frame of the new Segment.
+  name = [name copy];
+  [self.segmenter cutAtNextFrame:^(NSTimeInterval time) {
+    FBVideoMarker *marker = [FBVideoMarker markerWithName:name time:time];
+    self.currentIndex = [self.currentIndex indexByAppendingMarker:marker];
+  }];
+}
+
+- (FBVideoSegmentIndex *)stopWithError:(NSError **)error
+{
+  if (![self.segmenter stopWithError:error]) {
+    return nil;
+  }
+
+  __block FBVideoSegmentIndex *index = nil;
+  __block NSError *innerError = nil;
+  dispatch_sync(self.segmenter.queue, ^{
+    index = self.currentIndex;
+    if (index && ![index writeToFile:self.indexPath error:&innerError]) {
+      index = nil;
+    }
+  });
+  if (!index) {
+    return [[[FBSimulatorError describeFormat:@"Failed to write Video Index to %@", self.indexPath] causedBy:innerError] fail:error];
+  }
+  [self.logger logMessage:@"Finished Segmented Recording %@", index];
+  return index;
+}
+
+#pragma mark FBTerminationHandle
+
+- (void)terminate
+{
+  [self stopWithError:nil];
+}
+
+#pragma mark FBVideoSegmenterDelegate
+
+- (void)segmenter:(FBVideoSegmenter *)segmenter didStartAtDate:(NSDate *)date
+{
+  self.currentIndex = [FBVideoSegmentIndex indexWithStartDate:date segments:@[] markers:@[]];
+}
+
+- (void)segmenter:(FBVideoSegmenter *)segmenter didFinishSegment:(FBVideoSegment *)segment
+{
+  self.currentIndex = [self.currentIndex indexByAppendingSegment:segment];
+  // The Index is kept up to date on disk, so that it is usable even if the Recorder is never stopped.
+  NSError *error = nil;
+  if (![self.currentIndex writeToFile:self.indexPath error:&error]) {
+    [self.logger logMessage:@"Failed to write Video Index: %@", error];
+  }
+}
+
+@end
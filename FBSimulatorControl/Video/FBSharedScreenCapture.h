@@ -0,0 +1,125 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <CoreGraphics/CoreGraphics.h>
+#import <CoreVideo/CoreVideo.h>
+#import <Foundation/Foundation.h>
+
+#import <FBSimulatorControl/FBSimulatorLogger.h>
+#import <FBSimulatorControl/FBVideoFrameSource.h>
+
+/**
+ Returns the region of a captured Frame that a Client is interested in.
+ The region is in pixels of the Frame, with the origin at the top left.
+ Return CGRectNull if the region is not currently known, such as when a window is offscreen.
+ */
+typedef CGRect (^FBScreenRegionProvider)(CGSize frameSize);
+
+/**
+ The default number of Frames that may be queued for a Client before further Frames are dropped.
+ */
+extern NSUInteger const FBSharedScreenCaptureDefaultQueueDepth;
+
+/**
+ The default interval, in seconds of presentation time, between queries of a Client's region.
+ */
+extern NSTimeInterval const FBSharedScreenCaptureDefaultRegionRefreshInterval;
+
+/**
+ A Frame Source for a region of a Shared Screen Capture.
+ Frames are cropped into buffers of the Client's own as they are captured, then delivered on a queue that belongs to the Client.
+ A slow Consumer therefore holds none of the captured Frames and does not hold up the capture or other Clients.
+ When the queue is full, Frames for this Client are dropped, independently of any other Client.
+ */
+@interface FBSharedScreenCaptureClient : NSObject <FBVideoFrameSource>
+
+/**
+ The region of the most recent Frame that was delivered, CGRectNull if no Frame has been delivered.
+ The size of the region is fixed by the first Frame, so that an encoder sees Frames of the same dimensions when the window moves.
+ */
+@property (nonatomic, assign, readonly) CGRect region;
+
+/**
+ The number of Frames that have been delivered to the Consumer.
+ */
+@property (nonatomic, assign, readonly) NSUInteger deliveredFrameCount;
+
+/**
+ The number of Frames that have been dropped, either as the queue was full or the region was not known.
+ */
+@property (nonatomic, assign, readonly) NSUInteger droppedFrameCount;
+
+@end
+
+/**
+ Captures a Display once and demultiplexes the Frames to any number of Clients, each of which receives its own region of the Display.
+ Capturing the Display once is considerably cheaper than a separate capture for each Simulator when many are tiled on the same Display.
+
+ The underlying Frame Source is started when the first Client starts, and stopped when the last Client stops.
+ */
+@interface FBSharedScreenCapture : NSObject <FBVideoFrameConsumer>
+
+/**
+ Returns the Shared Capture for a Display at a Frame rate, creating it if it does not exist.
+ Callers that ask for different Frame rates get separate Captures. The logger is that of the call that created the Capture.
+ A Capture is kept for as long as it is referenced, which includes by any of its Clients.
+
+ @param displayID the Display to capture.
+ @param framesPerSecond the maximum rate at which to capture Frames.
+ @param logger a logger to record interactions. May be nil.
+ @return the Shared Capture for the Display.
+ */
++ (instancetype)sharedCaptureForDisplay:(CGDirectDisplayID)displayID framesPerSecond:(NSUInteger)framesPerSecond logger:(id<FBSimulatorLogger>)logger;
+
+/**
+ Creates a new Shared Capture of an arbitrary Frame Source.
+
+ @param frameSource the Source of the Frames to demultiplex. Frames must be BGRA.
+ @param logger a logger to record interactions. May be nil.
+ @return a new Shared Capture.
+ */
++ (instancetype)captureWithFrameSource:(id<FBVideoFrameSource>)frameSource logger:(id<FBSimulatorLogger>)logger;
+
+/**
+ Creates a new Client of the Capture. The Client receives Frames once it is started.
+
+ @param regionProvider provides the region of the Frames to deliver to the Client. Called as Frames are captured, once per refresh interval while the region is known, so it should not block.
+ @param queueDepth the number of Frames that may be queued or in delivery before further Frames are dropped. Must be at least 1.
+ @param regionRefreshInterval the interval, in seconds of presentation time, between calls to the region provider.
+ @return a new Client.
+ */
+- (FBSharedScreenCaptureClient *)clientWithRegionProvider:(FBScreenRegionProvider)regionProvider queueDepth:(NSUInteger)queueDepth regionRefreshInterval:(NSTimeInterval)regionRefreshInterval;
+
+/**
+ The number of Clients that are started.
+ */
+@property (nonatomic, assign, readonly) NSUInteger clientCount;
+
+/**
+ Calculates the region of a Frame to crop.
+ The region is integral, has even dimensions so that it can be encoded as H.264, and lies within the Frame.
+
+ @param rect the requested region.
+ @param lockedSize the size that the region must have, or CGSizeZero if it is not yet fixed. A region of a fixed size is moved to lie within the Frame.
+ @param frameSize the size of the Frame.
+ @return the region to crop, CGRectNull if there is no such region.
+ */
++ (CGRect)cropRegionForRect:(CGRect)rect lockedSize:(CGSize)lockedSize frameSize:(CGSize)frameSize;
+
+/**
+ Copies a region of a BGRA Pixel Buffer into a new Pixel Buffer. The caller is responsible for releasing it.
+
+ @param pixelBuffer the Pixel Buffer to crop.
+ @param region the region to copy. Must lie within the Pixel Buffer.
+ @param pool a pool of Pixel Buffers of the size of the region to copy into. May be NULL.
+ @return a new Pixel Buffer, NULL if the Pixel Buffer could not be cropped.
+ */
++ (CVPixelBufferRef)createCroppedPixelBuffer:(CVPixelBufferRef)pixelBuffer region:(CGRect)region pool:(CVPixelBufferPoolRef)pool CF_RETURNS_RETAINED;
+
+@end
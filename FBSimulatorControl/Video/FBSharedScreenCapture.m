@@ -0,0 +1,422 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "FBSharedScreenCapture.h"
+
+#import "FBDisplayCaptureFrameSource.h"
+#import "FBSimulatorError.h"
+
+NSUInteger const FBSharedScreenCaptureDefaultQueueDepth = 4;
+NSTimeInterval const FBSharedScreenCaptureDefaultRegionRefreshInterval = 1;
+
+static const char *const FBSharedScreenCaptureClientQueueKey = "FBSharedScreenCaptureClientQueueKey";
+
+@interface FBSharedScreenCapture ()
+
+@property (nonatomic, strong, readonly) id<FBVideoFrameSource> frameSource;
+@property (nonatomic, strong, readonly) id<FBSimulatorLogger> logger;
+@property (nonatomic, strong, readonly) NSMutableArray *clients;
+@property (nonatomic, strong, readonly) NSObject *lifecycleLock;
+
+- (BOOL)attachClient:(FBSharedScreenCaptureClient *)client error:(NSError **)error;
+- (void)detachClient:(FBSharedScreenCaptureClient *)client;
+
+@end
+
+@interface FBSharedScreenCaptureClient ()
+
+@property (nonatomic, strong, readonly) FBSharedScreenCapture *capture;
+@property (nonatomic, copy, readonly) FBScreenRegionProvider regionProvider;
+@property (nonatomic, assign, readonly) NSUInteger queueDepth;
+@property (nonatomic, assign, readonly) NSTimeInterval regionRefreshInterval;
+@property (nonatomic, strong, readonly) dispatch_queue_t queue;
+
+@property (nonatomic, strong, readwrite) id<FBVideoFrameConsumer> consumer;
+@property (nonatomic, assign, readwrite) NSUInteger pendingFrameCount;
+@property (nonatomic, assign, readwrite) CGRect region;
+@property (nonatomic, assign, readwrite) NSUInteger deliveredFrameCount;
+@property (nonatomic, assign, readwrite) NSUInteger droppedFrameCount;
+
+// Only accessed on the queue that the Shared Capture receives Frames on.
+@property (nonatomic, assign, readwrite) CGSize lockedSize;
+@property (nonatomic, assign, readwrite) CMTime lastRegionRefreshTime;
+@property (nonatomic, assign, readwrite) CVPixelBufferPoolRef pool;
+@property (nonatomic, assign, readwrite) CGRect croppedRegion;
+
+@end
+
+@implementation FBSharedScreenCaptureClient
+
+- (instancetype)initWithCapture:(FBSharedScreenCapture *)capture regionProvider:(FBScreenRegionProvider)regionProvider queueDepth:(NSUInteger)queueDepth regionRefreshInterval:(NSTimeInterval)regionRefreshInterval
+{
+  NSParameterAssert(capture);
+  NSParameterAssert(regionProvider);
+  NSParameterAssert(queueDepth > 0);
+
+  self = [super init];
+  if (!self) {
+    return nil;
+  }
+
+  _capture = capture;
+  _regionProvider = [regionProvider copy];
+  _queueDepth = queueDepth;
+  _regionRefreshInterval = regionRefreshInterval;
+  _queue = dispatch_queue_create("com.facebook.FBSimulatorControl.sharedcapture.client", DISPATCH_QUEUE_SERIAL);
+  dispatch_queue_set_specific(_queue, FBSharedScreenCaptureClientQueueKey, (__bridge void *) self, NULL);
+  _region = CGRectNull;
+  _lockedSize = CGSizeZero;
+  _croppedRegion = CGRectNull;
+  _lastRegionRefreshTime = kCMTimeInvalid;
+
+  return self;
+}
+
+- (void)dealloc
+{
+  CVPixelBufferPoolRelease(_pool);
+}
+
+#pragma mark FBVideoFrameSource
+
+- (BOOL)startWithConsumer:(id<FBVideoFrameConsumer>)consumer error:(NSError **)error
+{
+  NSParameterAssert(consumer);
+
+  @synchronized(self) {
+    if (self.consumer) {
+      return [[FBSimulatorError describe:@"Cannot Start a Shared Capture Client twice"] failBool:error];
+    }
+    self.consumer = consumer;
+  }
+
+  NSError *innerError = nil;
+  if (![self.capture attachClient:self error:&innerError]) {
+    @synchronized(self) {
+      self.consumer = nil;
+    }
+    return [[[FBSimulatorError describe:@"Could not start the Shared Capture"] causedBy:innerError] failBool:error];
+  }
+  return YES;
+}
+
+- (void)stop
+{
+  @synchronized(self) {
+    if (!self.consumer) {
+      return;
+    }
+    self.consumer = nil;
+  }
+  [self.capture detachClient:self];
+  // Waits for any Frame that is in delivery, so that none are delivered once stopped.
+  // When stopped from the Consumer, the Frame in delivery is the caller's own, and no further Frames will be delivered.
+  if (dispatch_get_specific(FBSharedScreenCaptureClientQueueKey) == (__bridge void *) self) {
+    return;
+  }
+  dispatch_sync(self.queue, ^{});
+}
+
+#pragma mark Private
+
+- (void)enqueueFrame:(CVPixelBufferRef)pixelBuffer presentationTime:(CMTime)presentationTime
+{
+  @synchronized(self) {
+    if (!self.consumer) {
+      return;
+    }
+    if (self.pendingFrameCount >= self.queueDepth) {
+      self.droppedFrameCount++;
+      return;
+    }
+  }
+
+  // The Frame is cropped into a buffer of the Client's own before it is queued.
+  // Holding on to the Source's Frame until the queue gets to it would drain the Source's buffers when a Client is slow.
+  CVPixelBufferRef cropped = [self createCroppedFrame:pixelBuffer presentationTime:presentationTime];
+  if (!cropped) {
+    @synchronized(self) {
+      self.droppedFrameCount++;
+    }
+    return;
+  }
+
+  CGRect region = self.croppedRegion;
+  @synchronized(self) {
+    self.pendingFrameCount++;
+  }
+  dispatch_async(self.queue, ^{
+    [self deliverFrame:cropped region:region presentationTime:presentationTime];
+    CVPixelBufferRelease(cropped);
+    @synchronized(self) {
+      self.pendingFrameCount--;
+    }
+  });
+}
+
+- (CVPixelBufferRef)createCroppedFrame:(CVPixelBufferRef)pixelBuffer presentationTime:(CMTime)presentationTime CF_RETURNS_RETAINED
+{
+  CGRect region = self.croppedRegion;
+  BOOL refresh = !CMTIME_IS_VALID(self.lastRegionRefreshTime) || CMTimeGetSeconds(CMTimeSubtract(presentationTime, self.lastRegionRefreshTime)) >= self.regionRefreshInterval;
+  if (refresh || CGRectIsNull(region)) {
+    CGSize frameSize = CGSizeMake(CVPixelBufferGetWidth(pixelBuffer), CVPixelBufferGetHeight(pixelBuffer));
+    CGRect refreshed = [FBSharedScreenCapture cropRegionForRect:self.regionProvider(frameSize) lockedSize:self.lockedSize frameSize:frameSize];
+    self.lastRegionRefreshTime = presentationTime;
+    // An unknown region, such as a window that has been hidden, continues with the last known region.
+    if (!CGRectIsNull(refreshed)) {
+      region = refreshed;
+    }
+  }
+  if (CGRectIsNull(region)) {
+    return NULL;
+  }
+  if (!self.pool) {
+    self.lockedSize = region.size;
+    self.pool = [self createPoolOfSize:region.size];
+  }
+  self.croppedRegion = region;
+  return [FBSharedScreenCapture createCroppedPixelBuffer:pixelBuffer region:region pool:self.pool];
+}
+
+- (void)deliverFrame:(CVPixelBufferRef)pixelBuffer region:(CGRect)region presentationTime:(CMTime)presentationTime
+{
+  id<FBVideoFrameConsumer> consumer = nil;
+  @synchronized(self) {
+    consumer = self.consumer;
+  }
+  if (!consumer) {
+    return;
+  }
+
+  [consumer frameSource:self didProduceFrame:pixelBuffer presentationTime:presentationTime];
+  @synchronized(self) {
+    self.region = region;
+    self.deliveredFrameCount++;
+  }
+}
+
+- (CVPixelBufferPoolRef)createPoolOfSize:(CGSize)size
+{
+  NSDictionary *attributes = @{
+    (NSString *) kCVPixelBufferPixelFormatTypeKey : @(kCVPixelFormatType_32BGRA),
+    (NSString *) kCVPixelBufferWidthKey : @(size.width),
+    (NSString *) kCVPixelBufferHeightKey : @(size.height),
+    (NSString *) kCVPixelBufferIOSurfacePropertiesKey : @{},
+  };
+  CVPixelBufferPoolRef pool = NULL;
+  CVPixelBufferPoolCreate(kCFAllocatorDefault, NULL, (__bridge CFDictionaryRef) attributes, &pool);
+  return pool;
+}
+
+#pragma mark NSObject
+
+- (NSString *)description
+{
+  @synchronized(self) {
+    return [NSString stringWithFormat:
+      @"Shared Capture Client | Region %@ | Delivered %lu | Dropped %lu",
+      NSStringFromRect(self.region),
+      (unsigned long) self.deliveredFrameCount,
+      (unsigned long) self.droppedFrameCount
+    ];
+  }
+}
+
+@end
+
+@implementation FBSharedScreenCapture
+
+#pragma mark Initializers
+
++ (instancetype)sharedCaptureForDisplay:(CGDirectDisplayID)displayID framesPerSecond:(NSUInteger)framesPerSecond logger:(id<FBSimulatorLogger>)logger
+{
+  // Captures are shared between callers that ask for the same Frame rate, so that no caller gets another's rate.
+  // Each Client retains its Capture, so a Capture is released along with the last of its Clients.
+  static NSMapTable *captures;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    captures = [NSMapTable strongToWeakObjectsMapTable];
+  });
+
+  NSArray *key = @[@(displayID), @(framesPerSecond)];
+  @synchronized(captures) {
+    FBSharedScreenCapture *capture = [captures objectForKey:key];
+    if (!capture) {
+      id<FBVideoFrameSource> frameSource = [FBDisplayCaptureFrameSource sourceWithDisplayID:displayID framesPerSecond:framesPerSecond logger:logger];
+      capture = [self captureWithFrameSource:frameSource logger:logger];
+      [captures setObject:capture forKey:key];
+    }
+    return capture;
+  }
+}
+
++ (instancetype)captureWithFrameSource:(id<FBVideoFrameSource>)frameSource logger:(id<FBSimulatorLogger>)logger
+{
+  return [[self alloc] initWithFrameSource:frameSource logger:logger];
+}
+
+- (instancetype)initWithFrameSource:(id<FBVideoFrameSource>)frameSource logger:(id<FBSimulatorLogger>)logger
+{
+  NSParameterAssert(frameSource);
+
+  self = [super init];
+  if (!self) {
+    return nil;
+  }
+
+  _frameSource = frameSource;
+  _logger = logger;
+  _clients = [NSMutableArray array];
+  _lifecycleLock = [NSObject new];
+
+  return self;
+}
+
+#pragma mark Public
+
+- (FBSharedScreenCaptureClient *)clientWithRegionProvider:(FBScreenRegionProvider)regionProvider queueDepth:(NSUInteger)queueDepth regionRefreshInterval:(NSTimeInterval)regionRefreshInterval
+{
+  return [[FBSharedScreenCaptureClient alloc] initWithCapture:self regionProvider:regionProvider queueDepth:queueDepth regionRefreshInterval:regionRefreshInterval];
+}
+
+- (NSUInteger)clientCount
+{
+  @synchronized(self) {
+    return self.clients.count;
+  }
+}
+
++ (CGRect)cropRegionForRect:(CGRect)rect lockedSize:(CGSize)lockedSize frameSize:(CGSize)frameSize
+{
+  if (CGRectIsNull(rect) || CGRectIsEmpty(rect)) {
+    return CGRectNull;
+  }
+  rect = CGRectIntegral(rect);
+
+  if (CGSizeEqualToSize(lockedSize, CGSizeZero)) {
+    rect = CGRectIntersection(rect, (CGRect) {CGPointZero, frameSize});
+    CGFloat width = floor(CGRectGetWidth(rect) / 2) * 2;
+    CGFloat height = floor(CGRectGetHeight(rect) / 2) * 2;
+    if (CGRectIsNull(rect) || width <= 0 || height <= 0) {
+      return CGRectNull;
+    }
+    return CGRectMake(CGRectGetMinX(rect), CGRectGetMinY(rect), width, height);
+  }
+
+  // A window that moves partially off the Frame is followed as far as the edge of the Frame.
+  if (lockedSize.width > frameSize.width || lockedSize.height > frameSize.height) {
+    return CGRectNull;
+  }
+  CGFloat x = MIN(MAX(CGRectGetMinX(rect), 0), frameSize.width - lockedSize.width);
+  CGFloat y = MIN(MAX(CGRectGetMinY(rect), 0), frameSize.height - lockedSize.height);
+  return CGRectMake(x, y, lockedSize.width, lockedSize.height);
+}
+
++ (CVPixelBufferRef)createCroppedPixelBuffer:(CVPixelBufferRef)pixelBuffer region:(CGRect)region pool:(CVPixelBufferPoolRef)pool
+{
+  if (CVPixelBufferGetPixelFormatType(pixelBuffer) != kCVPixelFormatType_32BGRA) {
+    return NULL;
+  }
+  size_t x = (size_t) CGRectGetMinX(region);
+  size_t y = (size_t) CGRectGetMinY(region);
+  size_t width = (size_t) CGRectGetWidth(region);
+  size_t height = (size_t) CGRectGetHeight(region);
+  if (CGRectGetMinX(region) < 0 || CGRectGetMinY(region) < 0 || x + width > CVPixelBufferGetWidth(pixelBuffer) || y + height > CVPixelBufferGetHeight(pixelBuffer)) {
+    return NULL;
+  }
+
+  CVPixelBufferRef cropped = NULL;
+  CVReturn status = pool
+    ? CVPixelBufferPoolCreatePixelBuffer(kCFAllocatorDefault, pool, &cropped)
+    : CVPixelBufferCreate(kCFAllocatorDefault, width, height, kCVPixelFormatType_32BGRA, NULL, &cropped);
+  if (status != kCVReturnSuccess) {
+    return NULL;
+  }
+  if (CVPixelBufferGetWidth(cropped) != width || CVPixelBufferGetHeight(cropped) != height) {
+    CVPixelBufferRelease(cropped);
+    return NULL;
+  }
+
+  CVPixelBufferLockBaseAddress(pixelBuffer, kCVPixelBufferLock_ReadOnly);
+  CVPixelBufferLockBaseAddress(cropped, 0);
+  size_t sourceBytesPerRow = CVPixelBufferGetBytesPerRow(pixelBuffer);
+  size_t destinationBytesPerRow = CVPixelBufferGetBytesPerRow(cropped);
+  const uint8_t *source = (const uint8_t *) CVPixelBufferGetBaseAddress(pixelBuffer) + (y * sourceBytesPerRow) + (x * 4);
+  uint8_t *destination = CVPixelBufferGetBaseAddress(cropped);
+  for (size_t row = 0; row < height; row++) {
+    memcpy(destination + (row * destinationBytesPerRow), source + (row * sourceBytesPerRow), width * 4);
+  }
+  CVPixelBufferUnlockBaseAddress(cropped, 0);
+  CVPixelBufferUnlockBaseAddress(pixelBuffer, kCVPixelBufferLock_ReadOnly);
+
+  return cropped;
+}
+
+#pragma mark FBVideoFrameConsumer
+
+- (void)frameSource:(id<FBVideoFrameSource>)frameSource didProduceFrame:(CVPixelBufferRef)pixelBuffer presentationTime:(CMTime)presentationTime
+{
+  NSArray *clients = nil;
+  @synchronized(self) {
+    clients = [self.clients copy];
+  }
+  // Each Client crops its region here, then delivers on its own queue, so one slow Client cannot hold up the capture or any other Client.
+  for (FBSharedScreenCaptureClient *client in clients) {
+    [client enqueueFrame:pixelBuffer presentationTime:presentationTime];
+  }
+}
+
+#pragma mark Private
+
+- (BOOL)attachClient:(FBSharedScreenCaptureClient *)client error:(NSError **)error
+{
+  // Starting and stopping the Source is serialized separately from the Client list.
+  // Stopping a Source waits for Frames in delivery, which need the Client list.
+  @synchronized(self.lifecycleLock) {
+    BOOL first = NO;
+    @synchronized(self) {
+      first = self.clients.count == 0;
+      [self.clients addObject:client];
+    }
+    if (!first) {
+      return YES;
+    }
+
+    NSError *innerError = nil;
+    if (![self.frameSource startWithConsumer:self error:&innerError]) {
+      @synchronized(self) {
+        [self.clients removeObject:client];
+      }
+      return [[[FBSimulatorError describe:@"Could not start the Frame Source of the Shared Capture"] causedBy:innerError] failBool:error];
+    }
+    [self.logger logMessage:@"Started Shared Capture for %@", client];
+    return YES;
+  }
+}
+
+- (void)detachClient:(FBSharedScreenCaptureClient *)client
+{
+  @synchronized(self.lifecycleLock) {
+    BOOL last = NO;
+    @synchronized(self) {
+      if (![self.clients containsObject:client]) {
+        return;
+      }
+      [self.clients removeObject:client];
+      last = self.clients.count == 0;
+    }
+    if (!last) {
+      return;
+    }
+    [self.frameSource stop];
+    [self.logger logMessage:@"Stopped Shared Capture as the last Client stopped"];
+  }
+}
+
+@end
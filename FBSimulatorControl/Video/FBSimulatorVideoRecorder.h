@@ -16,6 +16,7 @@
 
 /**
  A Class that Records Video for a given Simulator.
+ The Display is captured once for all Simulators that are Recorded on it, with each Recorder encoding the region of its Simulator's window.
 
  Helpful reference from:
  - Apple Technical QA1740
@@ -45,6 +46,7 @@
 
 /**
  Ends recording of the Simulator.
+ If no Frames were recorded, the Path is still returned but there is no movie at it.
 
  @param error the error out, for any error that occured.
  @return the Path of the recorded movie if successful, NO otherwise.
@@ -9,24 +9,24 @@
 
 #import "FBSimulatorVideoRecorder.h"
 
-#import <AVFoundation/AVFoundation.h>
-#import <CoreGraphics/CoreGraphics.h>
-#import <CoreMedia/CoreMedia.h>
-
+#import "FBScreenCaptureFrameSource.h"
 #import "FBSimulator.h"
 #import "FBSimulatorError.h"
-#import "FBSimulatorWindowHelpers.h"
-#import "FBSimulatorWindowTiler.h"
+#import "FBVideoSegment.h"
+#import "FBVideoSegmentWriter.h"
+
+static NSUInteger const FBSimulatorVideoRecorderFramesPerSecond = 30;
 
-@interface FBSimulatorVideoRecorder () <AVCaptureFileOutputRecordingDelegate, AVCaptureFileOutputDelegate>
+@interface FBSimulatorVideoRecorder () <FBVideoFrameConsumer>
 
 @property (nonatomic, strong, readwrite) FBSimulator *simulator;
 @property (nonatomic, strong, readwrite) id<FBSimulatorLogger> logger;
 
 @property (nonatomic, copy, readwrite) NSString *filePath;
-@property (nonatomic, copy, readwrite) NSURL *fileURL;
-@property (nonatomic, strong, readwrite) AVCaptureSession *session;
-@property (nonatomic, strong, readwrite) AVCaptureMovieFileOutput *output;
+@property (nonatomic, strong, readwrite) FBScreenCaptureFrameSource *frameSource;
+@property (nonatomic, strong, readwrite) FBVideoSegmentWriter *writer;
+@property (nonatomic, assign, readwrite) CMTime lastFrameTime;
+@property (nonatomic, assign, readwrite) CMTime lastFrameInterval;
 
 @end
 
@@ -42,67 +42,60 @@
 
 - (BOOL)startRecordingToFilePath:(NSString *)filePath error:(NSError **)error
 {
-  if (self.session) {
-    return [[[FBSimulatorError describe:@"Cannot Start Recording twice"] inSimulator:self.simulator] failBool:error];
-  }
-
-  CGRect cropRect = CGRectZero;
-  CGDirectDisplayID displayID = [FBSimulatorWindowHelpers displayIDForSimulator:self.simulator cropRect:&cropRect screenSize:NULL];
-  if (!displayID) {
-    return [[[FBSimulatorError describe:@"Cannot obtain display ID for recording"] inSimulator:self.simulator] failBool:error];
+  @synchronized(self) {
+    if (self.frameSource) {
+      return [[[FBSimulatorError describe:@"Cannot Start Recording twice"] inSimulator:self.simulator] failBool:error];
+    }
+
+    NSError *innerError = nil;
+    if ([NSFileManager.defaultManager fileExistsAtPath:filePath] && ![NSFileManager.defaultManager removeItemAtPath:filePath error:&innerError]) {
+      return [[[FBSimulatorError describeFormat:@"Cannot remove existing video at '%@'", filePath] inSimulator:self.simulator] failBool:error];
+    }
+    self.filePath = filePath;
+    self.writer = nil;
+    self.lastFrameTime = kCMTimeInvalid;
+    self.lastFrameInterval = kCMTimeInvalid;
+    self.frameSource = [FBScreenCaptureFrameSource forSimulator:self.simulator framesPerSecond:FBSimulatorVideoRecorderFramesPerSecond logger:self.logger];
   }
 
   NSError *innerError = nil;
-  if ([NSFileManager.defaultManager fileExistsAtPath:filePath] && ![NSFileManager.defaultManager removeItemAtPath:filePath error:&innerError]) {
-    return [[[FBSimulatorError describeFormat:@"Cannot remove existing video at '%@'", filePath] inSimulator:self.simulator] failBool:error];
-  }
-  self.filePath = filePath;
-  self.fileURL = [NSURL fileURLWithPath:filePath];
-
-  // Setup the Screen Capture Input
-  AVCaptureScreenInput *input = [[AVCaptureScreenInput alloc] initWithDisplayID:displayID];
-  if (!input) {
-    return [[[FBSimulatorError describe:@"Could not Create Screen input for display id"] inSimulator:self.simulator] failBool:error];
-  }
-  input.cropRect = cropRect;
-
-  // Then the Output
-  AVCaptureMovieFileOutput *output = [[AVCaptureMovieFileOutput alloc] init];
-  output.delegate = self;
-
-  // Create & Setup the Session.
-  AVCaptureSession *session = [[AVCaptureSession alloc] init];
-  [NSNotificationCenter.defaultCenter addObserver:self selector:@selector(captureSessionDidStart:) name:AVCaptureSessionDidStartRunningNotification object:session];
-  if (![session canAddInput:input]) {
-    return [[[FBSimulatorError describe:@"Could not add AV Input to the Capture Sesion"] inSimulator:self.simulator] failBool:error];
+  if (![self.frameSource startWithConsumer:self error:&innerError]) {
+    @synchronized(self) {
+      self.frameSource = nil;
+    }
+    return [[[[FBSimulatorError describe:@"Could not start capturing the Simulator"] causedBy:innerError] inSimulator:self.simulator] failBool:error];
   }
-  [session addInput:input];
-  if (![session canAddOutput:output]) {
-    return [[[FBSimulatorError describe:@"Could not add AV Output to the Capture Sesion"] inSimulator:self.simulator] failBool:error];
-  }
-  [session addOutput:output];
-  self.session = session;
-  self.output = output;
-
-  // The Session is started, but the recording to file isn't started *until* capture session starts.
-  // This is because the Pixel Format changes when the Simulator hits Springboard, causing the File output to Terminate.
-  // Instead of experiencing this termination, the file recording waits until the session is in a valid state.
-  [session startRunning];
+  [self.logger logMessage:@"Capture started to %@", filePath];
 
   return YES;
 }
 
 - (NSString *)stopRecordingWithError:(NSError **)error
 {
-  if (!self.session) {
+  FBScreenCaptureFrameSource *frameSource = nil;
+  @synchronized(self) {
+    frameSource = self.frameSource;
+    self.frameSource = nil;
+  }
+  if (!frameSource) {
     return [[FBSimulatorError describe:@"Cannot stop a Recording when one doesn't exist"] fail:error];
   }
-
-  [self.output stopRecording];
-  [self.session stopRunning];
-
-  self.session = nil;
-  self.output = nil;
+  [frameSource stop];
+
+  @synchronized(self) {
+    FBVideoSegmentWriter *writer = self.writer;
+    self.writer = nil;
+    // As with a capture session that never started, a Recording without any Frames still succeeds, but no movie is written.
+    if (writer.frameCount == 0) {
+      [self.logger logMessage:@"No Frames were recorded to %@", self.filePath];
+      return self.filePath;
+    }
+    NSError *innerError = nil;
+    if (![writer finishAtTime:CMTimeAdd(self.lastFrameTime, self.lastFrameInterval) error:&innerError]) {
+      return [[[[FBSimulatorError describeFormat:@"Failed to finish recording to %@", self.filePath] causedBy:innerError] inSimulator:self.simulator] fail:error];
+    }
+  }
+  [self.logger logMessage:@"Did finish recording to %@", self.filePath];
 
   return self.filePath;
 }
@@ -117,43 +110,31 @@
   [self terminate];
 }
 
-#pragma mark Notifications
+#pragma mark FBVideoFrameConsumer
 
-- (void)captureSessionDidStart:(NSNotification *)notification
+- (void)frameSource:(id<FBVideoFrameSource>)frameSource didProduceFrame:(CVPixelBufferRef)pixelBuffer presentationTime:(CMTime)presentationTime
 {
-  [self.output startRecordingToOutputFileURL:self.fileURL recordingDelegate:self];
-}
-
-#pragma mark AVCaptureFileOutputRecordingDelegate
-
-- (void)captureOutput:(AVCaptureFileOutput *)captureOutput didStartRecordingToOutputFileAtURL:(NSURL *)fileURL fromConnections:(NSArray *)connections;
-{
-  [self.logger logMessage:@"Capture started to %@", fileURL];
-}
-
-- (void)captureOutput:(AVCaptureFileOutput *)captureOutput didPauseRecordingToOutputFileAtURL:(NSURL *)fileURL fromConnections:(NSArray *)connections
-{
-  [self.logger logMessage:@"Capture paused at %@", fileURL];
-}
-
-- (void)captureOutput:(AVCaptureFileOutput *)captureOutput didResumeRecordingToOutputFileAtURL:(NSURL *)fileURL fromConnections:(NSArray *)connection
-{
-  [self.logger logMessage:@"Capture resumed at %@", fileURL];
-}
-
-- (void)captureOutput:(AVCaptureFileOutput *)captureOutput willFinishRecordingToOutputFileAtURL:(NSURL *)fileURL fromConnections:(NSArray *)connections error:(NSError *)error
-{
-  [self.logger logMessage:@"Will finish recording to %@", fileURL];
-}
-
-- (void)captureOutput:(AVCaptureFileOutput *)captureOutput didFinishRecordingToOutputFileAtURL:(NSURL *)fileURL fromConnections:(NSArray *)connections error:(NSError *)error;
-{
-  [self.logger logMessage:@"Did finish recording to %@", fileURL];
-}
-
-- (BOOL)captureOutputShouldProvideSampleAccurateRecordingStart:(AVCaptureOutput *)captureOutput
-{
-  return NO;
+  @synchronized(self) {
+    if (frameSource != self.frameSource) {
+      return;
+    }
+    // The dimensions of the movie are those of the first Frame, as the region of a Client is fixed once it has a Frame.
+    if (!self.writer) {
+      self.writer = [FBVideoSegmentWriter writerWithPath:self.filePath origin:presentationTime];
+    }
+
+    NSError *error = nil;
+    if (![self.writer appendFrame:pixelBuffer presentationTime:presentationTime error:&error]) {
+      [self.logger logMessage:@"Dropped Frame: %@", error];
+      return;
+    }
+    if (CMTIME_IS_VALID(self.lastFrameTime)) {
+      self.lastFrameInterval = CMTimeSubtract(presentationTime, self.lastFrameTime);
+    } else {
+      self.lastFrameInterval = CMTimeMake(1, (int32_t) FBSimulatorVideoRecorderFramesPerSecond);
+    }
+    self.lastFrameTime = presentationTime;
+  }
 }
 
 @end
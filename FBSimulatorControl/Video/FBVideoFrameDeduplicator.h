@@ -0,0 +1,63 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import <FBSimulatorControl/FBVideoFrameSource.h>
+
+/**
+ The default minimum Frame rate of a Deduplicator.
+ */
+extern double const FBVideoFrameDeduplicatorDefaultMinimumFramesPerSecond;
+
+/**
+ A Frame Source that drops Frames from another Frame Source that are unchanged from the last Frame that it delivered.
+ An encoder displays a Frame until the next, so dropping a Frame extends the previous one, saving encoder time and disk when the screen is idle.
+ */
+@interface FBVideoFrameDeduplicator : NSObject <FBVideoFrameSource, FBVideoFrameConsumer>
+
+/**
+ Creates a Deduplicator that detects any change and delivers at least 'FBVideoFrameDeduplicatorDefaultMinimumFramesPerSecond'.
+
+ @param frameSource the Frame Source to deduplicate.
+ @return a new Deduplicator.
+ */
++ (instancetype)deduplicatorWithFrameSource:(id<FBVideoFrameSource>)frameSource;
+
+/**
+ Creates a Deduplicator.
+
+ @param frameSource the Frame Source to deduplicate.
+ @param tolerance the largest change in the mean byte value of any tile of a Frame that is considered unchanged, from 0 to 255. 0 treats any detectable change as a change.
+ @param minimumFramesPerSecond the rate at which unchanged Frames are delivered regardless, so that a recording never goes too long without a Frame.
+ @return a new Deduplicator.
+ */
++ (instancetype)deduplicatorWithFrameSource:(id<FBVideoFrameSource>)frameSource tolerance:(double)tolerance minimumFramesPerSecond:(double)minimumFramesPerSecond;
+
+/**
+ The largest change that is considered unchanged.
+ */
+@property (nonatomic, assign, readonly) double tolerance;
+
+/**
+ The rate at which unchanged Frames are delivered regardless.
+ */
+@property (nonatomic, assign, readonly) double minimumFramesPerSecond;
+
+/**
+ The number of Frames delivered to the Consumer.
+ */
+@property (nonatomic, assign, readonly) NSUInteger deliveredFrameCount;
+
+/**
+ The number of Frames dropped as unchanged.
+ */
+@property (nonatomic, assign, readonly) NSUInteger droppedFrameCount;
+
+@end
@@ -0,0 +1,107 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "FBVideoFrameDeduplicator.h"
+
+#import "FBFrameSignature.h"
+
+double const FBVideoFrameDeduplicatorDefaultMinimumFramesPerSecond = 1;
+
+@interface FBVideoFrameDeduplicator ()
+
+@property (nonatomic, strong, readonly) id<FBVideoFrameSource> frameSource;
+@property (nonatomic, strong, readwrite) id<FBVideoFrameConsumer> consumer;
+@property (nonatomic, strong, readwrite) FBFrameSignature *lastSignature;
+@property (nonatomic, assign, readwrite) CMTime lastDeliveredTime;
+@property (nonatomic, assign, readwrite) NSUInteger deliveredFrameCount;
+@property (nonatomic, assign, readwrite) NSUInteger droppedFrameCount;
+
+@end
+
+@implementation FBVideoFrameDeduplicator
+
+#pragma mark Initializers
+
++ (instancetype)deduplicatorWithFrameSource:(id<FBVideoFrameSource>)frameSource
+{
+  return [self deduplicatorWithFrameSource:frameSource tolerance:0 minimumFramesPerSecond:FBVideoFrameDeduplicatorDefaultMinimumFramesPerSecond];
+}
+
++ (instancetype)deduplicatorWithFrameSource:(id<FBVideoFrameSource>)frameSource tolerance:(double)tolerance minimumFramesPerSecond:(double)minimumFramesPerSecond
+{
+  return [[self alloc] initWithFrameSource:frameSource tolerance:tolerance minimumFramesPerSecond:minimumFramesPerSecond];
+}
+
+- (instancetype)initWithFrameSource:(id<FBVideoFrameSource>)frameSource tolerance:(double)tolerance minimumFramesPerSecond:(double)minimumFramesPerSecond
+{
+  NSParameterAssert(frameSource);
+  NSParameterAssert(tolerance >= 0);
+  NSParameterAssert(minimumFramesPerSecond > 0);
+
+  self = [super init];
+  if (!self) {
+    return nil;
+  }
+
+  _frameSource = frameSource;
+  _tolerance = tolerance;
+  _minimumFramesPerSecond = minimumFramesPerSecond;
+  _lastDeliveredTime = kCMTimeInvalid;
+
+  return self;
+}
+
+#pragma mark FBVideoFrameSource
+
+- (BOOL)startWithConsumer:(id<FBVideoFrameConsumer>)consumer error:(NSError **)error
+{
+  @synchronized(self) {
+    self.consumer = consumer;
+    self.lastSignature = nil;
+    self.lastDeliveredTime = kCMTimeInvalid;
+  }
+  return [self.frameSource startWithConsumer:self error:error];
+}
+
+- (void)stop
+{
+  [self.frameSource stop];
+  @synchronized(self) {
+    self.consumer = nil;
+    self.lastSignature = nil;
+  }
+}
+
+#pragma mark FBVideoFrameConsumer
+
+- (void)frameSource:(id<FBVideoFrameSource>)frameSource didProduceFrame:(CVPixelBufferRef)pixelBuffer presentationTime:(CMTime)presentationTime
+{
+  id<FBVideoFrameConsumer> consumer = nil;
+  @synchronized(self) {
+    consumer = self.consumer;
+    if (!consumer) {
+      return;
+    }
+
+    // Frames that cannot be fingerprinted have a nil Signature, so are always delivered.
+    FBFrameSignature *signature = [FBFrameSignature signatureOfPixelBuffer:pixelBuffer];
+    BOOL overdue = !CMTIME_IS_VALID(self.lastDeliveredTime) || CMTimeGetSeconds(CMTimeSubtract(presentationTime, self.lastDeliveredTime)) >= 1 / self.minimumFramesPerSecond;
+    BOOL unchanged = signature && self.lastSignature && [signature differenceFromSignature:self.lastSignature] <= self.tolerance;
+    if (unchanged && !overdue) {
+      self.droppedFrameCount++;
+      return;
+    }
+    self.lastSignature = signature;
+    self.lastDeliveredTime = presentationTime;
+    self.deliveredFrameCount++;
+  }
+  [consumer frameSource:self didProduceFrame:pixelBuffer presentationTime:presentationTime];
+}
+
+@end
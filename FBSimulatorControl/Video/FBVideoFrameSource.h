@@ -0,0 +1,51 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <CoreMedia/CoreMedia.h>
+#import <CoreVideo/CoreVideo.h>
+#import <Foundation/Foundation.h>
+
+@protocol FBVideoFrameSource;
+
+/**
+ Receives Frames from a Frame Source.
+ */
+@protocol FBVideoFrameConsumer <NSObject>
+
+/**
+ Called when a Frame is available. Frames are delivered serially, in presentation order.
+
+ @param frameSource the Frame Source producing the Frame.
+ @param pixelBuffer the Frame. Retain it if it is to be used after this call returns.
+ @param presentationTime the time that the Frame was captured.
+ */
+- (void)frameSource:(id<FBVideoFrameSource>)frameSource didProduceFrame:(CVPixelBufferRef)pixelBuffer presentationTime:(CMTime)presentationTime;
+
+@end
+
+/**
+ Produces Frames, decoupling where Frames come from from what is done with them.
+ */
+@protocol FBVideoFrameSource <NSObject>
+
+/**
+ Starts producing Frames.
+
+ @param consumer the Consumer to deliver Frames to. Is retained until the Source is stopped.
+ @param error an error out for any error that occurred.
+ @return YES if successful, NO otherwise.
+ */
+- (BOOL)startWithConsumer:(id<FBVideoFrameConsumer>)consumer error:(NSError **)error;
+
+/**
+ Stops producing Frames. No Frames are delivered once this method returns.
+ */
+- (void)stop;
+
+@end
@@ -0,0 +1,107 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+/**
+ An encoded, self-contained piece of a recording, that begins with a keyframe.
+ */
+@interface FBVideoSegment : NSObject <NSCopying>
+
+/**
+ Creates and returns a new Segment.
+
+ @param path the path of the movie file containing the Segment.
+ @param startTime the time of the first Frame of the Segment, in seconds from the start of the recording.
+ @param endTime the time at which the Segment ends, in seconds from the start of the recording.
+ @param frameCount the number of Frames in the Segment.
+ @return a new Segment.
+ */
++ (instancetype)segmentWithPath:(NSString *)path startTime:(NSTimeInterval)startTime endTime:(NSTimeInterval)endTime frameCount:(NSUInteger)frameCount;
+
+/**
+ The path of the movie file containing the Segment.
+ */
+@property (nonatomic, copy, readonly) NSString *path;
+
+/**
+ The time of the first Frame of the Segment, in seconds from the start of the recording.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval startTime;
+
+/**
+ The time at which the Segment ends, in seconds from the start of the recording.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval endTime;
+
+/**
+ The duration of the Segment in seconds.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval duration;
+
+/**
+ The number of Frames in the Segment.
+ */
+@property (nonatomic, assign, readonly) NSUInteger frameCount;
+
+@end
+
+/**
+ A bounded ring of the most recent Segments of a recording.
+
+ Segments are appended in order. Once the Segments after the oldest cover the retention window on their own,
+ the oldest Segment is evicted and its file is deleted, so the ring never holds much more than the retention window.
+ */
+@interface FBVideoSegmentRing : NSObject
+
+/**
+ Creates and returns a new Ring.
+
+ @param retention the number of seconds of the most recent Segments to retain.
+ @return a new Ring.
+ */
++ (instancetype)ringWithRetention:(NSTimeInterval)retention;
+
+/**
+ The number of seconds of the most recent Segments to retain.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval retention;
+
+/**
+ An NSArray<FBVideoSegment *> of the retained Segments, oldest first.
+ */
+@property (nonatomic, copy, readonly) NSArray *segments;
+
+/**
+ The combined duration of the retained Segments.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval duration;
+
+/**
+ Appends a Segment, evicting the oldest Segments that are no longer needed to cover the retention window.
+
+ @param segment the Segment to append. Must not start before the end of the newest Segment.
+ @return an NSArray<FBVideoSegment *> of the evicted Segments.
+ */
+- (NSArray *)appendSegment:(FBVideoSegment *)segment;
+
+/**
+ Returns the Segments needed to cover the most recent duration of the recording.
+
+ @param duration the number of seconds, counting back from the end of the newest Segment.
+ @return an NSArray<FBVideoSegment *> of Segments, oldest first. May cover less than the duration if it is longer than what is retained.
+ */
+- (NSArray *)segmentsCoveringLast:(NSTimeInterval)duration;
+
+/**
+ Removes all Segments, deleting their files.
+ */
+- (void)removeAllSegments;
+
+@end
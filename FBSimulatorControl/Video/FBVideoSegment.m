@@ -0,0 +1,190 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "FBVideoSegment.h"
+
+@implementation FBVideoSegment
+
++ (instancetype)segmentWithPath:(NSString *)path startTime:(NSTimeInterval)startTime endTime:(NSTimeInterval)endTime frameCount:(NSUInteger)frameCount
+{
+  return [[self alloc] initWithPath:path startTime:startTime endTime:endTime frameCount:frameCount];
+}
+
+- (instancetype)initWithPath:(NSString *)path startTime:(NSTimeInterval)startTime endTime:(NSTimeInterval)endTime frameCount:(NSUInteger)frameCount
+{
+  NSParameterAssert(path);
+  NSParameterAssert(endTime >= startTime);
+
+  self = [super init];
+  if (!self) {
+    return nil;
+  }
+
+  _path = [path copy];
+  _startTime = startTime;
+  _endTime = endTime;
+  _frameCount = frameCount;
+
+  return self;
+}
+
+- (NSTimeInterval)duration
+{
+  return self.endTime - self.startTime;
+}
+
+#pragma mark NSCopying
+
+- (instancetype)copyWithZone:(NSZone *)zone
+{
+  return self;
+}
+
+#pragma mark NSObject
+
+- (BOOL)isEqual:(FBVideoSegment *)object
+{
+  if (![object isKindOfClass:self.class]) {
+    return NO;
+  }
+  return [self.path isEqualToString:object.path] &&
+         self.startTime == object.startTime &&
+         self.endTime == object.endTime &&
+         self.frameCount == object.frameCount;
+}
+
+- (NSUInteger)hash
+{
+  return self.path.hash ^ (NSUInteger) (self.startTime * 1000);
+}
+
+- (NSString *)description
+{
+  return [NSString stringWithFormat:
+    @"Segment %@ | %.3fs - %.3fs | %lu Frames",
+    self.path.lastPathComponent,
+    self.startTime,
+    self.endTime,
+    (unsigned long) self.frameCount
+  ];
+}
+
+@end
+
+@interface FBVideoSegmentRing ()
+
+@property (nonatomic, strong, readonly) NSMutableArray *mutableSegments;
+
+@end
+
+@implementation FBVideoSegmentRing
+
++ (instancetype)ringWithRetention:(NSTimeInterval)retention
+{
+  return [[self alloc] initWithRetention:retention];
+}
+
+- (instancetype)initWithRetention:(NSTimeInterval)retention
+{
+  NSParameterAssert(retention > 0);
+
+  self = [super init];
+  if (!self) {
+    return nil;
+  }
+
+  _retention = retention;
+  _mutableSegments = [NSMutableArray array];
+
+  return self;
+}
+
+#pragma mark Public
+
+- (NSArray *)segments
+{
+  @synchronized(self) {
+    return [self.mutableSegments copy];
+  }
+}
+
+- (NSTimeInterval)duration
+{
+  @synchronized(self) {
+    FBVideoSegment *oldest = self.mutableSegments.firstObject;
+    FBVideoSegment *newest = self.mutableSegments.lastObject;
+    return newest.endTime - oldest.startTime;
+  }
+}
+
+- (NSArray *)appendSegment:(FBVideoSegment *)segment
+{
+  NSParameterAssert(segment);
+
+  @synchronized(self) {
+    NSParameterAssert(segment.startTime >= [self.mutableSegments.lastObject endTime]);
+    [self.mutableSegments addObject:segment];
+
+    // The oldest Segment can go once the Segment after it starts at, or before, the beginning of the window.
+    NSMutableArray *evicted = [NSMutableArray array];
+    NSTimeInterval windowStart = segment.endTime - self.retention;
+    while (self.mutableSegments.count > 1 && [self.mutableSegments[1] startTime] <= windowStart) {
+      [evicted addObject:self.mutableSegments.firstObject];
+      [self.mutableSegments removeObjectAtIndex:0];
+    }
+    [FBVideoSegmentRing deleteFilesOfSegments:evicted];
+    return [evicted copy];
+  }
+}
+
+- (NSArray *)segmentsCoveringLast:(NSTimeInterval)duration
+{
+  @synchronized(self) {
+    NSTimeInterval windowStart = [self.mutableSegments.lastObject endTime] - duration;
+    NSMutableArray *segments = [NSMutableArray array];
+    for (FBVideoSegment *segment in self.mutableSegments.reverseObjectEnumerator) {
+      [segments insertObject:segment atIndex:0];
+      if (segment.startTime <= windowStart) {
+        break;
+      }
+    }
+    return [segments copy];
+  }
+}
+
+- (void)removeAllSegments
+{
+  @synchronized(self) {
+    [FBVideoSegmentRing deleteFilesOfSegments:self.mutableSegments];
+    [self.mutableSegments removeAllObjects];
+  }
+}
+
+#pragma mark NSObject
+
+- (NSString *)description
+{
+  return [NSString stringWithFormat:
+    @"Segment Ring | Retention %.1fs | %lu Segments | Duration %.3fs",
+    self.retention,
+    (unsigned long) self.segments.count,
+    self.duration
+  ];
+}
+
+#pragma mark Private
+
++ (void)deleteFilesOfSegments:(NSArray *)segments
+{
+  for (FBVideoSegment *segment in segments) {
+    [NSFileManager.defaultManager removeItemAtPath:segment.path error:nil];
+  }
+}
+
+@end
@@ -0,0 +1,171 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+@class FBVideoSegment;
+
+/**
+ A named point in a Segmented recording, such as the start of a Test.
+ */
+@interface FBVideoMarker : NSObject <NSCopying>
+
+/**
+ Creates and returns a new Marker.
+
+ @param name the name of the Marker.
+ @param time the time of the Marker, in seconds from the start of the recording.
+ @return a new Marker.
+ */
++ (instancetype)markerWithName:(NSString *)name time:(NSTimeInterval)time;
+
+/**
+ The name of the Marker.
+ */
+@property (nonatomic, copy, readonly) NSString *name;
+
+/**
+ The time of the Marker, in seconds from the start of the recording.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval time;
+
+@end
+
+/**
+ A contiguous span of a Segmented recording, along with the Segments that contain it.
+ */
+@interface FBVideoSpan : NSObject <NSCopying>
+
+/**
+ An NSArray<FBVideoSegment *> of the Segments that contain the Span, oldest first.
+ */
+@property (nonatomic, copy, readonly) NSArray *segments;
+
+/**
+ The start of the Span, in seconds from the start of the recording.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval startTime;
+
+/**
+ The end of the Span, in seconds from the start of the recording.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval endTime;
+
+/**
+ The duration of the Span in seconds.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval duration;
+
+@end
+
+/**
+ An immutable index of a Segmented recording, mapping Markers and wall-clock times to Segment files and offsets within them.
+ Is persisted as a JSON sidecar file alongside the Segments.
+ */
+@interface FBVideoSegmentIndex : NSObject <NSCopying>
+
+/**
+ Creates and returns a new Index.
+
+ @param startDate the wall-clock date of the start of the recording.
+ @param segments an NSArray<FBVideoSegment *> of contiguous Segments, oldest first.
+ @param markers an NSArray<FBVideoMarker *> of Markers, in order of time.
+ @return a new Index.
+ */
++ (instancetype)indexWithStartDate:(NSDate *)startDate segments:(NSArray *)segments markers:(NSArray *)markers;
+
+/**
+ Reads an Index from a sidecar file.
+ Segment files are resolved relative to the directory containing the sidecar file.
+
+ @param path the path of the sidecar file.
+ @param error an error out for any error that occurred.
+ @return a new Index if the file could be read, nil otherwise.
+ */
++ (instancetype)indexWithContentsOfFile:(NSString *)path error:(NSError **)error;
+
+/**
+ The wall-clock date of the start of the recording.
+ */
+@property (nonatomic, copy, readonly) NSDate *startDate;
+
+/**
+ An NSArray<FBVideoSegment *> of the Segments of the recording, oldest first.
+ */
+@property (nonatomic, copy, readonly) NSArray *segments;
+
+/**
+ An NSArray<FBVideoMarker *> of the Markers in the recording, in order of time.
+ */
+@property (nonatomic, copy, readonly) NSArray *markers;
+
+/**
+ Returns a new Index with the Segment appended.
+
+ @param segment the Segment to append. Must not start before the end of the last Segment.
+ @return a new Index.
+ */
+- (instancetype)indexByAppendingSegment:(FBVideoSegment *)segment;
+
+/**
+ Returns a new Index with the Marker appended.
+
+ @param marker the Marker to append. Must not be before the last Marker.
+ @return a new Index.
+ */
+- (instancetype)indexByAppendingMarker:(FBVideoMarker *)marker;
+
+/**
+ Returns the Segment that contains the given time.
+
+ @param time the time, in seconds from the start of the recording.
+ @return the Segment containing the time, or nil if no Segment contains it.
+ */
+- (FBVideoSegment *)segmentContainingTime:(NSTimeInterval)time;
+
+/**
+ Resolves a span of the recording, clamping it to the recorded Segments.
+
+ @param startTime the start of the span, in seconds from the start of the recording.
+ @param endTime the end of the span, in seconds from the start of the recording.
+ @param error an error out for any error that occurred.
+ @return a Span if any of it is recorded, nil otherwise.
+ */
+- (FBVideoSpan *)spanFromTime:(NSTimeInterval)startTime toTime:(NSTimeInterval)endTime error:(NSError **)error;
+
+/**
+ Resolves a span of the recording between two wall-clock dates, such as the timestamps of FBSimulatorHistory.
+
+ @param startDate the start of the span.
+ @param endDate the end of the span.
+ @param error an error out for any error that occurred.
+ @return a Span if any of it is recorded, nil otherwise.
+ */
+- (FBVideoSpan *)spanFromDate:(NSDate *)startDate toDate:(NSDate *)endDate error:(NSError **)error;
+
+/**
+ Resolves the span of the recording from the last Marker with the given name, to the Marker after it or the end of the recording.
+
+ @param name the name of the Marker.
+ @param error an error out for any error that occurred.
+ @return a Span if the Marker exists and any of its span is recorded, nil otherwise.
+ */
+- (FBVideoSpan *)spanOfMarkerNamed:(NSString *)name error:(NSError **)error;
+
+/**
+ Writes the Index as a JSON sidecar file.
+ Segments are referred to by file name, so the sidecar file should be in the same directory as the Segments.
+
+ @param path the path to write to.
+ @param error an error out for any error that occurred.
+ @return YES if successful, NO otherwise.
+ */
+- (BOOL)writeToFile:(NSString *)path error:(NSError **)error;
+
+@end
@@ -0,0 +1,357 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "FBVideoSegmentIndex.h"
+
+#import "FBSimulatorError.h"
+#import "FBVideoSegment.h"
+
+static NSString *const KeyStartDate = @"start_date";
+static NSString *const KeySegments = @"segments";
+static NSString *const KeyMarkers = @"markers";
+static NSString *const KeyFile = @"file";
+static NSString *const KeyStart = @"start";
+static NSString *const KeyEnd = @"end";
+static NSString *const KeyFrames = @"frames";
+static NSString *const KeyName = @"name";
+static NSString *const KeyTime = @"time";
+static NSString *const KeySegment = @"segment";
+static NSString *const KeyOffset = @"offset";
+
+@implementation FBVideoMarker
+
++ (instancetype)markerWithName:(NSString *)name time:(NSTimeInterval)time
+{
+  return [[self alloc] initWithName:name time:time];
+}
+
+- (instancetype)initWithName:(NSString *)name time:(NSTimeInterval)time
+{
+  NSParameterAssert(name);
+
+  self = [super init];
+  if (!self) {
+    return nil;
+  }
+
+  _name = [name copy];
+  _time = time;
+
+  return self;
+}
+
+#pragma mark NSCopying
+
+- (instancetype)copyWithZone:(NSZone *)zone
+{
+  return self;
+}
+
+#pragma mark NSObject
+
+- (BOOL)isEqual:(FBVideoMarker *)object
+{
+  if (![object isKindOfClass:self.class]) {
+    return NO;
+  }
+  return [self.name isEqualToString:object.name] && self.time == object.time;
+}
+
+- (NSUInteger)hash
+{
+  return self.name.hash ^ (NSUInteger) (self.time * 1000);
+}
+
+- (NSString *)description
+{
+  return [NSString stringWithFormat:@"Marker '%@' at %.3fs", self.name, self.time];
+}
+
+@end
+
+@implementation FBVideoSpan
+
+- (instancetype)initWithSegments:(NSArray *)segments startTime:(NSTimeInterval)startTime endTime:(NSTimeInterval)endTime
+{
+  self = [super init];
+  if (!self) {
+    return nil;
+  }
+
+  _segments = [segments copy];
+  _startTime = startTime;
+  _endTime = endTime;
+
+  return self;
+}
+
+- (NSTimeInterval)duration
+{
+  return self.endTime - self.startTime;
+}
+
+#pragma mark NSCopying
+
+- (instancetype)copyWithZone:(NSZone *)zone
+{
+  return self;
+}
+
+#pragma mark NSObject
+
+- (BOOL)isEqual:(FBVideoSpan *)object
+{
+  if (![object isKindOfClass:self.class]) {
+    return NO;
+  }
+  return [self.segments isEqualToArray:object.segments] &&
+         self.startTime == object.startTime &&
+         self.endTime == object.endTime;
+}
+
+- (NSUInteger)hash
+{
+  return self.segments.hash ^ (NSUInteger) (self.startTime * 1000);
+}
+
+- (NSString *)description
+{
+  return [NSString stringWithFormat:
+    @"Span %.3fs - %.3fs | %lu Segments",
+    self.startTime,
+    self.endTime,
+    (unsigned long) self.segments.count
+  ];
+}
+
+@end
+
+@implementation FBVideoSegmentIndex
+
+#pragma mark Initializers
+
++ (instancetype)indexWithStartDate:(NSDate *)startDate segments:(NSArray *)segments markers:(NSArray *)markers
+{
+  return [[self alloc] initWithStartDate:startDate segments:segments markers:markers];
+}
+
++ (instancetype)indexWithContentsOfFile:(NSString *)path error:(NSError **)error
+{
+  NSError *innerError = nil;
+  NSData *data = [NSData dataWithContentsOfFile:path options:0 error:&innerError];
+  if (!data) {
+    return [[[FBSimulatorError describeFormat:@"Could not read Video Index at path %@", path] causedBy:innerError] fail:error];
+  }
+  NSDictionary *json = [NSJSONSerialization JSONObjectWithData:data options:0 error:&innerError];
+  if (![json isKindOfClass:NSDictionary.class]) {
+    return [[[FBSimulatorError describeFormat:@"Video Index at path %@ is not a JSON Object", path] causedBy:innerError] fail:error];
+  }
+  NSNumber *startDate = json[KeyStartDate];
+  if (![startDate isKindOfClass:NSNumber.class]) {
+    return [[FBSimulatorError describeFormat:@"Video Index at path %@ has no %@", path, KeyStartDate] fail:error];
+  }
+
+  NSString *directory = path.stringByDeletingLastPathComponent;
+  NSMutableArray *segments = [NSMutableArray array];
+  for (NSDictionary *entry in json[KeySegments]) {
+    if (![entry isKindOfClass:NSDictionary.class] || ![entry[KeyFile] isKindOfClass:NSString.class] || ![entry[KeyStart] isKindOfClass:NSNumber.class] || ![entry[KeyEnd] isKindOfClass:NSNumber.class]) {
+      return [[FBSimulatorError describeFormat:@"Video Index Segment %@ is malformed", entry] fail:error];
+    }
+    NSString *file = entry[KeyFile];
+    [segments addObject:[FBVideoSegment
+      segmentWithPath:(file.isAbsolutePath ? file : [directory stringByAppendingPathComponent:file])
+      startTime:[entry[KeyStart] doubleValue]
+      endTime:[entry[KeyEnd] doubleValue]
+      frameCount:[entry[KeyFrames] unsignedIntegerValue]]];
+  }
+  NSMutableArray *markers = [NSMutableArray array];
+  for (NSDictionary *entry in json[KeyMarkers]) {
+    if (![entry isKindOfClass:NSDictionary.class] || ![entry[KeyName] isKindOfClass:NSString.class] || ![entry[KeyTime] isKindOfClass:NSNumber.class]) {
+      return [[FBSimulatorError describeFormat:@"Video Index Marker %@ is malformed", entry] fail:error];
+    }
+    [markers addObject:[FBVideoMarker markerWithName:entry[KeyName] time:[entry[KeyTime] doubleValue]]];
+  }
+
+  return [self indexWithStartDate:[NSDate dateWithTimeIntervalSince1970:startDate.doubleValue] segments:segments markers:markers];
+}
+
+- (instancetype)initWithStartDate:(NSDate *)startDate segments:(NSArray *)segments markers:(NSArray *)markers
+{
+  NSParameterAssert(startDate);
+
+  self = [super init];
+  if (!self) {
+    return nil;
+  }
+
+  _startDate = [startDate copy];
+  _segments = [segments copy] ?: @[];
+  _markers = [markers copy] ?: @[];
+
+  return self;
+}
+
+#pragma mark Public
+
+- (instancetype)indexByAppendingSegment:(FBVideoSegment *)segment
+{
+  NSParameterAssert(segment.startTime >= [self.segments.lastObject endTime]);
+  return [FBVideoSegmentIndex indexWithStartDate:self.startDate segments:[self.segments arrayByAddingObject:segment] markers:self.markers];
+}
+
+- (instancetype)indexByAppendingMarker:(FBVideoMarker *)marker
+{
+  NSParameterAssert(marker.time >= [self.markers.lastObject time]);
+  return [FBVideoSegmentIndex indexWithStartDate:self.startDate segments:self.segments markers:[self.markers arrayByAddingObject:marker]];
+}
+
+- (FBVideoSegment *)segmentContainingTime:(NSTimeInterval)time
+{
+  for (FBVideoSegment *segment in self.segments) {
+    if (segment.startTime <= time && time < segment.endTime) {
+      return segment;
+    }
+  }
+  return nil;
+}
+
+- (FBVideoSpan *)spanFromTime:(NSTimeInterval)startTime toTime:(NSTimeInterval)endTime error:(NSError **)error
+{
+  if (endTime <= startTime) {
+    return [[FBSimulatorError describeFormat:@"Span %.3fs - %.3fs ends before it starts", startTime, endTime] fail:error];
+  }
+  if (self.segments.count == 0) {
+    return [[FBSimulatorError describe:@"Cannot resolve a Span of a recording without any Segments"] fail:error];
+  }
+
+  startTime = MAX(startTime, [self.segments.firstObject startTime]);
+  endTime = MIN(endTime, [self.segments.lastObject endTime]);
+  NSMutableArray *segments = [NSMutableArray array];
+  for (FBVideoSegment *segment in self.segments) {
+    if (segment.endTime > startTime && segment.startTime < endTime) {
+      [segments addObject:segment];
+    }
+  }
+  if (segments.count == 0 || endTime <= startTime) {
+    return [[FBSimulatorError describeFormat:@"Span %.3fs - %.3fs is not within the recording", startTime, endTime] fail:error];
+  }
+  return [[FBVideoSpan alloc] initWithSegments:segments startTime:startTime endTime:endTime];
+}
+
+- (FBVideoSpan *)spanFromDate:(NSDate *)startDate toDate:(NSDate *)endDate error:(NSError **)error
+{
+  NSParameterAssert(startDate);
+  NSParameterAssert(endDate);
+
+  return [self
+    spanFromTime:[startDate timeIntervalSinceDate:self.startDate]
+    toTime:[endDate timeIntervalSinceDate:self.startDate]
+    error:error];
+}
+
+- (FBVideoSpan *)spanOfMarkerNamed:(NSString *)name error:(NSError **)error
+{
+  NSParameterAssert(name);
+
+  NSUInteger index = [self.markers indexOfObjectWithOptions:NSEnumerationReverse passingTest:^ BOOL (FBVideoMarker *marker, NSUInteger _, BOOL *__) {
+    return [marker.name isEqualToString:name];
+  }];
+  if (index == NSNotFound) {
+    return [[FBSimulatorError describeFormat:@"No Marker named '%@' in %@", name, self.markers] fail:error];
+  }
+
+  NSTimeInterval startTime = [self.markers[index] time];
+  NSTimeInterval endTime = (index + 1 < self.markers.count) ? [self.markers[index + 1] time] : [self.segments.lastObject endTime];
+  return [self spanFromTime:startTime toTime:endTime error:error];
+}
+
+- (BOOL)writeToFile:(NSString *)path error:(NSError **)error
+{
+  NSError *innerError = nil;
+  NSData *data = [NSJSONSerialization dataWithJSONObject:self.jsonRepresentation options:NSJSONWritingPrettyPrinted error:&innerError];
+  if (!data) {
+    return [[[FBSimulatorError describe:@"Could not serialize Video Index"] causedBy:innerError] failBool:error];
+  }
+  if (![data writeToFile:path options:NSDataWritingAtomic error:&innerError]) {
+    return [[[FBSimulatorError describeFormat:@"Could not write Video Index to path %@", path] causedBy:innerError] failBool:error];
+  }
+  return YES;
+}
+
+#pragma mark NSCopying
+
+- (instancetype)copyWithZone:(NSZone *)zone
+{
+  return self;
+}
+
+#pragma mark NSObject
+
+- (BOOL)isEqual:(FBVideoSegmentIndex *)object
+{
+  if (![object isKindOfClass:self.class]) {
+    return NO;
+  }
+  return [self.startDate isEqualToDate:object.startDate] &&
+         [self.segments isEqualToArray:object.segments] &&
+         [self.markers isEqualToArray:object.markers];
+}
+
+- (NSUInteger)hash
+{
+  return self.startDate.hash ^ self.segments.hash ^ self.markers.hash;
+}
+
+- (NSString *)description
+{
+  return [NSString stringWithFormat:
+    @"Video Index | Start %@ | %lu Segments | %lu Markers",
+    self.startDate,
+    (unsigned long) self.segments.count,
+    (unsigned long) self.markers.count
+  ];
+}
+
+#pragma mark Private
+
+- (NSDictionary *)jsonRepresentation
+{
+  NSMutableArray *segments = [NSMutableArray array];
+  for (FBVideoSegment *segment in self.segments) {
+    [segments addObject:@{
+      KeyFile : segment.path.lastPathComponent,
+      KeyStart : @(segment.startTime),
+      KeyEnd : @(segment.endTime),
+      KeyFrames : @(segment.frameCount),
+    }];
+  }
+
+  // The Segment and offset of a Marker are derived, but are written so that the sidecar can be used without this class.
+  NSMutableArray *markers = [NSMutableArray array];
+  for (FBVideoMarker *marker in self.markers) {
+    NSMutableDictionary *entry = [@{
+      KeyName : marker.name,
+      KeyTime : @(marker.time),
+    } mutableCopy];
+    FBVideoSegment *segment = [self segmentContainingTime:marker.time];
+    if (segment) {
+      entry[KeySegment] = segment.path.lastPathComponent;
+      entry[KeyOffset] = @(marker.time - segment.startTime);
+    }
+    [markers addObject:[entry copy]];
+  }
+
+  return @{
+    KeyStartDate : @(self.startDate.timeIntervalSince1970),
+    KeySegments : [segments copy],
+    KeyMarkers : [markers copy],
+  };
+}
+
+@end
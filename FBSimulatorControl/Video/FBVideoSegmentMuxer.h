@@ -0,0 +1,44 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+/**
+ Joins Segments into a standalone movie file, without re-encoding.
+ */
+@interface FBVideoSegmentMuxer : NSObject
+
+/**
+ Joins the Segments, in order, into a movie file.
+ The container is chosen from the extension of the path: '.mp4' or '.m4v' for MPEG-4, QuickTime otherwise.
+ Will delete and overwrite any existing file at the path.
+
+ @param segments an NSArray<FBVideoSegment *> of the Segments to join. Must be contiguous and in order.
+ @param startTime the time, in seconds from the start of the recording, to start the movie from. Earlier parts of the first Segment are trimmed.
+ @param filePath the path to write the movie to.
+ @param error an error out for any error that occurred.
+ @return YES if successful, NO otherwise.
+ */
++ (BOOL)muxSegments:(NSArray *)segments fromTime:(NSTimeInterval)startTime toFilePath:(NSString *)filePath error:(NSError **)error;
+
+/**
+ Joins the Segments, in order, into a movie file, trimming the movie to a span of the recording.
+ The container is chosen from the extension of the path: '.mp4' or '.m4v' for MPEG-4, QuickTime otherwise.
+ Will delete and overwrite any existing file at the path.
+
+ @param segments an NSArray<FBVideoSegment *> of the Segments to join. Must be contiguous and in order.
+ @param startTime the time, in seconds from the start of the recording, to start the movie from.
+ @param endTime the time, in seconds from the start of the recording, to end the movie at.
+ @param filePath the path to write the movie to.
+ @param error an error out for any error that occurred.
+ @return YES if successful, NO otherwise.
+ */
++ (BOOL)muxSegments:(NSArray *)segments fromTime:(NSTimeInterval)startTime toTime:(NSTimeInterval)endTime toFilePath:(NSString *)filePath error:(NSError **)error;
+
+@end
@@ -0,0 +1,88 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "FBVideoSegmentMuxer.h"
+
+#import <AVFoundation/AVFoundation.h>
+
+#import "FBSimulatorError.h"
+#import "FBVideoSegment.h"
+
+static int32_t const TimeScale = 600;
+
+@implementation FBVideoSegmentMuxer
+
++ (BOOL)muxSegments:(NSArray *)segments fromTime:(NSTimeInterval)startTime toFilePath:(NSString *)filePath error:(NSError **)error
+{
+  return [self muxSegments:segments fromTime:startTime toTime:[segments.lastObject endTime] toFilePath:filePath error:error];
+}
+
++ (BOOL)muxSegments:(NSArray *)segments fromTime:(NSTimeInterval)startTime toTime:(NSTimeInterval)endTime toFilePath:(NSString *)filePath error:(NSError **)error
+{
+  if (segments.count == 0) {
+    return [[FBSimulatorError describe:@"Cannot create a movie without any Segments"] failBool:error];
+  }
+
+  AVMutableComposition *composition = [AVMutableComposition composition];
+  AVMutableCompositionTrack *compositionTrack = [composition addMutableTrackWithMediaType:AVMediaTypeVideo preferredTrackID:kCMPersistentTrackID_Invalid];
+  CMTime cursor = kCMTimeZero;
+  NSError *innerError = nil;
+
+  for (FBVideoSegment *segment in segments) {
+    AVURLAsset *asset = [AVURLAsset URLAssetWithURL:[NSURL fileURLWithPath:segment.path] options:@{AVURLAssetPreferPreciseDurationAndTimingKey : @YES}];
+    AVAssetTrack *track = [asset tracksWithMediaType:AVMediaTypeVideo].firstObject;
+    if (!track) {
+      return [[FBSimulatorError describeFormat:@"%@ does not contain a video track", segment] failBool:error];
+    }
+
+    // Only the first and last Segments are trimmed, since the Segments between are wholly within the span.
+    NSTimeInterval headTrim = MAX(startTime - segment.startTime, 0);
+    NSTimeInterval tailTrim = MAX(segment.endTime - endTime, 0);
+    CMTime trackStart = CMTimeAdd(track.timeRange.start, CMTimeMakeWithSeconds(headTrim, TimeScale));
+    CMTime trackEnd = CMTimeSubtract(CMTimeRangeGetEnd(track.timeRange), CMTimeMakeWithSeconds(tailTrim, TimeScale));
+    CMTime trackDuration = CMTimeSubtract(trackEnd, trackStart);
+    if (CMTimeCompare(trackDuration, kCMTimeZero) <= 0) {
+      continue;
+    }
+    CMTimeRange range = CMTimeRangeMake(trackStart, trackDuration);
+    if (![compositionTrack insertTimeRange:range ofTrack:track atTime:cursor error:&innerError]) {
+      return [[[FBSimulatorError describeFormat:@"Could not insert %@ into the movie", segment] causedBy:innerError] failBool:error];
+    }
+    if (CMTimeCompare(cursor, kCMTimeZero) == 0) {
+      compositionTrack.preferredTransform = track.preferredTransform;
+    }
+    cursor = CMTimeAdd(cursor, trackDuration);
+  }
+  if (CMTimeCompare(cursor, kCMTimeZero) == 0) {
+    return [[FBSimulatorError describeFormat:@"Segments %@ contain nothing between %.3fs and %.3fs", segments, startTime, endTime] failBool:error];
+  }
+
+  if ([NSFileManager.defaultManager fileExistsAtPath:filePath] && ![NSFileManager.defaultManager removeItemAtPath:filePath error:&innerError]) {
+    return [[[FBSimulatorError describeFormat:@"Cannot remove existing video at '%@'", filePath] causedBy:innerError] failBool:error];
+  }
+
+  // Passthrough copies the encoded samples into the new container, so is fast and lossless.
+  AVAssetExportSession *exportSession = [AVAssetExportSession exportSessionWithAsset:composition presetName:AVAssetExportPresetPassthrough];
+  exportSession.outputURL = [NSURL fileURLWithPath:filePath];
+  NSString *extension = filePath.pathExtension.lowercaseString;
+  exportSession.outputFileType = ([extension isEqualToString:@"mp4"] || [extension isEqualToString:@"m4v"]) ? AVFileTypeMPEG4 : AVFileTypeQuickTimeMovie;
+
+  dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+  [exportSession exportAsynchronouslyWithCompletionHandler:^{
+    dispatch_semaphore_signal(semaphore);
+  }];
+  dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+
+  if (exportSession.status != AVAssetExportSessionStatusCompleted) {
+    return [[[FBSimulatorError describeFormat:@"Failed to write movie to %@", filePath] causedBy:exportSession.error] failBool:error];
+  }
+  return YES;
+}
+
+@end
@@ -0,0 +1,62 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <CoreMedia/CoreMedia.h>
+#import <CoreVideo/CoreVideo.h>
+#import <Foundation/Foundation.h>
+
+@class FBVideoSegment;
+
+/**
+ Encodes Frames into a single H.264 Segment file.
+ The dimensions of the Segment are those of the first Frame.
+ The container is MPEG-4 for paths with an 'mp4' or 'm4v' extension, QuickTime otherwise.
+ */
+@interface FBVideoSegmentWriter : NSObject
+
+/**
+ Creates a new Segment Writer.
+
+ @param path the path to write the Segment to. Any existing file is overwritten.
+ @param origin the presentation time of the start of the recording, that Segment times are relative to.
+ @return a new Segment Writer.
+ */
++ (instancetype)writerWithPath:(NSString *)path origin:(CMTime)origin;
+
+/**
+ The number of Frames that have been appended.
+ */
+@property (nonatomic, assign, readonly) NSUInteger frameCount;
+
+/**
+ The presentation time of the first Frame, kCMTimeInvalid if there are no Frames.
+ */
+@property (nonatomic, assign, readonly) CMTime firstFrameTime;
+
+/**
+ Encodes a Frame.
+ Does not wait for the encoder, so fails if the encoder is not ready for more Frames. The Frame should then be dropped.
+
+ @param pixelBuffer the Frame to encode.
+ @param presentationTime the presentation time of the Frame. Must be after that of the previous Frame.
+ @param error an error out for any error that occurred.
+ @return YES if successful, NO otherwise.
+ */
+- (BOOL)appendFrame:(CVPixelBufferRef)pixelBuffer presentationTime:(CMTime)presentationTime error:(NSError **)error;
+
+/**
+ Finishes the Segment file, blocking until it has been written.
+
+ @param endTime the presentation time at which the last Frame stops being displayed.
+ @param error an error out for any error that occurred.
+ @return the Segment if successful, nil otherwise.
+ */
+- (FBVideoSegment *)finishAtTime:(CMTime)endTime error:(NSError **)error;
+
+@end
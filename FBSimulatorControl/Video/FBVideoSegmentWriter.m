@@ -0,0 +1,146 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "FBVideoSegmentWriter.h"
+
+#import <AVFoundation/AVFoundation.h>
+
+#import "FBSimulatorError.h"
+#import "FBVideoSegment.h"
+
+@interface FBVideoSegmentWriter ()
+
+@property (nonatomic, copy, readonly) NSString *path;
+@property (nonatomic, assign, readonly) CMTime origin;
+
+@property (nonatomic, strong, readwrite) AVAssetWriter *writer;
+@property (nonatomic, strong, readwrite) AVAssetWriterInput *input;
+@property (nonatomic, strong, readwrite) AVAssetWriterInputPixelBufferAdaptor *adaptor;
+@property (nonatomic, assign, readwrite) NSUInteger frameCount;
+@property (nonatomic, assign, readwrite) CMTime firstFrameTime;
+@property (nonatomic, assign, readwrite) CMTime lastFrameTime;
+
+@end
+
+@implementation FBVideoSegmentWriter
+
++ (instancetype)writerWithPath:(NSString *)path origin:(CMTime)origin
+{
+  return [[self alloc] initWithPath:path origin:origin];
+}
+
+- (instancetype)initWithPath:(NSString *)path origin:(CMTime)origin
+{
+  NSParameterAssert(path);
+  NSParameterAssert(CMTIME_IS_VALID(origin));
+
+  self = [super init];
+  if (!self) {
+    return nil;
+  }
+
+  _path = [path copy];
+  _origin = origin;
+  _firstFrameTime = kCMTimeInvalid;
+  _lastFrameTime = kCMTimeInvalid;
+
+  return self;
+}
+
+#pragma mark Public
+
+- (BOOL)appendFrame:(CVPixelBufferRef)pixelBuffer presentationTime:(CMTime)presentationTime error:(NSError **)error
+{
+  if (!self.writer && ![self createWriterForFrame:pixelBuffer presentationTime:presentationTime error:error]) {
+    return NO;
+  }
+  if (CMTIME_IS_VALID(self.lastFrameTime) && CMTimeCompare(presentationTime, self.lastFrameTime) <= 0) {
+    return [[FBSimulatorError describeFormat:@"Frame at %.3fs is not after the previous Frame", CMTimeGetSeconds(presentationTime)] failBool:error];
+  }
+  // Frames arrive in real time and the caller may be holding up other producers, so the Frame is dropped rather than waiting for the encoder.
+  if (!self.input.isReadyForMoreMediaData) {
+    return [[FBSimulatorError describeFormat:@"Encoder is not ready for the Frame at %.3fs", CMTimeGetSeconds(presentationTime)] failBool:error];
+  }
+  // Times are rebased so that each Segment file starts at zero.
+  if (![self.adaptor appendPixelBuffer:pixelBuffer withPresentationTime:CMTimeSubtract(presentationTime, self.firstFrameTime)]) {
+    return [[[FBSimulatorError describeFormat:@"Could not encode the Frame at %.3fs", CMTimeGetSeconds(presentationTime)] causedBy:self.writer.error] failBool:error];
+  }
+  self.lastFrameTime = presentationTime;
+  self.frameCount++;
+  return YES;
+}
+
+- (FBVideoSegment *)finishAtTime:(CMTime)endTime error:(NSError **)error
+{
+  if (!self.writer) {
+    return [[FBSimulatorError describeFormat:@"Cannot finish Segment %@ without any Frames", self.path] fail:error];
+  }
+  if (CMTimeCompare(endTime, self.lastFrameTime) <= 0) {
+    return [[FBSimulatorError describeFormat:@"Segment %@ cannot end at %.3fs, before its last Frame", self.path, CMTimeGetSeconds(endTime)] fail:error];
+  }
+
+  [self.input markAsFinished];
+  [self.writer endSessionAtSourceTime:CMTimeSubtract(endTime, self.firstFrameTime)];
+  dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+  [self.writer finishWritingWithCompletionHandler:^{
+    dispatch_semaphore_signal(semaphore);
+  }];
+  dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+
+  if (self.writer.status != AVAssetWriterStatusCompleted) {
+    return [[[FBSimulatorError describeFormat:@"Failed to write Segment %@", self.path] causedBy:self.writer.error] fail:error];
+  }
+  return [FBVideoSegment
+    segmentWithPath:self.path
+    startTime:CMTimeGetSeconds(CMTimeSubtract(self.firstFrameTime, self.origin))
+    endTime:CMTimeGetSeconds(CMTimeSubtract(endTime, self.origin))
+    frameCount:self.frameCount];
+}
+
+#pragma mark Private
+
+- (BOOL)createWriterForFrame:(CVPixelBufferRef)pixelBuffer presentationTime:(CMTime)presentationTime error:(NSError **)error
+{
+  NSError *innerError = nil;
+  if ([NSFileManager.defaultManager fileExistsAtPath:self.path] && ![NSFileManager.defaultManager removeItemAtPath:self.path error:&innerError]) {
+    return [[[FBSimulatorError describeFormat:@"Cannot remove existing Segment at '%@'", self.path] causedBy:innerError] failBool:error];
+  }
+  NSString *extension = self.path.pathExtension.lowercaseString;
+  NSString *fileType = ([extension isEqualToString:@"mp4"] || [extension isEqualToString:@"m4v"]) ? AVFileTypeMPEG4 : AVFileTypeQuickTimeMovie;
+  AVAssetWriter *writer = [AVAssetWriter assetWriterWithURL:[NSURL fileURLWithPath:self.path] fileType:fileType error:&innerError];
+  if (!writer) {
+    return [[[FBSimulatorError describeFormat:@"Could not create a writer for Segment %@", self.path] causedBy:innerError] failBool:error];
+  }
+
+  NSDictionary *settings = @{
+    AVVideoCodecKey : AVVideoCodecH264,
+    AVVideoWidthKey : @(CVPixelBufferGetWidth(pixelBuffer)),
+    AVVideoHeightKey : @(CVPixelBufferGetHeight(pixelBuffer)),
+  };
+  AVAssetWriterInput *input = [AVAssetWriterInput assetWriterInputWithMediaType:AVMediaTypeVideo outputSettings:settings];
+  input.expectsMediaDataInRealTime = YES;
+  if (![writer canAddInput:input]) {
+    return [[FBSimulatorError describeFormat:@"Could not add an input to the writer for Segment %@", self.path] failBool:error];
+  }
+  [writer addInput:input];
+  AVAssetWriterInputPixelBufferAdaptor *adaptor = [AVAssetWriterInputPixelBufferAdaptor assetWriterInputPixelBufferAdaptorWithAssetWriterInput:input sourcePixelBufferAttributes:nil];
+
+  if (![writer startWriting]) {
+    return [[[FBSimulatorError describeFormat:@"Could not start writing Segment %@", self.path] causedBy:writer.error] failBool:error];
+  }
+  [writer startSessionAtSourceTime:kCMTimeZero];
+
+  self.writer = writer;
+  self.input = input;
+  self.adaptor = adaptor;
+  self.firstFrameTime = presentationTime;
+  return YES;
+}
+
+@end
@@ -0,0 +1,99 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import <FBSimulatorControl/FBSimulatorLogger.h>
+#import <FBSimulatorControl/FBVideoFrameSource.h>
+
+@class FBVideoSegment;
+@class FBVideoSegmenter;
+
+/**
+ Receives the Segments of a Segmenter. Is called on the Segmenter's queue.
+ */
+@protocol FBVideoSegmenterDelegate <NSObject>
+
+/**
+ Called when a Segment has been finished. Segments are delivered in order.
+
+ @param segmenter the Segmenter.
+ @param segment the finished Segment.
+ */
+- (void)segmenter:(FBVideoSegmenter *)segmenter didFinishSegment:(FBVideoSegment *)segment;
+
+@optional
+
+/**
+ Called when the first Frame has arrived, which is the start of the Recording.
+
+ @param segmenter the Segmenter.
+ @param date the date of the first Frame.
+ */
+- (void)segmenter:(FBVideoSegmenter *)segmenter didStartAtDate:(NSDate *)date;
+
+@end
+
+/**
+ Consumes Frames from a Frame Source, writing them into a sequence of Segment files of a maximum duration.
+ Segments are finished off the Frame delivery path, on a serial queue.
+ */
+@interface FBVideoSegmenter : NSObject <FBVideoFrameConsumer>
+
+/**
+ Creates a new Segmenter.
+
+ @param frameSource the Source of the Frames to Record.
+ @param segmentDuration the maximum duration of each Segment.
+ @param directory the directory to write Segments into. Will be created if it does not exist.
+ @param delegate the delegate to receive Segments. Is not retained.
+ @param logger a logger to record interactions. May be nil.
+ @return a new Segmenter.
+ */
++ (instancetype)segmenterWithFrameSource:(id<FBVideoFrameSource>)frameSource segmentDuration:(NSTimeInterval)segmentDuration directory:(NSString *)directory delegate:(id<FBVideoSegmenterDelegate>)delegate logger:(id<FBSimulatorLogger>)logger;
+
+/**
+ The serial queue that Segments are finished and the delegate is called on.
+ Blocks dispatched to it run after all previously finished Segments have been delivered.
+ */
+@property (nonatomic, strong, readonly) dispatch_queue_t queue;
+
+/**
+ Starts Recording.
+
+ @param error an error out for any error that occurred.
+ @return YES if successful, NO otherwise.
+ */
+- (BOOL)startWithError:(NSError **)error;
+
+/**
+ Finishes the Segment in progress, at the end of the most recent Frame.
+ Frames that arrive before the end of the Segment are then dropped.
+
+ @param error an error out for any error that occurred.
+ @return YES if successful, NO if there have been no Frames.
+ */
+- (BOOL)cutWithError:(NSError **)error;
+
+/**
+ Finishes the Segment in progress at the next Frame, so that the next Frame starts a new Segment.
+
+ @param handler a block to call on the queue once the Segment has been finished, with the time of the cut from the start of the Recording.
+ */
+- (void)cutAtNextFrame:(void(^)(NSTimeInterval time))handler;
+
+/**
+ Stops Recording, finishing the last Segment.
+
+ @param error an error out for any error that occurred.
+ @return YES if successful, NO if the Segmenter was not Recording.
+ */
+- (BOOL)stopWithError:(NSError **)error;
+
+@end
@@ -0,0 +1,223 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "FBVideoSegmenter.h"
+
+#import "FBSimulatorError.h"
+#import "FBVideoSegment.h"
+#import "FBVideoSegmentWriter.h"
+
+static NSUInteger const FBVideoSegmenterDefaultFramesPerSecond = 30;
+
+@interface FBVideoSegmenter ()
+
+@property (nonatomic, strong, readonly) id<FBVideoFrameSource> frameSource;
+@property (nonatomic, assign, readonly) NSTimeInterval segmentDuration;
+@property (nonatomic, copy, readonly) NSString *directory;
+@property (nonatomic, weak, readonly) id<FBVideoSegmenterDelegate> delegate;
+@property (nonatomic, strong, readonly) id<FBSimulatorLogger> logger;
+
+@property (nonatomic, assign, readwrite) BOOL running;
+@property (nonatomic, assign, readwrite) CMTime origin;
+@property (nonatomic, assign, readwrite) CMTime lastFrameTime;
+@property (nonatomic, assign, readwrite) CMTime lastFrameInterval;
+@property (nonatomic, assign, readwrite) CMTime segmentBoundary;
+@property (nonatomic, assign, readwrite) NSUInteger segmentCount;
+@property (nonatomic, strong, readwrite) FBVideoSegmentWriter *writer;
+@property (nonatomic, strong, readonly) NSMutableArray *pendingCutHandlers;
+
+@end
+
+@implementation FBVideoSegmenter
+
+#pragma mark Initializers
+
++ (instancetype)segmenterWithFrameSource:(id<FBVideoFrameSource>)frameSource segmentDuration:(NSTimeInterval)segmentDuration directory:(NSString *)directory delegate:(id<FBVideoSegmenterDelegate>)delegate logger:(id<FBSimulatorLogger>)logger
+{
+  return [[self alloc] initWithFrameSource:frameSource segmentDuration:segmentDuration directory:directory delegate:delegate logger:logger];
+}
+
+- (instancetype)initWithFrameSource:(id<FBVideoFrameSource>)frameSource segmentDuration:(NSTimeInterval)segmentDuration directory:(NSString *)directory delegate:(id<FBVideoSegmenterDelegate>)delegate logger:(id<FBSimulatorLogger>)logger
+{
+  NSParameterAssert(frameSource);
+  NSParameterAssert(segmentDuration > 0);
+  NSParameterAssert(directory);
+
+  self = [super init];
+  if (!self) {
+    return nil;
+  }
+
+  _frameSource = frameSource;
+  _segmentDuration = segmentDuration;
+  _directory = [directory copy];
+  _delegate = delegate;
+  _logger = logger;
+  _queue = dispatch_queue_create("com.facebook.FBSimulatorControl.videosegmenter", DISPATCH_QUEUE_SERIAL);
+  _origin = kCMTimeInvalid;
+  _lastFrameTime = kCMTimeInvalid;
+  _lastFrameInterval = kCMTimeInvalid;
+  _segmentBoundary = kCMTimeInvalid;
+  _pendingCutHandlers = [NSMutableArray array];
+
+  return self;
+}
+
+#pragma mark Public
+
+- (BOOL)startWithError:(NSError **)error
+{
+  @synchronized(self) {
+    if (self.running) {
+      return [[FBSimulatorError describe:@"Cannot Start Recording twice"] failBool:error];
+    }
+    NSError *innerError = nil;
+    if (![NSFileManager.defaultManager createDirectoryAtPath:self.directory withIntermediateDirectories:YES attributes:nil error:&innerError]) {
+      return [[[FBSimulatorError describeFormat:@"Could not create Segment directory %@", self.directory] causedBy:innerError] failBool:error];
+    }
+    self.running = YES;
+  }
+
+  NSError *innerError = nil;
+  if (![self.frameSource startWithConsumer:self error:&innerError]) {
+    @synchronized(self) {
+      self.running = NO;
+    }
+    return [[[FBSimulatorError describe:@"Could not start the Frame Source"] causedBy:innerError] failBool:error];
+  }
+  return YES;
+}
+
+- (BOOL)cutWithError:(NSError **)error
+{
+  @synchronized(self) {
+    if (!CMTIME_IS_VALID(self.lastFrameTime)) {
+      return [[FBSimulatorError describe:@"Cannot cut a Recording without any Frames"] failBool:error];
+    }
+    [self finishSegmentAtTime:CMTimeAdd(self.lastFrameTime, self.lastFrameInterval)];
+  }
+  return YES;
+}
+
+- (void)cutAtNextFrame:(void(^)(NSTimeInterval time))handler
+{
+  NSParameterAssert(handler);
+
+  @synchronized(self) {
+    [self.pendingCutHandlers addObject:[handler copy]];
+  }
+}
+
+- (BOOL)stopWithError:(NSError **)error
+{
+  @synchronized(self) {
+    if (!self.running) {
+      return [[FBSimulatorError describe:@"Cannot Stop a Recorder that is not Recording"] failBool:error];
+    }
+    self.running = NO;
+  }
+  [self.frameSource stop];
+
+  @synchronized(self) {
+    if (CMTIME_IS_VALID(self.lastFrameTime)) {
+      CMTime endTime = CMTimeAdd(self.lastFrameTime, self.lastFrameInterval);
+      [self finishSegmentAtTime:endTime];
+      [self runPendingCutHandlersAtTime:endTime];
+    }
+    [self.pendingCutHandlers removeAllObjects];
+  }
+  return YES;
+}
+
+#pragma mark FBVideoFrameConsumer
+
+- (void)frameSource:(id<FBVideoFrameSource>)frameSource didProduceFrame:(CVPixelBufferRef)pixelBuffer presentationTime:(CMTime)presentationTime
+{
+  @synchronized(self) {
+    if (!self.running) {
+      return;
+    }
+    // A Frame that arrives before the end of a Segment that has been cut short cannot be placed in the next Segment.
+    if (CMTIME_IS_VALID(self.segmentBoundary) && CMTimeCompare(presentationTime, self.segmentBoundary) < 0) {
+      return;
+    }
+    if (!CMTIME_IS_VALID(self.origin)) {
+      self.origin = presentationTime;
+      id<FBVideoSegmenterDelegate> delegate = self.delegate;
+      if ([delegate respondsToSelector:@selector(segmenter:didStartAtDate:)]) {
+        NSDate *date = NSDate.date;
+        dispatch_async(self.queue, ^{
+          [delegate segmenter:self didStartAtDate:date];
+        });
+      }
+    }
+
+    BOOL elapsed = self.writer && CMTimeGetSeconds(CMTimeSubtract(presentationTime, self.writer.firstFrameTime)) >= self.segmentDuration;
+    if (elapsed || self.pendingCutHandlers.count > 0) {
+      [self finishSegmentAtTime:presentationTime];
+    }
+    [self runPendingCutHandlersAtTime:presentationTime];
+    if (!self.writer) {
+      NSString *path = [self.directory stringByAppendingPathComponent:[NSString stringWithFormat:@"segment_%06lu.mov", (unsigned long) self.segmentCount]];
+      self.segmentCount++;
+      self.writer = [FBVideoSegmentWriter writerWithPath:path origin:self.origin];
+    }
+
+    NSError *error = nil;
+    if (![self.writer appendFrame:pixelBuffer presentationTime:presentationTime error:&error]) {
+      [self.logger logMessage:@"Dropped Frame: %@", error];
+      return;
+    }
+    if (CMTIME_IS_VALID(self.lastFrameTime)) {
+      self.lastFrameInterval = CMTimeSubtract(presentationTime, self.lastFrameTime);
+    } else {
+      self.lastFrameInterval = CMTimeMake(1, (int32_t) FBVideoSegmenterDefaultFramesPerSecond);
+    }
+    self.lastFrameTime = presentationTime;
+  }
+}
+
+#pragma mark Private
+
+- (void)runPendingCutHandlersAtTime:(CMTime)time
+{
+  NSTimeInterval seconds = CMTimeGetSeconds(CMTimeSubtract(time, self.origin));
+  for (void(^handler)(NSTimeInterval) in self.pendingCutHandlers) {
+    dispatch_async(self.queue, ^{
+      handler(seconds);
+    });
+  }
+  [self.pendingCutHandlers removeAllObjects];
+}
+
+- (void)finishSegmentAtTime:(CMTime)endTime
+{
+  FBVideoSegmentWriter *writer = self.writer;
+  self.writer = nil;
+  if (writer.frameCount == 0) {
+    return;
+  }
+  self.segmentBoundary = endTime;
+
+  // Finishing blocks until the file is written, so is done off the Frame delivery path.
+  // The queue is serial, so Segments are delivered in order.
+  id<FBVideoSegmenterDelegate> delegate = self.delegate;
+  id<FBSimulatorLogger> logger = self.logger;
+  dispatch_async(self.queue, ^{
+    NSError *error = nil;
+    FBVideoSegment *segment = [writer finishAtTime:endTime error:&error];
+    if (!segment) {
+      [logger logMessage:@"Failed to finish Segment: %@", error];
+      return;
+    }
+    [delegate segmenter:self didFinishSegment:segment];
+  });
+}
+
+@end
@@ -0,0 +1,55 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+@class FBSimulatorHistory;
+@class FBVideoSegmentIndex;
+@class FBVideoSpan;
+
+/**
+ Cuts spans out of a Segmented recording into standalone movie files, without re-encoding.
+ */
+@interface FBVideoTrimmer : NSObject
+
+/**
+ Writes a Span of a recording to a movie file.
+
+ @param span the Span to write.
+ @param filePath the path to write the movie to. Any existing file is overwritten.
+ @param error an error out for any error that occurred.
+ @return YES if successful, NO otherwise.
+ */
++ (BOOL)writeSpan:(FBVideoSpan *)span toFilePath:(NSString *)filePath error:(NSError **)error;
+
+/**
+ Writes the part of a recording between the timestamps of two History states.
+ For example, the state when an Application was launched and the state when it terminated.
+
+ @param index the Index of the recording.
+ @param fromHistory the History state to start from.
+ @param toHistory the History state to end at.
+ @param filePath the path to write the movie to. Any existing file is overwritten.
+ @param error an error out for any error that occurred.
+ @return YES if successful, NO otherwise.
+ */
++ (BOOL)trimIndex:(FBVideoSegmentIndex *)index fromHistory:(FBSimulatorHistory *)fromHistory toHistory:(FBSimulatorHistory *)toHistory toFilePath:(NSString *)filePath error:(NSError **)error;
+
+/**
+ Writes the part of a recording from a Marker to the Marker after it.
+
+ @param index the Index of the recording.
+ @param name the name of the Marker.
+ @param filePath the path to write the movie to. Any existing file is overwritten.
+ @param error an error out for any error that occurred.
+ @return YES if successful, NO otherwise.
+ */
++ (BOOL)trimIndex:(FBVideoSegmentIndex *)index markerNamed:(NSString *)name toFilePath:(NSString *)filePath error:(NSError **)error;
+
+@end
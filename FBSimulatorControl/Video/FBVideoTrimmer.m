@@ -0,0 +1,54 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "FBVideoTrimmer.h"
+
+#import "FBSimulatorError.h"
+#import "FBSimulatorHistory.h"
+#import "FBVideoSegmentIndex.h"
+#import "FBVideoSegmentMuxer.h"
+
+@implementation FBVideoTrimmer
+
++ (BOOL)writeSpan:(FBVideoSpan *)span toFilePath:(NSString *)filePath error:(NSError **)error
+{
+  NSParameterAssert(span);
+  NSParameterAssert(filePath);
+
+  NSError *innerError = nil;
+  if (![FBVideoSegmentMuxer muxSegments:span.segments fromTime:span.startTime toTime:span.endTime toFilePath:filePath error:&innerError]) {
+    return [[[FBSimulatorError describeFormat:@"Could not write %@ to %@", span, filePath] causedBy:innerError] failBool:error];
+  }
+  return YES;
+}
+
++ (BOOL)trimIndex:(FBVideoSegmentIndex *)index fromHistory:(FBSimulatorHistory *)fromHistory toHistory:(FBSimulatorHistory *)toHistory toFilePath:(NSString *)filePath error:(NSError **)error
+{
+  NSParameterAssert(fromHistory);
+  NSParameterAssert(toHistory);
+
+  NSError *innerError = nil;
+  FBVideoSpan *span = [index spanFromDate:fromHistory.timestamp toDate:toHistory.timestamp error:&innerError];
+  if (!span) {
+    return [[[FBSimulatorError describeFormat:@"Could not resolve the span between %@ and %@", fromHistory.timestamp, toHistory.timestamp] causedBy:innerError] failBool:error];
+  }
+  return [self writeSpan:span toFilePath:filePath error:error];
+}
+
++ (BOOL)trimIndex:(FBVideoSegmentIndex *)index markerNamed:(NSString *)name toFilePath:(NSString *)filePath error:(NSError **)error
+{
+  NSError *innerError = nil;
+  FBVideoSpan *span = [index spanOfMarkerNamed:name error:&innerError];
+  if (!span) {
+    return [FBSimulatorError failBoolWithError:innerError errorOut:error];
+  }
+  return [self writeSpan:span toFilePath:filePath error:error];
+}
+
+@end
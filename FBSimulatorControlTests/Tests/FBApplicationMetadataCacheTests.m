@@ -0,0 +1,153 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import <FBSimulatorControl/FBSimulatorControl.h>
+
+#import "FBSimulatorControlFixtures.h"
+
+@interface FBApplicationMetadataCacheTests : XCTestCase
+
+@property (nonatomic, copy) NSString *directory;
+@property (nonatomic, copy) NSString *cachePath;
+
+@end
+
+@implementation FBApplicationMetadataCacheTests
+
+- (void)setUp
+{
+  self.directory = [NSTemporaryDirectory() stringByAppendingPathComponent:[NSString stringWithFormat:@"FBApplicationMetadataCacheTests_%@", NSUUID.UUID.UUIDString]];
+  self.cachePath = [self.directory stringByAppendingPathComponent:@"cache/metadata.plist"];
+  [NSFileManager.defaultManager createDirectoryAtPath:self.directory withIntermediateDirectories:YES attributes:nil error:nil];
+}
+
+- (void)tearDown
+{
+  [NSFileManager.defaultManager removeItemAtPath:self.directory error:nil];
+}
+
+- (FBSimulatorApplication *)copiedApplicationNamed:(NSString *)name infoPlistPath:(NSString **)infoPlistPath
+{
+  NSString *path = [self.directory stringByAppendingPathComponent:[name stringByAppendingPathExtension:@"app"]];
+  NSError *error = nil;
+  XCTAssertTrue([NSFileManager.defaultManager copyItemAtPath:self.tableSearchApplication.path toPath:path error:&error], @"%@", error);
+  *infoPlistPath = [path stringByAppendingPathComponent:@"Info.plist"];
+
+  NSString *binaryPath = [path stringByAppendingPathComponent:self.tableSearchApplication.binary.name];
+  FBSimulatorBinary *binary = [FBSimulatorBinary withName:self.tableSearchApplication.binary.name path:binaryPath architectures:self.tableSearchApplication.binary.architectures];
+  return [FBSimulatorApplication withName:name path:path bundleID:self.tableSearchApplication.bundleID binary:binary];
+}
+
+- (void)testCachedApplicationIsVisibleToOtherInstances
+{
+  NSString *infoPlistPath = nil;
+  FBSimulatorApplication *application = [self copiedApplicationNamed:@"TableSearch" infoPlistPath:&infoPlistPath];
+  FBApplicationMetadataCache *cache = [FBApplicationMetadataCache cacheWithPath:self.cachePath capacity:8];
+  XCTAssertNil([cache applicationForPath:application.path]);
+
+  NSError *error = nil;
+  XCTAssertTrue([cache cacheApplication:application infoPlistPath:infoPlistPath error:&error], @"%@", error);
+  XCTAssertEqualObjects([cache applicationForPath:application.path], application);
+
+  // Another instance stands in for another process reading the same file.
+  FBApplicationMetadataCache *otherCache = [FBApplicationMetadataCache cacheWithPath:self.cachePath capacity:8];
+  XCTAssertEqualObjects([otherCache applicationForPath:application.path], application);
+  XCTAssertEqual(otherCache.count, 1u);
+}
+
+- (void)testEntryIsInvalidatedWhenFilesChange
+{
+  NSString *infoPlistPath = nil;
+  FBSimulatorApplication *application = [self copiedApplicationNamed:@"TableSearch" infoPlistPath:&infoPlistPath];
+  FBApplicationMetadataCache *cache = [FBApplicationMetadataCache cacheWithPath:self.cachePath capacity:8];
+  XCTAssertTrue([cache cacheApplication:application infoPlistPath:infoPlistPath error:nil]);
+  XCTAssertTrue([cache cacheBinary:application.binary error:nil]);
+  XCTAssertNotNil([cache applicationForPath:application.path]);
+  XCTAssertEqualObjects([cache binaryForPath:application.binary.path], application.binary);
+
+  NSMutableDictionary *infoPlist = [NSMutableDictionary dictionaryWithContentsOfFile:infoPlistPath];
+  infoPlist[@"CFBundleIdentifier"] = @"com.example.changed";
+  XCTAssertTrue([infoPlist writeToFile:infoPlistPath atomically:YES]);
+  XCTAssertNil([cache applicationForPath:application.path]);
+  XCTAssertNotNil([cache binaryForPath:application.binary.path]);
+
+  NSFileHandle *handle = [NSFileHandle fileHandleForWritingAtPath:application.binary.path];
+  [handle seekToEndOfFile];
+  [handle writeData:[NSData dataWithBytes:"\0" length:1]];
+  [handle closeFile];
+  XCTAssertNil([cache binaryForPath:application.binary.path]);
+}
+
+- (void)testEvictsLeastRecentlyUsedEntries
+{
+  NSString *firstPlist = nil;
+  NSString *secondPlist = nil;
+  NSString *thirdPlist = nil;
+  FBSimulatorApplication *first = [self copiedApplicationNamed:@"First" infoPlistPath:&firstPlist];
+  FBSimulatorApplication *second = [self copiedApplicationNamed:@"Second" infoPlistPath:&secondPlist];
+  FBSimulatorApplication *third = [self copiedApplicationNamed:@"Third" infoPlistPath:&thirdPlist];
+
+  FBApplicationMetadataCache *cache = [FBApplicationMetadataCache cacheWithPath:self.cachePath capacity:2];
+  XCTAssertTrue([cache cacheApplication:first infoPlistPath:firstPlist error:nil]);
+  XCTAssertTrue([cache cacheApplication:second infoPlistPath:secondPlist error:nil]);
+  XCTAssertNotNil([cache applicationForPath:first.path]);
+  XCTAssertTrue([cache cacheApplication:third infoPlistPath:thirdPlist error:nil]);
+
+  XCTAssertEqual(cache.count, 2u);
+  XCTAssertNotNil([cache applicationForPath:first.path]);
+  XCTAssertNil([cache applicationForPath:second.path]);
+  XCTAssertNotNil([cache applicationForPath:third.path]);
+}
+
+- (void)testCorruptAndOutdatedCachesAreDiscarded
+{
+  NSString *infoPlistPath = nil;
+  FBSimulatorApplication *application = [self copiedApplicationNamed:@"TableSearch" infoPlistPath:&infoPlistPath];
+  FBApplicationMetadataCache *cache = [FBApplicationMetadataCache cacheWithPath:self.cachePath capacity:8];
+  XCTAssertTrue([cache cacheApplication:application infoPlistPath:infoPlistPath error:nil]);
+
+  NSDictionary *outdated = @{@"version" : @(FBApplicationMetadataCacheVersion + 1), @"entries" : @{}};
+  XCTAssertTrue([outdated writeToFile:self.cachePath atomically:YES]);
+  XCTAssertNil([cache applicationForPath:application.path]);
+  XCTAssertEqual(cache.count, 0u);
+
+  XCTAssertTrue([[NSData dataWithBytes:"garbage" length:7] writeToFile:self.cachePath atomically:YES]);
+  XCTAssertNil([cache applicationForPath:application.path]);
+  XCTAssertTrue([cache cacheApplication:application infoPlistPath:infoPlistPath error:nil]);
+  XCTAssertEqualObjects([cache applicationForPath:application.path], application);
+
+  XCTAssertTrue([cache removeAllEntriesWithError:nil]);
+  XCTAssertEqual(cache.count, 0u);
+}
+
+- (void)testConcurrentWritersDoNotLoseEntries
+{
+  NSMutableArray *applications = [NSMutableArray array];
+  NSMutableArray *plists = [NSMutableArray array];
+  for (NSUInteger index = 0; index < 8; index++) {
+    NSString *infoPlistPath = nil;
+    [applications addObject:[self copiedApplicationNamed:[NSString stringWithFormat:@"App%lu", (unsigned long) index] infoPlistPath:&infoPlistPath]];
+    [plists addObject:infoPlistPath];
+  }
+
+  dispatch_apply(applications.count, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t index) {
+    FBApplicationMetadataCache *cache = [FBApplicationMetadataCache cacheWithPath:self.cachePath capacity:64];
+    [cache cacheApplication:applications[index] infoPlistPath:plists[index] error:nil];
+  });
+
+  FBApplicationMetadataCache *cache = [FBApplicationMetadataCache cacheWithPath:self.cachePath capacity:64];
+  XCTAssertEqual(cache.count, applications.count);
+  for (FBSimulatorApplication *application in applications) {
+    XCTAssertEqualObjects([cache applicationForPath:application.path], application);
+  }
+}
+
+@end
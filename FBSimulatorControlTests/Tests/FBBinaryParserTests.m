@@ -0,0 +1,151 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import <FBSimulatorControl/FBSimulatorControl.h>
+
+#import "FBMachOFixtures.h"
+#import "FBSimulatorControlFixtures.h"
+
+@interface FBBinaryParserTests : XCTestCase
+
+@end
+
+@implementation FBBinaryParserTests
+
+#pragma mark Fixtures
+
++ (NSData *)thinBinary
+{
+  return [FBMachOFixtures thinBinaryWithCPUType:FBMachOFixtureCPUTypeX86_64 minimumOSVersion:@"8.0" encrypted:NO];
+}
+
++ (NSData *)fatBinary
+{
+  return [FBMachOFixtures fatBinaryWithSlices:@[
+    FBBinaryParserTests.thinBinary,
+    [FBMachOFixtures thinBinaryWithCPUType:FBMachOFixtureCPUTypeARM64 minimumOSVersion:@"8.0" encrypted:YES],
+  ]];
+}
+
+#pragma mark Parsing
+
+- (void)testParsesThinBinary
+{
+  NSError *error = nil;
+  FBMachOBinary *binary = [FBBinaryParser binaryFromData:[FBMachOFixtures thinBinaryWithCPUType:FBMachOFixtureCPUTypeARM64 minimumOSVersion:@"8.0" encrypted:YES] error:&error];
+  XCTAssertNil(error);
+  XCTAssertNotNil(binary);
+  XCTAssertFalse(binary.isFat);
+  XCTAssertEqualObjects(binary.architectures, [NSSet setWithObject:@"arm64"]);
+
+  FBMachOSlice *slice = binary.slices.firstObject;
+  XCTAssertTrue(slice.is64Bit);
+  XCTAssertEqual(slice.fileType, 2u);
+  XCTAssertEqualObjects(slice.uuid, FBMachOFixtures.uuid);
+  XCTAssertEqualObjects(slice.platform, @"ios");
+  XCTAssertEqualObjects(slice.minimumOSVersion, @"8.0");
+  XCTAssertEqualObjects(slice.sdkVersion, @"9.2.1");
+  NSArray *expectedDylibs = @[@"/usr/lib/libSystem.B.dylib", @"@rpath/Weak.framework/Weak"];
+  XCTAssertEqualObjects(slice.linkedDylibs, expectedDylibs);
+  XCTAssertEqualObjects(slice.rpaths, @[@"@executable_path/Frameworks"]);
+  XCTAssertTrue(slice.hasCodeSignature);
+  XCTAssertTrue(slice.hasEncryptionInfo);
+  XCTAssertTrue(slice.isEncrypted);
+}
+
+- (void)testParsesFatBinary
+{
+  NSError *error = nil;
+  FBMachOBinary *binary = [FBBinaryParser binaryFromData:FBBinaryParserTests.fatBinary error:&error];
+  XCTAssertNil(error);
+  XCTAssertTrue(binary.isFat);
+  XCTAssertEqual(binary.slices.count, 2u);
+  NSSet *expected = [NSSet setWithArray:@[@"x86_64", @"arm64"]];
+  XCTAssertEqualObjects(binary.architectures, expected);
+
+  FBMachOSlice *x86 = binary.slices[0];
+  FBMachOSlice *arm = binary.slices[1];
+  XCTAssertEqual(x86.offset, 0x1000u);
+  XCTAssertEqual(arm.offset, 0x2000u);
+  XCTAssertFalse(x86.isEncrypted);
+  XCTAssertTrue(arm.isEncrypted);
+  XCTAssertEqualObjects(x86.uuid, arm.uuid);
+}
+
+- (void)testParsesFixtureBinary
+{
+  NSString *binaryPath = self.tableSearchApplication.binary.path;
+  NSError *error = nil;
+  FBMachOBinary *binary = [FBBinaryParser binaryAtPath:binaryPath error:&error];
+  XCTAssertNil(error);
+  XCTAssertGreaterThan(binary.slices.count, 0u);
+  XCTAssertEqualObjects(binary.architectures, [FBBinaryParser architecturesForBinaryAtPath:binaryPath error:nil]);
+  for (FBMachOSlice *slice in binary.slices) {
+    XCTAssertNotNil(slice.uuid);
+    XCTAssertGreaterThan(slice.linkedDylibs.count, 0u);
+  }
+}
+
+- (void)testFailsForNonMachO
+{
+  NSError *error = nil;
+  XCTAssertNil([FBBinaryParser binaryFromData:[NSData data] error:&error]);
+  XCTAssertNotNil(error);
+
+  error = nil;
+  XCTAssertNil([FBBinaryParser binaryFromData:[@"#!/bin/sh\necho hello\n" dataUsingEncoding:NSUTF8StringEncoding] error:&error]);
+  XCTAssertNotNil(error);
+
+  error = nil;
+  XCTAssertNil([FBBinaryParser binaryAtPath:@"/this/path/does/not/exist" error:&error]);
+  XCTAssertNotNil(error);
+}
+
+#pragma mark Fuzzing
+
+- (void)assertParsesOrFails:(NSData *)data
+{
+  NSError *error = nil;
+  FBMachOBinary *binary = [FBBinaryParser binaryFromData:data error:&error];
+  XCTAssertTrue((binary != nil) != (error != nil), @"Expected either a Binary or an Error for data of length %lu", (unsigned long) data.length);
+}
+
+- (void)testTruncationAtEveryLengthFails
+{
+  for (NSData *data in @[FBBinaryParserTests.thinBinary, FBBinaryParserTests.fatBinary]) {
+    for (NSUInteger length = 0; length < data.length; length++) {
+      NSError *error = nil;
+      XCTAssertNil([FBBinaryParser binaryFromData:[data subdataWithRange:NSMakeRange(0, length)] error:&error]);
+      XCTAssertNotNil(error);
+    }
+  }
+}
+
+- (void)testRandomCorruptionDoesNotCrash
+{
+  srand48(56);
+  for (NSData *data in @[FBBinaryParserTests.thinBinary, FBBinaryParserTests.fatBinary]) {
+    for (NSUInteger iteration = 0; iteration < 2000; iteration++) {
+      NSMutableData *corrupted = [data mutableCopy];
+      uint8_t *bytes = corrupted.mutableBytes;
+      NSUInteger corruptions = 1 + (NSUInteger) (drand48() * 8);
+      for (NSUInteger index = 0; index < corruptions; index++) {
+        // Bias corruption towards the headers and load commands, where the interesting structure is.
+        NSUInteger limit = MIN(corrupted.length, (NSUInteger) 0x1200);
+        NSUInteger position = (NSUInteger) (drand48() * limit);
+        bytes[position] = (uint8_t) (drand48() * 256);
+      }
+      [self assertParsesOrFails:corrupted];
+    }
+  }
+}
+
+@end
@@ -0,0 +1,162 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import <FBSimulatorControl/FBSimulatorControl.h>
+
+#import "FBMachOFixtures.h"
+#import "FBSimulatorControlFixtures.h"
+
+@interface FBBundleAnalyzerTests : XCTestCase
+
+@property (nonatomic, copy) NSString *bundlePath;
+
+@end
+
+@implementation FBBundleAnalyzerTests
+
+- (void)setUp
+{
+  NSString *directory = [NSTemporaryDirectory() stringByAppendingPathComponent:[NSString stringWithFormat:@"FBBundleAnalyzerTests_%@", NSUUID.UUID.UUIDString]];
+  self.bundlePath = [directory stringByAppendingPathComponent:@"Example.app"];
+}
+
+- (void)tearDown
+{
+  [NSFileManager.defaultManager removeItemAtPath:self.bundlePath.stringByDeletingLastPathComponent error:nil];
+}
+
+- (NSData *)simulatorBinary
+{
+  return [FBMachOFixtures fatBinaryWithSlices:@[
+    [FBMachOFixtures thinBinaryWithCPUType:FBMachOFixtureCPUTypeX86_64 minimumOSVersion:@"8.0" encrypted:NO],
+    [FBMachOFixtures thinBinaryWithCPUType:FBMachOFixtureCPUTypeARM64 minimumOSVersion:@"8.0" encrypted:NO],
+  ]];
+}
+
+- (void)writeBundle:(NSString *)relativePath executable:(NSData *)executable
+{
+  NSString *path = relativePath ? [self.bundlePath stringByAppendingPathComponent:relativePath] : self.bundlePath;
+  XCTAssertTrue([FBMachOFixtures writeBundleAtPath:path executable:executable]);
+}
+
+- (FBBundleAnalysis *)analyze
+{
+  NSError *error = nil;
+  FBBundleAnalysis *analysis = [FBBundleAnalyzer analyzeBundleAtPath:self.bundlePath architecture:@"x86_64" osVersion:@"9.2" error:&error];
+  XCTAssertNil(error);
+  XCTAssertNotNil(analysis);
+  return analysis;
+}
+
+- (void)testCompatibleBundleWithNestedComponents
+{
+  [self writeBundle:nil executable:self.simulatorBinary];
+  [self writeBundle:@"Frameworks/Shared.framework" executable:self.simulatorBinary];
+  [self writeBundle:@"PlugIns/Today.appex" executable:self.simulatorBinary];
+  [self writeBundle:@"PlugIns/Today.appex/Frameworks/Nested.framework" executable:self.simulatorBinary];
+  XCTAssertTrue([self.simulatorBinary writeToFile:[self.bundlePath stringByAppendingPathComponent:@"Frameworks/libswiftCore.dylib"] atomically:YES]);
+  // Resource bundles have no executable, so are not analyzed.
+  XCTAssertTrue([NSFileManager.defaultManager createDirectoryAtPath:[self.bundlePath stringByAppendingPathComponent:@"Frameworks/Resources.bundle"] withIntermediateDirectories:YES attributes:nil error:nil]);
+
+  FBBundleAnalysis *analysis = self.analyze;
+  NSArray *relativePaths = [analysis.components valueForKey:@"relativePath"];
+  NSArray *expected = @[
+    @"Example",
+    @"Frameworks/Shared.framework/Shared",
+    @"Frameworks/libswiftCore.dylib",
+    @"PlugIns/Today.appex/Frameworks/Nested.framework/Nested",
+    @"PlugIns/Today.appex/Today",
+  ];
+  XCTAssertEqualObjects(relativePaths, expected);
+  XCTAssertTrue(analysis.isCompatible);
+  XCTAssertEqual(analysis.incompatibleComponents.count, 0u);
+}
+
+- (void)testReportsIncompatibleComponents
+{
+  [self writeBundle:nil executable:self.simulatorBinary];
+  [self writeBundle:@"Frameworks/DeviceOnly.framework" executable:[FBMachOFixtures thinBinaryWithCPUType:FBMachOFixtureCPUTypeARM64 minimumOSVersion:@"8.0" encrypted:NO]];
+  [self writeBundle:@"Frameworks/TooNew.framework" executable:[FBMachOFixtures thinBinaryWithCPUType:FBMachOFixtureCPUTypeX86_64 minimumOSVersion:@"10.0" encrypted:NO]];
+  [self writeBundle:@"PlugIns/Encrypted.appex" executable:[FBMachOFixtures thinBinaryWithCPUType:FBMachOFixtureCPUTypeX86_64 minimumOSVersion:@"8.0" encrypted:YES]];
+  [self writeBundle:@"PlugIns/Garbage.appex" executable:[@"not a binary" dataUsingEncoding:NSUTF8StringEncoding]];
+
+  FBBundleAnalysis *analysis = self.analyze;
+  XCTAssertFalse(analysis.isCompatible);
+  XCTAssertEqual(analysis.components.count, 5u);
+  NSArray *incompatible = [analysis.incompatibleComponents valueForKey:@"relativePath"];
+  NSArray *expected = @[
+    @"Frameworks/DeviceOnly.framework/DeviceOnly",
+    @"Frameworks/TooNew.framework/TooNew",
+    @"PlugIns/Encrypted.appex/Encrypted",
+    @"PlugIns/Garbage.appex/Garbage",
+  ];
+  XCTAssertEqualObjects(incompatible, expected);
+
+  for (FBBundleComponent *component in analysis.incompatibleComponents) {
+    XCTAssertEqual(component.problems.count, 1u);
+  }
+  XCTAssertNil([analysis.incompatibleComponents.lastObject binary]);
+}
+
+- (void)testReportsPlatformMismatchBeforeOSVersion
+{
+  [self writeBundle:nil executable:[FBMachOFixtures thinBinaryWithCPUType:FBMachOFixtureCPUTypeX86_64 buildVersionPlatform:7 minimumOSVersion:@"8.0"]];
+  [self writeBundle:@"Frameworks/Mac.framework" executable:[FBMachOFixtures thinBinaryWithCPUType:FBMachOFixtureCPUTypeX86_64 buildVersionPlatform:1 minimumOSVersion:@"10.11"]];
+  [self writeBundle:@"Watch/Example.app" executable:[FBMachOFixtures thinBinaryWithCPUType:FBMachOFixtureCPUTypeI386 buildVersionPlatform:9 minimumOSVersion:@"2.0"]];
+
+  FBBundleAnalysis *analysis = self.analyze;
+  XCTAssertEqual(analysis.components.count, 3u);
+  XCTAssertEqualObjects([analysis.incompatibleComponents valueForKey:@"relativePath"], @[@"Frameworks/Mac.framework/Mac"]);
+  XCTAssertEqualObjects([analysis.incompatibleComponents.firstObject problems], @[@"Built for macos, target is ios or ios-simulator"]);
+}
+
+- (void)testChecksWatchComponentsAgainstTheWatchSimulatorArchitecture
+{
+  [self writeBundle:nil executable:self.simulatorBinary];
+  [self writeBundle:@"Watch/Example.app" executable:[FBMachOFixtures thinBinaryWithCPUType:FBMachOFixtureCPUTypeI386 buildVersionPlatform:9 minimumOSVersion:@"2.0"]];
+  [self writeBundle:@"Watch/Example.app/PlugIns/Extension.appex" executable:[FBMachOFixtures thinBinaryWithCPUType:FBMachOFixtureCPUTypeX86_64 buildVersionPlatform:9 minimumOSVersion:@"2.0"]];
+
+  FBBundleAnalysis *analysis = self.analyze;
+  XCTAssertEqual(analysis.components.count, 3u);
+  XCTAssertEqualObjects([analysis.incompatibleComponents valueForKey:@"relativePath"], @[@"Watch/Example.app/PlugIns/Extension.appex/Extension"]);
+  XCTAssertEqualObjects([analysis.incompatibleComponents.firstObject problems], @[@"Missing i386 slice, has x86_64"]);
+}
+
+- (void)testReportsDeviceSlicesForARMSimulators
+{
+  [self writeBundle:nil executable:[FBMachOFixtures thinBinaryWithCPUType:FBMachOFixtureCPUTypeARM64 buildVersionPlatform:2 minimumOSVersion:@"8.0"]];
+
+  NSError *error = nil;
+  FBBundleAnalysis *analysis = [FBBundleAnalyzer analyzeBundleAtPath:self.bundlePath architecture:@"arm64" osVersion:@"9.2" error:&error];
+  XCTAssertNil(error);
+  XCTAssertFalse(analysis.isCompatible);
+  XCTAssertEqualObjects([analysis.incompatibleComponents.firstObject problems], @[@"Built for ios, target is ios-simulator"]);
+}
+
+- (void)testFailsWithoutExecutable
+{
+  XCTAssertTrue([NSFileManager.defaultManager createDirectoryAtPath:self.bundlePath withIntermediateDirectories:YES attributes:nil error:nil]);
+  NSError *error = nil;
+  XCTAssertNil([FBBundleAnalyzer analyzeBundleAtPath:self.bundlePath architecture:@"x86_64" osVersion:@"9.2" error:&error]);
+  XCTAssertNotNil(error);
+}
+
+- (void)testAnalyzesFixtureApplication
+{
+  NSString *architecture = [self.tableSearchApplication.binary.architectures anyObject];
+  NSError *error = nil;
+  FBBundleAnalysis *analysis = [FBBundleAnalyzer analyzeBundleAtPath:self.tableSearchApplication.path architecture:architecture osVersion:@"99.0" error:&error];
+  XCTAssertNil(error);
+  XCTAssertEqual(analysis.components.count, 1u);
+  XCTAssertTrue(analysis.isCompatible);
+}
+
+@end
@@ -0,0 +1,214 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <XCTest/XCTest.h>
+
+#include <fcntl.h>
+
+#import <FBSimulatorControl/FBSimulatorControl.h>
+
+@interface FBDebuggerSessionTests : XCTestCase
+
+@end
+
+static NSUInteger FBDebuggerSessionTestsOpenFileDescriptorCount(void)
+{
+  NSUInteger count = 0;
+  for (int fileDescriptor = 0; fileDescriptor < getdtablesize(); fileDescriptor++) {
+    if (fcntl(fileDescriptor, F_GETFD) >= 0) {
+      count++;
+    }
+  }
+  return count;
+}
+
+@implementation FBDebuggerSessionTests
+
+/**
+ A stand-in for a Debugger: a shell that evaluates each line of stdin.
+ */
++ (FBDebuggerSession *)scriptedSessionForProcessIdentifier:(pid_t)processIdentifier
+{
+  return [FBDebuggerSession
+    sessionWithProcessIdentifier:processIdentifier
+    launchPath:@"/bin/sh"
+    arguments:@[@"-c", @"while IFS= read -r line; do eval \"$line\"; done"]
+    markerCommand:^ NSString * (NSString *marker) {
+      return [NSString stringWithFormat:@"echo %@", marker];
+    }
+    ignoredLinePrefix:@"(ignored) "
+    detachCommands:@[@"exit 0"]];
+}
+
+- (FBDebuggerSession *)startedSession
+{
+  FBDebuggerSession *session = [FBDebuggerSessionTests scriptedSessionForProcessIdentifier:getpid()];
+  NSError *error = nil;
+  XCTAssertTrue([session startWithError:&error]);
+  XCTAssertNil(error);
+  return session;
+}
+
+- (void)testFramesResponses
+{
+  FBDebuggerSession *session = self.startedSession;
+  NSError *error = nil;
+  XCTAssertEqualObjects([session executeCommand:@"echo one" timeout:5 error:&error], @"one");
+  XCTAssertEqualObjects([session executeCommand:@"echo two; echo '(ignored) prompt'; echo three" timeout:5 error:&error], @"two\nthree");
+  XCTAssertEqualObjects([session executeCommand:@"printf partial" timeout:5 error:&error], @"partial");
+  XCTAssertEqualObjects([session executeCommand:@"true" timeout:5 error:&error], @"");
+  XCTAssertNil(error);
+  [session terminate];
+}
+
+- (void)testPipelinesCommandsInOrder
+{
+  FBDebuggerSession *session = self.startedSession;
+  NSMutableArray *outputs = [NSMutableArray array];
+  NSUInteger count = 50;
+  for (NSUInteger index = 0; index < count; index++) {
+    XCTestExpectation *expectation = [self expectationWithDescription:@(index).stringValue];
+    [session executeCommand:[NSString stringWithFormat:@"echo %lu", (unsigned long) index] timeout:5 completion:^(NSString *output, NSError *error) {
+      XCTAssertNil(error);
+      @synchronized(outputs) {
+        [outputs addObject:output];
+      }
+      [expectation fulfill];
+    }];
+  }
+  [self waitForExpectationsWithTimeout:10 handler:nil];
+
+  NSMutableArray *expected = [NSMutableArray array];
+  for (NSUInteger index = 0; index < count; index++) {
+    [expected addObject:@(index).stringValue];
+  }
+  XCTAssertEqualObjects(outputs, expected);
+  XCTAssertEqual(session.pendingCommandCount, 0u);
+  [session terminate];
+}
+
+- (void)testPipelinesCommandsWhenBothPipesAreFull
+{
+  // More input and output than fits in the pipe buffers, so the Debugger blocks on writing output before reading all input.
+  FBDebuggerSession *session = self.startedSession;
+  NSString *padding = [@"" stringByPaddingToLength:4096 withString:@"x" startingAtIndex:0];
+  NSUInteger count = 100;
+  for (NSUInteger index = 0; index < count; index++) {
+    XCTestExpectation *expectation = [self expectationWithDescription:@(index).stringValue];
+    NSString *command = [NSString stringWithFormat:@"head -c 65536 /dev/zero | tr '\\0' a; echo # %@", padding];
+    [session executeCommand:command timeout:20 completion:^(NSString *output, NSError *error) {
+      XCTAssertNil(error);
+      XCTAssertEqual(output.length, 65536u);
+      [expectation fulfill];
+    }];
+  }
+  [self waitForExpectationsWithTimeout:30 handler:nil];
+  XCTAssertEqual(session.pendingCommandCount, 0u);
+  [session terminate];
+}
+
+- (void)testTimeoutFailsPendingCommandsAndTerminates
+{
+  FBDebuggerSession *session = self.startedSession;
+
+  XCTestExpectation *queued = [self expectationWithDescription:@"Queued command fails"];
+  [session executeCommand:@"sleep 10" timeout:0.5 completion:^(NSString *output, NSError *error) {
+    XCTAssertNil(output);
+    XCTAssertNotNil(error);
+  }];
+  [session executeCommand:@"echo never" timeout:5 completion:^(NSString *output, NSError *error) {
+    XCTAssertNil(output);
+    XCTAssertNotNil(error);
+    [queued fulfill];
+  }];
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+
+  XCTAssertTrue(session.hasTerminated);
+  NSError *error = nil;
+  XCTAssertNil([session executeCommand:@"echo after" timeout:1 error:&error]);
+  XCTAssertNotNil(error);
+}
+
+- (void)testClosesInputWhenDebuggerExits
+{
+  NSUInteger before = FBDebuggerSessionTestsOpenFileDescriptorCount();
+  NSUInteger count = 32;
+  for (NSUInteger index = 0; index < count; index++) {
+    FBDebuggerSession *session = self.startedSession;
+    NSError *error = nil;
+    XCTAssertNil([session executeCommand:@"exit 0" timeout:5 error:&error]);
+    XCTAssertNotNil(error);
+    XCTAssertTrue(session.hasTerminated);
+    [session terminate];
+  }
+  // Closes are enqueued on the writer queues, so allow them to drain.
+  [NSRunLoop.currentRunLoop runUntilDate:[NSDate dateWithTimeIntervalSinceNow:1]];
+
+  XCTAssertLessThan(FBDebuggerSessionTestsOpenFileDescriptorCount(), before + count);
+}
+
+- (void)testPoolReusesSessionsAndCapsLiveSessions
+{
+  __block NSUInteger created = 0;
+  FBDebuggerSessionPool *pool = [FBDebuggerSessionPool poolWithMaximumSessions:2 idleTimeout:60 sessionFactory:^ FBDebuggerSession * (pid_t processIdentifier) {
+    created++;
+    return [FBDebuggerSessionTests scriptedSessionForProcessIdentifier:processIdentifier];
+  }];
+
+  NSError *error = nil;
+  pid_t target = getpid();
+  XCTAssertEqualObjects([pool executeCommand:@"echo first" onProcessIdentifier:target timeout:5 error:&error], @"first");
+  XCTAssertEqualObjects([pool executeCommand:@"echo second" onProcessIdentifier:target timeout:5 error:&error], @"second");
+  XCTAssertEqual(created, 1u);
+
+  pid_t parent = getppid();
+  XCTAssertNotNil([pool sessionForProcessIdentifier:parent error:&error]);
+  XCTAssertNotNil([pool sessionForProcessIdentifier:1 error:&error]);
+  XCTAssertNil(error);
+  XCTAssertEqual(pool.sessionCount, 2u);
+  XCTAssertEqual(created, 3u);
+
+  [pool terminateAllSessions];
+  XCTAssertEqual(pool.sessionCount, 0u);
+}
+
+- (void)testPoolReapsSessionsWhenTargetExits
+{
+  NSTask *target = [NSTask launchedTaskWithLaunchPath:@"/bin/sleep" arguments:@[@"30"]];
+  FBDebuggerSessionPool *pool = [FBDebuggerSessionPool poolWithMaximumSessions:2 idleTimeout:60 sessionFactory:^ FBDebuggerSession * (pid_t processIdentifier) {
+    return [FBDebuggerSessionTests scriptedSessionForProcessIdentifier:processIdentifier];
+  }];
+
+  NSError *error = nil;
+  FBDebuggerSession *session = [pool sessionForProcessIdentifier:target.processIdentifier error:&error];
+  XCTAssertNotNil(session);
+  [pool reapSessions];
+  XCTAssertEqual(pool.sessionCount, 1u);
+
+  [target terminate];
+  [target waitUntilExit];
+  [pool reapSessions];
+  XCTAssertEqual(pool.sessionCount, 0u);
+  XCTAssertTrue(session.hasTerminated);
+}
+
+- (void)testPoolReapsIdleSessions
+{
+  FBDebuggerSessionPool *pool = [FBDebuggerSessionPool poolWithMaximumSessions:2 idleTimeout:0.2 sessionFactory:^ FBDebuggerSession * (pid_t processIdentifier) {
+    return [FBDebuggerSessionTests scriptedSessionForProcessIdentifier:processIdentifier];
+  }];
+  XCTAssertNotNil([pool sessionForProcessIdentifier:getpid() error:nil]);
+  XCTAssertEqual(pool.sessionCount, 1u);
+
+  [NSThread sleepForTimeInterval:0.5];
+  [pool reapSessions];
+  XCTAssertEqual(pool.sessionCount, 0u);
+}
+
+@end
@@ -0,0 +1,97 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import <FBSimulatorControl/FBSimulatorControl.h>
+
+@interface FBLaunchProbeTests : XCTestCase
+
+@end
+
+@implementation FBLaunchProbeTests
+
+- (void)testParsesEventsPerProcess
+{
+  NSString *output = [@[
+    @"100 process_start 1000.000000",
+    @"100 constructor 1000.250000",
+    @"200 process_start 2000.000000",
+    @"100 main_run_loop_idle 1001.500000",
+    @"",
+  ] componentsJoinedByString:@"\n"];
+
+  NSDictionary *timings = [FBLaunchTimings timingsFromProbeOutput:output];
+  XCTAssertEqual(timings.count, 2u);
+
+  FBLaunchTimings *first = timings[@100];
+  XCTAssertEqual(first.processIdentifier, 100);
+  XCTAssertEqualWithAccuracy([first intervalFromProcessStartToEvent:FBLaunchProbeEventConstructor], 0.25, 0.0001);
+  XCTAssertEqualWithAccuracy([first intervalFromProcessStartToEvent:FBLaunchProbeEventMainRunLoopIdle], 1.5, 0.0001);
+  XCTAssertLessThan([first intervalFromProcessStartToEvent:FBLaunchProbeEventDidFinishLaunching], 0);
+  XCTAssertTrue(first.isComplete);
+
+  FBLaunchTimings *second = timings[@200];
+  XCTAssertFalse(second.isComplete);
+  XCTAssertLessThan([second intervalFromProcessStartToEvent:FBLaunchProbeEventConstructor], 0);
+}
+
+- (void)testIgnoresMalformedRepeatedAndUnterminatedLines
+{
+  NSString *output = [@[
+    @"garbage",
+    @"100 process_start",
+    @"abc constructor 1000.0",
+    @"-5 constructor 1000.0",
+    @"100 process_start 1000.0 extra",
+    @"100 process_start 1000.000000",
+    @"100 process_start 5000.000000",
+    @"100 constructor notanumber",
+    @"100 constructor 1000.5",
+  ] componentsJoinedByString:@"\n"];
+
+  NSDictionary *timings = [FBLaunchTimings timingsFromProbeOutput:output];
+  XCTAssertEqual(timings.count, 1u);
+  FBLaunchTimings *timing = timings[@100];
+  XCTAssertEqualObjects(timing.events, @{FBLaunchProbeEventProcessStart : [NSDate dateWithTimeIntervalSince1970:1000]});
+}
+
+- (void)testTimingsAreValues
+{
+  FBLaunchTimings *timings = [FBLaunchTimings timingsFromProbeOutput:@"100 process_start 1000.0\n100 constructor 1000.1\n"][@100];
+  FBLaunchTimings *decoded = [NSKeyedUnarchiver unarchiveObjectWithData:[NSKeyedArchiver archivedDataWithRootObject:timings]];
+  XCTAssertEqualObjects(decoded, timings);
+  XCTAssertEqualObjects(timings.copy, timings);
+}
+
+- (void)testCollectsTimingsReportedByLaunchedProcess
+{
+  // A stand-in for a process with Shimulator injected, reporting in the same protocol.
+  FBLaunchProbe *probe = FBLaunchProbe.probe;
+  NSString *script = @"for event in process_start constructor main_run_loop did_finish_launching main_run_loop_idle; do "
+    @"printf '%d %s %s\\n' $$ $event $(date +%s) >> \"$SHIMULATOR_LAUNCH_PROBE\"; "
+    @"done";
+  NSTask *task = [NSTask new];
+  task.launchPath = @"/bin/sh";
+  task.arguments = @[@"-c", script];
+  task.environment = probe.environment;
+  [task launch];
+  [task waitUntilExit];
+
+  FBLaunchTimings *timings = [probe waitForTimingsForProcessIdentifier:task.processIdentifier timeout:5];
+  XCTAssertNotNil(timings);
+  XCTAssertTrue(timings.isComplete);
+  XCTAssertEqual(timings.events.count, 5u);
+  XCTAssertGreaterThanOrEqual([timings intervalFromProcessStartToEvent:FBLaunchProbeEventMainRunLoopIdle], 0);
+  XCTAssertNil([probe timingsForProcessIdentifier:task.processIdentifier + 1]);
+
+  [NSFileManager.defaultManager removeItemAtPath:probe.path error:nil];
+}
+
+@end
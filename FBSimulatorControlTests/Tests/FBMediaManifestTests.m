@@ -0,0 +1,135 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import <FBSimulatorControl/FBSimulatorControl.h>
+
+#import "FBSimulatorControlFixtures.h"
+
+@interface FBMediaManifestTests : XCTestCase
+
+@property (nonatomic, copy) NSString *temporaryDirectory;
+
+@end
+
+@implementation FBMediaManifestTests
+
+- (void)setUp
+{
+  self.temporaryDirectory = [NSTemporaryDirectory() stringByAppendingPathComponent:NSUUID.UUID.UUIDString];
+  [NSFileManager.defaultManager createDirectoryAtPath:self.temporaryDirectory withIntermediateDirectories:YES attributes:nil error:nil];
+}
+
+- (void)tearDown
+{
+  [NSFileManager.defaultManager removeItemAtPath:self.temporaryDirectory error:nil];
+}
+
+- (NSArray *)fixturePaths
+{
+  return @[FBSimulatorControlFixtures.photo0Path, FBSimulatorControlFixtures.photo1Path, FBSimulatorControlFixtures.video0Path];
+}
+
+- (void)testPartitionsPhotosAndVideos
+{
+  NSError *error = nil;
+  FBMediaManifest *manifest = [FBMediaManifest manifestWithPaths:self.fixturePaths error:&error];
+  XCTAssertNil(error);
+  XCTAssertEqual(manifest.items.count, 3u);
+  XCTAssertEqualObjects([manifest.photos valueForKey:@"path"], (@[FBSimulatorControlFixtures.photo0Path, FBSimulatorControlFixtures.photo1Path]));
+  XCTAssertEqualObjects([manifest.videos valueForKey:@"path"], @[FBSimulatorControlFixtures.video0Path]);
+  XCTAssertEqual(manifest.contentHashes.count, 3u);
+}
+
+- (void)testCollapsesIdenticalContent
+{
+  NSString *copyPath = [self.temporaryDirectory stringByAppendingPathComponent:@"copy.png"];
+  XCTAssertTrue([NSFileManager.defaultManager copyItemAtPath:FBSimulatorControlFixtures.photo0Path toPath:copyPath error:nil]);
+
+  FBMediaManifest *manifest = [FBMediaManifest manifestWithPaths:@[FBSimulatorControlFixtures.photo0Path, copyPath] error:nil];
+  XCTAssertEqual(manifest.items.count, 1u);
+  XCTAssertEqualObjects([manifest.items.firstObject path], FBSimulatorControlFixtures.photo0Path);
+}
+
+- (void)testRemovingContentHashesDiffs
+{
+  FBMediaManifest *manifest = [FBMediaManifest manifestWithPaths:self.fixturePaths error:nil];
+  FBMediaItem *photo = manifest.photos.firstObject;
+
+  FBMediaManifest *diff = [manifest manifestByRemovingContentHashes:[NSSet setWithObject:photo.contentHash]];
+  XCTAssertEqual(diff.items.count, 2u);
+  XCTAssertFalse([diff.contentHashes containsObject:photo.contentHash]);
+
+  diff = [manifest manifestByRemovingContentHashes:manifest.contentHashes];
+  XCTAssertEqual(diff.items.count, 0u);
+}
+
+- (void)testRecordIsIdempotent
+{
+  NSString *recordPath = [self.temporaryDirectory stringByAppendingPathComponent:@"Media/record.plist"];
+  XCTAssertEqualObjects([FBMediaManifest recordedContentHashesAtPath:recordPath], [NSSet set]);
+
+  FBMediaManifest *manifest = [FBMediaManifest manifestWithPaths:self.fixturePaths error:nil];
+  NSError *error = nil;
+  XCTAssertTrue([FBMediaManifest recordItems:manifest.photos atPath:recordPath error:&error]);
+  XCTAssertNil(error);
+
+  FBMediaManifest *pending = [manifest manifestByRemovingContentHashes:[FBMediaManifest recordedContentHashesAtPath:recordPath]];
+  XCTAssertEqualObjects(pending.items, manifest.videos);
+
+  XCTAssertTrue([FBMediaManifest recordItems:pending.items atPath:recordPath error:&error]);
+  XCTAssertTrue([FBMediaManifest recordItems:pending.items atPath:recordPath error:&error]);
+  XCTAssertEqualObjects([FBMediaManifest recordedContentHashesAtPath:recordPath], manifest.contentHashes);
+}
+
+- (void)testManifestFromDirectoryIgnoresOtherFiles
+{
+  NSFileManager *fileManager = NSFileManager.defaultManager;
+  NSString *nested = [self.temporaryDirectory stringByAppendingPathComponent:@"nested"];
+  XCTAssertTrue([fileManager createDirectoryAtPath:nested withIntermediateDirectories:YES attributes:nil error:nil]);
+  XCTAssertTrue([fileManager copyItemAtPath:FBSimulatorControlFixtures.photo0Path toPath:[self.temporaryDirectory stringByAppendingPathComponent:@"a.png"] error:nil]);
+  XCTAssertTrue([fileManager copyItemAtPath:FBSimulatorControlFixtures.video0Path toPath:[nested stringByAppendingPathComponent:@"b.mp4"] error:nil]);
+  XCTAssertTrue([@"not media" writeToFile:[self.temporaryDirectory stringByAppendingPathComponent:@"notes.txt"] atomically:YES encoding:NSUTF8StringEncoding error:nil]);
+
+  NSError *error = nil;
+  FBMediaManifest *manifest = [FBMediaManifest manifestWithDirectory:self.temporaryDirectory error:&error];
+  XCTAssertNil(error);
+  XCTAssertEqual(manifest.photos.count, 1u);
+  XCTAssertEqual(manifest.videos.count, 1u);
+}
+
+- (void)testManifestFromManifestFileResolvesRelativePaths
+{
+  NSFileManager *fileManager = NSFileManager.defaultManager;
+  XCTAssertTrue([fileManager copyItemAtPath:FBSimulatorControlFixtures.photo1Path toPath:[self.temporaryDirectory stringByAppendingPathComponent:@"relative.png"] error:nil]);
+  NSArray *entries = @[@"relative.png", FBSimulatorControlFixtures.video0Path];
+  NSString *manifestPath = [self.temporaryDirectory stringByAppendingPathComponent:@"manifest.json"];
+  XCTAssertTrue([[NSJSONSerialization dataWithJSONObject:entries options:0 error:nil] writeToFile:manifestPath atomically:YES]);
+
+  NSError *error = nil;
+  FBMediaManifest *manifest = [FBMediaManifest manifestWithManifestFile:manifestPath error:&error];
+  XCTAssertNil(error);
+  XCTAssertEqual(manifest.items.count, 2u);
+}
+
+- (void)testFailsForUnreadableOrUnknownFiles
+{
+  NSError *error = nil;
+  XCTAssertNil([FBMediaManifest manifestWithPaths:@[@"/does/not/exist.png"] error:&error]);
+  XCTAssertNotNil(error);
+
+  error = nil;
+  NSString *textPath = [self.temporaryDirectory stringByAppendingPathComponent:@"notes.txt"];
+  XCTAssertTrue([@"not media" writeToFile:textPath atomically:YES encoding:NSUTF8StringEncoding error:nil]);
+  XCTAssertNil([FBMediaManifest manifestWithPaths:@[textPath] error:&error]);
+  XCTAssertNotNil(error);
+}
+
+@end
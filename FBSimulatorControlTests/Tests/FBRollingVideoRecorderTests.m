@@ -0,0 +1,114 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <AVFoundation/AVFoundation.h>
+#import <XCTest/XCTest.h>
+
+#import <FBSimulatorControl/FBSimulatorControl.h>
+
+#import "FBSyntheticFrameSource.h"
+
+@interface FBRollingVideoRecorderTests : XCTestCase
+
+@property (nonatomic, copy) NSString *directory;
+@property (nonatomic, strong) FBSyntheticFrameSource *frameSource;
+@property (nonatomic, strong) FBRollingVideoRecorder *recorder;
+
+@end
+
+@implementation FBRollingVideoRecorderTests
+
+- (void)setUp
+{
+  [super setUp];
+  self.directory = [NSTemporaryDirectory() stringByAppendingPathComponent:NSUUID.UUID.UUIDString];
+  self.frameSource = [FBSyntheticFrameSource sourceWithWidth:64 height:64];
+  self.recorder = [FBRollingVideoRecorder
+    recorderWithFrameSource:self.frameSource
+    retention:4
+    segmentDuration:1
+    directory:[self.directory stringByAppendingPathComponent:@"segments"]
+    logger:nil];
+}
+
+- (void)tearDown
+{
+  [self.recorder stop];
+  [NSFileManager.defaultManager removeItemAtPath:self.directory error:nil];
+  [super tearDown];
+}
+
+- (void)testRetainsOnlyMostRecentVideo
+{
+  NSError *error = nil;
+  XCTAssertTrue([self.recorder startWithError:&error]);
+  XCTAssertNil(error);
+
+  [self.frameSource emitFrames:300 framesPerSecond:30];
+
+  NSString *filePath = [self.directory stringByAppendingPathComponent:@"last.mov"];
+  XCTAssertTrue([self.recorder commitLast:3 toFilePath:filePath error:&error]);
+  XCTAssertNil(error);
+
+  // The Ring holds the retention window, plus at most one Segment that straddles the start of it.
+  NSTimeInterval ringDuration = self.recorder.ring.duration;
+  XCTAssertGreaterThanOrEqual(ringDuration, 4);
+  XCTAssertLessThanOrEqual(ringDuration, 5);
+  XCTAssertEqualWithAccuracy([self.recorder.ring.segments.lastObject endTime], 10, 0.001);
+
+  NSArray *segmentFiles = [NSFileManager.defaultManager contentsOfDirectoryAtPath:[self.directory stringByAppendingPathComponent:@"segments"] error:nil];
+  XCTAssertEqual(segmentFiles.count, self.recorder.ring.segments.count);
+
+  AVURLAsset *asset = [AVURLAsset URLAssetWithURL:[NSURL fileURLWithPath:filePath] options:nil];
+  XCTAssertEqualWithAccuracy(CMTimeGetSeconds(asset.duration), 3, 0.1);
+}
+
+- (void)testContinuesRecordingAfterCommit
+{
+  NSError *error = nil;
+  XCTAssertTrue([self.recorder startWithError:&error]);
+
+  [self.frameSource emitFrames:45 framesPerSecond:30];
+  NSString *filePath = [self.directory stringByAppendingPathComponent:@"first.mov"];
+  XCTAssertTrue([self.recorder commitLast:10 toFilePath:filePath error:&error]);
+  XCTAssertNil(error);
+  AVURLAsset *asset = [AVURLAsset URLAssetWithURL:[NSURL fileURLWithPath:filePath] options:nil];
+  XCTAssertEqualWithAccuracy(CMTimeGetSeconds(asset.duration), 1.5, 0.1);
+
+  [self.frameSource emitFrames:60 framesPerSecond:30];
+  filePath = [self.directory stringByAppendingPathComponent:@"second.mov"];
+  XCTAssertTrue([self.recorder commitLast:2 toFilePath:filePath error:&error]);
+  XCTAssertNil(error);
+  asset = [AVURLAsset URLAssetWithURL:[NSURL fileURLWithPath:filePath] options:nil];
+  XCTAssertEqualWithAccuracy(CMTimeGetSeconds(asset.duration), 2, 0.1);
+}
+
+- (void)testStopDeletesSegments
+{
+  NSError *error = nil;
+  XCTAssertTrue([self.recorder startWithError:&error]);
+  [self.frameSource emitFrames:90 framesPerSecond:30];
+  [self.recorder stop];
+
+  XCTAssertEqual(self.recorder.ring.segments.count, 0u);
+  XCTAssertFalse([NSFileManager.defaultManager fileExistsAtPath:[self.directory stringByAppendingPathComponent:@"segments"]]);
+}
+
+- (void)testFailsToCommitWithoutFrames
+{
+  NSError *error = nil;
+  XCTAssertTrue([self.recorder startWithError:&error]);
+
+  NSString *filePath = [self.directory stringByAppendingPathComponent:@"empty.mov"];
+  XCTAssertFalse([self.recorder commitLast:3 toFilePath:filePath error:&error]);
+  XCTAssertNotNil(error);
+  XCTAssertFalse([FBVideoSegmentMuxer muxSegments:@[] fromTime:0 toFilePath:filePath error:nil]);
+}
+
+@end
@@ -0,0 +1,164 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <ImageIO/ImageIO.h>
+#import <XCTest/XCTest.h>
+
+#import <FBSimulatorControl/FBSimulatorControl.h>
+
+#import "FBSyntheticFrameSource.h"
+
+@interface FBScreenshotTests : XCTestCase
+
+@property (nonatomic, strong) FBSyntheticFrameSource *frameSource;
+
+@end
+
+@implementation FBScreenshotTests
+
+- (void)setUp
+{
+  [super setUp];
+  self.frameSource = [FBSyntheticFrameSource sourceWithWidth:64 height:48];
+}
+
+- (CGImageRef)createDecodedImage:(NSData *)data CF_RETURNS_RETAINED
+{
+  CGImageSourceRef source = CGImageSourceCreateWithData((__bridge CFDataRef) data, NULL);
+  CGImageRef image = CGImageSourceCreateImageAtIndex(source, 0, NULL);
+  CFRelease(source);
+  return image;
+}
+
+- (void)testEncodesPNGLosslessly
+{
+  CVPixelBufferRef pixelBuffer = [self.frameSource createPixelBufferWithShade:0x42];
+  NSError *error = nil;
+  NSData *data = [FBScreenshotEncoder.pngEncoder encodePixelBuffer:pixelBuffer error:&error];
+  CVPixelBufferRelease(pixelBuffer);
+  XCTAssertNil(error);
+
+  uint8_t signature[] = {0x89, 'P', 'N', 'G'};
+  XCTAssertEqualObjects([data subdataWithRange:NSMakeRange(0, 4)], [NSData dataWithBytes:signature length:4]);
+
+  CGImageRef image = [self createDecodedImage:data];
+  XCTAssertEqual(CGImageGetWidth(image), 64u);
+  XCTAssertEqual(CGImageGetHeight(image), 48u);
+
+  // Draw into a known BGRA layout, to compare against the source pixels.
+  uint8_t pixels[48][64][4];
+  CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+  CGContextRef context = CGBitmapContextCreate(pixels, 64, 48, 8, 64 * 4, colorSpace, kCGBitmapByteOrder32Little | kCGImageAlphaPremultipliedFirst);
+  CGContextDrawImage(context, CGRectMake(0, 0, 64, 48), image);
+  CGContextRelease(context);
+  CGColorSpaceRelease(colorSpace);
+  CGImageRelease(image);
+
+  XCTAssertEqual(pixels[10][20][0], 0x42);
+  XCTAssertEqual(pixels[10][20][1], 10);
+  XCTAssertEqual(pixels[10][20][2], 20);
+}
+
+- (void)testEncodesJPEG
+{
+  CVPixelBufferRef pixelBuffer = [self.frameSource createPixelBufferWithShade:0x80];
+  NSError *error = nil;
+  NSData *data = [FBScreenshotEncoder.jpegEncoder encodePixelBuffer:pixelBuffer error:&error];
+  CVPixelBufferRelease(pixelBuffer);
+  XCTAssertNil(error);
+  XCTAssertEqualObjects(FBScreenshotEncoder.jpegEncoder.fileExtension, @"jpg");
+
+  uint8_t signature[] = {0xFF, 0xD8};
+  XCTAssertEqualObjects([data subdataWithRange:NSMakeRange(0, 2)], [NSData dataWithBytes:signature length:2]);
+  CGImageRef image = [self createDecodedImage:data];
+  XCTAssertEqual(CGImageGetWidth(image), 64u);
+  CGImageRelease(image);
+}
+
+- (void)testFailsToEncodeUnsupportedPixelFormat
+{
+  CVPixelBufferRef pixelBuffer = NULL;
+  CVPixelBufferCreate(kCFAllocatorDefault, 64, 48, kCVPixelFormatType_420YpCbCr8BiPlanarVideoRange, NULL, &pixelBuffer);
+  NSError *error = nil;
+  XCTAssertNil([FBScreenshotEncoder.pngEncoder encodePixelBuffer:pixelBuffer error:&error]);
+  XCTAssertNotNil(error);
+  CVPixelBufferRelease(pixelBuffer);
+}
+
+- (void)testEncodesInBackgroundToWritableLog
+{
+  CVPixelBufferRef pixelBuffer = [self.frameSource createPixelBufferWithShade:0];
+  CGImageRef image = [FBScreenshotEncoder createImageFromPixelBuffer:pixelBuffer];
+  CVPixelBufferRelease(pixelBuffer);
+
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Encoded"];
+  __block FBWritableLog *log = nil;
+  [FBScreenshotEncoder.pngEncoder encodeImage:image name:@"screenshot" completion:^(FBWritableLog *innerLog, NSError *error) {
+    XCTAssertFalse(NSThread.isMainThread);
+    log = innerLog;
+    [expectation fulfill];
+  }];
+  CGImageRelease(image);
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+
+  XCTAssertEqualObjects(log.shortName, @"screenshot");
+  XCTAssertEqualObjects(log.fileType, @"png");
+  XCTAssertTrue(log.hasLogContent);
+
+  // Diagnostics are archived as part of the History.
+  FBWritableLog *unarchived = [NSKeyedUnarchiver unarchiveObjectWithData:[NSKeyedArchiver archivedDataWithRootObject:log]];
+  XCTAssertEqualObjects(unarchived.asData, log.asData);
+  XCTAssertEqualObjects(unarchived.fileType, @"png");
+}
+
+- (void)testEncodesSynchronouslyToWritableLog
+{
+  CVPixelBufferRef pixelBuffer = [self.frameSource createPixelBufferWithShade:0];
+  CGImageRef image = [FBScreenshotEncoder createImageFromPixelBuffer:pixelBuffer];
+  CVPixelBufferRelease(pixelBuffer);
+
+  NSError *error = nil;
+  FBWritableLog *log = [FBScreenshotEncoder.jpegEncoder encodeImage:image name:@"screenshot" error:&error];
+  CGImageRelease(image);
+  XCTAssertNil(error);
+  XCTAssertEqualObjects(log.shortName, @"screenshot");
+  XCTAssertEqualObjects(log.fileType, @"jpg");
+  XCTAssertTrue(log.hasLogContent);
+}
+
+- (void)testFrameSourceProvidesScreenshot
+{
+  self.frameSource.framesOnStart = 3;
+  id<FBScreenshotSource> source = [FBFrameScreenshotSource sourceWithFrameSource:self.frameSource timeout:1];
+
+  NSError *error = nil;
+  CGImageRef image = [source createImageWithError:&error];
+  XCTAssertNil(error);
+  XCTAssertTrue(image != NULL);
+  XCTAssertEqual(CGImageGetWidth(image), 64u);
+  XCTAssertEqual(CGImageGetHeight(image), 48u);
+  CGImageRelease(image);
+
+  // The Frame Source is stopped once the Screenshot has been taken.
+  NSUInteger frameCount = self.frameSource.frameCount;
+  [self.frameSource emitFrames:1 framesPerSecond:30];
+  XCTAssertEqual(self.frameSource.frameCount, frameCount);
+}
+
+- (void)testFrameSourceTimesOutWithoutFrames
+{
+  id<FBScreenshotSource> source = [FBFrameScreenshotSource sourceWithFrameSource:self.frameSource timeout:0.1];
+
+  NSError *error = nil;
+  CGImageRef image = [source createImageWithError:&error];
+  XCTAssertTrue(image == NULL);
+  XCTAssertNotNil(error);
+}
+
+@end
@@ -0,0 +1,123 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <AVFoundation/AVFoundation.h>
+#import <XCTest/XCTest.h>
+
+#import <FBSimulatorControl/FBSimulatorControl.h>
+#import <FBSimulatorControl/FBSimulatorHistory+Private.h>
+
+#import "FBSyntheticFrameSource.h"
+
+@interface FBSegmentedVideoRecorderTests : XCTestCase
+
+@property (nonatomic, copy) NSString *directory;
+@property (nonatomic, strong) FBSyntheticFrameSource *frameSource;
+@property (nonatomic, strong) FBSegmentedVideoRecorder *recorder;
+
+@end
+
+@implementation FBSegmentedVideoRecorderTests
+
+- (void)setUp
+{
+  [super setUp];
+  self.directory = [NSTemporaryDirectory() stringByAppendingPathComponent:NSUUID.UUID.UUIDString];
+  self.frameSource = [FBSyntheticFrameSource sourceWithWidth:64 height:64];
+  self.recorder = [FBSegmentedVideoRecorder
+    recorderWithFrameSource:self.frameSource
+    segmentDuration:2
+    directory:self.directory
+    logger:nil];
+}
+
+- (void)tearDown
+{
+  [NSFileManager.defaultManager removeItemAtPath:self.directory error:nil];
+  [super tearDown];
+}
+
+- (FBVideoSegmentIndex *)recordWithMarkers
+{
+  NSError *error = nil;
+  XCTAssertTrue([self.recorder startWithError:&error]);
+  XCTAssertNil(error);
+
+  // 3s before the first Test, a 1s Test, then a 2.5s Test.
+  [self.frameSource emitFrames:90 framesPerSecond:30];
+  [self.recorder markWithName:@"testFoo"];
+  [self.frameSource emitFrames:30 framesPerSecond:30];
+  [self.recorder markWithName:@"testBar"];
+  [self.frameSource emitFrames:75 framesPerSecond:30];
+
+  FBVideoSegmentIndex *index = [self.recorder stopWithError:&error];
+  XCTAssertNil(error);
+  XCTAssertNotNil(index);
+  return index;
+}
+
+- (void)testRotatesPeriodicallyAndAtMarkers
+{
+  FBVideoSegmentIndex *index = [self recordWithMarkers];
+
+  NSArray *startTimes = [index.segments valueForKey:@"startTime"];
+  XCTAssertEqualObjects(startTimes, (@[@0, @2, @3, @4, @6]));
+  XCTAssertEqualWithAccuracy([index.segments.lastObject endTime], 6.5, 0.001);
+  XCTAssertEqualObjects(([index.markers valueForKey:@"name"]), (@[@"testFoo", @"testBar"]));
+  XCTAssertEqualObjects([index segmentContainingTime:3], index.segments[2]);
+  XCTAssertEqualObjects([index segmentContainingTime:4], index.segments[3]);
+
+  for (FBVideoSegment *segment in index.segments) {
+    XCTAssertTrue([NSFileManager.defaultManager fileExistsAtPath:segment.path]);
+  }
+}
+
+- (void)testWritesSidecarIndex
+{
+  FBVideoSegmentIndex *index = [self recordWithMarkers];
+
+  NSError *error = nil;
+  FBVideoSegmentIndex *sidecar = [FBVideoSegmentIndex indexWithContentsOfFile:self.recorder.indexPath error:&error];
+  XCTAssertNil(error);
+  XCTAssertEqualObjects(sidecar.segments, index.segments);
+  XCTAssertEqualObjects(sidecar.markers, index.markers);
+  XCTAssertEqualWithAccuracy(sidecar.startDate.timeIntervalSinceReferenceDate, index.startDate.timeIntervalSinceReferenceDate, 0.001);
+}
+
+- (void)testTrimsSpanOfMarker
+{
+  FBVideoSegmentIndex *index = [self recordWithMarkers];
+  NSString *filePath = [self.directory stringByAppendingPathComponent:@"testBar.mov"];
+
+  NSError *error = nil;
+  XCTAssertTrue([FBVideoTrimmer trimIndex:index markerNamed:@"testBar" toFilePath:filePath error:&error]);
+  XCTAssertNil(error);
+
+  AVURLAsset *asset = [AVURLAsset URLAssetWithURL:[NSURL fileURLWithPath:filePath] options:nil];
+  XCTAssertEqualWithAccuracy(CMTimeGetSeconds(asset.duration), 2.5, 0.1);
+}
+
+- (void)testTrimsSpanBetweenHistoryTimestamps
+{
+  FBVideoSegmentIndex *index = [self recordWithMarkers];
+  FBSimulatorHistory *fromHistory = [FBSimulatorHistory new];
+  fromHistory.timestamp = [index.startDate dateByAddingTimeInterval:1.5];
+  FBSimulatorHistory *toHistory = [FBSimulatorHistory new];
+  toHistory.timestamp = [index.startDate dateByAddingTimeInterval:5];
+  NSString *filePath = [self.directory stringByAppendingPathComponent:@"history.mp4"];
+
+  NSError *error = nil;
+  XCTAssertTrue([FBVideoTrimmer trimIndex:index fromHistory:fromHistory toHistory:toHistory toFilePath:filePath error:&error]);
+  XCTAssertNil(error);
+
+  AVURLAsset *asset = [AVURLAsset URLAssetWithURL:[NSURL fileURLWithPath:filePath] options:nil];
+  XCTAssertEqualWithAccuracy(CMTimeGetSeconds(asset.duration), 3.5, 0.1);
+}
+
+@end
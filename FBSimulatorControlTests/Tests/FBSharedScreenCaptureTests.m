@@ -0,0 +1,293 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import <FBSimulatorControl/FBSimulatorControl.h>
+
+#import "FBSyntheticFrameSource.h"
+
+static size_t const Width = 64;
+static size_t const Height = 64;
+
+/**
+ Records the Frames that a Client delivers, optionally blocking on the first Frame to simulate a slow encoder.
+ */
+@interface FBSharedScreenCaptureTestConsumer : NSObject <FBVideoFrameConsumer>
+
+@property (nonatomic, strong, readwrite) dispatch_semaphore_t blockingSemaphore;
+@property (nonatomic, copy, readwrite) void (^onFrame)(id<FBVideoFrameSource> frameSource);
+@property (nonatomic, strong, readonly) NSMutableArray *sizes;
+@property (nonatomic, strong, readonly) NSMutableArray *firstPixels;
+
+@end
+
+@implementation FBSharedScreenCaptureTestConsumer
+
+- (instancetype)init
+{
+  self = [super init];
+  if (!self) {
+    return nil;
+  }
+
+  _sizes = [NSMutableArray array];
+  _firstPixels = [NSMutableArray array];
+
+  return self;
+}
+
+- (void)frameSource:(id<FBVideoFrameSource>)frameSource didProduceFrame:(CVPixelBufferRef)pixelBuffer presentationTime:(CMTime)presentationTime
+{
+  CVPixelBufferLockBaseAddress(pixelBuffer, kCVPixelBufferLock_ReadOnly);
+  const uint8_t *pixel = CVPixelBufferGetBaseAddress(pixelBuffer);
+  NSArray *firstPixel = @[@(pixel[1]), @(pixel[2])];
+  CVPixelBufferUnlockBaseAddress(pixelBuffer, kCVPixelBufferLock_ReadOnly);
+
+  @synchronized(self) {
+    [self.sizes addObject:[NSValue valueWithSize:CGSizeMake(CVPixelBufferGetWidth(pixelBuffer), CVPixelBufferGetHeight(pixelBuffer))]];
+    [self.firstPixels addObject:firstPixel];
+  }
+  if (self.blockingSemaphore) {
+    dispatch_semaphore_wait(self.blockingSemaphore, DISPATCH_TIME_FOREVER);
+  }
+  if (self.onFrame) {
+    self.onFrame(frameSource);
+  }
+}
+
+@end
+
+@interface FBSharedScreenCaptureTests : XCTestCase
+
+@property (nonatomic, strong) FBSyntheticFrameSource *source;
+@property (nonatomic, strong) FBSharedScreenCapture *capture;
+
+@end
+
+@implementation FBSharedScreenCaptureTests
+
+- (void)setUp
+{
+  [super setUp];
+  self.source = [FBSyntheticFrameSource sourceWithWidth:Width height:Height];
+  self.capture = [FBSharedScreenCapture captureWithFrameSource:self.source logger:nil];
+}
+
+- (FBSharedScreenCaptureClient *)startClientWithRegion:(CGRect)region queueDepth:(NSUInteger)queueDepth consumer:(id<FBVideoFrameConsumer>)consumer
+{
+  FBSharedScreenCaptureClient *client = [self.capture
+    clientWithRegionProvider:^ CGRect (CGSize _) {
+      return region;
+    }
+    queueDepth:queueDepth
+    regionRefreshInterval:FBSharedScreenCaptureDefaultRegionRefreshInterval];
+  NSError *error = nil;
+  XCTAssertTrue([client startWithConsumer:consumer error:&error]);
+  XCTAssertNil(error);
+  return client;
+}
+
+- (void)waitForClient:(FBSharedScreenCaptureClient *)client toHandleFrames:(NSUInteger)count
+{
+  BOOL handled = [NSRunLoop.currentRunLoop spinRunLoopWithTimeout:5 untilTrue:^ BOOL {
+    return client.deliveredFrameCount + client.droppedFrameCount >= count;
+  }];
+  XCTAssertTrue(handled, @"%@ did not handle %lu Frames", client, (unsigned long) count);
+}
+
+#pragma mark Cropping
+
+- (void)testCropRegionIsEvenAndWithinFrame
+{
+  CGRect region = [FBSharedScreenCapture cropRegionForRect:CGRectMake(-5, 10, 31, 21) lockedSize:CGSizeZero frameSize:CGSizeMake(100, 100)];
+  XCTAssertTrue(CGRectEqualToRect(region, CGRectMake(0, 10, 26, 20)));
+}
+
+- (void)testLockedCropRegionIsMovedWithinFrame
+{
+  CGRect region = [FBSharedScreenCapture cropRegionForRect:CGRectMake(90, 95, 30, 30) lockedSize:CGSizeMake(20, 20) frameSize:CGSizeMake(100, 100)];
+  XCTAssertTrue(CGRectEqualToRect(region, CGRectMake(80, 80, 20, 20)));
+}
+
+- (void)testCropRegionThatCannotBeSatisfiedIsNull
+{
+  CGSize frameSize = CGSizeMake(100, 100);
+  XCTAssertTrue(CGRectIsNull([FBSharedScreenCapture cropRegionForRect:CGRectNull lockedSize:CGSizeZero frameSize:frameSize]));
+  XCTAssertTrue(CGRectIsNull([FBSharedScreenCapture cropRegionForRect:CGRectMake(200, 200, 10, 10) lockedSize:CGSizeZero frameSize:frameSize]));
+  XCTAssertTrue(CGRectIsNull([FBSharedScreenCapture cropRegionForRect:CGRectMake(0, 0, 10, 10) lockedSize:CGSizeMake(120, 10) frameSize:frameSize]));
+}
+
+- (void)testCroppedPixelsComeFromRegion
+{
+  CVPixelBufferRef pixelBuffer = [self.source createPixelBufferWithShade:7];
+  CVPixelBufferRef cropped = [FBSharedScreenCapture createCroppedPixelBuffer:pixelBuffer region:CGRectMake(10, 20, 16, 8) pool:NULL];
+  CVPixelBufferRelease(pixelBuffer);
+  XCTAssertTrue(cropped != NULL);
+  XCTAssertEqual(CVPixelBufferGetWidth(cropped), 16u);
+  XCTAssertEqual(CVPixelBufferGetHeight(cropped), 8u);
+
+  CVPixelBufferLockBaseAddress(cropped, kCVPixelBufferLock_ReadOnly);
+  const uint8_t *base = CVPixelBufferGetBaseAddress(cropped);
+  size_t bytesPerRow = CVPixelBufferGetBytesPerRow(cropped);
+  for (size_t row = 0; row < 8; row++) {
+    for (size_t column = 0; column < 16; column++) {
+      const uint8_t *pixel = base + (row * bytesPerRow) + (column * 4);
+      XCTAssertEqual(pixel[0], 7);
+      XCTAssertEqual(pixel[1], 20 + row);
+      XCTAssertEqual(pixel[2], 10 + column);
+    }
+  }
+  CVPixelBufferUnlockBaseAddress(cropped, kCVPixelBufferLock_ReadOnly);
+  CVPixelBufferRelease(cropped);
+}
+
+- (void)testCroppingOutsideOfFrameFails
+{
+  CVPixelBufferRef pixelBuffer = [self.source createPixelBufferWithShade:0];
+  CVPixelBufferRef cropped = [FBSharedScreenCapture createCroppedPixelBuffer:pixelBuffer region:CGRectMake(60, 0, 16, 8) pool:NULL];
+  CVPixelBufferRelease(pixelBuffer);
+  XCTAssertTrue(cropped == NULL);
+}
+
+#pragma mark Fan-out
+
+- (void)testClientsReceiveTheirOwnRegions
+{
+  FBSharedScreenCaptureTestConsumer *firstConsumer = [FBSharedScreenCaptureTestConsumer new];
+  FBSharedScreenCaptureTestConsumer *secondConsumer = [FBSharedScreenCaptureTestConsumer new];
+  FBSharedScreenCaptureClient *first = [self startClientWithRegion:CGRectMake(0, 0, 32, 16) queueDepth:16 consumer:firstConsumer];
+  FBSharedScreenCaptureClient *second = [self startClientWithRegion:CGRectMake(16, 12, 20, 40) queueDepth:16 consumer:secondConsumer];
+
+  [self.source emitFrames:5 framesPerSecond:30];
+  [self waitForClient:first toHandleFrames:5];
+  [self waitForClient:second toHandleFrames:5];
+
+  XCTAssertEqual(first.deliveredFrameCount, 5u);
+  XCTAssertEqual(second.deliveredFrameCount, 5u);
+  XCTAssertEqualObjects(firstConsumer.sizes.lastObject, [NSValue valueWithSize:CGSizeMake(32, 16)]);
+  XCTAssertEqualObjects(secondConsumer.sizes.lastObject, [NSValue valueWithSize:CGSizeMake(20, 40)]);
+  XCTAssertEqualObjects(firstConsumer.firstPixels.lastObject, (@[@0, @0]));
+  XCTAssertEqualObjects(secondConsumer.firstPixels.lastObject, (@[@12, @16]));
+
+  [first stop];
+  [second stop];
+}
+
+- (void)testSourceRunsWhileAnyClientIsStarted
+{
+  FBSharedScreenCaptureTestConsumer *consumer = [FBSharedScreenCaptureTestConsumer new];
+  FBSharedScreenCaptureClient *first = [self startClientWithRegion:CGRectMake(0, 0, 8, 8) queueDepth:16 consumer:consumer];
+  FBSharedScreenCaptureClient *second = [self startClientWithRegion:CGRectMake(8, 8, 8, 8) queueDepth:16 consumer:consumer];
+  XCTAssertEqual(self.capture.clientCount, 2u);
+
+  [first stop];
+  XCTAssertEqual(self.capture.clientCount, 1u);
+  [self.source emitFrames:3 framesPerSecond:30];
+  [self waitForClient:second toHandleFrames:3];
+  XCTAssertEqual(first.deliveredFrameCount, 0u);
+  XCTAssertEqual(second.deliveredFrameCount, 3u);
+
+  [second stop];
+  XCTAssertEqual(self.capture.clientCount, 0u);
+  [self.source emitFrames:3 framesPerSecond:30];
+  XCTAssertEqual(self.source.frameCount, 3u);
+}
+
+#pragma mark Backpressure
+
+- (void)testSlowClientDropsFramesIndependently
+{
+  FBSharedScreenCaptureTestConsumer *slowConsumer = [FBSharedScreenCaptureTestConsumer new];
+  slowConsumer.blockingSemaphore = dispatch_semaphore_create(0);
+  FBSharedScreenCaptureTestConsumer *fastConsumer = [FBSharedScreenCaptureTestConsumer new];
+  FBSharedScreenCaptureClient *slow = [self startClientWithRegion:CGRectMake(0, 0, 16, 16) queueDepth:1 consumer:slowConsumer];
+  FBSharedScreenCaptureClient *fast = [self startClientWithRegion:CGRectMake(16, 16, 16, 16) queueDepth:16 consumer:fastConsumer];
+
+  [self.source emitFrames:10 framesPerSecond:30];
+  [self waitForClient:fast toHandleFrames:10];
+  XCTAssertEqual(fast.deliveredFrameCount, 10u);
+  XCTAssertEqual(fast.droppedFrameCount, 0u);
+  XCTAssertEqual(slow.droppedFrameCount, 9u);
+
+  dispatch_semaphore_signal(slowConsumer.blockingSemaphore);
+  [self waitForClient:slow toHandleFrames:10];
+  XCTAssertEqual(slow.deliveredFrameCount, 1u);
+
+  [slow stop];
+  [fast stop];
+}
+
+- (void)testClientCanBeStoppedByItsConsumer
+{
+  FBSharedScreenCaptureTestConsumer *consumer = [FBSharedScreenCaptureTestConsumer new];
+  consumer.onFrame = ^(id<FBVideoFrameSource> frameSource) {
+    [frameSource stop];
+  };
+  FBSharedScreenCaptureClient *client = [self startClientWithRegion:CGRectMake(0, 0, 16, 16) queueDepth:16 consumer:consumer];
+
+  [self.source emitFrames:3 framesPerSecond:30];
+  [self waitForClient:client toHandleFrames:1];
+  XCTAssertEqual(client.deliveredFrameCount, 1u);
+  XCTAssertEqual(self.capture.clientCount, 0u);
+}
+
+#pragma mark Window Moves
+
+- (void)testRegionFollowsWindowMoveAtFixedSize
+{
+  __block CGRect window = CGRectMake(0, 0, 20, 20);
+  FBSharedScreenCaptureTestConsumer *consumer = [FBSharedScreenCaptureTestConsumer new];
+  FBSharedScreenCaptureClient *client = [self.capture
+    clientWithRegionProvider:^ CGRect (CGSize _) {
+      @synchronized(self) {
+        return window;
+      }
+    }
+    queueDepth:16
+    regionRefreshInterval:0];
+  XCTAssertTrue([client startWithConsumer:consumer error:nil]);
+
+  [self.source emitFrames:1 framesPerSecond:30];
+  [self waitForClient:client toHandleFrames:1];
+  @synchronized(self) {
+    window = CGRectMake(30, 30, 24, 24);
+  }
+  [self.source emitFrames:1 framesPerSecond:30];
+  [self waitForClient:client toHandleFrames:2];
+
+  XCTAssertTrue(CGRectEqualToRect(client.region, CGRectMake(30, 30, 20, 20)));
+  XCTAssertEqualObjects(consumer.sizes, (@[[NSValue valueWithSize:CGSizeMake(20, 20)], [NSValue valueWithSize:CGSizeMake(20, 20)]]));
+  XCTAssertEqualObjects(consumer.firstPixels, (@[@[@0, @0], @[@30, @30]]));
+
+  [client stop];
+}
+
+- (void)testUnknownRegionDropsFrames
+{
+  FBSharedScreenCaptureTestConsumer *consumer = [FBSharedScreenCaptureTestConsumer new];
+  FBSharedScreenCaptureClient *client = [self startClientWithRegion:CGRectNull queueDepth:16 consumer:consumer];
+
+  [self.source emitFrames:4 framesPerSecond:30];
+  [self waitForClient:client toHandleFrames:4];
+  XCTAssertEqual(client.deliveredFrameCount, 0u);
+  XCTAssertEqual(client.droppedFrameCount, 4u);
+
+  [client stop];
+}
+
+- (void)testSharedCapturesAreKeyedByFrameRate
+{
+  CGDirectDisplayID displayID = CGMainDisplayID();
+  FBSharedScreenCapture *capture = [FBSharedScreenCapture sharedCaptureForDisplay:displayID framesPerSecond:30 logger:nil];
+  XCTAssertEqual([FBSharedScreenCapture sharedCaptureForDisplay:displayID framesPerSecond:30 logger:nil], capture);
+  XCTAssertNotEqual([FBSharedScreenCapture sharedCaptureForDisplay:displayID framesPerSecond:10 logger:nil], capture);
+}
+
+@end
@@ -0,0 +1,206 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import <FBSimulatorControl/FBSimulatorConfiguration+Private.h>
+#import <FBSimulatorControl/FBSimulatorControl.h>
+
+#import "CoreSimulatorDoubles.h"
+
+@interface FBSimulatorCatalogueTests : XCTestCase
+
+@end
+
+@implementation FBSimulatorCatalogueTests
+
+- (void)tearDown
+{
+  [FBSimulatorConfiguration setCatalogue:nil];
+}
+
+- (NSDictionary *)manifest
+{
+  return @{
+    @"version" : @1,
+    @"devices" : @[
+      @{@"name" : @"iPhone 7", @"family" : @"iPhone"},
+      @{@"name" : @"iPad Pro 2", @"family" : @"iPad"},
+    ],
+    @"runtimes" : @[
+      @{@"name" : @"iOS 10.0", @"version" : @"10.0", @"families" : @[@"iPhone", @"iPad"]},
+    ],
+  };
+}
+
+- (NSDictionary *)manifestByReplacing:(NSString *)key atIndex:(NSUInteger)index with:(NSDictionary *)entry
+{
+  NSMutableDictionary *manifest = [self.manifest mutableCopy];
+  NSMutableArray *entries = [manifest[key] mutableCopy];
+  entries[index] = entry;
+  manifest[key] = entries;
+  return manifest;
+}
+
+- (FBSimulatorCatalogue *)catalogue
+{
+  NSError *error = nil;
+  FBSimulatorCatalogue *catalogue = [FBSimulatorCatalogue catalogueWithManifest:self.manifest error:&error];
+  XCTAssertNil(error);
+  XCTAssertNotNil(catalogue);
+  return catalogue;
+}
+
+- (void)assertInvalidManifest:(NSDictionary *)manifest
+{
+  NSError *error = nil;
+  XCTAssertNil([FBSimulatorCatalogue catalogueWithManifest:manifest error:&error]);
+  XCTAssertNotNil(error);
+}
+
+- (void)testReadsValidManifest
+{
+  FBSimulatorCatalogue *catalogue = self.catalogue;
+  XCTAssertEqualObjects([catalogue.devices valueForKey:@"name"], (@[@"iPhone 7", @"iPad Pro 2"]));
+  XCTAssertEqualObjects([catalogue.runtimes valueForKey:@"name"], (@[@"iOS 10.0"]));
+
+  FBSimulatorCatalogueDevice *device = [catalogue deviceNamed:@"iPhone 7"];
+  XCTAssertEqualObjects(device.family, FBSimulatorCatalogueFamilyiPhone);
+  XCTAssertEqual(device.productFamilyID, 1);
+  XCTAssertEqual([catalogue deviceNamed:@"iPad Pro 2"].productFamilyID, 2);
+
+  FBSimulatorCatalogueRuntime *runtime = [catalogue runtimeNamed:@"iOS 10.0"];
+  XCTAssertEqualObjects(runtime.version, @"10.0");
+  XCTAssertEqualObjects(runtime.families, ([NSSet setWithArray:@[FBSimulatorCatalogueFamilyiPhone, FBSimulatorCatalogueFamilyiPad]]));
+  XCTAssertEqualObjects(runtime.productFamilyIDs, ([NSSet setWithArray:@[@1, @2]]));
+
+  XCTAssertNil([catalogue deviceNamed:@"iPhone 1"]);
+  XCTAssertNil([catalogue runtimeNamed:nil]);
+  XCTAssertEqualObjects(catalogue, self.catalogue);
+}
+
+- (void)testRejectsInvalidManifests
+{
+  NSMutableDictionary *manifest = [self.manifest mutableCopy];
+  manifest[@"version"] = @2;
+  [self assertInvalidManifest:manifest];
+
+  manifest = [self.manifest mutableCopy];
+  manifest[@"devices"] = @{};
+  [self assertInvalidManifest:manifest];
+
+  [self assertInvalidManifest:[self manifestByReplacing:@"devices" atIndex:1 with:@{@"name" : @"iPad Pro 2", @"family" : @"Mac"}]];
+  [self assertInvalidManifest:[self manifestByReplacing:@"devices" atIndex:1 with:@{@"name" : @"iPhone 7", @"family" : @"iPhone"}]];
+  [self assertInvalidManifest:[self manifestByReplacing:@"devices" atIndex:1 with:@{@"name" : @"", @"family" : @"iPad"}]];
+  [self assertInvalidManifest:[self manifestByReplacing:@"runtimes" atIndex:0 with:@{@"name" : @"iOS 10.0", @"version" : @"ten", @"families" : @[@"iPhone"]}]];
+  [self assertInvalidManifest:[self manifestByReplacing:@"runtimes" atIndex:0 with:@{@"name" : @"iOS 10.0", @"version" : @"10.0", @"families" : @[]}]];
+  [self assertInvalidManifest:(NSDictionary *) @[]];
+}
+
+- (void)testReadsJSONAndPlistManifests
+{
+  NSString *directory = [NSTemporaryDirectory() stringByAppendingPathComponent:[NSString stringWithFormat:@"FBSimulatorCatalogueTests_%@", NSUUID.UUID.UUIDString]];
+  XCTAssertTrue([NSFileManager.defaultManager createDirectoryAtPath:directory withIntermediateDirectories:YES attributes:nil error:nil]);
+
+  NSString *jsonPath = [directory stringByAppendingPathComponent:@"catalogue.json"];
+  XCTAssertTrue([[NSJSONSerialization dataWithJSONObject:self.manifest options:0 error:nil] writeToFile:jsonPath atomically:YES]);
+  NSString *plistPath = [directory stringByAppendingPathComponent:@"catalogue.plist"];
+  XCTAssertTrue([self.manifest writeToFile:plistPath atomically:YES]);
+  NSString *garbagePath = [directory stringByAppendingPathComponent:@"garbage.json"];
+  XCTAssertTrue([[@"{" dataUsingEncoding:NSUTF8StringEncoding] writeToFile:garbagePath atomically:YES]);
+
+  NSError *error = nil;
+  XCTAssertEqualObjects([FBSimulatorCatalogue catalogueWithManifestAtPath:jsonPath error:&error], self.catalogue);
+  XCTAssertNil(error);
+  XCTAssertEqualObjects([FBSimulatorCatalogue catalogueWithManifestAtPath:plistPath error:&error], self.catalogue);
+  XCTAssertNil(error);
+  XCTAssertNil([FBSimulatorCatalogue catalogueWithManifestAtPath:garbagePath error:&error]);
+  XCTAssertNotNil(error);
+  error = nil;
+  XCTAssertNil([FBSimulatorCatalogue catalogueWithManifestAtPath:[directory stringByAppendingPathComponent:@"missing.json"] error:&error]);
+  XCTAssertNotNil(error);
+
+  [NSFileManager.defaultManager removeItemAtPath:directory error:nil];
+}
+
+- (void)testMergesDiscoveredDeviceTypesAndRuntimes
+{
+  NSArray *deviceTypes = @[
+    @{@"name" : @"iPhone 7", @"productFamilyID" : @1},
+    @{@"name" : @"Apple Watch Series 2 - 42mm", @"productFamilyID" : @4},
+    @{@"name" : @"Unknown Family", @"productFamilyID" : @99},
+  ];
+  NSArray *runtimes = @[
+    @{@"name" : @"watchOS 3.0", @"versionString" : @"3.0", @"supportedProductFamilyIDs" : @[@4]},
+    @{@"name" : @"iOS 10.0", @"versionString" : @"10.0", @"supportedProductFamilyIDs" : @[@1]},
+  ];
+  FBSimulatorCatalogue *discovered = [FBSimulatorCatalogue catalogueFromDeviceTypes:deviceTypes runtimes:runtimes];
+  XCTAssertEqualObjects([discovered.devices valueForKey:@"name"], (@[@"iPhone 7", @"Apple Watch Series 2 - 42mm"]));
+  FBSimulatorCatalogueDevice *watch = [discovered deviceNamed:@"Apple Watch Series 2 - 42mm"];
+  XCTAssertEqualObjects(watch.family, FBSimulatorCatalogueFamilyWatch);
+  XCTAssertEqual(watch.productFamilyID, 4);
+
+  // The Manifest takes precedence over discovered entries of the same name.
+  FBSimulatorCatalogue *merged = [self.catalogue catalogueByMergingCatalogue:discovered];
+  XCTAssertEqualObjects([merged.devices valueForKey:@"name"], (@[@"iPhone 7", @"iPad Pro 2", @"Apple Watch Series 2 - 42mm"]));
+  XCTAssertEqualObjects([merged.runtimes valueForKey:@"name"], (@[@"iOS 10.0", @"watchOS 3.0"]));
+  XCTAssertEqualObjects([merged deviceNamed:@"iPhone 7"], [self.catalogue deviceNamed:@"iPhone 7"]);
+  XCTAssertEqual([merged runtimeNamed:@"iOS 10.0"].families.count, 2u);
+}
+
+- (void)testConfigurationsResolveCatalogueEntries
+{
+  XCTAssertNil([FBSimulatorConfiguration deviceWithName:@"iPhone 7"]);
+  XCTAssertNil([FBSimulatorConfiguration osWithName:@"iOS 10.0"]);
+
+  [FBSimulatorConfiguration setCatalogue:self.catalogue];
+  XCTAssertEqualObjects(FBSimulatorConfiguration.catalogue, self.catalogue);
+
+  FBSimulatorConfiguration *configuration = [[FBSimulatorConfiguration.defaultConfiguration withDeviceNamed:@"iPhone 7"] withOSNamed:@"iOS 10.0"];
+  XCTAssertEqualObjects(configuration.deviceName, @"iPhone 7");
+  XCTAssertEqualObjects(configuration.osVersionString, @"iOS 10.0");
+  XCTAssertTrue([configuration.device.family isKindOfClass:FBSimulatorConfiguration_Family_iPhone.class]);
+  XCTAssertTrue([configuration.os.families containsObject:configuration.device.family]);
+
+  // Built-in Variants are not shadowed by the Catalogue.
+  XCTAssertEqual([FBSimulatorConfiguration deviceWithName:@"iPhone 6"], FBSimulatorConfiguration.iPhone6.device);
+
+  NSData *data = [NSKeyedArchiver archivedDataWithRootObject:configuration];
+  FBSimulatorConfiguration *unarchived = [NSKeyedUnarchiver unarchiveObjectWithData:data];
+  XCTAssertEqualObjects(unarchived, configuration);
+
+  [FBSimulatorConfiguration setCatalogue:nil];
+  XCTAssertNil([FBSimulatorConfiguration deviceWithName:@"iPhone 7"]);
+  XCTAssertNil([FBSimulatorConfiguration osWithName:@"iOS 10.0"]);
+}
+
+- (void)testInferredConfigurationsFollowTheCatalogue
+{
+  FBSimulatorControlTests_SimDeviceType_Double *deviceType = [FBSimulatorControlTests_SimDeviceType_Double new];
+  deviceType.name = @"iPhone 7";
+  deviceType.identifier = @"com.apple.CoreSimulator.SimDeviceType.iPhone-7";
+  FBSimulatorControlTests_SimDeviceRuntime_Double *runtime = [FBSimulatorControlTests_SimDeviceRuntime_Double new];
+  runtime.name = @"iOS 10.0";
+  runtime.identifier = @"com.apple.CoreSimulator.SimRuntime.iOS-10-0";
+  FBSimulatorControlTests_SimDevice_Double *device = [FBSimulatorControlTests_SimDevice_Double new];
+  device.deviceType = deviceType;
+  device.runtime = runtime;
+
+  [FBSimulatorConfiguration setCatalogue:self.catalogue];
+  NSError *error = nil;
+  FBSimulatorConfiguration *configuration = [FBSimulatorConfiguration inferSimulatorConfigurationFromDevice:(SimDevice *) device error:&error];
+  XCTAssertNil(error);
+  XCTAssertEqualObjects(configuration.deviceName, @"iPhone 7");
+
+  [FBSimulatorConfiguration setCatalogue:nil];
+  XCTAssertNil([FBSimulatorConfiguration inferSimulatorConfigurationFromDevice:(SimDevice *) device error:&error]);
+  XCTAssertNotNil(error);
+}
+
+@end
@@ -9,6 +9,7 @@
 
 #import <XCTest/XCTest.h>
 
+#import <FBSimulatorControl/FBSimulatorConfiguration+Private.h>
 #import <FBSimulatorControl/FBSimulatorControl.h>
 
 @interface FBSimulatorConfigurationTests : XCTestCase
@@ -43,4 +44,26 @@
   XCTAssertEqualObjects(config, configUnarchived);
 }
 
+- (void)testLooksUpEveryVariantByName
+{
+  for (id<FBSimulatorConfiguration_Device> device in FBSimulatorConfiguration.deviceConfigurations) {
+    XCTAssertEqual([FBSimulatorConfiguration deviceWithName:device.deviceName], device);
+  }
+  for (id<FBSimulatorConfiguration_OS> os in FBSimulatorConfiguration.OSConfigurations) {
+    XCTAssertEqual([FBSimulatorConfiguration osWithName:os.name], os);
+  }
+  XCTAssertNil([FBSimulatorConfiguration deviceWithName:@"iPhone 1"]);
+  XCTAssertNil([FBSimulatorConfiguration deviceWithName:@""]);
+  XCTAssertNil([FBSimulatorConfiguration osWithName:@"iOS 1.0"]);
+  XCTAssertNil([FBSimulatorConfiguration osWithName:nil]);
+}
+
+- (void)testNamedConfigurations
+{
+  XCTAssertEqualObjects([FBSimulatorConfiguration withDeviceNamed:@"iPad Air 2"].deviceName, @"iPad Air 2");
+  XCTAssertNil([FBSimulatorConfiguration withDeviceNamed:@"iPad 3"]);
+  XCTAssertEqualObjects([FBSimulatorConfiguration.iPhone6 withOSNamed:@"iOS 9.1"].osVersionString, @"iOS 9.1");
+  XCTAssertNil([FBSimulatorConfiguration withOSNamed:@"iOS 9.9"]);
+}
+
 @end
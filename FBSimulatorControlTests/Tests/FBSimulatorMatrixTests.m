@@ -0,0 +1,106 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import <FBSimulatorControl/FBSimulatorControl.h>
+
+@interface FBSimulatorMatrixTests : XCTestCase
+
+@end
+
+@implementation FBSimulatorMatrixTests
+
+- (FBSimulatorMatrix *)matrix
+{
+  return [FBSimulatorMatrix
+    matrixWithDeviceNames:@[@"iPhone 5", @"iPad 2", @"Apple Watch - 38mm", @"iPhone 5"]
+    osNames:@[@"iOS 8.4", @"iOS 9.2", @"watchOS 2.1"]];
+}
+
+- (NSArray *)descriptionsOfCells:(NSArray *)cells
+{
+  return [cells valueForKey:@"description"];
+}
+
+- (void)testEnumeratesCellsByDeviceThenOS
+{
+  NSArray *expected = @[
+    @"iPhone 5 | iOS 8.4",
+    @"iPhone 5 | iOS 9.2",
+    @"iPhone 5 | watchOS 2.1",
+    @"iPad 2 | iOS 8.4",
+    @"iPad 2 | iOS 9.2",
+    @"iPad 2 | watchOS 2.1",
+    @"Apple Watch - 38mm | iOS 8.4",
+    @"Apple Watch - 38mm | iOS 9.2",
+    @"Apple Watch - 38mm | watchOS 2.1",
+  ];
+  XCTAssertEqualObjects([self descriptionsOfCells:self.matrix.cells], expected);
+}
+
+- (void)testExclusions
+{
+  FBSimulatorMatrix *matrix = [[[self.matrix
+    excludingDeviceName:@"Apple Watch - 38mm" osName:nil]
+    excludingDeviceName:nil osName:@"watchOS 2.1"]
+    excludingDeviceName:@"iPad 2" osName:@"iOS 8.4"];
+  NSArray *expected = @[
+    @"iPhone 5 | iOS 8.4",
+    @"iPhone 5 | iOS 9.2",
+    @"iPad 2 | iOS 9.2",
+  ];
+  XCTAssertEqualObjects([self descriptionsOfCells:matrix.cells], expected);
+  XCTAssertEqual(self.matrix.cells.count, 9u);
+  XCTAssertNotEqualObjects(matrix, self.matrix);
+  XCTAssertEqualObjects([self.matrix excludingDeviceName:nil osName:@"iOS 8.4"], [self.matrix excludingDeviceName:nil osName:@"iOS 8.4"]);
+}
+
+- (void)testConfigurationsOfValidCells
+{
+  FBSimulatorMatrix *matrix = [self.matrix withBaseConfiguration:FBSimulatorConfiguration.defaultConfiguration.scale50Percent];
+  NSError *error = nil;
+  FBSimulatorConfiguration *configuration = [matrix configurationForCell:[FBSimulatorMatrixCell cellWithDeviceName:@"iPad 2" osName:@"iOS 8.4"] error:&error];
+  XCTAssertNil(error);
+  XCTAssertEqualObjects(configuration.deviceName, @"iPad 2");
+  XCTAssertEqualObjects(configuration.osVersionString, @"iOS 8.4");
+  XCTAssertEqualObjects(configuration.scaleString, @"0.50");
+
+  configuration = [matrix configurationForCell:[FBSimulatorMatrixCell cellWithDeviceName:@"Apple Watch - 38mm" osName:@"watchOS 2.1"] error:&error];
+  XCTAssertNil(error);
+  XCTAssertEqualObjects(configuration.deviceName, @"Apple Watch - 38mm");
+}
+
+- (void)testConfigurationsOfInvalidCells
+{
+  NSArray *cells = @[
+    [FBSimulatorMatrixCell cellWithDeviceName:@"Apple Watch - 38mm" osName:@"iOS 9.2"],
+    [FBSimulatorMatrixCell cellWithDeviceName:@"iPhone 5" osName:@"watchOS 2.1"],
+    [FBSimulatorMatrixCell cellWithDeviceName:@"iPhone 1" osName:@"iOS 9.2"],
+    [FBSimulatorMatrixCell cellWithDeviceName:@"iPhone 5" osName:@"iOS 1.0"],
+  ];
+  for (FBSimulatorMatrixCell *cell in cells) {
+    NSError *error = nil;
+    XCTAssertNil([self.matrix configurationForCell:cell error:&error]);
+    XCTAssertNotNil(error, @"%@ should be invalid", cell);
+  }
+}
+
+- (void)testCellsAreKeys
+{
+  NSDictionary *table = @{
+    [FBSimulatorMatrixCell cellWithDeviceName:@"iPhone 5" osName:@"iOS 9.2"] : @1,
+    [FBSimulatorMatrixCell cellWithDeviceName:@"iPhone 5" osName:@"iOS 8.4"] : @2,
+  };
+  XCTAssertEqualObjects(table[[FBSimulatorMatrixCell cellWithDeviceName:@"iPhone 5" osName:@"iOS 9.2"]], @1);
+  XCTAssertEqualObjects(table[[FBSimulatorMatrixCell cellWithDeviceName:@"iPhone 5" osName:@"iOS 8.4"]], @2);
+  XCTAssertNil(table[[FBSimulatorMatrixCell cellWithDeviceName:@"iOS 9.2" osName:@"iPhone 5"]]);
+}
+
+@end
@@ -105,6 +105,25 @@
   XCTAssertEqual(simulatorUUIDs.count, 0u);
 }
 
+- (void)testProvisionsMatrixWithPerCellFailures
+{
+  NSString *osName = self.simulatorConfiguration.osVersionString;
+  FBSimulatorMatrix *matrix = [FBSimulatorMatrix matrixWithDeviceNames:@[@"iPhone 5", @"iPad 2", @"Apple Watch - 38mm"] osNames:@[osName]];
+  FBSimulatorMatrixResult *result = [self.control.simulatorPool provisionMatrix:matrix options:self.allocationOptions maxConcurrency:2];
+
+  XCTAssertEqual(result.cells.count, 3u);
+  XCTAssertFalse(result.isComplete);
+  XCTAssertNotNil([result errorForDeviceName:@"Apple Watch - 38mm" osName:osName]);
+  for (NSString *deviceName in @[@"iPhone 5", @"iPad 2"]) {
+    FBSimulator *simulator = [result simulatorForDeviceName:deviceName osName:osName];
+    XCTAssertNotNil(simulator, @"%@", [result errorForDeviceName:deviceName osName:osName]);
+    XCTAssertEqual(simulator.state, FBSimulatorStateBooted);
+    XCTAssertEqualObjects(simulator.configuration.deviceName, deviceName);
+    XCTAssertTrue([self.control.simulatorPool.allocatedSimulators containsObject:simulator]);
+    [self assertFreesSimulator:simulator];
+  }
+}
+
 #pragma mark Helpers
 
 - (NSString *)temporaryFilePathForSimulator:(FBSimulator *)simulator
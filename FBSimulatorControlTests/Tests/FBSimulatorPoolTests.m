@@ -11,6 +11,7 @@
 
 #import <FBSimulatorControl/FBSimulator.h>
 #import <FBSimulatorControl/FBSimulatorApplication.h>
+#import <FBSimulatorControl/FBSimulatorConfiguration.h>
 #import <FBSimulatorControl/FBSimulatorControlConfiguration.h>
 #import <FBSimulatorControl/FBSimulatorPool+Private.h>
 #import <FBSimulatorControl/FBSimulatorPool.h>
@@ -51,9 +52,11 @@
 
     FBSimulatorControlTests_SimDeviceType_Double *deviceType = [FBSimulatorControlTests_SimDeviceType_Double new];
     deviceType.name = name;
+    deviceType.identifier = [@"com.apple.CoreSimulator.SimDeviceType." stringByAppendingString:name];
 
     FBSimulatorControlTests_SimDeviceRuntime_Double *runtime = [FBSimulatorControlTests_SimDeviceRuntime_Double new];
     runtime.name = os;
+    runtime.identifier = [@"com.apple.CoreSimulator.SimRuntime." stringByAppendingString:os];
     runtime.versionString = version;
 
     FBSimulatorControlTests_SimDevice_Double *device = [FBSimulatorControlTests_SimDevice_Double new];
@@ -214,4 +217,36 @@
   }
 }
 
+- (void)testInfersConfigurationsOfInflatedSimulators
+{
+  [self createPoolWithExistingSimDeviceSpecs:@[
+    @{@"name" : @"iPad 2", @"os" : @"iOS 9.1"},
+    @{@"name" : @"iPhone 5"},
+    @{@"name" : @"iPhone 5"},
+    @{@"name" : @"iPad 3"},
+  ]];
+
+  NSArray *simulators = self.pool.allSimulators;
+  XCTAssertEqualObjects([simulators[0] configuration], [FBSimulatorConfiguration.iPad2 withOSNamed:@"iOS 9.1"]);
+  XCTAssertEqualObjects([simulators[1] configuration], [FBSimulatorConfiguration.iPhone5 withOSNamed:@"iOS 9.0"]);
+  // Simulators of the same Device Type & Runtime share the same inferred Configuration.
+  XCTAssertEqual([simulators[1] configuration], [simulators[2] configuration]);
+  XCTAssertNil([simulators[3] configuration]);
+}
+
+- (void)testInflatingThousandsOfSimulatorsPerformance
+{
+  NSArray *names = @[@"iPhone 5", @"iPhone 6", @"iPad Air", @"iPad Air 2", @"iPhone 6s Plus"];
+  NSArray *oses = @[@"iOS 8.4", @"iOS 9.0", @"iOS 9.1", @"iOS 9.2"];
+  NSMutableArray *specs = [NSMutableArray array];
+  for (NSUInteger index = 0; index < 4000; index++) {
+    [specs addObject:@{@"name" : names[index % names.count], @"os" : oses[index % oses.count]}];
+  }
+
+  [self measureBlock:^{
+    [self createPoolWithExistingSimDeviceSpecs:specs];
+    XCTAssertEqual(self.pool.allSimulators.count, specs.count);
+  }];
+}
+
 @end
@@ -0,0 +1,138 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import <FBSimulatorControl/FBSimulatorControl.h>
+
+static NSString *const GlobalPreferencesPath = @"Library/Preferences/.GlobalPreferences.plist";
+static NSString *const PreferencesPath = @"Library/Preferences/com.apple.Preferences.plist";
+
+@interface FBSimulatorPreferencesProfileTests : XCTestCase
+
+@property (nonatomic, copy) NSString *rootPath;
+
+@end
+
+@implementation FBSimulatorPreferencesProfileTests
+
+- (void)setUp
+{
+  self.rootPath = [NSTemporaryDirectory() stringByAppendingPathComponent:NSUUID.UUID.UUIDString];
+  [NSFileManager.defaultManager createDirectoryAtPath:[self.rootPath stringByAppendingPathComponent:@"Library/Preferences"] withIntermediateDirectories:YES attributes:nil error:nil];
+}
+
+- (void)tearDown
+{
+  [NSFileManager.defaultManager removeItemAtPath:self.rootPath error:nil];
+}
+
+- (void)writeFixture:(NSDictionary *)plist toRelativePath:(NSString *)relativePath format:(NSPropertyListFormat)format
+{
+  NSData *data = [NSPropertyListSerialization dataWithPropertyList:plist format:format options:0 error:nil];
+  XCTAssertTrue([data writeToFile:[self.rootPath stringByAppendingPathComponent:relativePath] atomically:YES]);
+}
+
+- (NSDictionary *)readRelativePath:(NSString *)relativePath format:(NSPropertyListFormat *)format
+{
+  NSData *data = [NSData dataWithContentsOfFile:[self.rootPath stringByAppendingPathComponent:relativePath]];
+  return [NSPropertyListSerialization propertyListWithData:data options:0 format:format error:nil];
+}
+
+- (NSDate *)modificationDateOfRelativePath:(NSString *)relativePath
+{
+  return [NSFileManager.defaultManager attributesOfItemAtPath:[self.rootPath stringByAppendingPathComponent:relativePath] error:nil].fileModificationDate;
+}
+
+- (void)testComposesProfiles
+{
+  FBSimulatorPreferencesProfile *profile = [[FBSimulatorPreferencesProfile.profile
+    withLocale:[NSLocale localeWithLocaleIdentifier:@"fr_FR"]]
+    withKeyboardDefaults];
+  XCTAssertEqualObjects(profile.plists[GlobalPreferencesPath][@"AppleLocale"], @"fr_FR");
+  XCTAssertEqualObjects(profile.plists[PreferencesPath][@"KeyboardCapsLock"], @NO);
+
+  FBSimulatorPreferencesProfile *override = [FBSimulatorPreferencesProfile.profile withLocale:[NSLocale localeWithLocaleIdentifier:@"en_GB"]];
+  FBSimulatorPreferencesProfile *merged = [profile withProfile:override];
+  XCTAssertEqualObjects(merged.plists[GlobalPreferencesPath][@"AppleLocale"], @"en_GB");
+  XCTAssertEqualObjects(merged.plists[PreferencesPath], profile.plists[PreferencesPath]);
+  XCTAssertEqualObjects(profile.plists[GlobalPreferencesPath][@"AppleLocale"], @"fr_FR");
+
+  FBSimulatorPreferencesProfile *decoded = [NSKeyedUnarchiver unarchiveObjectWithData:[NSKeyedArchiver archivedDataWithRootObject:merged]];
+  XCTAssertEqualObjects(decoded, merged);
+}
+
+- (void)testDiffContainsOnlyChangedKeys
+{
+  [self writeFixture:@{@"KeyboardCapsLock" : @NO, @"KeyboardAutocapitalization" : @YES, @"Unrelated" : @"Value"} toRelativePath:PreferencesPath format:NSPropertyListBinaryFormat_v1_0];
+
+  FBSimulatorPreferencesProfile *profile = [FBSimulatorPreferencesProfile.profile.withKeyboardDefaults withLocale:[NSLocale localeWithLocaleIdentifier:@"en_US"]];
+  NSDictionary *diff = [profile diffAgainstRootPath:self.rootPath];
+  XCTAssertEqualObjects(diff[PreferencesPath], (@{@"KeyboardAutocapitalization" : @NO, @"KeyboardAutocorrection" : @NO}));
+  XCTAssertEqualObjects(diff[GlobalPreferencesPath], profile.plists[GlobalPreferencesPath]);
+}
+
+- (void)testApplyMergesAndPreservesFormat
+{
+  [self writeFixture:@{@"KeyboardCapsLock" : @YES, @"Unrelated" : @"Value"} toRelativePath:PreferencesPath format:NSPropertyListXMLFormat_v1_0];
+
+  NSError *error = nil;
+  NSArray *written = [FBSimulatorPreferencesProfile.profile.withKeyboardDefaults applyToRootPath:self.rootPath error:&error];
+  XCTAssertNil(error);
+  XCTAssertEqualObjects(written, @[PreferencesPath]);
+
+  NSPropertyListFormat format = 0;
+  NSDictionary *plist = [self readRelativePath:PreferencesPath format:&format];
+  XCTAssertEqual(format, NSPropertyListXMLFormat_v1_0);
+  XCTAssertEqualObjects(plist, (@{
+    @"KeyboardCapsLock" : @NO,
+    @"KeyboardAutocapitalization" : @NO,
+    @"KeyboardAutocorrection" : @NO,
+    @"Unrelated" : @"Value",
+  }));
+}
+
+- (void)testApplyCreatesMissingFiles
+{
+  NSError *error = nil;
+  NSArray *written = [[FBSimulatorPreferencesProfile.profile withLocationAuthorizationForBundleID:@"com.example.app"] applyToRootPath:self.rootPath error:&error];
+  XCTAssertNil(error);
+  XCTAssertEqual(written.count, 1u);
+
+  NSPropertyListFormat format = 0;
+  NSDictionary *plist = [self readRelativePath:written.firstObject format:&format];
+  XCTAssertEqual(format, NSPropertyListBinaryFormat_v1_0);
+  XCTAssertEqualObjects(plist[@"com.example.app"][@"Authorized"], @YES);
+}
+
+- (void)testApplyIsIdempotent
+{
+  FBSimulatorPreferencesProfile *profile = [FBSimulatorPreferencesProfile.profile.withKeyboardDefaults withLocale:[NSLocale localeWithLocaleIdentifier:@"en_US"]];
+  NSError *error = nil;
+  XCTAssertEqual([profile applyToRootPath:self.rootPath error:&error].count, 2u);
+  XCTAssertNil(error);
+  NSDate *modificationDate = [self modificationDateOfRelativePath:PreferencesPath];
+
+  XCTAssertEqualObjects([profile diffAgainstRootPath:self.rootPath], @{});
+  XCTAssertEqualObjects([profile applyToRootPath:self.rootPath error:&error], @[]);
+  XCTAssertNil(error);
+  XCTAssertEqualObjects([self modificationDateOfRelativePath:PreferencesPath], modificationDate);
+}
+
+- (void)testApplyFailsWhenPathIsNotWritable
+{
+  NSString *blocker = [self.rootPath stringByAppendingPathComponent:@"Library/Caches"];
+  XCTAssertTrue([@"file" writeToFile:blocker atomically:YES encoding:NSUTF8StringEncoding error:nil]);
+
+  NSError *error = nil;
+  XCTAssertNil([[FBSimulatorPreferencesProfile.profile withLocationAuthorizationForBundleID:@"com.example.app"] applyToRootPath:self.rootPath error:&error]);
+  XCTAssertNotNil(error);
+}
+
+@end
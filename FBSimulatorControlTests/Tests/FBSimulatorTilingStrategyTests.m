@@ -17,6 +17,88 @@
 
 @implementation FBSimulatorTilingStrategyTests
 
++ (NSArray *)rects:(CGRect *)rects count:(NSUInteger)count
+{
+  NSMutableArray *values = [NSMutableArray array];
+  for (NSUInteger index = 0; index < count; index++) {
+    [values addObject:[NSValue valueWithRect:rects[index]]];
+  }
+  return [values copy];
+}
+
++ (NSUInteger)indexOfDisplayContainingWindow:(CGRect)window displays:(NSArray *)displays
+{
+  return [displays indexOfObjectPassingTest:^ BOOL (NSValue *display, NSUInteger _, BOOL *__) {
+    return CGRectContainsRect(display.rectValue, window);
+  }];
+}
+
+- (void)assertWindows:(NSArray *)windows withinDisplays:(NSArray *)displays margin:(CGFloat)margin
+{
+  for (NSUInteger index = 0; index < windows.count; index++) {
+    CGRect window = [windows[index] rectValue];
+    NSUInteger displayIndex = [FBSimulatorTilingStrategyTests indexOfDisplayContainingWindow:window displays:displays];
+    XCTAssertNotEqual(displayIndex, NSNotFound, @"%@ is not within a Display", NSStringFromRect(window));
+
+    // Windows on the same Display that are apart by at least the margin do not overlap when both are extended by half of it.
+    for (NSUInteger otherIndex = index + 1; otherIndex < windows.count; otherIndex++) {
+      CGRect otherWindow = [windows[otherIndex] rectValue];
+      BOOL sameDisplay = displayIndex == [FBSimulatorTilingStrategyTests indexOfDisplayContainingWindow:otherWindow displays:displays];
+      CGFloat outset = sameDisplay ? -margin / 2 : 0;
+      CGRect intersection = CGRectIntersection(CGRectInset(window, outset, outset), CGRectInset(otherWindow, outset, outset));
+      XCTAssertTrue(CGRectIsEmpty(intersection), @"%@ overlaps %@", NSStringFromRect(window), NSStringFromRect(otherWindow));
+    }
+  }
+}
+
+- (void)assertFreeRectsOfPacker:(FBSimulatorWindowPacker *)packer coverDisplaysExceptWindows:(NSArray *)windows
+{
+  // Without a margin, every point in a Display is either in a Window or in a free rectangle, but never both.
+  XCTAssertEqual(packer.margin, 0);
+  for (NSValue *display in packer.displayBounds) {
+    CGRect displayRect = display.rectValue;
+    for (CGFloat y = CGRectGetMinY(displayRect) + 0.5; y < CGRectGetMaxY(displayRect); y += 8) {
+      for (CGFloat x = CGRectGetMinX(displayRect) + 0.5; x < CGRectGetMaxX(displayRect); x += 8) {
+        CGPoint point = CGPointMake(x, y);
+        BOOL inWindow = NO;
+        for (NSValue *window in windows) {
+          inWindow = inWindow || CGRectContainsPoint(window.rectValue, point);
+        }
+        BOOL inFreeRect = NO;
+        for (NSValue *freeRect in packer.freeRects) {
+          inFreeRect = inFreeRect || CGRectContainsPoint(freeRect.rectValue, point);
+        }
+        if (inWindow == inFreeRect) {
+          XCTFail(@"%@ is in %@ Window and free rectangle", NSStringFromPoint(point), inWindow ? @"both a" : @"neither a");
+          return;
+        }
+      }
+    }
+  }
+}
+
+- (NSArray *)packWindowsOfSizes:(NSArray *)sizes withPacker:(FBSimulatorWindowPacker *)packer
+{
+  NSMutableArray *windows = [NSMutableArray array];
+  for (NSValue *size in sizes) {
+    CGRect window = [packer placeWindowOfSize:size.sizeValue];
+    if (!CGRectIsNull(window)) {
+      [windows addObject:[NSValue valueWithRect:window]];
+    }
+  }
+  return [windows copy];
+}
+
+- (NSArray *)randomSizesWithSeed:(long)seed count:(NSUInteger)count
+{
+  srand48(seed);
+  NSMutableArray *sizes = [NSMutableArray array];
+  for (NSUInteger index = 0; index < count; index++) {
+    [sizes addObject:[NSValue valueWithSize:CGSizeMake(floor(64 + drand48() * 320), floor(64 + drand48() * 480))]];
+  }
+  return [sizes copy];
+}
+
 - (void)testTilesInRegions
 {
   CGRect window = [[FBSimulatorWindowTilingStrategy isolatedRegionStrategyWithOffset:0 total:3]
@@ -32,4 +114,131 @@
   XCTAssertTrue(CGRectEqualToRect(CGRectMake(682, 0, 200, 500), window));
 }
 
+- (void)testPacksInTwoDimensions
+{
+  id<FBSimulatorWindowTilingStrategy> strategy = [FBSimulatorWindowTilingStrategy packingStrategyWithDisplayBounds:nil occupiedBounds:@[] margin:0];
+  CGRect window = [strategy targetPositionOfWindowWithSize:CGSizeMake(400, 300) inScreenSize:CGSizeMake(1024, 768) withError:nil];
+  XCTAssertTrue(CGRectEqualToRect(CGRectMake(0, 0, 400, 300), window));
+
+  CGRect occupied[] = {
+    CGRectMake(0, 0, 400, 300),
+    CGRectMake(400, 0, 400, 300),
+  };
+  strategy = [FBSimulatorWindowTilingStrategy packingStrategyWithDisplayBounds:nil occupiedBounds:[FBSimulatorTilingStrategyTests rects:occupied count:2] margin:0];
+  window = [strategy targetPositionOfWindowWithSize:CGSizeMake(400, 300) inScreenSize:CGSizeMake(1024, 768) withError:nil];
+  XCTAssertTrue(CGRectEqualToRect(CGRectMake(0, 300, 400, 300), window));
+
+  window = [strategy targetPositionOfWindowWithSize:CGSizeMake(200, 300) inScreenSize:CGSizeMake(1024, 768) withError:nil];
+  XCTAssertTrue(CGRectEqualToRect(CGRectMake(800, 0, 200, 300), window));
+}
+
+- (void)testPackingFailsWhenThereIsNoRoom
+{
+  CGRect occupied[] = {
+    CGRectMake(0, 0, 1024, 500),
+  };
+  id<FBSimulatorWindowTilingStrategy> strategy = [FBSimulatorWindowTilingStrategy packingStrategyWithDisplayBounds:nil occupiedBounds:[FBSimulatorTilingStrategyTests rects:occupied count:1] margin:0];
+  NSError *error = nil;
+  CGRect window = [strategy targetPositionOfWindowWithSize:CGSizeMake(300, 300) inScreenSize:CGSizeMake(1024, 768) withError:&error];
+  XCTAssertTrue(CGRectIsNull(window));
+  XCTAssertNotNil(error);
+}
+
+- (void)testPacksAcrossDisplays
+{
+  CGRect displays[] = {
+    CGRectMake(0, 0, 800, 600),
+    CGRectMake(800, -100, 800, 600),
+  };
+  FBSimulatorWindowPacker *packer = [FBSimulatorWindowPacker packerWithDisplayBounds:[FBSimulatorTilingStrategyTests rects:displays count:2] margin:0];
+  XCTAssertTrue(CGRectEqualToRect(CGRectMake(0, 0, 500, 500), [packer placeWindowOfSize:CGSizeMake(500, 500)]));
+  XCTAssertTrue(CGRectEqualToRect(CGRectMake(800, -100, 500, 500), [packer placeWindowOfSize:CGSizeMake(500, 500)]));
+  XCTAssertTrue(CGRectEqualToRect(CGRectMake(500, 0, 300, 300), [packer placeWindowOfSize:CGSizeMake(300, 300)]));
+  XCTAssertTrue(CGRectIsNull([packer placeWindowOfSize:CGSizeMake(500, 500)]));
+}
+
+- (void)testMarginSeparatesWindowsButNotDisplayEdges
+{
+  CGRect displays[] = {
+    CGRectMake(0, 0, 1000, 500),
+  };
+  FBSimulatorWindowPacker *packer = [FBSimulatorWindowPacker packerWithDisplayBounds:[FBSimulatorTilingStrategyTests rects:displays count:1] margin:10];
+  XCTAssertTrue(CGRectEqualToRect(CGRectMake(0, 0, 495, 245), [packer placeWindowOfSize:CGSizeMake(495, 245)]));
+  XCTAssertTrue(CGRectEqualToRect(CGRectMake(505, 0, 495, 245), [packer placeWindowOfSize:CGSizeMake(495, 245)]));
+  XCTAssertTrue(CGRectEqualToRect(CGRectMake(0, 255, 495, 245), [packer placeWindowOfSize:CGSizeMake(495, 245)]));
+  XCTAssertTrue(CGRectIsNull([packer placeWindowOfSize:CGSizeMake(500, 245)]));
+}
+
+- (void)testExactTilingCoversTheDisplay
+{
+  CGRect displays[] = {
+    CGRectMake(0, 0, 1024, 768),
+  };
+  FBSimulatorWindowPacker *packer = [FBSimulatorWindowPacker packerWithDisplayBounds:[FBSimulatorTilingStrategyTests rects:displays count:1] margin:0];
+  NSMutableArray *sizes = [NSMutableArray array];
+  for (NSUInteger index = 0; index < 12; index++) {
+    [sizes addObject:[NSValue valueWithSize:CGSizeMake(256, 256)]];
+  }
+  NSArray *windows = [self packWindowsOfSizes:sizes withPacker:packer];
+
+  XCTAssertEqual(windows.count, 12u);
+  XCTAssertEqual(packer.freeRects.count, 0u);
+  [self assertWindows:windows withinDisplays:packer.displayBounds margin:0];
+  XCTAssertTrue(CGRectIsNull([packer placeWindowOfSize:CGSizeMake(1, 1)]));
+}
+
+- (void)testRandomWindowsNeverOverlap
+{
+  CGRect displays[] = {
+    CGRectMake(0, 0, 1440, 900),
+    CGRectMake(1440, 0, 1024, 768),
+  };
+  NSArray *displayBounds = [FBSimulatorTilingStrategyTests rects:displays count:2];
+  for (long seed = 1; seed <= 20; seed++) {
+    for (NSNumber *margin in @[@0, @8]) {
+      FBSimulatorWindowPacker *packer = [FBSimulatorWindowPacker packerWithDisplayBounds:displayBounds margin:margin.doubleValue];
+      NSArray *windows = [self packWindowsOfSizes:[self randomSizesWithSeed:seed count:40] withPacker:packer];
+      XCTAssertGreaterThan(windows.count, 0u);
+      [self assertWindows:windows withinDisplays:displayBounds margin:margin.doubleValue];
+      if (margin.doubleValue == 0) {
+        [self assertFreeRectsOfPacker:packer coverDisplaysExceptWindows:windows];
+      }
+    }
+  }
+}
+
+- (void)testRandomWindowsAvoidOccupiedAreas
+{
+  CGRect displays[] = {
+    CGRectMake(0, 0, 1440, 900),
+  };
+  CGRect occupied[] = {
+    CGRectMake(100, 50, 375, 667),
+    CGRectMake(700, 300, 414, 500),
+  };
+  NSArray *displayBounds = [FBSimulatorTilingStrategyTests rects:displays count:1];
+  NSArray *occupiedBounds = [FBSimulatorTilingStrategyTests rects:occupied count:2];
+  for (long seed = 1; seed <= 20; seed++) {
+    FBSimulatorWindowPacker *packer = [FBSimulatorWindowPacker packerWithDisplayBounds:displayBounds margin:0];
+    for (NSValue *value in occupiedBounds) {
+      [packer occupyRect:value.rectValue];
+    }
+    NSArray *windows = [self packWindowsOfSizes:[self randomSizesWithSeed:seed count:30] withPacker:packer];
+    [self assertWindows:[windows arrayByAddingObjectsFromArray:occupiedBounds] withinDisplays:displayBounds margin:0];
+    [self assertFreeRectsOfPacker:packer coverDisplaysExceptWindows:[windows arrayByAddingObjectsFromArray:occupiedBounds]];
+  }
+}
+
+- (void)testPackingIsDeterministic
+{
+  CGRect displays[] = {
+    CGRectMake(0, 0, 1440, 900),
+  };
+  NSArray *displayBounds = [FBSimulatorTilingStrategyTests rects:displays count:1];
+  NSArray *sizes = [self randomSizesWithSeed:42 count:30];
+  NSArray *first = [self packWindowsOfSizes:sizes withPacker:[FBSimulatorWindowPacker packerWithDisplayBounds:displayBounds margin:4]];
+  NSArray *second = [self packWindowsOfSizes:sizes withPacker:[FBSimulatorWindowPacker packerWithDisplayBounds:displayBounds margin:4]];
+  XCTAssertEqualObjects(first, second);
+}
+
 @end
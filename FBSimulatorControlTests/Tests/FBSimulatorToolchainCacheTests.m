@@ -0,0 +1,187 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import <FBSimulatorControl/FBSimulatorControl.h>
+
+@interface FBSimulatorToolchainCacheTests : XCTestCase
+
+@property (nonatomic, copy) NSString *directory;
+
+@end
+
+@implementation FBSimulatorToolchainCacheTests
+
+- (void)setUp
+{
+  self.directory = [NSTemporaryDirectory() stringByAppendingPathComponent:[NSString stringWithFormat:@"FBSimulatorToolchainCacheTests_%@", NSUUID.UUID.UUIDString]];
+  XCTAssertTrue([NSFileManager.defaultManager createDirectoryAtPath:self.directory withIntermediateDirectories:YES attributes:nil error:nil]);
+  XCTAssertTrue([NSFileManager.defaultManager createDirectoryAtPath:[self pathFor:@"Xcode.app/Contents/Developer"] withIntermediateDirectories:YES attributes:nil error:nil]);
+  XCTAssertTrue([NSFileManager.defaultManager createDirectoryAtPath:[self pathFor:@"Xcode-beta.app/Contents/Developer"] withIntermediateDirectories:YES attributes:nil error:nil]);
+  [self selectDeveloperDirectory:@"Xcode.app/Contents/Developer"];
+  [self writeStubTool:@"xcodebuild" output:@"iOS SDKs:\n\tiOS 9.2 -sdk iphoneos9.2\n\niOS Simulator SDKs:\n\tSimulator - iOS 9.2 -sdk iphonesimulator9.2\n" status:0];
+}
+
+- (void)tearDown
+{
+  [NSFileManager.defaultManager removeItemAtPath:self.directory error:nil];
+}
+
+- (NSString *)pathFor:(NSString *)component
+{
+  return [self.directory stringByAppendingPathComponent:component];
+}
+
+- (void)writeStubTool:(NSString *)name output:(NSString *)output status:(int)status
+{
+  // Each invocation appends a line to a log, so that the number of invocations can be counted.
+  NSString *script = [NSString stringWithFormat:
+    @"#!/bin/sh\necho %@ >> '%@'\nprintf '%%s' '%@'\nexit %d\n",
+    name,
+    [self pathFor:@"invocations.log"],
+    output,
+    status
+  ];
+  NSString *path = [self pathFor:name];
+  XCTAssertTrue([script writeToFile:path atomically:YES encoding:NSUTF8StringEncoding error:nil]);
+  XCTAssertTrue([NSFileManager.defaultManager setAttributes:@{NSFilePosixPermissions : @0755} ofItemAtPath:path error:nil]);
+}
+
+- (void)selectDeveloperDirectory:(NSString *)component
+{
+  NSString *link = [self pathFor:@"xcode_select_link"];
+  [NSFileManager.defaultManager removeItemAtPath:link error:nil];
+  XCTAssertTrue([NSFileManager.defaultManager createSymbolicLinkAtPath:link withDestinationPath:[self pathFor:component] error:nil]);
+  [self writeStubTool:@"xcode-select" output:[self pathFor:component] status:0];
+}
+
+- (FBSimulatorToolchainCache *)cacheWithEnvironment:(NSDictionary *)environment
+{
+  return [FBSimulatorToolchainCache
+    cacheWithPath:[self pathFor:@"Caches/toolchain.plist"]
+    selectionPath:[self pathFor:@"xcode_select_link"]
+    xcodeSelectPath:[self pathFor:@"xcode-select"]
+    xcodebuildPath:[self pathFor:@"xcodebuild"]
+    environment:environment];
+}
+
+- (FBSimulatorToolchainCache *)cache
+{
+  return [self cacheWithEnvironment:@{}];
+}
+
+- (NSUInteger)invocationCount
+{
+  NSString *log = [NSString stringWithContentsOfFile:[self pathFor:@"invocations.log"] encoding:NSUTF8StringEncoding error:nil];
+  return [log componentsSeparatedByCharactersInSet:NSCharacterSet.newlineCharacterSet].count - 1;
+}
+
+- (FBSimulatorToolchain *)toolchainFromCache:(FBSimulatorToolchainCache *)cache
+{
+  NSError *error = nil;
+  FBSimulatorToolchain *toolchain = [cache toolchainWithError:&error];
+  XCTAssertNil(error);
+  XCTAssertNotNil(toolchain);
+  return toolchain;
+}
+
+- (void)testParsesShowSDKsOutput
+{
+  XCTAssertEqualObjects([FBSimulatorToolchainCache sdkVersionFromShowSDKsOutput:@"Simulator - iOS 9.2 -sdk iphonesimulator9.2"], @"9.2");
+  XCTAssertEqualObjects([FBSimulatorToolchainCache sdkVersionFromShowSDKsOutput:@"-sdk iphonesimulator9.0\n-sdk iphonesimulator9.3\n"], @"9.3");
+  XCTAssertNil([FBSimulatorToolchainCache sdkVersionFromShowSDKsOutput:@"-sdk macosx10.11"]);
+  XCTAssertNil([FBSimulatorToolchainCache sdkVersionFromShowSDKsOutput:@""]);
+  XCTAssertNil([FBSimulatorToolchainCache sdkVersionFromShowSDKsOutput:nil]);
+}
+
+- (void)testDiscoversOnceAcrossInstances
+{
+  FBSimulatorToolchain *expected = [FBSimulatorToolchain toolchainWithDeveloperDirectory:[self pathFor:@"Xcode.app/Contents/Developer"] sdkVersion:@"9.2"];
+  XCTAssertEqualObjects([self toolchainFromCache:self.cache], expected);
+  XCTAssertEqual(self.invocationCount, 2u);
+
+  // A new instance stands in for a new process.
+  XCTAssertEqualObjects([self toolchainFromCache:self.cache], expected);
+  XCTAssertEqualObjects([self toolchainFromCache:self.cache], expected);
+  XCTAssertEqual(self.invocationCount, 2u);
+}
+
+- (void)testRediscoversWhenSelectionChanges
+{
+  [self toolchainFromCache:self.cache];
+  XCTAssertEqual(self.invocationCount, 2u);
+
+  [self selectDeveloperDirectory:@"Xcode-beta.app/Contents/Developer"];
+  [self writeStubTool:@"xcodebuild" output:@"-sdk iphonesimulator9.3" status:0];
+  FBSimulatorToolchain *toolchain = [self toolchainFromCache:self.cache];
+  XCTAssertEqualObjects(toolchain.developerDirectory, [self pathFor:@"Xcode-beta.app/Contents/Developer"]);
+  XCTAssertEqualObjects(toolchain.sdkVersion, @"9.3");
+  XCTAssertEqual(self.invocationCount, 4u);
+
+  [self toolchainFromCache:self.cache];
+  XCTAssertEqual(self.invocationCount, 4u);
+}
+
+- (void)testRediscoversWhenSelectedXcodeIsReplaced
+{
+  [self toolchainFromCache:self.cache];
+  NSString *developerDirectory = [self pathFor:@"Xcode.app/Contents/Developer"];
+  XCTAssertTrue([NSFileManager.defaultManager removeItemAtPath:developerDirectory error:nil]);
+  XCTAssertTrue([NSFileManager.defaultManager createDirectoryAtPath:developerDirectory withIntermediateDirectories:YES attributes:nil error:nil]);
+
+  [self toolchainFromCache:self.cache];
+  XCTAssertEqual(self.invocationCount, 4u);
+}
+
+- (void)testDeveloperDirEnvironmentTakesPrecedence
+{
+  [self toolchainFromCache:self.cache];
+  NSDictionary *environment = @{@"DEVELOPER_DIR" : [self pathFor:@"Xcode-beta.app/Contents/Developer"]};
+  [self toolchainFromCache:[self cacheWithEnvironment:environment]];
+  [self toolchainFromCache:[self cacheWithEnvironment:environment]];
+  XCTAssertEqual(self.invocationCount, 4u);
+
+  [self toolchainFromCache:self.cache];
+  XCTAssertEqual(self.invocationCount, 6u);
+}
+
+- (void)testDiscoversEveryTimeWithoutSelection
+{
+  XCTAssertTrue([NSFileManager.defaultManager removeItemAtPath:[self pathFor:@"xcode_select_link"] error:nil]);
+  [self toolchainFromCache:self.cache];
+  [self toolchainFromCache:self.cache];
+  XCTAssertEqual(self.invocationCount, 4u);
+  XCTAssertFalse([NSFileManager.defaultManager fileExistsAtPath:[self pathFor:@"Caches/toolchain.plist"]]);
+}
+
+- (void)testIgnoresCorruptCache
+{
+  XCTAssertTrue([NSFileManager.defaultManager createDirectoryAtPath:[self pathFor:@"Caches"] withIntermediateDirectories:YES attributes:nil error:nil]);
+  XCTAssertTrue([[@"garbage" dataUsingEncoding:NSUTF8StringEncoding] writeToFile:[self pathFor:@"Caches/toolchain.plist"] atomically:YES]);
+  XCTAssertEqualObjects([self toolchainFromCache:self.cache].sdkVersion, @"9.2");
+  [self toolchainFromCache:self.cache];
+  XCTAssertEqual(self.invocationCount, 2u);
+}
+
+- (void)testFailsWhenDiscoveryFails
+{
+  [self writeStubTool:@"xcodebuild" output:@"" status:0];
+  NSError *error = nil;
+  XCTAssertNil([self.cache toolchainWithError:&error]);
+  XCTAssertNotNil(error);
+
+  [self writeStubTool:@"xcode-select" output:@"" status:2];
+  error = nil;
+  XCTAssertNil([self.cache toolchainWithError:&error]);
+  XCTAssertNotNil(error);
+  XCTAssertFalse([NSFileManager.defaultManager fileExistsAtPath:[self pathFor:@"Caches/toolchain.plist"]]);
+}
+
+@end
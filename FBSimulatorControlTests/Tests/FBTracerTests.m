@@ -0,0 +1,141 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import <FBSimulatorControl/FBSimulatorControl.h>
+
+@interface FBTracerTests : XCTestCase
+
+@end
+
+@implementation FBTracerTests
+
+- (void)setUp
+{
+  [FBTracer reset];
+  [FBTracer setEnabled:YES];
+}
+
+- (void)tearDown
+{
+  [FBTracer setEnabled:NO];
+  [FBTracer reset];
+}
+
+- (NSArray *)completeEvents
+{
+  return [FBTracer.traceEvents filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"ph == 'X'"]];
+}
+
+- (void)testRecordsSpansWithUDID
+{
+  FBTraceSpan span = FBTraceBegin("test", "withUDID");
+  FBTraceEndWithUDID(span, @"E8F3A9E1-5B4F-4C3D-8F21-5E2C9B7D0A11");
+  FBTraceEnd(FBTraceBegin("test", "withoutUDID"));
+
+  NSArray *events = self.completeEvents;
+  XCTAssertEqual(events.count, 2u);
+  NSDictionary *first = [events filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"name == 'withUDID'"]].firstObject;
+  XCTAssertEqualObjects(first[@"cat"], @"test");
+  XCTAssertEqualObjects(first[@"args"][@"udid"], @"E8F3A9E1-5B4F-4C3D-8F21-5E2C9B7D0A11");
+  XCTAssertGreaterThanOrEqual([first[@"dur"] doubleValue], 0);
+  NSDictionary *second = [events filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"name == 'withoutUDID'"]].firstObject;
+  XCTAssertNil(second[@"args"][@"udid"]);
+}
+
+- (void)testRecordsNothingWhenDisabled
+{
+  [FBTracer setEnabled:NO];
+  FBTraceSpan span = FBTraceBegin("test", "disabled");
+  XCTAssertEqual(span.start, 0u);
+  FBTraceEndWithUDID(span, @"UDID");
+  XCTAssertEqual(self.completeEvents.count, 0u);
+}
+
+- (void)testRecordsSpansFromManyThreads
+{
+  NSUInteger threadCount = 8;
+  NSUInteger spansPerThread = 100;
+  dispatch_apply(threadCount, dispatch_queue_create("com.facebook.fbsimulatorcontrol.tracertests", DISPATCH_QUEUE_CONCURRENT), ^(size_t _) {
+    for (NSUInteger index = 0; index < spansPerThread; index++) {
+      FBTraceEnd(FBTraceBegin("test", "concurrent"));
+    }
+  });
+
+  NSArray *events = self.completeEvents;
+  XCTAssertEqual(events.count, threadCount * spansPerThread);
+  XCTAssertEqual(FBTracer.droppedSpanCount, 0u);
+
+  NSSet *threadIdentifiers = [NSSet setWithArray:[events valueForKey:@"tid"]];
+  NSArray *metadata = [FBTracer.traceEvents filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"ph == 'M'"]];
+  XCTAssertEqualObjects([NSSet setWithArray:[metadata valueForKey:@"tid"]], threadIdentifiers);
+}
+
+- (void)testKeepsSpansFromExitedThreads
+{
+  NSThread *thread = [[NSThread alloc] initWithBlock:^{
+    FBTraceEndWithUDID(FBTraceBegin("test", "exited"), @"UDID");
+  }];
+  [thread start];
+  NSDate *deadline = [NSDate dateWithTimeIntervalSinceNow:5];
+  while (!thread.isFinished && deadline.timeIntervalSinceNow > 0) {
+    [NSThread sleepForTimeInterval:0.01];
+  }
+  // The thread's buffer is retired by a destructor that may run just after the thread is marked as finished.
+  [NSThread sleepForTimeInterval:0.1];
+
+  NSArray *events = [self.completeEvents filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"name == 'exited'"]];
+  XCTAssertEqual(events.count, 1u);
+  XCTAssertEqualObjects(events.firstObject[@"args"][@"udid"], @"UDID");
+}
+
+- (void)testCountsDroppedSpansWhenBufferIsFull
+{
+  dispatch_queue_t queue = dispatch_queue_create("com.facebook.fbsimulatorcontrol.tracertests.dropped", DISPATCH_QUEUE_SERIAL);
+  dispatch_sync(queue, ^{
+    for (NSUInteger index = 0; index < 20000; index++) {
+      FBTraceEnd(FBTraceBegin("test", "dropped"));
+    }
+  });
+  XCTAssertGreaterThan(FBTracer.droppedSpanCount, 0u);
+  XCTAssertEqual(self.completeEvents.count + FBTracer.droppedSpanCount, 20000u);
+}
+
+- (void)testExportsChromeTraceJSON
+{
+  FBTraceEndWithUDID(FBTraceBegin("test", "export"), @"UDID");
+
+  NSError *error = nil;
+  NSData *data = [FBTracer chromeTraceJSONWithError:&error];
+  XCTAssertNil(error);
+  NSDictionary *trace = [NSJSONSerialization JSONObjectWithData:data options:0 error:&error];
+  XCTAssertNil(error);
+  XCTAssertEqualObjects(trace[@"displayTimeUnit"], @"ms");
+  XCTAssertTrue([trace[@"traceEvents"] isKindOfClass:NSArray.class]);
+
+  NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:[NSString stringWithFormat:@"%@.json", NSUUID.UUID.UUIDString]];
+  XCTAssertTrue([FBTracer writeChromeTraceToPath:path error:&error]);
+  XCTAssertNil(error);
+  XCTAssertEqualObjects([NSData dataWithContentsOfFile:path], data);
+  [NSFileManager.defaultManager removeItemAtPath:path error:nil];
+}
+
+- (void)testDisabledOverheadBenchmark
+{
+  [FBTracer setEnabled:NO];
+  [self measureBlock:^{
+    for (NSUInteger index = 0; index < 1000000; index++) {
+      FBTraceEnd(FBTraceBegin("benchmark", "disabled"));
+    }
+  }];
+  XCTAssertEqual(self.completeEvents.count, 0u);
+}
+
+@end
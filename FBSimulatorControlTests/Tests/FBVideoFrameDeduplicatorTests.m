@@ -0,0 +1,186 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import <FBSimulatorControl/FBSimulatorControl.h>
+
+#import "FBSyntheticFrameSource.h"
+
+static NSUInteger const Width = 750;
+static NSUInteger const Height = 1334;
+static NSUInteger const BytesPerRow = Width * 4;
+
+@interface FBVideoFrameDeduplicatorTests : XCTestCase <FBVideoFrameConsumer>
+
+@property (nonatomic, strong) NSMutableData *frame;
+@property (nonatomic, strong) NSMutableArray *deliveredTimes;
+
+@end
+
+@implementation FBVideoFrameDeduplicatorTests
+
+- (void)setUp
+{
+  [super setUp];
+  self.frame = [NSMutableData dataWithLength:BytesPerRow * Height];
+  uint8_t *bytes = self.frame.mutableBytes;
+  for (NSUInteger index = 0; index < self.frame.length; index++) {
+    bytes[index] = (uint8_t) (index * 31);
+  }
+  self.deliveredTimes = [NSMutableArray array];
+}
+
+- (FBFrameSignature *)signatureOfFrame
+{
+  return [FBFrameSignature
+    signatureOfBytes:self.frame.bytes
+    width:Width
+    height:Height
+    bytesPerRow:BytesPerRow
+    gridSize:FBFrameSignatureDefaultGridSize
+    rowStride:FBFrameSignatureDefaultRowStride];
+}
+
+- (void)fillRectAtX:(NSUInteger)x y:(NSUInteger)y width:(NSUInteger)width height:(NSUInteger)height value:(uint8_t)value
+{
+  uint8_t *bytes = self.frame.mutableBytes;
+  for (NSUInteger row = y; row < y + height; row++) {
+    memset(bytes + (row * BytesPerRow) + (x * 4), value, width * 4);
+  }
+}
+
+#pragma mark Signatures
+
+- (void)testIdenticalFramesHaveNoDifference
+{
+  FBFrameSignature *first = self.signatureOfFrame;
+  FBFrameSignature *second = self.signatureOfFrame;
+  XCTAssertEqual([first differenceFromSignature:second], 0);
+  XCTAssertEqual(first.gridWidth, FBFrameSignatureDefaultGridSize);
+  XCTAssertEqual(first.gridHeight, FBFrameSignatureDefaultGridSize);
+}
+
+- (void)testDetectsSmallChange
+{
+  FBFrameSignature *before = self.signatureOfFrame;
+  // A 10x10 pixel change, such as a caret, in the bottom right tile.
+  [self fillRectAtX:Width - 20 y:Height - 20 width:10 height:10 value:0xFF];
+  FBFrameSignature *after = self.signatureOfFrame;
+
+  double difference = [after differenceFromSignature:before];
+  XCTAssertGreaterThan(difference, 0);
+  XCTAssertLessThan(difference, 10);
+}
+
+- (void)testLargeChangeExceedsSmallChange
+{
+  FBFrameSignature *before = self.signatureOfFrame;
+  [self fillRectAtX:0 y:0 width:Width height:Height / 2 value:0];
+  FBFrameSignature *after = self.signatureOfFrame;
+
+  XCTAssertGreaterThan([after differenceFromSignature:before], 50);
+}
+
+- (void)testDifferentGeometryIsMaximallyDifferent
+{
+  FBFrameSignature *signature = self.signatureOfFrame;
+  FBFrameSignature *smaller = [FBFrameSignature signatureOfBytes:self.frame.bytes width:Width / 2 height:Height bytesPerRow:BytesPerRow gridSize:16 rowStride:2];
+  XCTAssertEqual([signature differenceFromSignature:smaller], 255);
+}
+
+- (void)testClampsGridToTinyFrames
+{
+  uint8_t bytes[2 * 3 * 4] = {0};
+  FBFrameSignature *signature = [FBFrameSignature signatureOfBytes:bytes width:2 height:3 bytesPerRow:8 gridSize:16 rowStride:1];
+  XCTAssertEqual(signature.gridWidth, 2u);
+  XCTAssertEqual(signature.gridHeight, 3u);
+}
+
+#pragma mark Deduplication
+
+- (void)frameSource:(id<FBVideoFrameSource>)frameSource didProduceFrame:(CVPixelBufferRef)pixelBuffer presentationTime:(CMTime)presentationTime
+{
+  [self.deliveredTimes addObject:@(CMTimeGetSeconds(presentationTime))];
+}
+
+- (void)testDropsIdleFramesAboveMinimumRate
+{
+  FBSyntheticFrameSource *source = [FBSyntheticFrameSource sourceWithWidth:64 height:64];
+  source.idle = YES;
+  FBVideoFrameDeduplicator *deduplicator = [FBVideoFrameDeduplicator deduplicatorWithFrameSource:source tolerance:0 minimumFramesPerSecond:2];
+  XCTAssertTrue([deduplicator startWithConsumer:self error:nil]);
+
+  // 3 seconds of an idle screen at 30fps is the first Frame, then a Frame every 0.5s.
+  [source emitFrames:90 framesPerSecond:30];
+  XCTAssertEqual(deduplicator.deliveredFrameCount, 6u);
+  XCTAssertEqual(deduplicator.droppedFrameCount, 84u);
+  XCTAssertEqualWithAccuracy([self.deliveredTimes[1] doubleValue], 0.5, 0.001);
+  XCTAssertEqualWithAccuracy([self.deliveredTimes.lastObject doubleValue], 2.5, 0.001);
+}
+
+- (void)testDeliversChangingFrames
+{
+  FBSyntheticFrameSource *source = [FBSyntheticFrameSource sourceWithWidth:64 height:64];
+  FBVideoFrameDeduplicator *deduplicator = [FBVideoFrameDeduplicator deduplicatorWithFrameSource:source];
+  XCTAssertTrue([deduplicator startWithConsumer:self error:nil]);
+
+  [source emitFrames:30 framesPerSecond:30];
+  XCTAssertEqual(deduplicator.deliveredFrameCount, 30u);
+  XCTAssertEqual(deduplicator.droppedFrameCount, 0u);
+}
+
+- (void)testToleranceIgnoresChangesWithinIt
+{
+  FBSyntheticFrameSource *source = [FBSyntheticFrameSource sourceWithWidth:64 height:64];
+  // Each synthetic Frame changes the blue channel by 8, so the mean of a tile changes by 2.
+  FBVideoFrameDeduplicator *deduplicator = [FBVideoFrameDeduplicator deduplicatorWithFrameSource:source tolerance:5 minimumFramesPerSecond:1];
+  XCTAssertTrue([deduplicator startWithConsumer:self error:nil]);
+
+  [source emitFrames:6 framesPerSecond:30];
+  // The first Frame, then the Frame that has drifted by 6 from it.
+  XCTAssertEqual(deduplicator.deliveredFrameCount, 2u);
+}
+
+- (void)testStopsUnderlyingSource
+{
+  FBSyntheticFrameSource *source = [FBSyntheticFrameSource sourceWithWidth:64 height:64];
+  FBVideoFrameDeduplicator *deduplicator = [FBVideoFrameDeduplicator deduplicatorWithFrameSource:source];
+  XCTAssertTrue([deduplicator startWithConsumer:self error:nil]);
+  [deduplicator stop];
+
+  [source emitFrames:5 framesPerSecond:30];
+  XCTAssertEqual(self.deliveredTimes.count, 0u);
+}
+
+#pragma mark Benchmarks
+
+- (void)testSignaturePerformance
+{
+  // A full resolution iPhone 6 Frame; 30fps capture leaves a budget of 33ms per Frame for everything.
+  [self measureBlock:^{
+    for (NSUInteger index = 0; index < 30; index++) {
+      [self signatureOfFrame];
+    }
+  }];
+}
+
+- (void)testIdleStreamDeduplicationPerformance
+{
+  FBSyntheticFrameSource *source = [FBSyntheticFrameSource sourceWithWidth:Width height:Height];
+  source.idle = YES;
+  FBVideoFrameDeduplicator *deduplicator = [FBVideoFrameDeduplicator deduplicatorWithFrameSource:source];
+  XCTAssertTrue([deduplicator startWithConsumer:self error:nil]);
+
+  [self measureBlock:^{
+    [source emitFrames:30 framesPerSecond:30];
+  }];
+}
+
+@end
@@ -0,0 +1,172 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import <FBSimulatorControl/FBSimulatorControl.h>
+
+@interface FBVideoSegmentIndexTests : XCTestCase
+
+@property (nonatomic, copy) NSString *directory;
+@property (nonatomic, copy) FBVideoSegmentIndex *index;
+
+@end
+
+@implementation FBVideoSegmentIndexTests
+
+- (void)setUp
+{
+  [super setUp];
+  self.directory = [NSTemporaryDirectory() stringByAppendingPathComponent:NSUUID.UUID.UUIDString];
+  [NSFileManager.defaultManager createDirectoryAtPath:self.directory withIntermediateDirectories:YES attributes:nil error:nil];
+
+  // Three Segments of [0, 2), [2, 3.5), [3.5, 6), the second and third starting at Markers.
+  self.index = [FBVideoSegmentIndex
+    indexWithStartDate:[NSDate dateWithTimeIntervalSince1970:1000]
+    segments:@[
+      [self segmentNamed:@"segment_000000.mov" from:0 to:2],
+      [self segmentNamed:@"segment_000001.mov" from:2 to:3.5],
+      [self segmentNamed:@"segment_000002.mov" from:3.5 to:6],
+    ]
+    markers:@[
+      [FBVideoMarker markerWithName:@"testFoo" time:2],
+      [FBVideoMarker markerWithName:@"testBar" time:3.5],
+    ]];
+}
+
+- (void)tearDown
+{
+  [NSFileManager.defaultManager removeItemAtPath:self.directory error:nil];
+  [super tearDown];
+}
+
+- (FBVideoSegment *)segmentNamed:(NSString *)name from:(NSTimeInterval)startTime to:(NSTimeInterval)endTime
+{
+  return [FBVideoSegment segmentWithPath:[self.directory stringByAppendingPathComponent:name] startTime:startTime endTime:endTime frameCount:(NSUInteger) ((endTime - startTime) * 30)];
+}
+
+- (void)testSegmentContainingTime
+{
+  XCTAssertEqualObjects([self.index segmentContainingTime:0], self.index.segments[0]);
+  XCTAssertEqualObjects([self.index segmentContainingTime:1.999], self.index.segments[0]);
+  XCTAssertEqualObjects([self.index segmentContainingTime:2], self.index.segments[1]);
+  XCTAssertEqualObjects([self.index segmentContainingTime:5.9], self.index.segments[2]);
+  XCTAssertNil([self.index segmentContainingTime:6]);
+  XCTAssertNil([self.index segmentContainingTime:-1]);
+}
+
+- (void)testResolvesSpanAcrossSegments
+{
+  NSError *error = nil;
+  FBVideoSpan *span = [self.index spanFromTime:1 toTime:4 error:&error];
+  XCTAssertNil(error);
+  XCTAssertEqualObjects(span.segments, self.index.segments);
+  XCTAssertEqual(span.startTime, 1);
+  XCTAssertEqual(span.endTime, 4);
+
+  span = [self.index spanFromTime:2 toTime:3.5 error:&error];
+  XCTAssertEqualObjects(span.segments, @[self.index.segments[1]]);
+}
+
+- (void)testClampsSpanToRecording
+{
+  NSError *error = nil;
+  FBVideoSpan *span = [self.index spanFromTime:-10 toTime:100 error:&error];
+  XCTAssertNil(error);
+  XCTAssertEqual(span.startTime, 0);
+  XCTAssertEqual(span.endTime, 6);
+  XCTAssertEqual(span.segments.count, 3u);
+}
+
+- (void)testFailsToResolveSpanOutsideOfRecording
+{
+  NSError *error = nil;
+  XCTAssertNil([self.index spanFromTime:7 toTime:8 error:&error]);
+  XCTAssertNotNil(error);
+
+  error = nil;
+  XCTAssertNil([self.index spanFromTime:3 toTime:2 error:&error]);
+  XCTAssertNotNil(error);
+
+  FBVideoSegmentIndex *empty = [FBVideoSegmentIndex indexWithStartDate:NSDate.date segments:@[] markers:@[]];
+  error = nil;
+  XCTAssertNil([empty spanFromTime:0 toTime:1 error:&error]);
+  XCTAssertNotNil(error);
+}
+
+- (void)testResolvesSpanFromDates
+{
+  NSError *error = nil;
+  FBVideoSpan *span = [self.index
+    spanFromDate:[NSDate dateWithTimeIntervalSince1970:1002.5]
+    toDate:[NSDate dateWithTimeIntervalSince1970:1005]
+    error:&error];
+  XCTAssertNil(error);
+  XCTAssertEqual(span.startTime, 2.5);
+  XCTAssertEqual(span.endTime, 5);
+  XCTAssertEqualObjects(span.segments, ([self.index.segments subarrayWithRange:NSMakeRange(1, 2)]));
+}
+
+- (void)testResolvesSpanOfMarker
+{
+  NSError *error = nil;
+  FBVideoSpan *span = [self.index spanOfMarkerNamed:@"testFoo" error:&error];
+  XCTAssertNil(error);
+  XCTAssertEqual(span.startTime, 2);
+  XCTAssertEqual(span.endTime, 3.5);
+
+  span = [self.index spanOfMarkerNamed:@"testBar" error:&error];
+  XCTAssertEqual(span.startTime, 3.5);
+  XCTAssertEqual(span.endTime, 6);
+
+  XCTAssertNil([self.index spanOfMarkerNamed:@"testBaz" error:&error]);
+  XCTAssertNotNil(error);
+}
+
+- (void)testRoundTripsThroughSidecar
+{
+  NSString *path = [self.directory stringByAppendingPathComponent:@"index.json"];
+  NSError *error = nil;
+  XCTAssertTrue([self.index writeToFile:path error:&error]);
+  XCTAssertNil(error);
+
+  FBVideoSegmentIndex *index = [FBVideoSegmentIndex indexWithContentsOfFile:path error:&error];
+  XCTAssertNil(error);
+  XCTAssertEqualObjects(index, self.index);
+
+  NSDictionary *json = [NSJSONSerialization JSONObjectWithData:[NSData dataWithContentsOfFile:path] options:0 error:nil];
+  NSDictionary *marker = json[@"markers"][1];
+  XCTAssertEqualObjects(marker[@"name"], @"testBar");
+  XCTAssertEqualObjects(marker[@"segment"], @"segment_000002.mov");
+  XCTAssertEqualObjects(marker[@"offset"], @0);
+}
+
+- (void)testSidecarMapsMarkerToOffsetWithinSegment
+{
+  NSString *path = [self.directory stringByAppendingPathComponent:@"index.json"];
+  FBVideoSegmentIndex *index = [self.index indexByAppendingMarker:[FBVideoMarker markerWithName:@"screenshot" time:4.5]];
+  XCTAssertTrue([index writeToFile:path error:nil]);
+
+  NSDictionary *json = [NSJSONSerialization JSONObjectWithData:[NSData dataWithContentsOfFile:path] options:0 error:nil];
+  NSDictionary *marker = [json[@"markers"] lastObject];
+  XCTAssertEqualObjects(marker[@"segment"], @"segment_000002.mov");
+  XCTAssertEqualWithAccuracy([marker[@"offset"] doubleValue], 1, 0.0001);
+}
+
+- (void)testFailsToReadMalformedSidecar
+{
+  NSString *path = [self.directory stringByAppendingPathComponent:@"index.json"];
+  [@"{\"start_date\": 0, \"segments\": [{\"file\": 1}]}" writeToFile:path atomically:YES encoding:NSUTF8StringEncoding error:nil];
+
+  NSError *error = nil;
+  XCTAssertNil([FBVideoSegmentIndex indexWithContentsOfFile:path error:&error]);
+  XCTAssertNotNil(error);
+}
+
+@end
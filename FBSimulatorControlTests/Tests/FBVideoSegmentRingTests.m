@@ -0,0 +1,107 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <XCTest/XCTest.h>
+
+#import <FBSimulatorControl/FBSimulatorControl.h>
+
+@interface FBVideoSegmentRingTests : XCTestCase
+
+@property (nonatomic, copy) NSString *directory;
+
+@end
+
+@implementation FBVideoSegmentRingTests
+
+- (void)setUp
+{
+  [super setUp];
+  self.directory = [NSTemporaryDirectory() stringByAppendingPathComponent:NSUUID.UUID.UUIDString];
+  [NSFileManager.defaultManager createDirectoryAtPath:self.directory withIntermediateDirectories:YES attributes:nil error:nil];
+}
+
+- (void)tearDown
+{
+  [NSFileManager.defaultManager removeItemAtPath:self.directory error:nil];
+  [super tearDown];
+}
+
+- (FBVideoSegment *)segmentFrom:(NSTimeInterval)startTime to:(NSTimeInterval)endTime
+{
+  NSString *path = [self.directory stringByAppendingPathComponent:[NSString stringWithFormat:@"segment_%.0f.mov", startTime]];
+  [NSData.data writeToFile:path atomically:YES];
+  return [FBVideoSegment segmentWithPath:path startTime:startTime endTime:endTime frameCount:30];
+}
+
+- (void)testEvictsSegmentsOutsideOfRetention
+{
+  FBVideoSegmentRing *ring = [FBVideoSegmentRing ringWithRetention:3];
+  NSMutableArray *segments = [NSMutableArray array];
+  for (NSUInteger index = 0; index < 4; index++) {
+    FBVideoSegment *segment = [self segmentFrom:index to:index + 1];
+    [segments addObject:segment];
+    XCTAssertEqual([ring appendSegment:segment].count, 0u);
+  }
+  XCTAssertEqualWithAccuracy(ring.duration, 4, 0.001);
+
+  FBVideoSegment *segment = [self segmentFrom:4 to:5];
+  [segments addObject:segment];
+  NSArray *evicted = [ring appendSegment:segment];
+  XCTAssertEqualObjects(evicted, (@[segments[0], segments[1]]));
+  XCTAssertEqualObjects(ring.segments, ([segments subarrayWithRange:NSMakeRange(2, 3)]));
+  XCTAssertEqualWithAccuracy(ring.duration, 3, 0.001);
+
+  XCTAssertFalse([NSFileManager.defaultManager fileExistsAtPath:[segments[0] path]]);
+  XCTAssertFalse([NSFileManager.defaultManager fileExistsAtPath:[segments[1] path]]);
+  XCTAssertTrue([NSFileManager.defaultManager fileExistsAtPath:[segments[2] path]]);
+}
+
+- (void)testKeepsSegmentStraddlingStartOfRetention
+{
+  FBVideoSegmentRing *ring = [FBVideoSegmentRing ringWithRetention:2.5];
+  FBVideoSegment *first = [self segmentFrom:0 to:1];
+  FBVideoSegment *second = [self segmentFrom:1 to:2];
+  FBVideoSegment *third = [self segmentFrom:2 to:3];
+  FBVideoSegment *fourth = [self segmentFrom:3 to:4];
+  [ring appendSegment:first];
+  [ring appendSegment:second];
+  [ring appendSegment:third];
+  XCTAssertEqualObjects([ring appendSegment:fourth], @[first]);
+  XCTAssertEqualObjects(ring.segments, (@[second, third, fourth]));
+  XCTAssertGreaterThanOrEqual(ring.duration, ring.retention);
+}
+
+- (void)testSegmentsCoveringLast
+{
+  FBVideoSegmentRing *ring = [FBVideoSegmentRing ringWithRetention:10];
+  FBVideoSegment *first = [self segmentFrom:0 to:2];
+  FBVideoSegment *second = [self segmentFrom:2 to:4];
+  FBVideoSegment *third = [self segmentFrom:4 to:6];
+  [ring appendSegment:first];
+  [ring appendSegment:second];
+  [ring appendSegment:third];
+
+  XCTAssertEqualObjects([ring segmentsCoveringLast:1], @[third]);
+  XCTAssertEqualObjects([ring segmentsCoveringLast:2], @[third]);
+  XCTAssertEqualObjects([ring segmentsCoveringLast:3], (@[second, third]));
+  XCTAssertEqualObjects([ring segmentsCoveringLast:60], (@[first, second, third]));
+}
+
+- (void)testRemoveAllSegmentsDeletesFiles
+{
+  FBVideoSegmentRing *ring = [FBVideoSegmentRing ringWithRetention:10];
+  FBVideoSegment *segment = [self segmentFrom:0 to:1];
+  [ring appendSegment:segment];
+  [ring removeAllSegments];
+
+  XCTAssertEqual(ring.segments.count, 0u);
+  XCTAssertFalse([NSFileManager.defaultManager fileExistsAtPath:segment.path]);
+}
+
+@end
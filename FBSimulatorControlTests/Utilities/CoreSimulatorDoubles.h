@@ -15,12 +15,14 @@
 @interface FBSimulatorControlTests_SimDeviceType_Double : NSObject
 
 @property (nonatomic, readwrite, copy) NSString *name;
+@property (nonatomic, readwrite, copy) NSString *identifier;
 
 @end
 
 @interface FBSimulatorControlTests_SimDeviceRuntime_Double : NSObject
 
 @property (nonatomic, readwrite, copy) NSString *name;
+@property (nonatomic, readwrite, copy) NSString *identifier;
 @property (nonatomic, readwrite, copy) NSString *versionString;
 
 @end
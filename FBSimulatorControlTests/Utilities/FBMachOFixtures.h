@@ -0,0 +1,66 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+/**
+ CPU Types for synthetic Mach-Os.
+ */
+extern uint32_t const FBMachOFixtureCPUTypeI386;
+extern uint32_t const FBMachOFixtureCPUTypeX86_64;
+extern uint32_t const FBMachOFixtureCPUTypeARM64;
+
+/**
+ Builds synthetic Mach-O Binaries and Bundles containing them, without depending on a toolchain.
+ */
+@interface FBMachOFixtures : NSObject
+
+/**
+ The UUID in the LC_UUID of all synthetic Mach-Os.
+ */
++ (NSUUID *)uuid;
+
+/**
+ A thin 64-Bit Mach-O with UUID, iOS version minimum, two dylibs, an rpath, a code signature and encryption info.
+
+ @param cpuType the CPU Type of the Mach Header.
+ @param minimumOSVersion the iOS Version minimum, such as '8.0'.
+ @param encrypted YES if the encryption info should be active.
+ @return the Mach-O Data.
+ */
++ (NSData *)thinBinaryWithCPUType:(uint32_t)cpuType minimumOSVersion:(NSString *)minimumOSVersion encrypted:(BOOL)encrypted;
+
+/**
+ A thin 64-Bit Mach-O, as above but unencrypted and with an LC_BUILD_VERSION in place of the iOS version minimum.
+
+ @param cpuType the CPU Type of the Mach Header.
+ @param platform the Platform of the LC_BUILD_VERSION, such as 7 for the iOS Simulator.
+ @param minimumOSVersion the OS Version minimum, such as '8.0'.
+ @return the Mach-O Data.
+ */
++ (NSData *)thinBinaryWithCPUType:(uint32_t)cpuType buildVersionPlatform:(uint32_t)platform minimumOSVersion:(NSString *)minimumOSVersion;
+
+/**
+ A Fat Mach-O containing the provided thin Mach-Os, page aligned.
+
+ @param slices an NSArray<NSData *> of thin Mach-Os.
+ @return the Mach-O Data.
+ */
++ (NSData *)fatBinaryWithSlices:(NSArray *)slices;
+
+/**
+ Writes a Bundle with an Info.plist and executable at the given path.
+
+ @param path the path of the Bundle.
+ @param executable the data of the executable.
+ @return YES if successful, NO otherwise.
+ */
++ (BOOL)writeBundleAtPath:(NSString *)path executable:(NSData *)executable;
+
+@end
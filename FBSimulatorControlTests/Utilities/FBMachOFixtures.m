@@ -0,0 +1,164 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "FBMachOFixtures.h"
+
+uint32_t const FBMachOFixtureCPUTypeI386 = 0x00000007;
+uint32_t const FBMachOFixtureCPUTypeX86_64 = 0x01000007;
+uint32_t const FBMachOFixtureCPUTypeARM64 = 0x0100000c;
+
+static void AppendUInt32(NSMutableData *data, uint32_t value)
+{
+  [data appendBytes:&value length:sizeof(value)];
+}
+
+static void AppendBigEndianUInt32(NSMutableData *data, uint32_t value)
+{
+  AppendUInt32(data, __builtin_bswap32(value));
+}
+
+static void AppendStringCommand(NSMutableData *commands, uint32_t command, uint32_t headerSize, NSString *string)
+{
+  NSData *bytes = [string dataUsingEncoding:NSUTF8StringEncoding];
+  uint32_t size = (uint32_t) ((headerSize + bytes.length + 1 + 7) & ~7);
+  AppendUInt32(commands, command);
+  AppendUInt32(commands, size);
+  AppendUInt32(commands, headerSize);
+  for (uint32_t offset = 12; offset < headerSize; offset += 4) {
+    AppendUInt32(commands, 0);
+  }
+  [commands appendData:bytes];
+  [commands increaseLengthBy:size - headerSize - bytes.length];
+}
+
+static uint32_t EncodedVersion(NSString *version)
+{
+  NSArray *components = [version componentsSeparatedByString:@"."];
+  uint32_t major = components.count > 0 ? (uint32_t) [components[0] intValue] : 0;
+  uint32_t minor = components.count > 1 ? (uint32_t) [components[1] intValue] : 0;
+  uint32_t patch = components.count > 2 ? (uint32_t) [components[2] intValue] : 0;
+  return (major << 16) | ((minor & 0xff) << 8) | (patch & 0xff);
+}
+
+@implementation FBMachOFixtures
+
++ (NSUUID *)uuid
+{
+  return [[NSUUID alloc] initWithUUIDString:@"E621E1F8-C36C-495A-93FC-0C247A3E6E5F"];
+}
+
++ (NSData *)thinBinaryWithCPUType:(uint32_t)cpuType minimumOSVersion:(NSString *)minimumOSVersion encrypted:(BOOL)encrypted
+{
+  // LC_VERSION_MIN_IPHONEOS, with SDK 9.2.1.
+  NSMutableData *versionCommand = [NSMutableData data];
+  AppendUInt32(versionCommand, 0x25);
+  AppendUInt32(versionCommand, 16);
+  AppendUInt32(versionCommand, EncodedVersion(minimumOSVersion));
+  AppendUInt32(versionCommand, EncodedVersion(@"9.2.1"));
+  return [self thinBinaryWithCPUType:cpuType versionCommand:versionCommand encrypted:encrypted];
+}
+
++ (NSData *)thinBinaryWithCPUType:(uint32_t)cpuType buildVersionPlatform:(uint32_t)platform minimumOSVersion:(NSString *)minimumOSVersion
+{
+  // LC_BUILD_VERSION, with SDK 9.2.1 and no tools.
+  NSMutableData *versionCommand = [NSMutableData data];
+  AppendUInt32(versionCommand, 0x32);
+  AppendUInt32(versionCommand, 24);
+  AppendUInt32(versionCommand, platform);
+  AppendUInt32(versionCommand, EncodedVersion(minimumOSVersion));
+  AppendUInt32(versionCommand, EncodedVersion(@"9.2.1"));
+  AppendUInt32(versionCommand, 0);
+  return [self thinBinaryWithCPUType:cpuType versionCommand:versionCommand encrypted:NO];
+}
+
++ (NSData *)fatBinaryWithSlices:(NSArray *)slices
+{
+  uint32_t alignment = 0x1000;
+
+  NSMutableData *binary = [NSMutableData data];
+  AppendBigEndianUInt32(binary, 0xcafebabe);
+  AppendBigEndianUInt32(binary, (uint32_t) slices.count);
+  uint32_t offset = alignment;
+  for (NSData *slice in slices) {
+    uint32_t cpuType = 0;
+    [slice getBytes:&cpuType range:NSMakeRange(4, sizeof(cpuType))];
+    AppendBigEndianUInt32(binary, cpuType);
+    AppendBigEndianUInt32(binary, 0);
+    AppendBigEndianUInt32(binary, offset);
+    AppendBigEndianUInt32(binary, (uint32_t) slice.length);
+    AppendBigEndianUInt32(binary, 12);
+    offset += ((uint32_t) slice.length + alignment - 1) & ~(alignment - 1);
+  }
+  for (NSData *slice in slices) {
+    binary.length = (binary.length + alignment - 1) & ~(alignment - 1);
+    [binary appendData:slice];
+  }
+  return [binary copy];
+}
+
++ (BOOL)writeBundleAtPath:(NSString *)path executable:(NSData *)executable
+{
+  if (![NSFileManager.defaultManager createDirectoryAtPath:path withIntermediateDirectories:YES attributes:nil error:nil]) {
+    return NO;
+  }
+  NSString *executableName = path.lastPathComponent.stringByDeletingPathExtension;
+  NSDictionary *infoPlist = @{
+    @"CFBundleExecutable" : executableName,
+    @"CFBundleIdentifier" : [@"com.example." stringByAppendingString:executableName],
+  };
+  return [infoPlist writeToFile:[path stringByAppendingPathComponent:@"Info.plist"] atomically:YES]
+      && [executable writeToFile:[path stringByAppendingPathComponent:executableName] atomically:YES];
+}
+
++ (NSData *)thinBinaryWithCPUType:(uint32_t)cpuType versionCommand:(NSData *)versionCommand encrypted:(BOOL)encrypted
+{
+  NSMutableData *commands = [NSMutableData data];
+
+  // LC_UUID
+  AppendUInt32(commands, 0x1b);
+  AppendUInt32(commands, 24);
+  uuid_t uuid;
+  [self.uuid getUUIDBytes:uuid];
+  [commands appendBytes:uuid length:sizeof(uuid)];
+
+  [commands appendData:versionCommand];
+
+  // LC_LOAD_DYLIB, LC_LOAD_WEAK_DYLIB & LC_RPATH
+  AppendStringCommand(commands, 0xc, 24, @"/usr/lib/libSystem.B.dylib");
+  AppendStringCommand(commands, 0x80000018, 24, @"@rpath/Weak.framework/Weak");
+  AppendStringCommand(commands, 0x8000001c, 12, @"@executable_path/Frameworks");
+
+  // LC_CODE_SIGNATURE
+  AppendUInt32(commands, 0x1d);
+  AppendUInt32(commands, 16);
+  AppendUInt32(commands, 0);
+  AppendUInt32(commands, 0);
+
+  // LC_ENCRYPTION_INFO_64
+  AppendUInt32(commands, 0x2c);
+  AppendUInt32(commands, 24);
+  AppendUInt32(commands, 0);
+  AppendUInt32(commands, 0);
+  AppendUInt32(commands, encrypted ? 1 : 0);
+  AppendUInt32(commands, 0);
+
+  NSMutableData *binary = [NSMutableData data];
+  AppendUInt32(binary, 0xfeedfacf);
+  AppendUInt32(binary, cpuType);
+  AppendUInt32(binary, 0);
+  AppendUInt32(binary, 2);
+  AppendUInt32(binary, 7);
+  AppendUInt32(binary, (uint32_t) commands.length);
+  AppendUInt32(binary, 0);
+  AppendUInt32(binary, 0);
+  [binary appendData:commands];
+  return [binary copy];
+}
+
+@end
@@ -0,0 +1,60 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import <Foundation/Foundation.h>
+
+#import <FBSimulatorControl/FBVideoFrameSource.h>
+
+/**
+ A Frame Source that produces solid-colour Frames on demand, so that Video can be tested without capturing the screen.
+ */
+@interface FBSyntheticFrameSource : NSObject <FBVideoFrameSource>
+
+/**
+ Creates and returns a new Source.
+
+ @param width the width of the Frames.
+ @param height the height of the Frames.
+ @return a new Source.
+ */
++ (instancetype)sourceWithWidth:(size_t)width height:(size_t)height;
+
+/**
+ Synchronously delivers Frames to the Consumer, with presentation times continuing from the last Frame delivered.
+ Does nothing if the Source is not started.
+
+ @param count the number of Frames to deliver.
+ @param framesPerSecond the rate of the presentation times of the Frames.
+ */
+- (void)emitFrames:(NSUInteger)count framesPerSecond:(int32_t)framesPerSecond;
+
+/**
+ The number of Frames to synchronously deliver when the Source is started, at 30 Frames per second. Defaults to 0.
+ */
+@property (nonatomic, assign, readwrite) NSUInteger framesOnStart;
+
+/**
+ When YES, every Frame delivered is identical, as if the screen were idle. Defaults to NO.
+ */
+@property (nonatomic, assign, readwrite) BOOL idle;
+
+/**
+ The total number of Frames that have been delivered.
+ */
+@property (nonatomic, assign, readonly) NSUInteger frameCount;
+
+/**
+ Creates a BGRA Frame, where each pixel is (shade, row, column). The caller is responsible for releasing it.
+
+ @param shade the blue component of every pixel.
+ @return a new Pixel Buffer.
+ */
+- (CVPixelBufferRef)createPixelBufferWithShade:(uint8_t)shade CF_RETURNS_RETAINED;
+
+@end
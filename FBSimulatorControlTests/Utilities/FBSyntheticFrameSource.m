@@ -0,0 +1,98 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+#import "FBSyntheticFrameSource.h"
+
+@interface FBSyntheticFrameSource ()
+
+@property (nonatomic, assign, readonly) size_t width;
+@property (nonatomic, assign, readonly) size_t height;
+@property (nonatomic, strong, readwrite) id<FBVideoFrameConsumer> consumer;
+@property (nonatomic, assign, readwrite) NSUInteger frameCount;
+@property (nonatomic, assign, readwrite) NSTimeInterval nextFrameTime;
+
+@end
+
+@implementation FBSyntheticFrameSource
+
++ (instancetype)sourceWithWidth:(size_t)width height:(size_t)height
+{
+  return [[self alloc] initWithWidth:width height:height];
+}
+
+- (instancetype)initWithWidth:(size_t)width height:(size_t)height
+{
+  self = [super init];
+  if (!self) {
+    return nil;
+  }
+
+  _width = width;
+  _height = height;
+
+  return self;
+}
+
+#pragma mark FBVideoFrameSource
+
+- (BOOL)startWithConsumer:(id<FBVideoFrameConsumer>)consumer error:(NSError **)error
+{
+  self.consumer = consumer;
+  [self emitFrames:self.framesOnStart framesPerSecond:30];
+  return YES;
+}
+
+- (void)stop
+{
+  self.consumer = nil;
+}
+
+#pragma mark Public
+
+- (void)emitFrames:(NSUInteger)count framesPerSecond:(int32_t)framesPerSecond
+{
+  for (NSUInteger index = 0; index < count; index++) {
+    id<FBVideoFrameConsumer> consumer = self.consumer;
+    if (!consumer) {
+      return;
+    }
+    CVPixelBufferRef pixelBuffer = [self createPixelBufferWithShade:self.idle ? 0 : (uint8_t) (self.frameCount * 8)];
+    CMTime presentationTime = CMTimeMakeWithSeconds(self.nextFrameTime, 600);
+    [consumer frameSource:self didProduceFrame:pixelBuffer presentationTime:presentationTime];
+    CVPixelBufferRelease(pixelBuffer);
+
+    self.frameCount++;
+    self.nextFrameTime += 1.0 / framesPerSecond;
+  }
+}
+
+- (CVPixelBufferRef)createPixelBufferWithShade:(uint8_t)shade
+{
+  CVPixelBufferRef pixelBuffer = NULL;
+  NSDictionary *attributes = @{(NSString *) kCVPixelBufferIOSurfacePropertiesKey : @{}};
+  CVPixelBufferCreate(kCFAllocatorDefault, self.width, self.height, kCVPixelFormatType_32BGRA, (__bridge CFDictionaryRef) attributes, &pixelBuffer);
+
+  CVPixelBufferLockBaseAddress(pixelBuffer, 0);
+  uint8_t *base = CVPixelBufferGetBaseAddress(pixelBuffer);
+  size_t bytesPerRow = CVPixelBufferGetBytesPerRow(pixelBuffer);
+  for (size_t row = 0; row < self.height; row++) {
+    uint8_t *pixel = base + (row * bytesPerRow);
+    for (size_t column = 0; column < self.width; column++, pixel += 4) {
+      pixel[0] = shade;
+      pixel[1] = (uint8_t) row;
+      pixel[2] = (uint8_t) column;
+      pixel[3] = 0xFF;
+    }
+  }
+  CVPixelBufferUnlockBaseAddress(pixelBuffer, 0);
+
+  return pixelBuffer;
+}
+
+@end
@@ -10,8 +10,16 @@
 #import <Foundation/Foundation.h>
 #import <UIKit/UIKit.h>
 
+#include <fcntl.h>
+#include <sys/sysctl.h>
+#include <sys/time.h>
+#include <unistd.h>
+
 static NSString *const ShimulatorCrashAfter = @"SHIMULATOR_CRASH_AFTER";
 static NSString *const ShimulatorUploadVideo = @"SHIMULATOR_UPLOAD_VIDEO";
+static NSString *const ShimulatorLaunchProbe = @"SHIMULATOR_LAUNCH_PROBE";
+
+static int LaunchProbeFileDescriptor = -1;
 
 @interface VideoSaveDelegate : NSObject
 
@@ -88,10 +96,74 @@ static void PerformAddVideo(void)
   [delegate performSelector:@selector(performAddVideo) withObject:nil afterDelay:5];
 }
 
+/**
+ Appends a line of '<pid> <event> <seconds since epoch>' to the probe file.
+ A single write(2) to a file opened with O_APPEND is atomic for lines of this size.
+ */
+static void LaunchProbeRecord(const char *event, struct timeval time)
+{
+  if (LaunchProbeFileDescriptor < 0) {
+    return;
+  }
+  char line[128];
+  int length = snprintf(line, sizeof(line), "%d %s %ld.%06d\n", getpid(), event, (long) time.tv_sec, (int) time.tv_usec);
+  if (length > 0 && length < (int) sizeof(line)) {
+    write(LaunchProbeFileDescriptor, line, (size_t) length);
+  }
+}
+
+static void LaunchProbeRecordNow(const char *event)
+{
+  struct timeval now;
+  gettimeofday(&now, NULL);
+  LaunchProbeRecord(event, now);
+}
+
+static void PerformLaunchProbe(void)
+{
+  NSString *path = NSProcessInfo.processInfo.environment[ShimulatorLaunchProbe];
+  if (!path) {
+    return;
+  }
+  LaunchProbeFileDescriptor = open(path.fileSystemRepresentation, O_WRONLY | O_APPEND | O_CREAT, 0644);
+  if (LaunchProbeFileDescriptor < 0) {
+    NSLog(@"Could not open Launch Probe at %@", path);
+    return;
+  }
+
+  struct kinfo_proc info;
+  size_t size = sizeof(info);
+  int name[] = {CTL_KERN, KERN_PROC, KERN_PROC_PID, getpid()};
+  if (sysctl(name, 4, &info, &size, NULL, 0) == 0 && size > 0) {
+    LaunchProbeRecord("process_start", info.kp_proc.p_starttime);
+  }
+  LaunchProbeRecordNow("constructor");
+
+  // main() cannot be interposed from an injected library.
+  // The first turn of the main run loop is the earliest observable point after main() calls UIApplicationMain.
+  // The main run loop first going idle is the closest approximation of the first frame being committed.
+  CFRunLoopObserverRef entryObserver = CFRunLoopObserverCreateWithHandler(NULL, kCFRunLoopEntry, false, 0, ^(CFRunLoopObserverRef _, CFRunLoopActivity __) {
+    LaunchProbeRecordNow("main_run_loop");
+  });
+  CFRunLoopObserverRef idleObserver = CFRunLoopObserverCreateWithHandler(NULL, kCFRunLoopBeforeWaiting, false, 0, ^(CFRunLoopObserverRef _, CFRunLoopActivity __) {
+    LaunchProbeRecordNow("main_run_loop_idle");
+  });
+  CFRunLoopAddObserver(CFRunLoopGetMain(), entryObserver, kCFRunLoopCommonModes);
+  CFRunLoopAddObserver(CFRunLoopGetMain(), idleObserver, kCFRunLoopCommonModes);
+  CFRelease(entryObserver);
+  CFRelease(idleObserver);
+
+  __block id token = [NSNotificationCenter.defaultCenter addObserverForName:UIApplicationDidFinishLaunchingNotification object:nil queue:nil usingBlock:^(NSNotification *_) {
+    LaunchProbeRecordNow("did_finish_launching");
+    [NSNotificationCenter.defaultCenter removeObserver:token];
+  }];
+}
+
 __attribute__((constructor)) static void EntryPoint()
 {
   NSLog(@"Start of Shimulator");
 
+  PerformLaunchProbe();
   PerformCrashAfter();
   PerformAddVideo();
 
@@ -15,4 +15,71 @@ public extension Subcommand {
   public static let LIST = "list"
   public static let BOOT = "boot"
   public static let SHUTDOWN = "shutdown"
+  public static let DAEMON = "daemon"
+}
+
+/**
+ Converts between a line of text and the Arguments that it contains.
+ Arguments are separated by whitespace, and may contain whitespace when double-quoted or escaped with a backslash.
+*/
+enum ArgumentTokenizer {
+  /**
+   Returns nil if the line ends inside a quote or escape.
+  */
+  static func tokenize(line: String) -> [String]? {
+    let whitespace = NSCharacterSet.whitespaceAndNewlineCharacterSet()
+    var tokens: [String] = []
+    var token = ""
+    var inToken = false
+    var quoted = false
+    var escaped = false
+
+    for character in line.unicodeScalars {
+      if escaped {
+        token.append(character)
+        escaped = false
+      } else if character == "\\" {
+        inToken = true
+        escaped = true
+      } else if character == "\"" {
+        inToken = true
+        quoted = !quoted
+      } else if !quoted && whitespace.longCharacterIsMember(character.value) {
+        if inToken {
+          tokens.append(token)
+          token = ""
+          inToken = false
+        }
+      } else {
+        token.append(character)
+        inToken = true
+      }
+    }
+    if quoted || escaped {
+      return nil
+    }
+    if inToken {
+      tokens.append(token)
+    }
+    return tokens
+  }
+
+  /**
+   The inverse of tokenize, quoting only the Arguments that need it.
+  */
+  static func quote(arguments: [String]) -> String {
+    let special = NSMutableCharacterSet.whitespaceAndNewlineCharacterSet()
+    special.addCharactersInString("\"\\")
+    return arguments
+      .map { argument in
+        if !argument.isEmpty && argument.rangeOfCharacterFromSet(special) == nil {
+          return argument
+        }
+        let escaped = argument
+          .stringByReplacingOccurrencesOfString("\\", withString: "\\\\")
+          .stringByReplacingOccurrencesOfString("\"", withString: "\\\"")
+        return "\"\(escaped)\""
+      }
+      .joinWithSeparator(" ")
+  }
 }
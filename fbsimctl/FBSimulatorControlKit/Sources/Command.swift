@@ -14,10 +14,25 @@ import FBSimulatorControl
  Defines a single transaction with FBSimulatorControl
 */
 public struct Command {
+  /**
+   The number of Simulators that a Command acts on at once, when no --jobs are given.
+  */
+  static let DefaultJobs = NSProcessInfo.processInfo().activeProcessorCount
+
   let configuration: Configuration
+  let outputMode: OutputMode
+  let jobs: Int
   let subcommand: Subcommand
 }
 
+/**
+ Defines how the results of a Command are written
+*/
+public enum OutputMode {
+  case Text
+  case JSON
+}
+
 /**
   Describes the Configuration for the running of a Command
 */
@@ -59,6 +74,7 @@ public indirect enum Query {
 */
 public indirect enum Subcommand {
   case Interact(Int?)
+  case Daemon(String?)
   case List(Query, Format)
   case Boot(Query)
   case Shutdown(Query)
@@ -69,12 +69,32 @@ extension FBSimulatorState : Parsable {
 
 extension Command : Parsable {
   public static func parser() -> Parser<Command> {
+    let subcommandParser = Parser.ofTwo(Command.jobsParser().fallback(Command.DefaultJobs), b: Subcommand.parser())
+    let followingParser = Parser.ofTwo(OutputMode.parser().fallback(.Text), b: subcommandParser)
     return Parser
-      .ofTwo(Configuration.parser(), b: Subcommand.parser())
-      .fmap { (configuration, subcommand) in
-        Command(configuration: configuration, subcommand: subcommand)
+      .ofTwo(Configuration.parser(), b: followingParser)
+      .fmap { (configuration, following) in
+        let (outputMode, (jobs, subcommand)) = following
+        return Command(configuration: configuration, outputMode: outputMode, jobs: jobs, subcommand: subcommand)
     }
   }
+
+  static func jobsParser() -> Parser<Int> {
+    return Parser
+      .succeeded("--jobs", by: Parser<Int>.ofInt())
+      .bind { jobs -> Parser<Int> in
+        if jobs < 1 {
+          return Parser<Int>.fail(ParseError.InvalidNumber)
+        }
+        return Parser<Int> { tokens in (tokens, jobs) }
+      }
+  }
+}
+
+extension OutputMode : Parsable {
+  public static func parser() -> Parser<OutputMode> {
+    return Parser.ofString("--json", constant: OutputMode.JSON)
+  }
 }
 
 extension FBSimulatorAllocationOptions : Parsable {
@@ -191,6 +211,7 @@ extension Subcommand : Parsable {
     return Parser.ofAny([
       self.helpParser(),
       self.interactParser(),
+      self.daemonParser(),
       self.listParser(),
       self.bootParser(),
       self.shutdownParser(),
@@ -208,6 +229,13 @@ extension Subcommand : Parsable {
       .fmap { Subcommand.Interact($0) }
   }
 
+  static func daemonParser() -> Parser<Subcommand> {
+    let socketPathParser = Parser<String>.single { $0 }
+    return Parser
+      .succeeded("daemon", by: Parser.succeeded("--socket", by: socketPathParser).optional())
+      .fmap { Subcommand.Daemon($0) }
+  }
+
   static func listParser() -> Parser<Subcommand> {
     let followingParser = Parser
       .ofTwo(Query.parser(), b: Format.parser())
@@ -13,5 +13,39 @@
 
 + (int32_t)sol_socket;
 + (int32_t)so_reuseaddr;
++ (int32_t)so_nosigpipe;
+
+/**
+ Puts a File Descriptor into non-blocking mode, as fcntl(2) is variadic and cannot be called from Swift.
+
+ @param fileDescriptor the File Descriptor.
+ @return YES if successful, NO otherwise.
+ */
++ (BOOL)setNonBlocking:(int32_t)fileDescriptor;
+
+/**
+ Ignores a signal, as SIG_IGN is a macro that cannot be used from Swift.
+ An ignored signal is still delivered to dispatch sources, but no longer terminates the process.
+
+ @param signal the signal to ignore.
+ @return the previous handler of the signal, to restore with signal(3).
+ */
++ (sig_t)ignoreSignal:(int32_t)signal;
+
+/**
+ Creates a Unix Domain Socket bound to the path, as the path of sockaddr_un is a fixed size C array.
+
+ @param path the path to bind to. There must not be a file at the path already.
+ @return the File Descriptor of the Socket, or -1 with errno set if unsuccessful.
+ */
++ (int32_t)bindUnixSocketToPath:(NSString *)path;
+
+/**
+ Creates a Unix Domain Socket connected to the path.
+
+ @param path the path of the listening Socket.
+ @return the File Descriptor of the Socket, or -1 with errno set if unsuccessful.
+ */
++ (int32_t)connectUnixSocketToPath:(NSString *)path;
 
 @end
@@ -9,7 +9,11 @@
 
 #import "Constants.h"
 
+#import <fcntl.h>
+#import <signal.h>
 #import <sys/socket.h>
+#import <sys/un.h>
+#import <unistd.h>
 
 @implementation Constants
 
@@ -23,4 +27,75 @@
   return SO_REUSEADDR;
 }
 
++ (int32_t)so_nosigpipe
+{
+  return SO_NOSIGPIPE;
+}
+
++ (BOOL)setNonBlocking:(int32_t)fileDescriptor
+{
+  int flags = fcntl(fileDescriptor, F_GETFL, 0);
+  if (flags == -1) {
+    return NO;
+  }
+  return fcntl(fileDescriptor, F_SETFL, flags | O_NONBLOCK) != -1;
+}
+
++ (sig_t)ignoreSignal:(int32_t)signalNumber
+{
+  return signal(signalNumber, SIG_IGN);
+}
+
++ (int32_t)bindUnixSocketToPath:(NSString *)path
+{
+  struct sockaddr_un address;
+  if (![self fillUnixSocketAddress:&address path:path]) {
+    return -1;
+  }
+  int fileDescriptor = socket(PF_UNIX, SOCK_STREAM, 0);
+  if (fileDescriptor == -1) {
+    return -1;
+  }
+  if (bind(fileDescriptor, (struct sockaddr *) &address, sizeof(address)) == -1) {
+    int bindErrno = errno;
+    close(fileDescriptor);
+    errno = bindErrno;
+    return -1;
+  }
+  return fileDescriptor;
+}
+
++ (int32_t)connectUnixSocketToPath:(NSString *)path
+{
+  struct sockaddr_un address;
+  if (![self fillUnixSocketAddress:&address path:path]) {
+    return -1;
+  }
+  int fileDescriptor = socket(PF_UNIX, SOCK_STREAM, 0);
+  if (fileDescriptor == -1) {
+    return -1;
+  }
+  if (connect(fileDescriptor, (struct sockaddr *) &address, sizeof(address)) == -1) {
+    int connectErrno = errno;
+    close(fileDescriptor);
+    errno = connectErrno;
+    return -1;
+  }
+  return fileDescriptor;
+}
+
+#pragma mark Private
+
++ (BOOL)fillUnixSocketAddress:(struct sockaddr_un *)address path:(NSString *)path
+{
+  memset(address, 0, sizeof(struct sockaddr_un));
+  address->sun_len = sizeof(struct sockaddr_un);
+  address->sun_family = AF_UNIX;
+  if (strlcpy(address->sun_path, path.fileSystemRepresentation, sizeof(address->sun_path)) >= sizeof(address->sun_path)) {
+    errno = ENAMETOOLONG;
+    return NO;
+  }
+  return YES;
+}
+
 @end
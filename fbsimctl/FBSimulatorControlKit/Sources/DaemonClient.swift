@@ -0,0 +1,131 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+import Foundation
+import FBSimulatorControl
+
+/**
+ Forwards a Command to a running Daemon, so that it is run against the Daemon's FBSimulatorControl.
+ This saves each invocation from setting up FBSimulatorControl and loading the Simulator Frameworks.
+*/
+final class DaemonClient : LineBufferDelegate {
+  static let RequestIdentifier = "cli"
+
+  /**
+   The path that the Daemon for a Configuration listens on by default.
+   Each Configuration has its own path, so that a Command is only forwarded to a Daemon that acts on the same Simulators.
+  */
+  static func defaultSocketPath(configuration: FBSimulatorControlConfiguration) -> String {
+    let deviceSetPath = configuration.deviceSetPath.map { ($0 as NSString).stringByStandardizingPath } ?? ""
+    let key = "\(deviceSetPath)\0\(configuration.options.rawValue)"
+    // FNV-1a, as the path must be the same in every process.
+    var hash: UInt64 = 14695981039346656037
+    for byte in key.utf8 {
+      hash = (hash ^ UInt64(byte)) &* 1099511628211
+    }
+    let name = String(format: "fbsimctl-%016llx.sock", hash)
+    return (NSTemporaryDirectory() as NSString).stringByAppendingPathComponent(name)
+  }
+
+  let socketPath: String
+  let writer: String -> Void
+  private var result: Output? = nil
+
+  init(socketPath: String, writer: String -> Void) {
+    self.socketPath = socketPath
+    self.writer = writer
+  }
+
+  /**
+   Sends the Arguments to the Daemon, writing each line of the response as it arrives.
+   The Configuration is not sent, as the Daemon only accepts the rest of a Command and already has the Configuration of its path.
+   Returns nil if there is no Daemon listening, so that the Command can be run in this process instead.
+  */
+  func forward(arguments: [String]) -> Output? {
+    let fileDescriptor = Constants.connectUnixSocketToPath(self.socketPath)
+    if fileDescriptor == -1 {
+      return nil
+    }
+    defer {
+      close(fileDescriptor)
+    }
+    var yes: Int32 = 1
+    setsockopt(fileDescriptor, Constants.sol_socket(), Constants.so_nosigpipe(), &yes, socklen_t(strideof(Int32)))
+
+    let request = "[\(DaemonClient.RequestIdentifier)] \(ArgumentTokenizer.quote(DaemonClient.argumentsWithoutConfiguration(arguments)))\n"
+    if !DaemonClient.writeString(request, fileDescriptor: fileDescriptor) {
+      return .Failure("Could not send the Command to the Daemon at \(self.socketPath): \(String.fromCString(strerror(errno))!)")
+    }
+    // No more Commands will be sent, so the Daemon closes the Connection once this one is answered.
+    shutdown(fileDescriptor, SHUT_WR)
+
+    let lineBuffer = LineBuffer(delegate: self)
+    var buffer = [UInt8](count: DefaultReadLength, repeatedValue: 0)
+    while self.result == nil {
+      let count = read(fileDescriptor, &buffer, buffer.count)
+      if count > 0 {
+        lineBuffer.appendBytes(buffer, length: count)
+      } else if count == 0 || errno != EINTR {
+        break
+      }
+    }
+    lineBuffer.finish()
+    return self.result ?? .Failure("The Daemon at \(self.socketPath) closed the Connection before the Command finished")
+  }
+
+  static func argumentsWithoutConfiguration(arguments: [String]) -> [String] {
+    do {
+      let (remaining, _) = try Configuration.parser().parse(arguments)
+      return remaining
+    } catch {
+      return arguments
+    }
+  }
+
+  private static func writeString(string: String, fileDescriptor: Int32) -> Bool {
+    let bytes = Array(string.utf8)
+    var offset = 0
+    while offset < bytes.count {
+      let count = bytes.withUnsafeBufferPointer { pointer in
+        write(fileDescriptor, pointer.baseAddress.advancedBy(offset), pointer.count - offset)
+      }
+      if count == -1 && errno == EINTR {
+        continue
+      }
+      if count <= 0 {
+        return false
+      }
+      offset += count
+    }
+    return true
+  }
+
+  // MARK: LineBufferDelegate
+
+  func buffer(lineAvailable: String) {
+    let prefix = "[\(DaemonClient.RequestIdentifier)] "
+    if !lineAvailable.hasPrefix(prefix) {
+      self.writer(lineAvailable)
+      return
+    }
+    let line = String(lineAvailable.characters.dropFirst(prefix.characters.count))
+    switch (line) {
+    case "OK":
+      self.result = .Success("")
+    case "ERROR":
+      self.result = .Failure("")
+    default:
+      self.writer(line)
+    }
+  }
+
+  func buffer(lineRejected error: LineBufferError) {
+    self.writer(error.description)
+  }
+}
@@ -0,0 +1,166 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+import Foundation
+
+/**
+ A single-threaded loop that dispatches readiness of File Descriptors to handlers, backed by kqueue.
+ Handlers are called on the thread that runs the loop. Work from other threads is submitted with perform(_:).
+*/
+final class EventLoop {
+  typealias Handler = () -> Void
+
+  private static let WakeIdentifier: UInt = 0
+  private static let MaximumEvents = 64
+
+  private let kqueueDescriptor: Int32
+  private var readHandlers: [Int32 : Handler] = [:]
+  private var writeHandlers: [Int32 : Handler] = [:]
+
+  private let lock = NSLock()
+  private var pendingBlocks: [() -> Void] = []
+  private var running = false
+
+  init() {
+    self.kqueueDescriptor = kqueue()
+    assert(self.kqueueDescriptor != -1, "Expected to be able to create a kqueue")
+    self.change(EventLoop.WakeIdentifier, filter: EVFILT_USER, flags: EV_ADD | EV_CLEAR, fflags: 0)
+  }
+
+  deinit {
+    close(self.kqueueDescriptor)
+  }
+
+  /**
+   Calls the handler whenever the File Descriptor is readable, including at end of file, or stops doing so if the handler is nil.
+   Must be called on the loop's thread.
+  */
+  func setReadHandler(fileDescriptor: Int32, handler: Handler?) {
+    if let handler = handler {
+      self.readHandlers[fileDescriptor] = handler
+      self.change(UInt(fileDescriptor), filter: EVFILT_READ, flags: EV_ADD | EV_ENABLE, fflags: 0)
+    } else if self.readHandlers.removeValueForKey(fileDescriptor) != nil {
+      self.change(UInt(fileDescriptor), filter: EVFILT_READ, flags: EV_DELETE, fflags: 0)
+    }
+  }
+
+  /**
+   Calls the handler whenever the File Descriptor is writable, or stops doing so if the handler is nil.
+   Must be called on the loop's thread.
+  */
+  func setWriteHandler(fileDescriptor: Int32, handler: Handler?) {
+    if let handler = handler {
+      self.writeHandlers[fileDescriptor] = handler
+      self.change(UInt(fileDescriptor), filter: EVFILT_WRITE, flags: EV_ADD | EV_ENABLE, fflags: 0)
+    } else if self.writeHandlers.removeValueForKey(fileDescriptor) != nil {
+      self.change(UInt(fileDescriptor), filter: EVFILT_WRITE, flags: EV_DELETE, fflags: 0)
+    }
+  }
+
+  /**
+   Stops calling handlers for the File Descriptor. This should be called before the File Descriptor is closed.
+   Must be called on the loop's thread.
+  */
+  func removeHandlers(fileDescriptor: Int32) {
+    self.setReadHandler(fileDescriptor, handler: nil)
+    self.setWriteHandler(fileDescriptor, handler: nil)
+  }
+
+  /**
+   Calls the block on the loop's thread. Can be called from any thread.
+  */
+  func perform(block: () -> Void) {
+    self.lock.lock()
+    self.pendingBlocks.append(block)
+    self.lock.unlock()
+    self.wake()
+  }
+
+  /**
+   Runs the loop on the current thread, until stop() is called.
+   Throws if the loop cannot wait for events, which the owner of the loop reports.
+  */
+  func run() throws {
+    self.lock.lock()
+    self.running = true
+    self.lock.unlock()
+
+    // Blocks that were submitted before the loop failed are still run.
+    defer { self.runPendingBlocks() }
+    var events = [kevent](count: EventLoop.MaximumEvents, repeatedValue: kevent())
+    while self.isRunning {
+      let count = kevent(self.kqueueDescriptor, nil, 0, &events, Int32(events.count), nil)
+      if count < 0 {
+        if errno == EINTR {
+          continue
+        }
+        throw SocketRelayError.System("kevent", errno)
+      }
+      for event in events[0..<Int(count)] {
+        let fileDescriptor = Int32(event.ident)
+        switch Int32(event.filter) {
+        case EVFILT_USER:
+          self.runPendingBlocks()
+        case EVFILT_READ:
+          // A handler that closes a File Descriptor removes the handlers for it, so later events in the batch are ignored.
+          self.readHandlers[fileDescriptor]?()
+        case EVFILT_WRITE:
+          self.writeHandlers[fileDescriptor]?()
+        default:
+          break
+        }
+      }
+    }
+  }
+
+  /**
+   Stops the loop once the current handler returns. Can be called from any thread.
+  */
+  func stop() {
+    self.lock.lock()
+    self.running = false
+    self.lock.unlock()
+    self.wake()
+  }
+
+  private var isRunning: Bool {
+    get {
+      self.lock.lock()
+      defer { self.lock.unlock() }
+      return self.running
+    }
+  }
+
+  private func runPendingBlocks() {
+    self.lock.lock()
+    let blocks = self.pendingBlocks
+    self.pendingBlocks = []
+    self.lock.unlock()
+
+    for block in blocks {
+      block()
+    }
+  }
+
+  private func wake() {
+    self.change(EventLoop.WakeIdentifier, filter: EVFILT_USER, flags: 0, fflags: NOTE_TRIGGER)
+  }
+
+  private func change(identifier: UInt, filter: Int32, flags: Int32, fflags: Int32) {
+    var event = kevent(
+      ident: identifier,
+      filter: Int16(filter),
+      flags: UInt16(flags),
+      fflags: UInt32(fflags),
+      data: 0,
+      udata: nil
+    )
+    kevent(self.kqueueDescriptor, &event, 1, nil, 0, nil)
+  }
+}
@@ -0,0 +1,167 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+import Foundation
+import FBSimulatorControl
+
+/**
+ The version of the JSON output's schema.
+ Fields may be added without changing the version, but it is incremented if a field is removed or changes meaning.
+*/
+public let JSONOutputSchemaVersion = 1
+
+/**
+ The values of a Simulator that are output as JSON, captured at a point in time.
+*/
+struct SimulatorSnapshot {
+  let udid: String
+  let name: String
+  let state: String
+  let allocated: Bool
+  let deviceName: String
+  let osVersion: String
+  let scale: String?
+  let locale: String?
+  let launchdProcessIdentifier: Int?
+  let simulatorApplicationProcessIdentifier: Int?
+
+  func jsonObject() -> [String : AnyObject] {
+    var configuration: [String : AnyObject] = [
+      "device_name" : self.deviceName,
+      "os_version" : self.osVersion,
+      "scale" : NSNull(),
+      "locale" : NSNull()
+    ]
+    if let scale = self.scale {
+      configuration["scale"] = scale
+    }
+    if let locale = self.locale {
+      configuration["locale"] = locale
+    }
+
+    var pids: [String : AnyObject] = [
+      "launchd_sim" : NSNull(),
+      "simulator_application" : NSNull()
+    ]
+    if let launchdProcessIdentifier = self.launchdProcessIdentifier {
+      pids["launchd_sim"] = launchdProcessIdentifier
+    }
+    if let simulatorApplicationProcessIdentifier = self.simulatorApplicationProcessIdentifier {
+      pids["simulator_application"] = simulatorApplicationProcessIdentifier
+    }
+
+    return [
+      "udid" : self.udid,
+      "name" : self.name,
+      "state" : self.state,
+      "configuration" : configuration,
+      "allocation" : [ "allocated" : self.allocated ],
+      "pids" : pids
+    ]
+  }
+}
+
+extension SimulatorSnapshot {
+  init(simulator: FBSimulator) {
+    let configuration: FBSimulatorConfiguration? = simulator.configuration
+    let launchInfo: FBSimulatorLaunchInfo? = simulator.launchInfo
+    self.init(
+      udid: simulator.udid,
+      name: simulator.name,
+      state: simulator.stateString,
+      allocated: simulator.allocated,
+      deviceName: configuration?.deviceName ?? simulator.name,
+      osVersion: configuration?.osVersionString ?? "",
+      scale: configuration?.scaleString,
+      locale: configuration?.locale?.localeIdentifier,
+      launchdProcessIdentifier: (launchInfo?.launchdProcess?.processIdentifier).map { Int($0) },
+      simulatorApplicationProcessIdentifier: (launchInfo?.simulatorProcess?.processIdentifier).map { Int($0) }
+    )
+  }
+}
+
+/**
+ A single line of JSON output. Each line is a complete JSON Object, so output can be consumed as it is written.
+ Commands that act on Simulators output a 'started' and 'ended' Event for each Simulator, followed by a Result.
+*/
+enum JSONEvent {
+  case Simulator(SimulatorSnapshot)
+  case Started(name: String, simulator: SimulatorSnapshot)
+  case Ended(name: String, simulator: SimulatorSnapshot, duration: NSTimeInterval, message: String?, error: String?)
+  case Result(name: String, success: Bool, message: String?, errors: [String : String], duration: NSTimeInterval)
+
+  func jsonObject(timestamp: NSDate) -> [String : AnyObject] {
+    var object: [String : AnyObject] = [
+      "schema_version" : JSONOutputSchemaVersion,
+      "timestamp" : timestamp.timeIntervalSince1970
+    ]
+    switch (self) {
+    case .Simulator(let simulator):
+      object["type"] = "simulator"
+      object["simulator"] = simulator.jsonObject()
+    case .Started(let name, let simulator):
+      object["type"] = "event"
+      object["event"] = name
+      object["phase"] = "started"
+      object["simulator"] = simulator.jsonObject()
+    case .Ended(let name, let simulator, let duration, let message, let error):
+      object["type"] = "event"
+      object["event"] = name
+      object["phase"] = "ended"
+      object["simulator"] = simulator.jsonObject()
+      object["duration"] = duration
+      object["success"] = error == nil
+      object["message"] = NSNull()
+      if let message = message {
+        object["message"] = message
+      }
+      object["error"] = NSNull()
+      if let error = error {
+        object["error"] = error
+      }
+    case .Result(let name, let success, let message, let errors, let duration):
+      object["type"] = "result"
+      object["command"] = name
+      object["success"] = success
+      object["message"] = NSNull()
+      if let message = message {
+        object["message"] = message
+      }
+      // Keyed by the UDID of each Simulator that the Command failed on.
+      object["errors"] = errors
+      object["duration"] = duration
+    }
+    return object
+  }
+
+  func serialize(timestamp: NSDate = NSDate()) -> String {
+    let data = try! NSJSONSerialization.dataWithJSONObject(self.jsonObject(timestamp), options: NSJSONWritingOptions())
+    return String(data: data, encoding: NSUTF8StringEncoding)!
+  }
+}
+
+/**
+ Writes JSON Events as soon as they occur.
+ Events may be reported from any thread, but are written one at a time so that lines are never interleaved.
+*/
+final class JSONReporter {
+  let writer: String -> Void
+  private let lock = NSLock()
+
+  init(writer: String -> Void) {
+    self.writer = writer
+  }
+
+  func report(event: JSONEvent) {
+    let line = event.serialize()
+    self.lock.lock()
+    defer { self.lock.unlock() }
+    self.writer(line)
+  }
+}
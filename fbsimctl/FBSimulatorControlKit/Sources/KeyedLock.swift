@@ -0,0 +1,38 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+import Foundation
+
+/**
+ A Lock for each of any number of keys, so that work on the same key is serialized whilst work on different keys is not.
+*/
+final class KeyedLock {
+  private let condition = NSCondition()
+  private var heldKeys: Set<String> = []
+
+  /**
+   Runs the block once no other block is running for the same key, blocking until then.
+  */
+  func withLock<T>(key: String, @noescape block: () throws -> T) rethrows -> T {
+    self.condition.lock()
+    while self.heldKeys.contains(key) {
+      self.condition.wait()
+    }
+    self.heldKeys.insert(key)
+    self.condition.unlock()
+
+    defer {
+      self.condition.lock()
+      self.heldKeys.remove(key)
+      self.condition.broadcast()
+      self.condition.unlock()
+    }
+    return try block()
+  }
+}
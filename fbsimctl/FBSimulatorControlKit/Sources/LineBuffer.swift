@@ -9,38 +9,152 @@
 
 import Foundation
 
+/**
+ The reasons that a Line can be rejected by a LineBuffer.
+*/
+enum LineBufferError : CustomStringConvertible {
+  case LineTooLong(Int)
+  case InvalidEncoding
+
+  var description: String {
+    switch (self) {
+    case .LineTooLong(let maximumLength):
+      return "Line exceeds the maximum length of \(maximumLength) bytes"
+    case .InvalidEncoding:
+      return "Line is not valid UTF-8"
+    }
+  }
+}
+
+/**
+ Splits a stream of bytes into Lines terminated by LF or CRLF, delivering them on the queue that appended the bytes.
+ Each byte is scanned once, so the cost of a Line does not depend on how many reads it arrived in.
+*/
 class LineBuffer {
+  static let DefaultMaximumLineLength = 1024 * 1024
+
   unowned let delegate: LineBufferDelegate
+  let maximumLineLength: Int
 
-  private var buffer: String = ""
+  private var bytes: [UInt8] = []
+  // The start of the Line that has not yet been terminated.
+  private var lineStart = 0
+  // The offset up to which the unterminated Line is known not to contain a newline.
+  private var scanOffset = 0
+  // Set whilst the remainder of a Line that is too long is being skipped.
+  private var discarding = false
 
-  init(delegate: LineBufferDelegate) {
+  private enum Event {
+    case Line(String)
+    case Rejected(LineBufferError)
+  }
+
+  init(delegate: LineBufferDelegate, maximumLineLength: Int = LineBuffer.DefaultMaximumLineLength) {
     self.delegate = delegate
+    self.maximumLineLength = maximumLineLength
   }
 
   func appendData(data: NSData) {
-    let string = String(data: data, encoding: NSUTF8StringEncoding)!
-    self.buffer.appendContentsOf(string)
+    self.appendBytes(UnsafePointer<UInt8>(data.bytes), length: data.length)
+  }
+
+  func appendBytes(bytes: UnsafePointer<UInt8>, length: Int) {
+    if length == 0 {
+      return
+    }
+    self.bytes.appendContentsOf(UnsafeBufferPointer(start: bytes, count: length))
     self.runBuffer()
   }
 
+  /**
+   Delivers any final Line that was not terminated, for when the stream has ended.
+  */
+  func finish() {
+    var events: [Event] = []
+    if !self.discarding && self.lineStart < self.bytes.count {
+      self.bytes.withUnsafeBufferPointer { buffer in
+        self.appendLine(buffer, start: self.lineStart, end: buffer.count, events: &events)
+      }
+    }
+    self.bytes.removeAll()
+    self.lineStart = 0
+    self.scanOffset = 0
+    self.discarding = false
+    self.deliver(events)
+  }
+
   private func runBuffer() {
-    let buffer = self.buffer
-    let lines = buffer
-      .componentsSeparatedByCharactersInSet(NSCharacterSet.newlineCharacterSet())
-      .filter { line in
-        line != ""
+    var events: [Event] = []
+    self.bytes.withUnsafeBufferPointer { buffer in
+      while self.scanOffset < buffer.count {
+        let found = memchr(buffer.baseAddress.advancedBy(self.scanOffset), 0x0A, buffer.count - self.scanOffset)
+        if found == nil {
+          self.scanOffset = buffer.count
+          break
+        }
+        let newline = buffer.baseAddress.distanceTo(UnsafePointer<UInt8>(found))
+        if self.discarding {
+          self.discarding = false
+        } else {
+          let end = newline > self.lineStart && buffer[newline - 1] == 0x0D ? newline - 1 : newline
+          self.appendLine(buffer, start: self.lineStart, end: end, events: &events)
+        }
+        self.lineStart = newline + 1
+        self.scanOffset = newline + 1
+      }
+
+      // An unterminated Line that is already too long is rejected now, rather than buffered until it ends.
+      // One byte of slack is allowed for the CR of a CRLF that has not yet arrived.
+      if !self.discarding && buffer.count - self.lineStart > self.maximumLineLength + 1 {
+        events.append(.Rejected(.LineTooLong(self.maximumLineLength)))
+        self.discarding = true
+      }
+      if self.discarding {
+        self.lineStart = buffer.count
+      }
+    }
+    self.compact()
+    self.deliver(events)
+  }
+
+  private func appendLine(buffer: UnsafeBufferPointer<UInt8>, start: Int, end: Int, inout events: [Event]) {
+    let length = end - start
+    if length == 0 {
+      return
+    }
+    if length > self.maximumLineLength {
+      events.append(.Rejected(.LineTooLong(self.maximumLineLength)))
+      return
     }
-    if (lines.isEmpty) {
+    guard let line = NSString(bytes: buffer.baseAddress.advancedBy(start), length: length, encoding: NSUTF8StringEncoding) else {
+      events.append(.Rejected(.InvalidEncoding))
       return
     }
+    events.append(.Line(line as String))
+  }
 
-    self.buffer = ""
-    let delegate = self.delegate
+  private func compact() {
+    if self.lineStart == self.bytes.count {
+      self.bytes.removeAll(keepCapacity: true)
+      self.lineStart = 0
+      self.scanOffset = 0
+      return
+    }
+    // Consumed bytes are only moved once they outweigh the unterminated Line, so copying is amortized.
+    if self.lineStart > self.bytes.count / 2 {
+      self.bytes.removeRange(0..<self.lineStart)
+      self.scanOffset -= self.lineStart
+      self.lineStart = 0
+    }
+  }
 
-    dispatch_async(dispatch_get_main_queue()) {
-      for line in lines {
-        delegate.buffer(line)
+  private func deliver(events: [Event]) {
+    for event in events {
+      switch (event) {
+      case .Line(let line):
+        self.delegate.buffer(line)
+      case .Rejected(let error):
+        self.delegate.buffer(lineRejected: error)
       }
     }
   }
@@ -48,4 +162,5 @@ class LineBuffer {
 
 protocol LineBufferDelegate : class {
   func buffer(lineAvailable: String)
+  func buffer(lineRejected error: LineBufferError)
 }
@@ -16,7 +16,7 @@ public extension Command {
       let (_, command) = try Command.parser().parse(arguments)
       return command
     } catch {
-      return Command(configuration: Configuration.defaultConfiguration(), subcommand: .Help(nil))
+      return Command(configuration: Configuration.defaultConfiguration(), outputMode: .Text, jobs: Command.DefaultJobs, subcommand: .Help(nil))
     }
   }
 }
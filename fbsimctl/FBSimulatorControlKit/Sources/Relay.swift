@@ -41,25 +41,101 @@ protocol OutputWriter {
 }
 
 /**
-  A Connection of input to output via a buffer
+ A Line of input to a Relay, which may be prefixed with a Request ID in brackets, such as "[7] boot iPhone 5".
+ Commands with a Request ID may complete out of order, so every line of their response is prefixed with the same ID,
+ followed by a final line of "OK" or "ERROR". Commands without a Request ID are answered in order.
+*/
+struct RelayRequest {
+  let identifier: String?
+  let command: String
+
+  static func parse(line: String) -> RelayRequest {
+    guard line.hasPrefix("["), let close = line.rangeOfString("]") else {
+      return RelayRequest(identifier: nil, command: line)
+    }
+    let identifier = line.substringWithRange(line.startIndex.successor()..<close.startIndex)
+    if identifier.isEmpty || identifier.rangeOfCharacterFromSet(NSCharacterSet.whitespaceCharacterSet()) != nil {
+      return RelayRequest(identifier: nil, command: line)
+    }
+    let command = line.substringFromIndex(close.endIndex).stringByTrimmingCharactersInSet(NSCharacterSet.whitespaceCharacterSet())
+    return RelayRequest(identifier: identifier, command: command)
+  }
+
+  var ordered: Bool {
+    get {
+      return self.identifier == nil
+    }
+  }
+
+  /**
+   The response to write for the Output of the Command.
+  */
+  func response(output: Output) -> String {
+    let string: String
+    let status: String
+    switch (output) {
+    case .Success(let success):
+      string = success
+      status = "OK"
+    case .Failure(let failure):
+      string = failure
+      status = "ERROR"
+    }
+    guard let identifier = self.identifier else {
+      return string
+    }
+    var lines = string
+      .componentsSeparatedByString("\n")
+      .filter { $0 != "" }
+    lines.append(status)
+    return lines
+      .map { "[\(identifier)] \($0)" }
+      .joinWithSeparator("\n")
+  }
+}
+
+/**
+  A Connection of input to output via a buffer.
+  Commands without a Request ID are executed as they are received, whilst those with one are executed in the background.
  */
 class RelayConnection : LineBufferDelegate {
   let transformer: RelayTransformer
   let outputWriter: OutputWriter
   lazy var lineBuffer: LineBuffer = LineBuffer(delegate: self)
 
-  init (transformer: RelayTransformer, outputWriter: OutputWriter) {
+  private let backgroundQueue = NSOperationQueue()
+
+  init (transformer: RelayTransformer, outputWriter: OutputWriter, maximumConcurrentCommands: Int = 4) {
     self.transformer = transformer
     self.outputWriter = outputWriter
+    self.backgroundQueue.maxConcurrentOperationCount = maximumConcurrentCommands
   }
 
   func buffer(lineAvailable: String) {
-    let result = self.transformer.transform(lineAvailable)
-    switch (result) {
-    case .Success(let string):
-      self.outputWriter.writeOut(string)
-    case .Failure(let string):
-      self.outputWriter.writeErr(string)
+    let request = RelayRequest.parse(lineAvailable)
+    if request.ordered {
+      self.write(request, output: self.transformer.transform(request.command))
+      return
+    }
+    self.backgroundQueue.addOperationWithBlock {
+      let output = self.transformer.transform(request.command)
+      dispatch_async(dispatch_get_main_queue()) {
+        self.write(request, output: output)
+      }
+    }
+  }
+
+  func buffer(lineRejected error: LineBufferError) {
+    self.outputWriter.writeErr(error.description)
+  }
+
+  private func write(request: RelayRequest, output: Output) {
+    let response = request.response(output)
+    switch (output) {
+    case .Success:
+      self.outputWriter.writeOut(response)
+    case .Failure:
+      self.outputWriter.writeErr(response)
     }
   }
 }
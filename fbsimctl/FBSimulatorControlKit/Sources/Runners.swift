@@ -15,14 +15,53 @@ protocol Runner {
 }
 
 public extension Command {
-  func runFromCLI() -> Void {
-    switch (BaseRunner(command: self).run()) {
+  /**
+   Runs the Command in a Daemon, when there is one listening, otherwise in this process.
+   Returns the exit status for the process.
+  */
+  static func runFromCLI(arguments: [String]) -> Int32 {
+    let command = Command.fromArguments(arguments)
+    if command.forwardsToDaemon {
+      let client = DaemonClient(socketPath: DaemonClient.defaultSocketPath(command.configuration), writer: BaseRunner.writeLine)
+      if let output = client.forward(arguments) {
+        return command.printResult(output)
+      }
+    }
+    return command.runFromCLI()
+  }
+
+  func runFromCLI() -> Int32 {
+    return self.printResult(BaseRunner(command: self).run())
+  }
+
+  // The default path of a Daemon is derived from its Configuration, so a Daemon found there has the same Configuration.
+  private var forwardsToDaemon: Bool {
+    switch (self.subcommand) {
+    case .List, .Boot, .Shutdown, .Diagnose:
+      return true
+    default:
+      return false
+    }
+  }
+
+  private func printResult(output: Output) -> Int32 {
+    switch (output) {
     case .Failure(let string):
-      print(string)
+      self.printOutput(string)
+      return 1
     case .Success(let string):
-      print(string)
+      self.printOutput(string)
+      return 0
     }
   }
+
+  private func printOutput(string: String) {
+    // Output that was written as it happened, such as JSON, leaves nothing more to print.
+    if string.isEmpty {
+      return
+    }
+    print(string)
+  }
 }
 
 private struct BaseRunner : Runner {
@@ -39,36 +78,66 @@ private struct BaseRunner : Runner {
     let control = try! FBSimulatorControl.withConfiguration(command.configuration)
     switch (self.command.subcommand) {
     case .Interact(let portNumber):
-      return InteractionRunner(control: control, portNumber: portNumber).run()
+      return InteractionRunner(control: control, portNumber: portNumber, socketPath: nil, outputMode: self.command.outputMode, jobs: self.command.jobs).run()
+    case .Daemon(let socketPath):
+      let socketPath = socketPath ?? DaemonClient.defaultSocketPath(command.configuration)
+      return InteractionRunner(control: control, portNumber: nil, socketPath: socketPath, outputMode: self.command.outputMode, jobs: self.command.jobs).run()
     default:
-      let runner = SubcommandRunner(subcommand: self.command.subcommand, control: control)
+      let reporter = self.command.outputMode == .JSON ? JSONReporter(writer: BaseRunner.writeLine) : nil
+      let textWriter: (String -> Void)? = self.command.outputMode == .Text ? BaseRunner.writeLine : nil
+      let runner = SubcommandRunner(
+        subcommand: self.command.subcommand,
+        control: control,
+        simulatorLock: KeyedLock(),
+        jobs: self.command.jobs,
+        simulatorQueue: nil,
+        reporter: reporter,
+        textWriter: textWriter
+      )
       return runner.run()
     }
   }
+
+  private static func writeLine(line: String) {
+    print(line)
+    // Flushed so that each line reaches a pipe as soon as it is written.
+    fflush(stdout)
+  }
 }
 
 private struct SubcommandRunner : Runner {
   let subcommand: Subcommand
   let control: FBSimulatorControl
+  let simulatorLock: KeyedLock
+  let jobs: Int
+  // When present, Simulators are acted on in this queue, so that its limit applies across concurrent Commands.
+  let simulatorQueue: NSOperationQueue?
+  let reporter: JSONReporter?
+  // When present, the result for each Simulator is written as soon as it is available, rather than returned.
+  let textWriter: (String -> Void)?
 
   // TODO: Sessions don't make much sense in this context, combine multiple simulators into one session
   func run() -> Output {
     switch (self.subcommand) {
     case .List(let query, let format):
+      let start = NSDate()
       let simulators = Query.perform(control.simulatorPool, query: query)
-      return .Success(Format.formatAll(format)(simulators: simulators))
+      for simulator in simulators {
+        self.reporter?.report(.Simulator(SimulatorSnapshot(simulator: simulator)))
+      }
+      return self.finish("list", start: start, success: true, text: Format.formatAll(format)(simulators: simulators))
     case .Boot(let query):
-      return self.runSimulatorWithQuery(query) { simulator in
+      return self.runSimulatorWithQuery("boot", query: query) { simulator in
         try simulator.interact().bootSimulator().performInteraction()
         return "Booted \(simulator.udid)"
       }
     case .Shutdown(let query):
-      return self.runSimulatorWithQuery(query) { simulator in
+      return self.runSimulatorWithQuery("shutdown", query: query) { simulator in
         try simulator.interact().shutdownSimulator().performInteraction()
         return "Shutdown \(simulator.udid)"
       }
     case .Diagnose(let query):
-      return self.runSimulatorWithQuery(query) { simulator in
+      return self.runSimulatorWithQuery("diagnose", query: query) { simulator in
         if let sysLog = simulator.logs.systemLog() {
           return "\(sysLog.shortName) \(sysLog.asPath)"
         }
@@ -79,50 +148,197 @@ private struct SubcommandRunner : Runner {
     }
   }
 
-  private func runSimulatorWithQuery(query: Query, with: FBSimulator throws -> String) -> Output {
+  private func runSimulatorWithQuery(name: String, query: Query, with: FBSimulator throws -> String) -> Output {
+    let start = NSDate()
+    let simulators = Query.perform(self.control.simulatorPool, query: query)
+
+    // Up to the number of jobs Simulators are acted on at once, with each result written as it completes.
+    // A failure on one Simulator does not stop the others, so that every failure can be summarized.
+    let lock = NSLock()
+    var buffer = ""
+    var errors: [String : String] = [:]
+    var remaining = simulators.generate()
+    let queue = self.simulatorQueue ?? NSOperationQueue()
+    if self.simulatorQueue == nil {
+      queue.maxConcurrentOperationCount = self.jobs
+    }
+    // Each job takes the next Simulator until there are none left, so a Command has no more than its jobs in the queue.
+    let group = dispatch_group_create()
+    for _ in 0..<min(self.jobs, simulators.count) {
+      dispatch_group_enter(group)
+      queue.addOperationWithBlock {
+        defer { dispatch_group_leave(group) }
+        while true {
+          lock.lock()
+          let next = remaining.next()
+          lock.unlock()
+          guard let simulator = next else {
+            return
+          }
+          let output = self.runSimulator(name, simulator: simulator, with: with)
+          lock.lock()
+          switch (output) {
+          case .Success(let text):
+            if let textWriter = self.textWriter {
+              textWriter(text)
+            } else if self.reporter == nil {
+              buffer.appendContentsOf(text)
+              buffer.append("\n" as Character)
+            }
+          case .Failure(let error):
+            errors[simulator.udid] = error
+          }
+          lock.unlock()
+        }
+      }
+    }
+    if NSThread.isMainThread() {
+      // The main run loop is spun rather than blocked on, as interactions may need the main queue to make progress.
+      NSRunLoop.currentRunLoop().spinRunLoopWithTimeout(DBL_MAX) { dispatch_group_wait(group, DISPATCH_TIME_NOW) == 0 }
+    } else {
+      // Other threads, such as the workers of a Socket Relay, have no sources in their run loop, so spinning would busy-wait.
+      dispatch_group_wait(group, DISPATCH_TIME_FOREVER)
+    }
+
+    if errors.isEmpty {
+      return self.finish(name, start: start, success: true, text: buffer)
+    }
+    let summary = errors.keys.sort().map { "\($0): \(errors[$0]!)" }
+    let text = buffer + "\(errors.count) of \(simulators.count) Simulators failed to \(name)\n" + summary.joinWithSeparator("\n")
+    return self.finish(name, start: start, success: false, text: text, errors: errors)
+  }
+
+  private func runSimulator(name: String, simulator: FBSimulator, with: FBSimulator throws -> String) -> Output {
+    self.reporter?.report(.Started(name: name, simulator: SimulatorSnapshot(simulator: simulator)))
+    let start = NSDate()
     do {
-      var buffer = ""
-      let simulators = Query.perform(self.control.simulatorPool, query: query)
-      for simulator in simulators {
-        let result = try with(simulator)
-        buffer.appendContentsOf(result)
-        buffer.append("\n" as Character)
+      // Commands may be running concurrently, but only one of them may act on a Simulator at a time.
+      let result = try self.simulatorLock.withLock(simulator.udid) {
+        try with(simulator)
       }
-      return .Success(buffer)
+      self.reporter?.report(.Ended(
+        name: name,
+        simulator: SimulatorSnapshot(simulator: simulator),
+        duration: NSDate().timeIntervalSinceDate(start),
+        message: result,
+        error: nil
+      ))
+      return .Success(result)
     } catch let error as NSError {
+      self.reporter?.report(.Ended(
+        name: name,
+        simulator: SimulatorSnapshot(simulator: simulator),
+        duration: NSDate().timeIntervalSinceDate(start),
+        message: nil,
+        error: error.description
+      ))
       return .Failure(error.description)
     }
   }
+
+  private func finish(name: String, start: NSDate, success: Bool, text: String, errors: [String : String] = [:]) -> Output {
+    guard let reporter = self.reporter else {
+      return success ? .Success(text) : .Failure(text)
+    }
+    reporter.report(.Result(
+      name: name,
+      success: success,
+      message: success ? nil : text,
+      errors: errors,
+      duration: NSDate().timeIntervalSinceDate(start)
+    ))
+    // Everything has already been reported as JSON.
+    return success ? .Success("") : .Failure("")
+  }
 }
 
 
 private class InteractionRunner : Runner, RelayTransformer {
   let control: FBSimulatorControl
   let portNumber: Int?
+  let socketPath: String?
+  let outputMode: OutputMode
+  let jobs: Int
+  let simulatorLock = KeyedLock()
+  // Shared by every Command, so that concurrent Commands act on no more than the jobs of the interact Command in total.
+  let simulatorQueue = NSOperationQueue()
 
-  init(control: FBSimulatorControl, portNumber: Int?) {
+  init(control: FBSimulatorControl, portNumber: Int?, socketPath: String?, outputMode: OutputMode, jobs: Int) {
     self.control = control
     self.portNumber = portNumber
+    self.socketPath = socketPath
+    self.outputMode = outputMode
+    self.jobs = jobs
+    self.simulatorQueue.name = "com.facebook.fbsimctl.simulators"
+    self.simulatorQueue.maxConcurrentOperationCount = jobs
   }
 
   func run() -> Output {
+    if let socketPath = self.socketPath {
+      self.printStatus("Starting Daemon on \(socketPath)")
+      SocketRelay(unixSocketPath: socketPath, transformer: self, statusWriter: self.writeRelayStatus).start()
+      return self.status("Ending Daemon")
+    }
     if let portNumber = self.portNumber {
-      print("Starting Socket server on \(portNumber)")
-      SocketRelay(portNumber: portNumber, transformer: self).start()
-      return .Success("Ending Socket Server")
+      self.printStatus("Starting Socket server on \(portNumber)")
+      SocketRelay(portNumber: portNumber, transformer: self, statusWriter: self.writeRelayStatus).start()
+      return self.status("Ending Socket Server")
     }
-    print("Starting local interactive mode")
+    self.printStatus("Starting local interactive mode")
     StdIORelay(transformer: self).start()
-    return .Success("Ending local interactive mode")
+    return self.status("Ending local interactive mode")
+  }
+
+  // Status messages are not JSON, so are only written as Text.
+  private func printStatus(string: String) {
+    if self.outputMode == .Text {
+      print(string)
+    }
+  }
+
+  // The status of a Socket Relay includes errors, so is written to stderr rather than dropped when the output is JSON.
+  private func writeRelayStatus(string: String) {
+    if self.outputMode == .Text {
+      print(string)
+    } else {
+      SocketRelay.writeStatusToStandardError(string)
+    }
+  }
+
+  private func status(string: String) -> Output {
+    return .Success(self.outputMode == .Text ? string : "")
   }
 
   func transform(input: String) -> Output {
-    let arguments = input.componentsSeparatedByCharactersInSet(NSCharacterSet.whitespaceCharacterSet())
     do {
-      let (_, subcommand) = try Subcommand.parser().parse(arguments)
-      let runner = SubcommandRunner(subcommand: subcommand, control: self.control)
-      return runner.run()
+      guard let arguments = ArgumentTokenizer.tokenize(input) else {
+        throw ParseError.EndOfInput
+      }
+      // Each line may choose its own Output Mode and jobs, defaulting to those of the interact Command.
+      let subcommandParser = Parser.ofTwo(Command.jobsParser().optional(), b: Subcommand.parser())
+      let parser = Parser.ofTwo(OutputMode.parser().optional(), b: subcommandParser)
+      let (_, (lineOutputMode, (lineJobs, subcommand))) = try parser.parse(arguments)
+      // A line may ask for fewer jobs, but not more than are shared across all Commands.
+      let jobs = min(lineJobs ?? self.jobs, self.jobs)
+      if (lineOutputMode ?? self.outputMode) == .Text {
+        return SubcommandRunner(subcommand: subcommand, control: self.control, simulatorLock: self.simulatorLock, jobs: jobs, simulatorQueue: self.simulatorQueue, reporter: nil, textWriter: nil).run()
+      }
+
+      // A response is a single Output, so the JSON lines are collected rather than streamed.
+      var lines: [String] = []
+      let reporter = JSONReporter { lines.append($0) }
+      let output = SubcommandRunner(subcommand: subcommand, control: self.control, simulatorLock: self.simulatorLock, jobs: jobs, simulatorQueue: self.simulatorQueue, reporter: reporter, textWriter: nil).run()
+      switch (output) {
+      case .Success:
+        return .Success(lines.joinWithSeparator("\n"))
+      case .Failure:
+        return .Failure(lines.joinWithSeparator("\n"))
+      }
     } catch {
+      if self.outputMode == .JSON {
+        let event = JSONEvent.Result(name: "unknown", success: false, message: "Could not parse '\(input)'", errors: [:], duration: 0)
+        return .Failure(event.serialize())
+      }
       return .Failure("NOPE")
     }
   }
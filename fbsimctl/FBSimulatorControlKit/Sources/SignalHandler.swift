@@ -12,6 +12,7 @@ import Foundation
 class SignalHandler {
   let callback: String -> Void
   var sources: [dispatch_source_t] = []
+  var previousHandlers: [(Int32, sig_t?)] = []
 
   init(callback: String -> Void) {
     self.callback = callback
@@ -23,6 +24,11 @@ class SignalHandler {
       (SIGHUP, "SIGHUP"),
       (SIGINT, "SIGINT")
     ]
+    // The default action of these signals terminates the process before the dispatch sources can respond.
+    // Dispatch sources still receive signals that are ignored.
+    self.previousHandlers = signalPairs.map { (signal, _) in
+      (signal, Constants.ignoreSignal(signal))
+    }
     self.sources = signalPairs.map { (signal, name) in
       let source = dispatch_source_create(
         DISPATCH_SOURCE_TYPE_SIGNAL,
@@ -42,19 +48,27 @@ class SignalHandler {
     for source in self.sources {
       dispatch_source_cancel(source)
     }
+    self.sources = []
+    for (signalNumber, handler) in self.previousHandlers {
+      signal(signalNumber, handler)
+    }
+    self.previousHandlers = []
   }
 }
 
 extension SignalHandler {
-  static func runUntilSignalled() {
-    var signalled = false
+  /**
+   Spins the run loop until a terminating signal is received, returning the name of the signal.
+  */
+  static func runUntilSignalled() -> String {
+    var signalled: String? = nil
     let handler = SignalHandler { signalName in
-      print("Signalled by \(signalName)")
-      signalled = true
+      signalled = signalName
     }
 
     handler.register()
-    NSRunLoop.currentRunLoop().spinRunLoopWithTimeout(DBL_MAX) { signalled }
+    NSRunLoop.currentRunLoop().spinRunLoopWithTimeout(DBL_MAX) { signalled != nil }
     handler.unregister()
+    return signalled!
   }
 }
@@ -9,345 +9,663 @@
 
 import Foundation
 
-let DefaultReadLength = 1024
-let DefaultWriteCharacters = 512
+let DefaultReadLength = 16384
 
-func acceptCallback(socket: CFSocket!, callback: CFSocketCallBackType, address: NSData!, data: UnsafePointer<Void>, info: UnsafeMutablePointer<Void>) -> Void {
-  if callback != CFSocketCallBackType.AcceptCallBack {
-    return
-  }
-
-  print(sockaddr_in.fromData(address).description)
-
-  let acceptHandle = UnsafePointer<CFSocketNativeHandle>(data).memory
-  let socketHandle = CFSocketGetNative(socket)
-  print("Accept Handle \(acceptHandle) Socket Handle \(socketHandle)")
-  assert(acceptHandle != socketHandle, "Accept and Socket FD are the same")
-
-  var readStreamPointer: Unmanaged<CFReadStream>? = nil
-  var writeStreamPointer: Unmanaged<CFWriteStream>? = nil
+/**
+ Errors from the underlying Socket calls.
+*/
+enum SocketRelayError : ErrorType, CustomStringConvertible {
+  case System(String, Int32)
 
-  CFStreamCreatePairWithSocket(
-    kCFAllocatorDefault,
-    acceptHandle,
-    &readStreamPointer,
-    &writeStreamPointer
-  )
+  var description: String {
+    switch (self) {
+    case .System(let call, let code):
+      let reason = String.fromCString(strerror(code)) ?? "errno \(code)"
+      return "\(call) failed: \(reason)"
+    }
+  }
+}
 
-  let readStream = readStreamPointer?.takeUnretainedValue()
-  let writeStream = writeStreamPointer?.takeUnretainedValue()
-  let socketRelay = Unmanaged<SocketRelay>.fromOpaque(COpaquePointer(info)).takeUnretainedValue()
-  socketRelay.registerConnection(readStream!, outputStream: writeStream!)
+protocol SocketConnectionDelegate : class {
+  func connectionClosed(socketConnection: SocketConnection)
 }
 
-extension sockaddr_in6 : CustomStringConvertible {
-  static func fromData(data: NSData) -> sockaddr_in6 {
-    var addr = sockaddr_in6()
-    data.getBytes(&addr, length: strideof(sockaddr_in6))
-    return addr
+/**
+ A Connection to a single client of a SocketRelay.
+ The Socket is read and written on the Event Loop, whilst Commands are executed on the worker queue.
+ Commands without a Request ID are executed one at a time, in the order that they are received.
+ Commands with a Request ID are executed concurrently, up to a limit for each Connection.
+
+ A client that stops reading only holds up itself. Once too much output is queued, no further Commands
+ are started and the Socket is no longer read, until the client catches up.
+*/
+final class SocketConnection : LineBufferDelegate {
+  let fileDescriptor: Int32
+
+  private let eventLoop: EventLoop
+  private let workQueue: NSOperationQueue
+  private let transformer: RelayTransformer
+  private let maximumQueuedOutput: Int
+  private let maximumQueuedCommands: Int
+  private let maximumConcurrentCommands: Int
+  private weak var delegate: SocketConnectionDelegate?
+  private lazy var lineBuffer: LineBuffer = LineBuffer(delegate: self)
+
+  // Only accessed on the Event Loop.
+  private var outputQueue: [NSData] = []
+  private var outputOffset = 0
+  private var queuedOutputLength = 0
+  private var waitingCommands: [PendingCommand] = []
+  private var runningCommands: [Int : PendingCommand] = [:]
+  private var orderedCommandRunning = false
+  private var nextCommandIdentifier = 0
+  private var reading = false
+  private var readClosed = false
+  private var closed = false
+
+  private struct PendingCommand {
+    let identifier: Int
+    let operation: NSOperation
+    let ordered: Bool
   }
 
-  public var description: String {
-    return "Port \(self.sin6_port.littleEndian)"
+  init(fileDescriptor: Int32, eventLoop: EventLoop, workQueue: NSOperationQueue, transformer: RelayTransformer, maximumQueuedOutput: Int, maximumQueuedCommands: Int, maximumConcurrentCommands: Int, delegate: SocketConnectionDelegate) {
+    self.fileDescriptor = fileDescriptor
+    self.eventLoop = eventLoop
+    self.workQueue = workQueue
+    self.transformer = transformer
+    self.maximumQueuedOutput = maximumQueuedOutput
+    self.maximumQueuedCommands = maximumQueuedCommands
+    self.maximumConcurrentCommands = maximumConcurrentCommands
+    self.delegate = delegate
   }
-}
 
-extension sockaddr_in : CustomStringConvertible {
-  static func fromData(data: NSData) -> sockaddr_in {
-    var addr = sockaddr_in()
-    data.getBytes(&addr, length: strideof(sockaddr_in))
-    return addr
+  /**
+   Starts reading from the Socket. Must be called on the Event Loop.
+  */
+  func start() {
+    self.updateReading()
   }
 
-  public var description: String {
-    return "Port \(self.sin_port)"
+  /**
+   Closes the Socket, cancelling any Commands that have not finished and discarding any unwritten output.
+   Must be called on the Event Loop.
+  */
+  func close() {
+    if self.closed {
+      return
+    }
+    self.closed = true
+    for command in self.runningCommands.values {
+      command.operation.cancel()
+    }
+    self.runningCommands = [:]
+    self.waitingCommands = []
+    self.outputQueue = []
+    self.outputOffset = 0
+    self.queuedOutputLength = 0
+    self.eventLoop.removeHandlers(self.fileDescriptor)
+    Darwin.close(self.fileDescriptor)
+    self.delegate?.connectionClosed(self)
   }
-}
 
-extension NSStreamStatus : CustomStringConvertible {
-  public var description: String {
-    switch (self) {
-    case NotOpen: return "None"
-    case Opening: return "Opening"
-    case Open: return "Open"
-    case Reading: return "Reading"
-    case Writing: return "Writing"
-    case AtEnd: return "AtEnd"
-    case Closed: return "Closed"
-    case Error: return "Error"
+  /**
+   Stops reading Commands, closing once those that have already been received are answered.
+   Must be called on the Event Loop.
+  */
+  func finish() {
+    if self.closed {
+      return
     }
+    self.readClosed = true
+    self.updateReading()
+    self.closeIfFinished()
   }
-}
 
-extension NSStreamEvent : CustomStringConvertible {
-  public var description: String {
-    switch (self.rawValue) {
-    case NSStreamEvent.None.rawValue: return "None"
-    case NSStreamEvent.OpenCompleted.rawValue: return "OpenCompleted"
-    case NSStreamEvent.HasBytesAvailable.rawValue: return "HasBytesAvailable"
-    case NSStreamEvent.HasSpaceAvailable.rawValue: return "HasSpaceAvailable"
-    case NSStreamEvent.ErrorOccurred.rawValue: return "ErrorOccured"
-    case NSStreamEvent.EndEncountered.rawValue: return "EndEncountered"
-    default: return "Unknown"
+  // MARK: LineBufferDelegate
+
+  func buffer(lineAvailable: String) {
+    let request = RelayRequest.parse(lineAvailable)
+    self.enqueueCommand(request.ordered) {
+      request.response(self.transformer.transform(request.command))
     }
   }
-}
 
-protocol SocketConnectionDelegate {
-  func connectionClosed(socketConnection: SocketConnection)
-}
+  func buffer(lineRejected error: LineBufferError) {
+    // The error is ordered with the output of the Commands without a Request ID that came before it.
+    self.enqueueCommand(true) {
+      error.description
+    }
+  }
 
-class SocketConnection {
-  private class InputDelegate : NSObject, NSStreamDelegate {
-    let lineBuffer: LineBuffer
+  // MARK: Private
 
-    init(lineBuffer: LineBuffer) {
-      self.lineBuffer = lineBuffer
+  private func enqueueCommand(ordered: Bool, command: () -> String) {
+    let identifier = self.nextCommandIdentifier
+    self.nextCommandIdentifier += 1
+    let operation = NSBlockOperation {
+      let output = command()
+      self.eventLoop.perform {
+        self.commandFinished(identifier, output: output)
+      }
     }
+    self.waitingCommands.append(PendingCommand(identifier: identifier, operation: operation, ordered: ordered))
+    self.startCommands()
+  }
 
-    @objc func stream(stream: NSStream, handleEvent eventCode: NSStreamEvent) {
-      guard let stream = stream as? NSInputStream else {
-        return
+  private func startCommands() {
+    var index = 0
+    while index < self.waitingCommands.count && self.canStartCommand() {
+      let command = self.waitingCommands[index]
+      // An ordered Command waits for the previous ordered Command, but Commands with a Request ID can overtake it.
+      if command.ordered && self.orderedCommandRunning {
+        index += 1
+        continue
       }
-
-      print("Input Event \(eventCode.description)")
-      switch (eventCode.rawValue) {
-        case NSStreamEvent.HasBytesAvailable.rawValue:
-          let buffer = UnsafeMutablePointer<UInt8>.alloc(DefaultReadLength)
-          let count = stream.read(buffer, maxLength: DefaultReadLength)
-          let data = NSData(bytesNoCopy: buffer, length: count)
-          lineBuffer.appendData(data)
-          buffer.destroy()
-        default:
-          return
+      self.waitingCommands.removeAtIndex(index)
+      self.runningCommands[command.identifier] = command
+      if command.ordered {
+        self.orderedCommandRunning = true
       }
+      self.workQueue.addOperation(command.operation)
     }
+    self.updateReading()
   }
 
-  private class OutputDelegate : NSObject, NSStreamDelegate, OutputWriter {
-    var buffer: String = ""
-    let stream: NSOutputStream
+  private func canStartCommand() -> Bool {
+    // Commands are held back whilst the client is not reading the output of earlier Commands.
+    return !self.closed
+      && self.runningCommands.count < self.maximumConcurrentCommands
+      && self.queuedOutputLength < self.maximumQueuedOutput
+  }
 
-    init (stream: NSOutputStream) {
-      self.stream = stream
+  private func commandFinished(identifier: Int, var output: String) {
+    // The output of a Command that was running when the Connection closed is discarded.
+    if self.closed {
+      return
     }
-
-    @objc func stream(stream: NSStream, handleEvent eventCode: NSStreamEvent) {
-      assert(stream == self.stream, "Handled delegate from unexpected stream")
-      print("Output Event \(eventCode.description)")
-      switch (eventCode.rawValue) {
-        case NSStreamEvent.HasSpaceAvailable.rawValue:
-          self.flushAvailable()
-        default:
-          return
-      }
+    if let command = self.runningCommands.removeValueForKey(identifier) where command.ordered {
+      self.orderedCommandRunning = false
     }
 
-    func writeOut(string: String) {
-      buffer.appendContentsOf(string)
-      self.flushAvailable()
+    if (output.characters.last != "\n") {
+      output.append("\n" as Character)
     }
+    let data = output.dataUsingEncoding(NSUTF8StringEncoding)!
+    self.outputQueue.append(data)
+    self.queuedOutputLength += data.length
+    self.flushOutput()
+  }
 
-    func writeErr(string: String) {
-      buffer.appendContentsOf(string)
-      self.flushAvailable()
+  private func updateReading() {
+    if self.closed {
+      return
     }
-
-    func flushAvailable() {
-      while (buffer.characters.count > 0 && self.stream.hasSpaceAvailable) {
-        // TODO: Buffer appropriately
-        let range = buffer.characters.indices
-        let slice = buffer.substringWithRange(range)
-        self.buffer = ""
-
-        let data = slice.dataUsingEncoding(NSUTF8StringEncoding)!
-        let cData = UnsafeMutablePointer<UInt8>.alloc(data.length)
-        data.getBytes(cData, length: data.length)
-        stream.write(cData, maxLength: data.length)
-        cData.destroy()
+    let reading = !self.readClosed
+      && self.queuedOutputLength < self.maximumQueuedOutput
+      && self.waitingCommands.count < self.maximumQueuedCommands
+    if reading == self.reading {
+      return
+    }
+    self.reading = reading
+    if reading {
+      self.eventLoop.setReadHandler(self.fileDescriptor) { [unowned self] in
+        self.readAvailable()
       }
+    } else {
+      // Unread input backs up into the Socket, so the client is slowed down by TCP.
+      self.eventLoop.setReadHandler(self.fileDescriptor, handler: nil)
     }
   }
 
-  private let readStream: NSInputStream
-  private let readStreamDelegate: InputDelegate
-
-  private let writeStream: NSOutputStream
-  private let writeStreamDelegate: OutputDelegate
-
-  private let relayConnection: RelayConnection
+  private func readAvailable() {
+    var buffer = [UInt8](count: DefaultReadLength, repeatedValue: 0)
+    let count = Darwin.read(self.fileDescriptor, &buffer, buffer.count)
+    if count > 0 {
+      self.lineBuffer.appendBytes(buffer, length: count)
+      return
+    }
+    if count < 0 && (errno == EAGAIN || errno == EINTR) {
+      return
+    }
+    if count < 0 {
+      self.close()
+      return
+    }
 
-  init(readStream: NSInputStream, writeStream: NSOutputStream, delegate: SocketConnectionDelegate, transformer: RelayTransformer) {
-    self.writeStream = writeStream
-    self.writeStreamDelegate = OutputDelegate(stream: writeStream)
-    self.relayConnection = RelayConnection(transformer: transformer, outputWriter: self.writeStreamDelegate)
-    self.readStream = readStream
-    self.readStreamDelegate = InputDelegate(lineBuffer: self.relayConnection.lineBuffer)
+    // The client has finished sending, but may still be waiting for the output of the Commands it sent.
+    self.readClosed = true
+    self.updateReading()
+    self.lineBuffer.finish()
+    self.closeIfFinished()
   }
 
-  func start() {
-    assert(self.readStream.streamStatus == NSStreamStatus.NotOpen, "Expected an unopened Read Stream")
-    assert(self.writeStream.streamStatus == NSStreamStatus.NotOpen, "Expected an unopened Write Stream")
-
-    self.readStream.delegate = self.readStreamDelegate
-    self.readStream.scheduleInRunLoop(NSRunLoop.currentRunLoop(), forMode: NSDefaultRunLoopMode)
-    self.readStream.open()
+  private func flushOutput() {
+    while let data = self.outputQueue.first {
+      let bytes = UnsafePointer<UInt8>(data.bytes).advancedBy(self.outputOffset)
+      let written = Darwin.write(self.fileDescriptor, bytes, data.length - self.outputOffset)
+      if written < 0 && errno == EINTR {
+        continue
+      }
+      if written < 0 && errno == EAGAIN {
+        break
+      }
+      if written < 0 {
+        self.close()
+        return
+      }
+      self.outputOffset += written
+      self.queuedOutputLength -= written
+      if self.outputOffset == data.length {
+        self.outputQueue.removeFirst()
+        self.outputOffset = 0
+      }
+    }
 
-    self.writeStream.delegate = self.writeStreamDelegate
-    self.writeStream.scheduleInRunLoop(NSRunLoop.currentRunLoop(), forMode: NSDefaultRunLoopMode)
-    self.writeStream.open()
+    if self.outputQueue.isEmpty {
+      self.eventLoop.setWriteHandler(self.fileDescriptor, handler: nil)
+    } else {
+      // The Socket is full, so the remainder is written once the client has read some of it.
+      self.eventLoop.setWriteHandler(self.fileDescriptor) { [unowned self] in
+        self.flushOutput()
+      }
+    }
+    self.startCommands()
+    self.closeIfFinished()
   }
 
-  func stop() {
-    self.readStream.close()
-    self.writeStream.close()
+  private func closeIfFinished() {
+    if self.readClosed && self.runningCommands.isEmpty && self.waitingCommands.isEmpty && self.outputQueue.isEmpty {
+      self.close()
+    }
   }
 }
 
+/**
+ A Relay that accepts Commands from any number of clients over TCP, or a Unix Domain Socket.
+ All Sockets are non-blocking and are serviced by a single Event Loop, whilst Commands are executed on a pool of workers.
+ A slow Command therefore only holds up the Connection that sent it.
+*/
 class SocketRelay : Relay, SocketConnectionDelegate {
   struct Options {
     let portNumber: Int
     let bindIPv4: Bool
     let bindIPv6: Bool
+    let unixSocketPath: String?
+    let maximumConnections: Int
+    let workerCount: Int
+    let maximumQueuedOutput: Int
+    let maximumQueuedCommands: Int
+    let maximumConcurrentCommands: Int
 
     func portNumberNetworkByteOrder() -> in_port_t {
       return UInt16(self.portNumber).bigEndian
     }
   }
 
+  /**
+   The number of seconds that Commands are given to finish when stopping, before their Connections are closed.
+  */
+  static let ShutdownGracePeriod: NSTimeInterval = 10
+
   let options: SocketRelay.Options
-  var transformer: RelayTransformer
-  var registeredConnections: [SocketConnection] = []
+  let transformer: RelayTransformer
+  let statusWriter: String -> Void
+
+  /**
+   The port that is listened on, which differs from the Options when listening on port 0.
+  */
+  private(set) var boundPort: Int = 0
+
+  private let eventLoop = EventLoop()
+  private let eventLoopQueue = dispatch_queue_create("com.facebook.fbsimctl.socketrelay", DISPATCH_QUEUE_SERIAL)
+  private let eventLoopFinished = dispatch_semaphore_create(0)
+  private let workQueue = NSOperationQueue()
+  private var listenDescriptors: [Int32] = []
+  private var lockDescriptor: Int32 = -1
+
+  // Only accessed on the Event Loop.
+  private var connections: [Int32 : SocketConnection] = [:]
+
+  convenience init(portNumber: Int, transformer: RelayTransformer, statusWriter: String -> Void = SocketRelay.writeStatusToStandardError) {
+    let options = SocketRelay.defaultOptions(portNumber, bindIPv6: true, unixSocketPath: nil)
+    self.init(options: options, transformer: transformer, statusWriter: statusWriter)
+  }
 
-  init(portNumber: Int, transformer: RelayTransformer) {
+  convenience init(unixSocketPath: String, transformer: RelayTransformer, statusWriter: String -> Void = SocketRelay.writeStatusToStandardError) {
+    let options = SocketRelay.defaultOptions(0, bindIPv6: false, unixSocketPath: unixSocketPath)
+    self.init(options: options, transformer: transformer, statusWriter: statusWriter)
+  }
+
+  /**
+   Creates a Relay. Status messages, such as errors that happen whilst listening, are given to the statusWriter rather than printed.
+  */
+  init(options: SocketRelay.Options, transformer: RelayTransformer, statusWriter: String -> Void = SocketRelay.writeStatusToStandardError) {
+    self.options = options
     self.transformer = transformer
-    self.options = SocketRelay.Options(portNumber: portNumber, bindIPv4: false, bindIPv6: true)
+    self.statusWriter = statusWriter
+    self.workQueue.name = "com.facebook.fbsimctl.socketrelay.workers"
+    self.workQueue.maxConcurrentOperationCount = options.workerCount
   }
 
   func start() {
-    createSocketsAndRunInRunLoop()
-    SignalHandler.runUntilSignalled()
+    do {
+      try self.listen()
+    } catch let error {
+      self.statusWriter("Could not start Socket server: \(error)")
+      return
+    }
+    if let unixSocketPath = self.options.unixSocketPath {
+      self.statusWriter("Listening on \(unixSocketPath)")
+    } else {
+      self.statusWriter("Listening on port \(self.boundPort)")
+    }
+    let signalName = SignalHandler.runUntilSignalled()
+    self.statusWriter("Signalled by \(signalName)")
+    self.stop()
   }
 
+  /**
+   Stops accepting Connections, then waits for the Commands that have already been received to be answered.
+  */
   func stop() {
+    if self.listenDescriptors.isEmpty {
+      return
+    }
+    self.eventLoop.perform {
+      for listenDescriptor in self.listenDescriptors {
+        self.eventLoop.removeHandlers(listenDescriptor)
+        close(listenDescriptor)
+      }
+      for connection in Array(self.connections.values) {
+        connection.finish()
+      }
+    }
+    if let unixSocketPath = self.options.unixSocketPath {
+      unlink(unixSocketPath)
+    }
+    // Released only once the Socket is unlinked, so that the next Relay to take the lock has the path to itself.
+    self.unlockUnixSocketPath()
 
+    // The run loop is spun, as Commands may need the main queue in order to finish.
+    NSRunLoop.currentRunLoop().spinRunLoopWithTimeout(SocketRelay.ShutdownGracePeriod) {
+      self.connectionCount == 0
+    }
+    self.eventLoop.perform {
+      for connection in Array(self.connections.values) {
+        connection.close()
+      }
+    }
+    self.eventLoop.stop()
+    dispatch_semaphore_wait(self.eventLoopFinished, DISPATCH_TIME_FOREVER)
+    self.workQueue.cancelAllOperations()
+    self.listenDescriptors = []
   }
 
-  private func socketContext() -> CFSocketContext {
-    return CFSocketContext(
-      version: 0,
-      info: UnsafeMutablePointer(Unmanaged.passUnretained(self).toOpaque()),
-      retain: nil,
-      release: nil,
-      copyDescription: nil
-    )
+  /**
+   The number of open Connections. Can be called from any thread whilst listening.
+  */
+  var connectionCount: Int {
+    get {
+      var count = 0
+      let semaphore = dispatch_semaphore_create(0)
+      self.eventLoop.perform {
+        count = self.connections.count
+        dispatch_semaphore_signal(semaphore)
+      }
+      dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER)
+      return count
+    }
   }
 
-  private func setSocketOptions(socket: CFSocket) {
-    let socketDescriptor = CFSocketGetNative(socket)
-    var yes: Int32 = 1
-    let result = setsockopt(socketDescriptor, Constants.sol_socket(), Constants.so_reuseaddr(), &yes, UInt32(strideof(Int32)))
-    assert(result != -1, "Expected to be able to setsockopt")
-  }
-
-  private func createSocket4() -> CFSocket {
-    var context = socketContext()
-    let sock = CFSocketCreate(
-      kCFAllocatorDefault,
-      PF_INET,
-      SOCK_STREAM,
-      IPPROTO_TCP,
-      CFSocketCallBackType.AcceptCallBack.rawValue,
-      acceptCallback,
-      &context
-    )
-    setSocketOptions(sock)
-
-    var addr = sockaddr_in(
-      sin_len: UInt8(strideof(sockaddr_in)),
-      sin_family: UInt8(AF_INET),
-      sin_port: self.options.portNumberNetworkByteOrder(),
-      sin_addr: in_addr(s_addr: UInt32(0).bigEndian),
-      sin_zero: (0, 0, 0, 0, 0, 0, 0, 0)
-    )
+  /**
+   Binds the listening Sockets and starts servicing them on the Event Loop, returning immediately.
+  */
+  func listen() throws {
+    var listenDescriptors: [Int32] = []
+    do {
+      if (self.options.bindIPv4) {
+        listenDescriptors.append(try self.createListenSocket(PF_INET))
+      }
+      if (self.options.bindIPv6) {
+        listenDescriptors.append(try self.createListenSocket(PF_INET6))
+      }
+      if let unixSocketPath = self.options.unixSocketPath {
+        listenDescriptors.append(try self.createUnixListenSocket(unixSocketPath))
+      }
+    } catch let error {
+      for listenDescriptor in listenDescriptors {
+        close(listenDescriptor)
+      }
+      self.unlockUnixSocketPath()
+      throw error
+    }
+    self.listenDescriptors = listenDescriptors
 
-    let data: CFDataRef = NSData(bytes: &addr, length: strideof(sockaddr_in))
-    let error = CFSocketSetAddress(sock, data)
-    assert(error == CFSocketError.Success, "Could not bind ipv4")
+    dispatch_async(self.eventLoopQueue) {
+      for listenDescriptor in listenDescriptors {
+        self.eventLoop.setReadHandler(listenDescriptor) { [unowned self] in
+          self.acceptConnections(listenDescriptor)
+        }
+      }
+      do {
+        try self.eventLoop.run()
+      } catch let error {
+        self.statusWriter("Event Loop failed: \(error)")
+      }
+      dispatch_semaphore_signal(self.eventLoopFinished)
+    }
+  }
 
-    return sock
+  /**
+   Writes a status message to stderr, so that it is kept apart from the output of Commands.
+  */
+  static func writeStatusToStandardError(string: String) {
+    StdIORelay.StdIOWriter().writeErr(string)
   }
 
-  private func createSocket6() -> CFSocket {
-    var context = socketContext()
-    let sock = CFSocketCreate(
-      kCFAllocatorDefault,
-      PF_INET6,
-      SOCK_STREAM,
-      IPPROTO_TCP,
-      CFSocketCallBackType.AcceptCallBack.rawValue,
-      acceptCallback,
-      &context
-    )
-    setSocketOptions(sock)
-
-    var addr = sockaddr_in6(
-      sin6_len: UInt8(strideof(sockaddr_in6)),
-      sin6_family: UInt8(AF_INET6),
-      sin6_port: self.options.portNumberNetworkByteOrder(),
-      sin6_flowinfo: 0,
-      sin6_addr: in6addr_any,
-      sin6_scope_id: 0
-    )
+  // MARK: SocketConnectionDelegate
+
+  func connectionClosed(socketConnection: SocketConnection) {
+    self.connections.removeValueForKey(socketConnection.fileDescriptor)
+  }
+
+  // MARK: Private
+
+  private func acceptConnections(listenDescriptor: Int32) {
+    while true {
+      let fileDescriptor = accept(listenDescriptor, nil, nil)
+      if fileDescriptor == -1 && errno == EINTR {
+        continue
+      }
+      if fileDescriptor == -1 {
+        return
+      }
+      if self.connections.count >= self.options.maximumConnections {
+        self.reject(fileDescriptor, reason: "Too many connections, the limit is \(self.options.maximumConnections)")
+        continue
+      }
 
-    let data: CFDataRef = NSData(bytes: &addr, length: strideof(sockaddr_in6))
-    let error = CFSocketSetAddress(sock, data)
-    assert(error == CFSocketError.Success, "Could not bind ipv6")
+      var yes: Int32 = 1
+      setsockopt(fileDescriptor, Constants.sol_socket(), Constants.so_nosigpipe(), &yes, socklen_t(strideof(Int32)))
+      if !Constants.setNonBlocking(fileDescriptor) {
+        close(fileDescriptor)
+        continue
+      }
+      let connection = SocketConnection(
+        fileDescriptor: fileDescriptor,
+        eventLoop: self.eventLoop,
+        workQueue: self.workQueue,
+        transformer: self.transformer,
+        maximumQueuedOutput: self.options.maximumQueuedOutput,
+        maximumQueuedCommands: self.options.maximumQueuedCommands,
+        maximumConcurrentCommands: self.options.maximumConcurrentCommands,
+        delegate: self
+      )
+      self.connections[fileDescriptor] = connection
+      connection.start()
+    }
+  }
 
-    return sock
+  private func reject(fileDescriptor: Int32, reason: String) {
+    // A short message fits in the empty send buffer of a new Socket, so is written without waiting.
+    var yes: Int32 = 1
+    setsockopt(fileDescriptor, Constants.sol_socket(), Constants.so_nosigpipe(), &yes, socklen_t(strideof(Int32)))
+    let data = "\(reason)\n".dataUsingEncoding(NSUTF8StringEncoding)!
+    write(fileDescriptor, data.bytes, data.length)
+    close(fileDescriptor)
   }
 
-  func createSocketsAndRunInRunLoop() {
-    var sockets: [CFSocket] = []
+  private func createListenSocket(family: Int32) throws -> Int32 {
+    let fileDescriptor = socket(family, SOCK_STREAM, IPPROTO_TCP)
+    if fileDescriptor == -1 {
+      throw SocketRelayError.System("socket", errno)
+    }
 
-    if (self.options.bindIPv4) {
-      sockets.append(createSocket4())
+    do {
+      var yes: Int32 = 1
+      if setsockopt(fileDescriptor, Constants.sol_socket(), Constants.so_reuseaddr(), &yes, socklen_t(strideof(Int32))) == -1 {
+        throw SocketRelayError.System("setsockopt", errno)
+      }
+      // When listening on port 0, the port of the first Socket is used for the second.
+      let portNumber = self.boundPort > 0 ? UInt16(self.boundPort).bigEndian : self.options.portNumberNetworkByteOrder()
+      if family == PF_INET {
+        var address = sockaddr_in(
+          sin_len: UInt8(strideof(sockaddr_in)),
+          sin_family: UInt8(AF_INET),
+          sin_port: portNumber,
+          sin_addr: in_addr(s_addr: UInt32(0).bigEndian),
+          sin_zero: (0, 0, 0, 0, 0, 0, 0, 0)
+        )
+        let result = withUnsafePointer(&address) { bind(fileDescriptor, UnsafePointer<sockaddr>($0), socklen_t(strideof(sockaddr_in))) }
+        if result == -1 {
+          throw SocketRelayError.System("bind", errno)
+        }
+      } else {
+        var address = sockaddr_in6(
+          sin6_len: UInt8(strideof(sockaddr_in6)),
+          sin6_family: UInt8(AF_INET6),
+          sin6_port: portNumber,
+          sin6_flowinfo: 0,
+          sin6_addr: in6addr_any,
+          sin6_scope_id: 0
+        )
+        let result = withUnsafePointer(&address) { bind(fileDescriptor, UnsafePointer<sockaddr>($0), socklen_t(strideof(sockaddr_in6))) }
+        if result == -1 {
+          throw SocketRelayError.System("bind", errno)
+        }
+      }
+      if Darwin.listen(fileDescriptor, min(Int32(self.options.maximumConnections), SOMAXCONN)) == -1 {
+        throw SocketRelayError.System("listen", errno)
+      }
+      if !Constants.setNonBlocking(fileDescriptor) {
+        throw SocketRelayError.System("fcntl", errno)
+      }
+      self.boundPort = try SocketRelay.portOfSocket(fileDescriptor)
+    } catch let error {
+      close(fileDescriptor)
+      throw error
     }
-    if (self.options.bindIPv6) {
-      sockets.append(createSocket6())
+
+    return fileDescriptor
+  }
+
+  private func createUnixListenSocket(path: String) throws -> Int32 {
+    // The lock is held for as long as the Relay listens, so that Relays starting at once cannot unlink each other's Sockets.
+    let lockDescriptor = try SocketRelay.lockUnixSocketPath(path)
+    do {
+      let fileDescriptor = try self.bindUnixSocket(path)
+      self.lockDescriptor = lockDescriptor
+      return fileDescriptor
+    } catch let error {
+      close(lockDescriptor)
+      throw error
     }
+  }
 
-    for socket in sockets {
-      let source = CFSocketCreateRunLoopSource(
-        kCFAllocatorDefault,
-        socket,
-        0
-      )
-      CFRunLoopAddSource(
-        CFRunLoopGetCurrent(),
-        source,
-        kCFRunLoopDefaultMode
-      )
+  private static func lockUnixSocketPath(path: String) throws -> Int32 {
+    let lockPath = path + ".lock"
+    let lockDescriptor = open(lockPath, O_RDWR | O_CREAT | O_CLOEXEC, 0o600)
+    if lockDescriptor == -1 {
+      throw SocketRelayError.System("open", errno)
+    }
+    while flock(lockDescriptor, LOCK_EX | LOCK_NB) == -1 {
+      if errno == EINTR {
+        continue
+      }
+      let lockErrno = errno
+      close(lockDescriptor)
+      throw SocketRelayError.System("flock", lockErrno == EWOULDBLOCK ? EADDRINUSE : lockErrno)
+    }
+    return lockDescriptor
+  }
 
-      let native = CFSocketGetNative(socket)
-      print("Native socket of \(native)")
-      assert(native != 0, "Couldn't get native socket")
+  private func unlockUnixSocketPath() {
+    if self.lockDescriptor == -1 {
+      return
     }
+    close(self.lockDescriptor)
+    self.lockDescriptor = -1
   }
 
-  func registerConnection(inputStream: NSInputStream, outputStream: NSOutputStream) {
-    let connection = SocketConnection(
-      readStream: inputStream,
-      writeStream: outputStream,
-      delegate: self,
-      transformer: self.transformer
-    )
+  private func bindUnixSocket(path: String) throws -> Int32 {
+    // With the lock held, a Socket file that cannot be connected to was left behind by a Relay that did not stop cleanly, so is replaced.
+    let existing = Constants.connectUnixSocketToPath(path)
+    if existing != -1 {
+      close(existing)
+      throw SocketRelayError.System("bind", EADDRINUSE)
+    }
+    var info = stat()
+    if lstat(path, &info) == 0 && (info.st_mode & S_IFMT) == S_IFSOCK {
+      unlink(path)
+    }
 
-    registeredConnections.append(connection)
-    connection.start()
+    // Only the user that started the Relay may send it Commands.
+    // The Socket is created with these permissions, as a chmod after binding leaves a window where others can connect.
+    let previousMask = umask(0o177)
+    let fileDescriptor = Constants.bindUnixSocketToPath(path)
+    let bindErrno = errno
+    umask(previousMask)
+    if fileDescriptor == -1 {
+      throw SocketRelayError.System("bind", bindErrno)
+    }
+    do {
+      if Darwin.listen(fileDescriptor, min(Int32(self.options.maximumConnections), SOMAXCONN)) == -1 {
+        throw SocketRelayError.System("listen", errno)
+      }
+      if !Constants.setNonBlocking(fileDescriptor) {
+        throw SocketRelayError.System("fcntl", errno)
+      }
+    } catch let error {
+      close(fileDescriptor)
+      unlink(path)
+      throw error
+    }
+    return fileDescriptor
   }
 
-  func connectionClosed(socketConnection: SocketConnection) {
+  private static func defaultOptions(portNumber: Int, bindIPv6: Bool, unixSocketPath: String?) -> SocketRelay.Options {
+    return SocketRelay.Options(
+      portNumber: portNumber,
+      bindIPv4: false,
+      bindIPv6: bindIPv6,
+      unixSocketPath: unixSocketPath,
+      maximumConnections: 256,
+      workerCount: 4,
+      maximumQueuedOutput: 1024 * 1024,
+      maximumQueuedCommands: 64,
+      maximumConcurrentCommands: 4
+    )
+  }
 
+  private static func portOfSocket(fileDescriptor: Int32) throws -> Int {
+    // The port is at the same offset of sockaddr_in and sockaddr_in6.
+    var address = sockaddr_in6()
+    var length = socklen_t(strideof(sockaddr_in6))
+    let result = withUnsafeMutablePointer(&address) { getsockname(fileDescriptor, UnsafeMutablePointer<sockaddr>($0), &length) }
+    if result == -1 {
+      throw SocketRelayError.System("getsockname", errno)
+    }
+    return Int(UInt16(bigEndian: address.sin6_port))
   }
 }
@@ -22,11 +22,22 @@ class StdIORelay : Relay {
   func start() {
     let lineBuffer = self.relayConnection.lineBuffer
 
+    // Lines are buffered and executed on the main queue, as the handler is called on a background queue.
     self.stdIn.readabilityHandler = { handle in
       let data = handle.availableData
-      lineBuffer.appendData(data)
+      if data.length == 0 {
+        handle.readabilityHandler = nil
+        dispatch_async(dispatch_get_main_queue()) {
+          lineBuffer.finish()
+        }
+        return
+      }
+      dispatch_async(dispatch_get_main_queue()) {
+        lineBuffer.appendData(data)
+      }
     }
-    SignalHandler.runUntilSignalled()
+    let signalName = SignalHandler.runUntilSignalled()
+    self.relayConnection.outputWriter.writeErr("Signalled by \(signalName)")
   }
 
   func stop() {
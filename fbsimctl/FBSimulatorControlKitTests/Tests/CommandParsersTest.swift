@@ -76,3 +76,62 @@ class QueryParserTests : XCTestCase {
     }
   }
 }
+
+class OutputModeParserTests : XCTestCase {
+  func testParsesJSONFlag() {
+    let (remaining, outputMode) = try! OutputMode.parser().parse(["--json", "list"])
+    XCTAssertEqual(outputMode, OutputMode.JSON)
+    XCTAssertEqual(remaining, ["list"])
+  }
+
+  func testDefaultsToText() {
+    let (remaining, outputMode) = try! OutputMode.parser().fallback(.Text).parse(["list"])
+    XCTAssertEqual(outputMode, OutputMode.Text)
+    XCTAssertEqual(remaining, ["list"])
+  }
+}
+
+class JobsParserTests : XCTestCase {
+  func testParsesJobs() {
+    let (remaining, jobs) = try! Command.jobsParser().parse(["--jobs", "8", "boot"])
+    XCTAssertEqual(jobs, 8)
+    XCTAssertEqual(remaining, ["boot"])
+  }
+
+  func testFailsJobsLessThanOne() {
+    for arguments in [["--jobs", "0"], ["--jobs", "-2"], ["--jobs", "many"], ["--jobs"]] {
+      do {
+        try Command.jobsParser().parse(arguments)
+        XCTFail("Parsed invalid jobs \(arguments)")
+      } catch {
+      }
+    }
+  }
+}
+
+class ArgumentTokenizerTests : XCTestCase {
+  func testSplitsOnWhitespace() {
+    XCTAssertEqual(ArgumentTokenizer.tokenize("  --json  list\tbooted ")!, ["--json", "list", "booted"])
+  }
+
+  func testKeepsQuotedAndEscapedWhitespace() {
+    XCTAssertEqual(ArgumentTokenizer.tokenize("boot \"iPhone 6\" iPad\\ Air")!, ["boot", "iPhone 6", "iPad Air"])
+    XCTAssertEqual(ArgumentTokenizer.tokenize("list \"\"")!, ["list", ""])
+  }
+
+  func testFailsUnterminatedQuotes() {
+    XCTAssertNil(ArgumentTokenizer.tokenize("boot \"iPhone 6"))
+    XCTAssertNil(ArgumentTokenizer.tokenize("boot iPhone\\"))
+  }
+
+  func testQuoteIsInverseOfTokenize() {
+    let argumentLists = [
+      ["list"],
+      ["boot", "iPhone 6", "iPad Air 2"],
+      ["--device-set", "/tmp/a \"quoted\" path\\", ""],
+    ]
+    for arguments in argumentLists {
+      XCTAssertEqual(ArgumentTokenizer.tokenize(ArgumentTokenizer.quote(arguments))!, arguments)
+    }
+  }
+}
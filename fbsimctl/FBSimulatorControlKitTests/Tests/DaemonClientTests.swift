@@ -0,0 +1,166 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+import XCTest
+import FBSimulatorControl
+@testable import FBSimulatorControlKit
+
+class DaemonClientTests : XCTestCase {
+  var socketPath: String! = nil
+  var relays: [SocketRelay] = []
+
+  override func setUp() {
+    super.setUp()
+    self.socketPath = (NSTemporaryDirectory() as NSString).stringByAppendingPathComponent("fbsimctl-\(NSUUID().UUIDString).sock")
+  }
+
+  override func tearDown() {
+    for relay in self.relays {
+      relay.stop()
+    }
+    self.relays = []
+    unlink(self.socketPath)
+    unlink(self.socketPath + ".lock")
+    super.tearDown()
+  }
+
+  func makeDaemon(transformer: RelayTransformer = EchoTransformer()) -> SocketRelay {
+    let relay = SocketRelay(unixSocketPath: self.socketPath, transformer: transformer)
+    self.relays.append(relay)
+    return relay
+  }
+
+  func forward(arguments: [String]) -> (Bool?, [String]) {
+    var lines: [String] = []
+    let client = DaemonClient(socketPath: self.socketPath) { lines.append($0) }
+    guard let output = client.forward(arguments) else {
+      return (nil, lines)
+    }
+    switch (output) {
+    case .Success:
+      return (true, lines)
+    case .Failure:
+      return (false, lines)
+    }
+  }
+
+  func testForwardsArgumentsToDaemon() {
+    try! self.makeDaemon().listen()
+    let (success, lines) = self.forward(["boot", "iPhone 6"])
+    XCTAssertEqual(success, true)
+    XCTAssertEqual(lines, ["echo boot \"iPhone 6\""])
+  }
+
+  func testForwardsArgumentsWithoutConfiguration() {
+    try! self.makeDaemon().listen()
+    let (success, lines) = self.forward(["--device-set", NSTemporaryDirectory(), "--delete-all", "--kill-spurious-services", "--json", "list"])
+    XCTAssertEqual(success, true)
+    XCTAssertEqual(lines, ["echo --json list"])
+  }
+
+  func testDefaultSocketPathDependsOnConfiguration() {
+    let application = try! FBSimulatorApplication(error: ())
+    let defaultPath = DaemonClient.defaultSocketPath(Configuration.defaultConfiguration())
+    let deviceSetPath = DaemonClient.defaultSocketPath(Configuration(simulatorApplication: application, deviceSetPath: "/foo", options: FBSimulatorManagementOptions()))
+    let optionsPath = DaemonClient.defaultSocketPath(Configuration(simulatorApplication: application, deviceSetPath: nil, options: .KillSpuriousSimulatorsOnFirstStart))
+
+    XCTAssertEqual(defaultPath, DaemonClient.defaultSocketPath(Configuration.defaultConfiguration()))
+    XCTAssertEqual(deviceSetPath, DaemonClient.defaultSocketPath(Configuration(simulatorApplication: application, deviceSetPath: "/foo/", options: FBSimulatorManagementOptions())))
+    XCTAssertEqual(Set([defaultPath, deviceSetPath, optionsPath]).count, 3)
+  }
+
+  func testDoesNotForwardWithoutDaemon() {
+    let (success, lines) = self.forward(["list"])
+    XCTAssertNil(success)
+    XCTAssertEqual(lines, [])
+  }
+
+  func testOnlyOneDaemonListensOnAPath() {
+    try! self.makeDaemon().listen()
+    do {
+      try self.makeDaemon().listen()
+      XCTFail("A second Daemon should not listen on a path that is in use")
+    } catch {
+    }
+    let (success, _) = self.forward(["list"])
+    XCTAssertEqual(success, true)
+  }
+
+  func testOnlyOneDaemonHoldsAPath() {
+    try! self.makeDaemon().listen()
+    // Without a Socket file to connect to, the lock still keeps a second Daemon from taking the path.
+    unlink(self.socketPath)
+    do {
+      try self.makeDaemon().listen()
+      XCTFail("A second Daemon should not listen on a path that is locked")
+    } catch {
+    }
+  }
+
+  func testSocketIsOnlyAccessibleToTheOwner() {
+    try! self.makeDaemon().listen()
+    var info = stat()
+    XCTAssertEqual(lstat(self.socketPath, &info), 0)
+    XCTAssertEqual(info.st_mode & 0o777, 0o600)
+  }
+
+  func testReplacesStaleSocketFile() {
+    // Bound but never listened on, as is left behind by a Daemon that did not stop cleanly.
+    let staleDescriptor = Constants.bindUnixSocketToPath(self.socketPath)
+    XCTAssertNotEqual(staleDescriptor, -1)
+    close(staleDescriptor)
+
+    try! self.makeDaemon().listen()
+    let (success, _) = self.forward(["list"])
+    XCTAssertEqual(success, true)
+  }
+
+  func testStopAnswersCommandsAlreadyReceived() {
+    let transformer = EchoTransformer()
+    let relay = self.makeDaemon(transformer)
+    try! relay.listen()
+
+    var result: (Bool?, [String]) = (nil, [])
+    let group = dispatch_group_create()
+    dispatch_group_async(group, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0)) {
+      result = self.forward(["slow"])
+    }
+    NSRunLoop.currentRunLoop().spinRunLoopWithTimeout(5) { transformer.executed == 1 }
+
+    relay.stop()
+    XCTAssertEqual(dispatch_group_wait(group, dispatch_time(DISPATCH_TIME_NOW, Int64(5 * NSEC_PER_SEC))), 0)
+    XCTAssertEqual(result.0, true)
+    XCTAssertEqual(result.1, ["echo slow"])
+    XCTAssertFalse(NSFileManager.defaultManager().fileExistsAtPath(self.socketPath))
+    XCTAssertNil(self.forward(["list"]).0)
+  }
+
+  func testStopsGracefullyWhenSignalled() {
+    let previousHandler = DaemonClientTests.handlerAddressOfSignal(SIGTERM)
+    var statuses: [String] = []
+    let relay = SocketRelay(unixSocketPath: self.socketPath, transformer: EchoTransformer(), statusWriter: { statuses.append($0) })
+    self.relays.append(relay)
+
+    // Runs once start() spins the run loop, which is after the signal handlers are registered.
+    dispatch_async(dispatch_get_main_queue()) {
+      kill(getpid(), SIGTERM)
+    }
+    relay.start()
+
+    XCTAssertEqual(statuses, ["Listening on \(self.socketPath!)", "Signalled by SIGTERM"])
+    XCTAssertFalse(NSFileManager.defaultManager().fileExistsAtPath(self.socketPath))
+    XCTAssertEqual(DaemonClientTests.handlerAddressOfSignal(SIGTERM), previousHandler)
+  }
+
+  static func handlerAddressOfSignal(signalNumber: Int32) -> Int {
+    let handler: sig_t? = Constants.ignoreSignal(signalNumber)
+    signal(signalNumber, handler)
+    return unsafeBitCast(handler, Int.self)
+  }
+}
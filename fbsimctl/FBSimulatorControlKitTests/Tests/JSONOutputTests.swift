@@ -0,0 +1,122 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+import XCTest
+@testable import FBSimulatorControlKit
+
+class JSONOutputTests : XCTestCase {
+  let bootedSimulator = SimulatorSnapshot(
+    udid: "B8EEA6C4-841B-47E5-92DE-014E0ECD8139",
+    name: "iPhone 5",
+    state: "Booted",
+    allocated: true,
+    deviceName: "iPhone 5",
+    osVersion: "iOS 9.2",
+    scale: "50%",
+    locale: "en_GB",
+    launchdProcessIdentifier: 1234,
+    simulatorApplicationProcessIdentifier: 1230
+  )
+
+  let shutdownSimulator = SimulatorSnapshot(
+    udid: "124DAC9C-4DFF-4F0C-9828-998CCFFCD4C8",
+    name: "iPad 2",
+    state: "Shutdown",
+    allocated: false,
+    deviceName: "iPad 2",
+    osVersion: "iOS 9.2",
+    scale: nil,
+    locale: nil,
+    launchdProcessIdentifier: nil,
+    simulatorApplicationProcessIdentifier: nil
+  )
+
+  func assertSerializes(event: JSONEvent) -> NSDictionary {
+    let line = event.serialize(NSDate(timeIntervalSince1970: 1000))
+    XCTAssertFalse(line.containsString("\n"), "JSON Lines must not contain a newline")
+    let data = line.dataUsingEncoding(NSUTF8StringEncoding)!
+    let object = try! NSJSONSerialization.JSONObjectWithData(data, options: NSJSONReadingOptions()) as! NSDictionary
+    XCTAssertEqual(object["schema_version"] as? Int, JSONOutputSchemaVersion)
+    XCTAssertEqual(object["timestamp"] as? Double, 1000)
+    return object
+  }
+
+  func testSerializesSimulator() {
+    let object = self.assertSerializes(.Simulator(self.bootedSimulator))
+    XCTAssertEqual(object["type"] as? String, "simulator")
+
+    let simulator = object["simulator"] as! NSDictionary
+    XCTAssertEqual(simulator["udid"] as? String, "B8EEA6C4-841B-47E5-92DE-014E0ECD8139")
+    XCTAssertEqual(simulator["name"] as? String, "iPhone 5")
+    XCTAssertEqual(simulator["state"] as? String, "Booted")
+    XCTAssertEqual(simulator.valueForKeyPath("configuration.device_name") as? String, "iPhone 5")
+    XCTAssertEqual(simulator.valueForKeyPath("configuration.os_version") as? String, "iOS 9.2")
+    XCTAssertEqual(simulator.valueForKeyPath("configuration.scale") as? String, "50%")
+    XCTAssertEqual(simulator.valueForKeyPath("configuration.locale") as? String, "en_GB")
+    XCTAssertEqual(simulator.valueForKeyPath("allocation.allocated") as? Bool, true)
+    XCTAssertEqual(simulator.valueForKeyPath("pids.launchd_sim") as? Int, 1234)
+    XCTAssertEqual(simulator.valueForKeyPath("pids.simulator_application") as? Int, 1230)
+  }
+
+  func testMissingValuesAreNull() {
+    let object = self.assertSerializes(.Simulator(self.shutdownSimulator))
+    let simulator = object["simulator"] as! NSDictionary
+    XCTAssertEqual(simulator.valueForKeyPath("configuration.scale") as? NSNull, NSNull())
+    XCTAssertEqual(simulator.valueForKeyPath("configuration.locale") as? NSNull, NSNull())
+    XCTAssertEqual(simulator.valueForKeyPath("allocation.allocated") as? Bool, false)
+    XCTAssertEqual(simulator.valueForKeyPath("pids.launchd_sim") as? NSNull, NSNull())
+    XCTAssertEqual(simulator.valueForKeyPath("pids.simulator_application") as? NSNull, NSNull())
+  }
+
+  func testSerializesEvents() {
+    let started = self.assertSerializes(.Started(name: "boot", simulator: self.shutdownSimulator))
+    XCTAssertEqual(started["type"] as? String, "event")
+    XCTAssertEqual(started["event"] as? String, "boot")
+    XCTAssertEqual(started["phase"] as? String, "started")
+    XCTAssertEqual(started.valueForKeyPath("simulator.state") as? String, "Shutdown")
+
+    let ended = self.assertSerializes(.Ended(name: "boot", simulator: self.bootedSimulator, duration: 12.5, message: "Booted", error: nil))
+    XCTAssertEqual(ended["type"] as? String, "event")
+    XCTAssertEqual(ended["phase"] as? String, "ended")
+    XCTAssertEqual(ended["duration"] as? Double, 12.5)
+    XCTAssertEqual(ended["success"] as? Bool, true)
+    XCTAssertEqual(ended["message"] as? String, "Booted")
+    XCTAssertEqual(ended["error"] as? NSNull, NSNull())
+    XCTAssertEqual(ended.valueForKeyPath("simulator.state") as? String, "Booted")
+
+    let failed = self.assertSerializes(.Ended(name: "boot", simulator: self.shutdownSimulator, duration: 1, message: nil, error: "Timed out"))
+    XCTAssertEqual(failed["success"] as? Bool, false)
+    XCTAssertEqual(failed["error"] as? String, "Timed out")
+  }
+
+  func testSerializesResults() {
+    let success = self.assertSerializes(.Result(name: "list", success: true, message: nil, errors: [:], duration: 0.25))
+    XCTAssertEqual(success["type"] as? String, "result")
+    XCTAssertEqual(success["command"] as? String, "list")
+    XCTAssertEqual(success["success"] as? Bool, true)
+    XCTAssertEqual(success["message"] as? NSNull, NSNull())
+    XCTAssertEqual(success["duration"] as? Double, 0.25)
+    XCTAssertEqual((success["errors"] as? [String : String])!, [:])
+
+    let errors = ["B8EEA6C4-841B-47E5-92DE-014E0ECD8139" : "Timed out"]
+    let failure = self.assertSerializes(.Result(name: "shutdown", success: false, message: "Line one\nLine two \"quoted\"", errors: errors, duration: 3))
+    XCTAssertEqual(failure["success"] as? Bool, false)
+    XCTAssertEqual(failure["message"] as? String, "Line one\nLine two \"quoted\"")
+    XCTAssertEqual((failure["errors"] as? [String : String])!, errors)
+  }
+
+  func testReporterWritesOneLinePerEvent() {
+    var lines: [String] = []
+    let reporter = JSONReporter { lines.append($0) }
+    reporter.report(.Started(name: "boot", simulator: self.shutdownSimulator))
+    reporter.report(.Ended(name: "boot", simulator: self.bootedSimulator, duration: 1, message: nil, error: nil))
+    reporter.report(.Result(name: "boot", success: true, message: nil, errors: [:], duration: 1))
+    XCTAssertEqual(lines.count, 3)
+  }
+}
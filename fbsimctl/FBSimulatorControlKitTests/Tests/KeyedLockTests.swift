@@ -0,0 +1,48 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+import XCTest
+@testable import FBSimulatorControlKit
+
+class KeyedLockTests : XCTestCase {
+  func maximumConcurrency(keys: [String]) -> Int {
+    let keyedLock = KeyedLock()
+    let counterLock = NSLock()
+    var running = 0
+    var maximum = 0
+
+    let group = dispatch_group_create()
+    for key in keys {
+      dispatch_group_async(group, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0)) {
+        keyedLock.withLock(key) {
+          counterLock.lock()
+          running += 1
+          maximum = max(maximum, running)
+          counterLock.unlock()
+
+          NSThread.sleepForTimeInterval(0.1)
+
+          counterLock.lock()
+          running -= 1
+          counterLock.unlock()
+        }
+      }
+    }
+    dispatch_group_wait(group, DISPATCH_TIME_FOREVER)
+    return maximum
+  }
+
+  func testSerializesTheSameKey() {
+    XCTAssertEqual(self.maximumConcurrency(["A", "A", "A", "A"]), 1)
+  }
+
+  func testDoesNotSerializeDifferentKeys() {
+    XCTAssertGreaterThan(self.maximumConcurrency(["A", "B", "C", "D"]), 1)
+  }
+}
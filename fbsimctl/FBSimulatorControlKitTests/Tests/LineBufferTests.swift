@@ -0,0 +1,176 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+import XCTest
+@testable import FBSimulatorControlKit
+
+private class LineRecorder : LineBufferDelegate {
+  var lines: [String] = []
+  var rejections: [String] = []
+
+  func buffer(lineAvailable: String) {
+    self.lines.append(lineAvailable)
+  }
+
+  func buffer(lineRejected error: LineBufferError) {
+    self.rejections.append(error.description)
+  }
+}
+
+/**
+ A Linear Congruential Generator, so that a failing fuzz case can be reproduced from its seed.
+*/
+private struct SeededRandom {
+  var state: UInt64
+
+  mutating func next(upperBound: Int) -> Int {
+    self.state = self.state &* 6364136223846793005 &+ 1442695040888963407
+    return Int((self.state >> 33) % UInt64(upperBound))
+  }
+}
+
+class LineBufferTests : XCTestCase {
+  func appendString(buffer: LineBuffer, _ string: String) {
+    buffer.appendData(string.dataUsingEncoding(NSUTF8StringEncoding)!)
+  }
+
+  func testDeliversLinesTerminatedByLineFeed() {
+    let recorder = LineRecorder()
+    let buffer = LineBuffer(delegate: recorder)
+    self.appendString(buffer, "list\nboot iPhone 5\n")
+    XCTAssertEqual(recorder.lines, ["list", "boot iPhone 5"])
+  }
+
+  func testStripsCarriageReturns() {
+    let recorder = LineRecorder()
+    let buffer = LineBuffer(delegate: recorder)
+    self.appendString(buffer, "list\r\nboot\r")
+    self.appendString(buffer, "\nshutdown\n")
+    XCTAssertEqual(recorder.lines, ["list", "boot", "shutdown"])
+  }
+
+  func testKeepsPartialLinesAcrossReads() {
+    let recorder = LineRecorder()
+    let buffer = LineBuffer(delegate: recorder)
+    self.appendString(buffer, "bo")
+    XCTAssertEqual(recorder.lines, [])
+    self.appendString(buffer, "ot\nshut")
+    XCTAssertEqual(recorder.lines, ["boot"])
+    self.appendString(buffer, "down\n")
+    XCTAssertEqual(recorder.lines, ["boot", "shutdown"])
+  }
+
+  func testSkipsEmptyLines() {
+    let recorder = LineRecorder()
+    let buffer = LineBuffer(delegate: recorder)
+    self.appendString(buffer, "\n\r\nlist\n\n")
+    XCTAssertEqual(recorder.lines, ["list"])
+  }
+
+  func testFinishDeliversUnterminatedLine() {
+    let recorder = LineRecorder()
+    let buffer = LineBuffer(delegate: recorder)
+    self.appendString(buffer, "list\nboot")
+    XCTAssertEqual(recorder.lines, ["list"])
+    buffer.finish()
+    XCTAssertEqual(recorder.lines, ["list", "boot"])
+  }
+
+  func testRejectsLinesOverMaximumLength() {
+    let recorder = LineRecorder()
+    let buffer = LineBuffer(delegate: recorder, maximumLineLength: 8)
+    self.appendString(buffer, "12345678\n123456789\n12345678\r\nlist\n")
+    XCTAssertEqual(recorder.lines, ["12345678", "12345678", "list"])
+    XCTAssertEqual(recorder.rejections.count, 1)
+  }
+
+  func testRejectsUnterminatedLineOnceOverMaximumLength() {
+    let recorder = LineRecorder()
+    let buffer = LineBuffer(delegate: recorder, maximumLineLength: 8)
+    for _ in 0..<100 {
+      self.appendString(buffer, "0123456789")
+    }
+    XCTAssertEqual(recorder.rejections.count, 1)
+    self.appendString(buffer, "9\nlist\n")
+    XCTAssertEqual(recorder.lines, ["list"])
+    XCTAssertEqual(recorder.rejections.count, 1)
+  }
+
+  func testRejectsInvalidEncoding() {
+    let recorder = LineRecorder()
+    let buffer = LineBuffer(delegate: recorder)
+    let bytes: [UInt8] = [0xFF, 0xFE, 0x0A, 0x6C, 0x69, 0x73, 0x74, 0x0A]
+    buffer.appendBytes(bytes, length: bytes.count)
+    XCTAssertEqual(recorder.lines, ["list"])
+    XCTAssertEqual(recorder.rejections.count, 1)
+  }
+
+  func testFuzzedChunkBoundaries() {
+    let alphabet = Array("abcdefghijklmnopqrstuvwxyz0123456789 -".utf8)
+    for seed in 0..<200 {
+      var random = SeededRandom(state: UInt64(seed))
+
+      var expected: [String] = []
+      var stream: [UInt8] = []
+      for _ in 0..<random.next(50) {
+        var line: [UInt8] = []
+        for _ in 0..<random.next(100) {
+          line.append(alphabet[random.next(alphabet.count)])
+        }
+        // Multi-byte characters are only inserted whole, but may still be split across chunks.
+        if random.next(4) == 0 {
+          line.appendContentsOf(Array("é".utf8))
+        }
+        if !line.isEmpty {
+          expected.append(String(bytes: line, encoding: NSUTF8StringEncoding)!)
+        }
+        stream.appendContentsOf(line)
+        stream.appendContentsOf(random.next(2) == 0 ? [0x0A] : [0x0D, 0x0A])
+      }
+
+      let recorder = LineRecorder()
+      let buffer = LineBuffer(delegate: recorder)
+      var offset = 0
+      while offset < stream.count {
+        let length = min(random.next(32), stream.count - offset)
+        stream.withUnsafeBufferPointer { pointer in
+          buffer.appendBytes(pointer.baseAddress.advancedBy(offset), length: length)
+        }
+        offset += length
+      }
+      buffer.finish()
+
+      XCTAssertEqual(recorder.lines, expected, "Failed for seed \(seed)")
+      XCTAssertEqual(recorder.rejections, [], "Failed for seed \(seed)")
+    }
+  }
+
+  func testThroughput() {
+    let line = Array("boot --locale en_GB --scale 50 iPhone 6 iPad Air 2\n".utf8)
+    var stream: [UInt8] = []
+    for _ in 0..<100000 {
+      stream.appendContentsOf(line)
+    }
+    let chunkLength = 16384
+
+    self.measureBlock {
+      let recorder = LineRecorder()
+      let buffer = LineBuffer(delegate: recorder)
+      stream.withUnsafeBufferPointer { pointer in
+        var offset = 0
+        while offset < pointer.count {
+          let length = min(chunkLength, pointer.count - offset)
+          buffer.appendBytes(pointer.baseAddress.advancedBy(offset), length: length)
+          offset += length
+        }
+      }
+      XCTAssertEqual(recorder.lines.count, 100000)
+    }
+  }
+}
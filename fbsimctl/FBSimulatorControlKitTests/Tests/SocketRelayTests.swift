@@ -0,0 +1,408 @@
+/**
+ * Copyright (c) 2015-present, Facebook, Inc.
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree. An additional grant
+ * of patent rights can be found in the PATENTS file in the same directory.
+ */
+
+import XCTest
+import FBSimulatorControl
+@testable import FBSimulatorControlKit
+
+private let LargeOutputLength = 512 * 1024
+
+class EchoTransformer : RelayTransformer {
+  private let lock = NSLock()
+  private var executedCount = 0
+
+  var executed: Int {
+    get {
+      self.lock.lock()
+      defer { self.lock.unlock() }
+      return self.executedCount
+    }
+  }
+
+  func transform(input: String) -> Output {
+    self.lock.lock()
+    self.executedCount += 1
+    self.lock.unlock()
+
+    if input.hasPrefix("slow") {
+      NSThread.sleepForTimeInterval(2)
+    }
+    if input.hasPrefix("large") {
+      return .Success("echo \(input) " + String(count: LargeOutputLength, repeatedValue: "x" as Character))
+    }
+    return .Success("echo \(input)")
+  }
+}
+
+class SocketRelayTests : XCTestCase {
+  var relay: SocketRelay? = nil
+
+  override func tearDown() {
+    self.relay?.stop()
+    self.relay = nil
+    super.tearDown()
+  }
+
+  func startRelay(maximumConnections: Int, workerCount: Int, maximumConcurrentCommands: Int = 4, transformer: RelayTransformer = EchoTransformer()) -> SocketRelay {
+    let options = SocketRelay.Options(
+      portNumber: 0,
+      bindIPv4: true,
+      bindIPv6: false,
+      unixSocketPath: nil,
+      maximumConnections: maximumConnections,
+      workerCount: workerCount,
+      maximumQueuedOutput: 64 * 1024,
+      maximumQueuedCommands: 16,
+      maximumConcurrentCommands: maximumConcurrentCommands
+    )
+    let relay = SocketRelay(options: options, transformer: transformer)
+    try! relay.listen()
+    self.relay = relay
+    return relay
+  }
+
+  func connectClient(relay: SocketRelay) -> Int32 {
+    let fileDescriptor = socket(PF_INET, SOCK_STREAM, IPPROTO_TCP)
+    var address = sockaddr_in(
+      sin_len: UInt8(strideof(sockaddr_in)),
+      sin_family: UInt8(AF_INET),
+      sin_port: UInt16(relay.boundPort).bigEndian,
+      sin_addr: in_addr(s_addr: inet_addr("127.0.0.1")),
+      sin_zero: (0, 0, 0, 0, 0, 0, 0, 0)
+    )
+    let result = withUnsafePointer(&address) { connect(fileDescriptor, UnsafePointer<sockaddr>($0), socklen_t(strideof(sockaddr_in))) }
+    XCTAssertEqual(result, 0)
+
+    // A server that never responds fails the test, rather than hanging it.
+    var timeout = timeval(tv_sec: 10, tv_usec: 0)
+    setsockopt(fileDescriptor, Constants.sol_socket(), SO_RCVTIMEO, &timeout, socklen_t(strideof(timeval)))
+    return fileDescriptor
+  }
+
+  func sendLine(fileDescriptor: Int32, line: String) {
+    let data = "\(line)\n".dataUsingEncoding(NSUTF8StringEncoding)!
+    XCTAssertEqual(write(fileDescriptor, data.bytes, data.length), data.length)
+  }
+
+  func readLine(fileDescriptor: Int32) -> String? {
+    var bytes: [UInt8] = []
+    var byte: UInt8 = 0
+    while read(fileDescriptor, &byte, 1) == 1 {
+      if byte == 10 {
+        return String(bytes: bytes, encoding: NSUTF8StringEncoding)
+      }
+      bytes.append(byte)
+    }
+    return nil
+  }
+
+  /**
+   Clients are run in the background, so that a server that stops responding fails the test rather than hanging it.
+  */
+  func runInBackground(timeout: NSTimeInterval, block: () -> Void) {
+    let group = dispatch_group_create()
+    dispatch_group_async(group, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), block)
+    let finished = NSRunLoop.currentRunLoop().spinRunLoopWithTimeout(timeout) {
+      dispatch_group_wait(group, DISPATCH_TIME_NOW) == 0
+    }
+    XCTAssertTrue(finished, "Clients did not finish within \(timeout) seconds")
+  }
+
+  func testServesHundredsOfConcurrentClients() {
+    let relay = self.startRelay(512, workerCount: 8)
+    let clientCount = 300
+    var responses: [String?] = []
+
+    self.runInBackground(30) {
+      // Every client is connected and has sent its Command before any response is read.
+      let clients = (0..<clientCount).map { _ in self.connectClient(relay) }
+      for (index, client) in clients.enumerate() {
+        self.sendLine(client, line: "client \(index)")
+      }
+      responses = clients.map(self.readLine)
+      for client in clients {
+        close(client)
+      }
+    }
+
+    XCTAssertEqual(responses.count, clientCount)
+    for (index, response) in responses.enumerate() {
+      XCTAssertEqual(response, "echo client \(index)")
+    }
+  }
+
+  func testSlowCommandDoesNotBlockOtherClients() {
+    let relay = self.startRelay(16, workerCount: 4)
+    var fastResponse: String? = nil
+    var fastDuration: NSTimeInterval = 0
+    var slowResponse: String? = nil
+
+    self.runInBackground(10) {
+      let slowClient = self.connectClient(relay)
+      let fastClient = self.connectClient(relay)
+      self.sendLine(slowClient, line: "slow")
+
+      let start = NSDate()
+      self.sendLine(fastClient, line: "fast")
+      fastResponse = self.readLine(fastClient)
+      fastDuration = NSDate().timeIntervalSinceDate(start)
+      slowResponse = self.readLine(slowClient)
+
+      close(slowClient)
+      close(fastClient)
+    }
+
+    XCTAssertEqual(fastResponse, "echo fast")
+    XCTAssertLessThan(fastDuration, 1)
+    XCTAssertEqual(slowResponse, "echo slow")
+  }
+
+  func testCommandsFromOneClientAreAnsweredInOrder() {
+    let relay = self.startRelay(16, workerCount: 4)
+    var responses: [String?] = []
+
+    self.runInBackground(10) {
+      let client = self.connectClient(relay)
+      self.sendLine(client, line: "slow 1\nfast 2")
+      responses = [self.readLine(client), self.readLine(client)]
+      close(client)
+    }
+
+    XCTAssertEqual(responses.count, 2)
+    XCTAssertEqual(responses.first!, "echo slow 1")
+    XCTAssertEqual(responses.last!, "echo fast 2")
+  }
+
+  func testRejectsConnectionsOverTheLimit() {
+    let relay = self.startRelay(2, workerCount: 1)
+    var acceptedResponses: [String?] = []
+    var rejection: String? = nil
+    var afterRejection: String? = "Not Read"
+
+    self.runInBackground(10) {
+      let accepted = [self.connectClient(relay), self.connectClient(relay)]
+      for client in accepted {
+        self.sendLine(client, line: "hello")
+      }
+      acceptedResponses = accepted.map(self.readLine)
+
+      let rejected = self.connectClient(relay)
+      rejection = self.readLine(rejected)
+      afterRejection = self.readLine(rejected)
+
+      close(rejected)
+      for client in accepted {
+        close(client)
+      }
+    }
+
+    XCTAssertEqual(acceptedResponses.count, 2)
+    for response in acceptedResponses {
+      XCTAssertEqual(response, "echo hello")
+    }
+    XCTAssertTrue(rejection?.hasPrefix("Too many connections") ?? false)
+    XCTAssertNil(afterRejection)
+  }
+
+  func testClosesOnceClientHasFinishedSendingAndReceived() {
+    let relay = self.startRelay(16, workerCount: 1)
+    var response: String? = nil
+    var afterResponse: String? = "Not Read"
+
+    self.runInBackground(10) {
+      let client = self.connectClient(relay)
+      self.sendLine(client, line: "hello")
+      shutdown(client, SHUT_WR)
+      response = self.readLine(client)
+      afterResponse = self.readLine(client)
+      close(client)
+    }
+
+    XCTAssertEqual(response, "echo hello")
+    XCTAssertNil(afterResponse)
+  }
+
+  func testSlowReaderReceivesAllOutputInOrder() {
+    let relay = self.startRelay(16, workerCount: 4)
+    let commandCount = 20
+    var responses: [String?] = []
+
+    self.runInBackground(60) {
+      let client = self.connectClient(relay)
+      for index in 0..<commandCount {
+        self.sendLine(client, line: "large \(index)")
+      }
+      // Output backs up whilst the client is not reading, then is read in small pieces.
+      NSThread.sleepForTimeInterval(0.5)
+      var bytes: [UInt8] = []
+      var chunk = [UInt8](count: 1024, repeatedValue: 0)
+      while responses.count < commandCount {
+        let count = read(client, &chunk, chunk.count)
+        if count <= 0 {
+          break
+        }
+        for byte in chunk[0..<count] {
+          if byte == 10 {
+            responses.append(String(bytes: bytes, encoding: NSUTF8StringEncoding))
+            bytes = []
+          } else {
+            bytes.append(byte)
+          }
+        }
+      }
+      close(client)
+    }
+
+    XCTAssertEqual(responses.count, commandCount)
+    let padding = String(count: LargeOutputLength, repeatedValue: "x" as Character)
+    for (index, response) in responses.enumerate() {
+      XCTAssertEqual(response, "echo large \(index) \(padding)")
+    }
+  }
+
+  func testClientThatStopsReadingHoldsUpItsCommands() {
+    let transformer = EchoTransformer()
+    let relay = self.startRelay(16, workerCount: 4, transformer: transformer)
+    let commandCount = 40
+    var executedWhilstNotReading = 0
+    var responses: [String?] = []
+    var otherResponse: String? = nil
+
+    self.runInBackground(60) {
+      let client = self.connectClient(relay)
+      for index in 0..<commandCount {
+        self.sendLine(client, line: "large \(index)")
+      }
+      NSThread.sleepForTimeInterval(1)
+      executedWhilstNotReading = transformer.executed
+
+      // Other clients are unaffected.
+      let otherClient = self.connectClient(relay)
+      self.sendLine(otherClient, line: "hello")
+      otherResponse = self.readLine(otherClient)
+      close(otherClient)
+
+      for _ in 0..<commandCount {
+        responses.append(self.readLine(client))
+      }
+      close(client)
+    }
+
+    XCTAssertLessThan(executedWhilstNotReading, commandCount / 2)
+    XCTAssertEqual(otherResponse, "echo hello")
+    XCTAssertEqual(responses.count, commandCount)
+    XCTAssertEqual(responses.filter { $0?.hasPrefix("echo large") ?? false }.count, commandCount)
+  }
+
+  func testClosedConnectionsAreCleanedUp() {
+    let transformer = EchoTransformer()
+    let relay = self.startRelay(16, workerCount: 4, transformer: transformer)
+    let commandCount = 40
+    var connectionCountWhilstOpen = 0
+    var executedAtClose = 0
+
+    self.runInBackground(30) {
+      let clients = [self.connectClient(relay), self.connectClient(relay)]
+      for client in clients {
+        for index in 0..<commandCount {
+          self.sendLine(client, line: "large \(index)")
+        }
+      }
+      NSThread.sleepForTimeInterval(0.5)
+      connectionCountWhilstOpen = relay.connectionCount
+
+      // The clients go away without reading any output.
+      for client in clients {
+        close(client)
+      }
+      executedAtClose = transformer.executed
+      NSThread.sleepForTimeInterval(1)
+    }
+
+    XCTAssertEqual(connectionCountWhilstOpen, 2)
+    XCTAssertEqual(relay.connectionCount, 0)
+    // Commands that were held back are cancelled rather than executed.
+    XCTAssertLessThanOrEqual(transformer.executed, executedAtClose + 2)
+    XCTAssertLessThan(transformer.executed, commandCount * 2)
+  }
+
+  func testCommandsWithRequestIDsCompleteOutOfOrder() {
+    let relay = self.startRelay(16, workerCount: 4)
+    var responses: [String?] = []
+
+    self.runInBackground(10) {
+      let client = self.connectClient(relay)
+      self.sendLine(client, line: "[1] slow")
+      self.sendLine(client, line: "[2] fast")
+      responses.append(self.readLine(client))
+      responses.append(self.readLine(client))
+      // A Command without a Request ID does not wait for those with one.
+      self.sendLine(client, line: "unordered")
+      responses.append(self.readLine(client))
+      responses.append(self.readLine(client))
+      responses.append(self.readLine(client))
+      close(client)
+    }
+
+    XCTAssertEqual(responses.count, 5)
+    XCTAssertEqual(responses[0], "[2] echo fast")
+    XCTAssertEqual(responses[1], "[2] OK")
+    XCTAssertEqual(responses[2], "echo unordered")
+    XCTAssertEqual(responses[3], "[1] echo slow")
+    XCTAssertEqual(responses[4], "[1] OK")
+  }
+
+  func testConcurrentCommandsAreBoundedPerConnection() {
+    let relay = self.startRelay(16, workerCount: 8, maximumConcurrentCommands: 2)
+    var responses: [String?] = []
+
+    self.runInBackground(20) {
+      let client = self.connectClient(relay)
+      self.sendLine(client, line: "[a] slow")
+      self.sendLine(client, line: "[b] slow")
+      self.sendLine(client, line: "[c] fast")
+      responses = (0..<6).map { _ in self.readLine(client) }
+      close(client)
+    }
+
+    // The fast Command cannot start until one of the slow Commands has finished.
+    XCTAssertEqual(responses.count, 6)
+    XCTAssertEqual(responses[4], "[c] echo fast")
+    XCTAssertEqual(responses[5], "[c] OK")
+  }
+}
+
+class RelayRequestTests : XCTestCase {
+  func testParsesRequestIDs() {
+    let request = RelayRequest.parse("[42] boot iPhone 5")
+    XCTAssertEqual(request.identifier, "42")
+    XCTAssertEqual(request.command, "boot iPhone 5")
+    XCTAssertFalse(request.ordered)
+  }
+
+  func testLinesWithoutRequestIDsAreOrdered() {
+    for line in ["boot iPhone 5", "[] boot", "[4 2] boot", "[42 boot"] {
+      let request = RelayRequest.parse(line)
+      XCTAssertNil(request.identifier)
+      XCTAssertEqual(request.command, line)
+      XCTAssertTrue(request.ordered)
+    }
+  }
+
+  func testTagsEveryLineOfResponse() {
+    let request = RelayRequest.parse("[7] list")
+    XCTAssertEqual(request.response(.Success("iPhone 5\niPad 2\n")), "[7] iPhone 5\n[7] iPad 2\n[7] OK")
+    XCTAssertEqual(request.response(.Failure("NOPE")), "[7] NOPE\n[7] ERROR")
+  }
+
+  func testDoesNotTagUnorderedResponse() {
+    let request = RelayRequest.parse("list")
+    XCTAssertEqual(request.response(.Success("iPhone 5")), "iPhone 5")
+  }
+}
@@ -9,6 +9,4 @@
 
 import Foundation
 
-Command
-  .fromArguments(Array(NSProcessInfo.processInfo().arguments.dropFirst(1)))
-  .runFromCLI()
+exit(Command.runFromCLI(Array(NSProcessInfo.processInfo().arguments.dropFirst(1))))